@@ -0,0 +1,70 @@
+// Local includes.
+#include "OTA_Handler.h"
+#include "Memory_Updater.h"
+#include "DefaultLogger.h"
+
+// Library includes.
+#include <benchmark/benchmark.h>
+#include <vector>
+
+
+namespace {
+
+uint64_t Get_Time() {
+    return 0U;
+}
+
+bool On_Request_Chunk(size_t const & request_id, size_t const & chunk) {
+    return true;
+}
+
+bool On_State(char const * state, char const * error) {
+    return true;
+}
+
+bool On_Finish() {
+    return true;
+}
+
+void On_Updated(bool const & success) {
+    benchmark::DoNotOptimize(success);
+}
+
+} // namespace
+
+/// Downloads a complete firmware binary of 64 chunks, with the chunk window given as the argument.
+/// Chunks are received in reverse order inside of every window, which means every chunk but the first one of a window has to be buffered
+static void BM_OTA_Download(benchmark::State & state) {
+    uint16_t constexpr chunk_size = 1024U;
+    size_t constexpr chunks = 64U;
+    size_t constexpr firmware_size = (chunks - 1U) * chunk_size + 1U;
+    std::vector<uint8_t> firmware(firmware_size, 0xA5U);
+    std::vector<uint8_t> flash(firmware_size);
+    std::vector<uint8_t> payload(chunk_size);
+    Memory_Updater updater(flash.data(), flash.size());
+    Timer_Queue timer_queue(&Get_Time);
+    uint8_t const window = static_cast<uint8_t>(state.range(0));
+
+    HashGenerator hash;
+    (void)hash.start(MBEDTLS_MD_SHA256);
+    (void)hash.update(firmware.data(), firmware.size());
+    char checksum[FIRMWARE_HASH_SIZE] = {};
+    (void)hash.finish(checksum);
+
+    OTA_Update_Callback const callback("title", "1.0", &updater, &On_Updated, nullptr, nullptr, 0U, chunk_size, 5000000U, window);
+    for (auto _ : state) {
+        OTA_Handler<DefaultLogger> handler(&On_Request_Chunk, &On_State, &On_Finish);
+        handler.Set_Timer_Queue(&timer_queue);
+        handler.Start_Firmware_Update(callback, "title", "2.0", firmware_size, checksum, MBEDTLS_MD_SHA256);
+        for (size_t first = 0U; first < chunks; first += window) {
+            size_t const last = first + window < chunks ? first + window : chunks;
+            for (size_t chunk = last; chunk-- > first;) {
+                size_t const size = chunk + 1U == chunks ? firmware_size % chunk_size : chunk_size;
+                (void)memcpy(payload.data(), firmware.data() + chunk * chunk_size, size);
+                handler.Process_Firmware_Packet(chunk, payload.data(), size);
+            }
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * firmware_size);
+}
+BENCHMARK(BM_OTA_Download)->Arg(1)->Arg(4);
@@ -0,0 +1,53 @@
+// Local includes.
+#include "Telemetry.h"
+
+// Library includes.
+#include <ArduinoJson.h>
+#include <benchmark/benchmark.h>
+
+
+namespace {
+
+Telemetry const telemetry[] = { Telemetry("temperature", 21.5), Telemetry("humidity", 40), Telemetry("pressure", 101325.25), Telemetry("voltage", 3.3e-5),
+    Telemetry("uptime", 1234567890123), Telemetry("active", true), Telemetry("mode", "auto"), Telemetry("label", "room \"A\"") };
+size_t constexpr TELEMETRY_AMOUNT = sizeof(telemetry) / sizeof(telemetry[0U]);
+
+} // namespace
+
+/// @brief Copies every record into a JsonDocument first and serializes the document afterwards, which is how the payload is built without the direct writer
+static void BM_Telemetry_Serialize_Document(benchmark::State & state) {
+    char buffer[256U] = {};
+    for (auto _ : state) {
+        StaticJsonDocument<JSON_OBJECT_SIZE(TELEMETRY_AMOUNT)> json_buffer;
+        for (Telemetry const & data : telemetry) {
+            (void)data.SerializeKeyValue(json_buffer);
+        }
+        size_t const length = serializeJson(json_buffer, buffer, sizeof(buffer));
+        benchmark::DoNotOptimize(length);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Telemetry_Serialize_Document);
+
+/// @brief Writes every record directly into the buffer with Write_Json_Object(), which results in the same payload
+static void BM_Telemetry_Write_Json_Object(benchmark::State & state) {
+    char buffer[256U] = {};
+    for (auto _ : state) {
+        size_t const length = Telemetry::Write_Json_Object(&telemetry[0U], &telemetry[0U] + TELEMETRY_AMOUNT, buffer, sizeof(buffer));
+        benchmark::DoNotOptimize(length);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Telemetry_Write_Json_Object);
+
+/// @brief Writes only floating point values of different magnitudes, to measure the number formatting without the surrounding object
+static void BM_Telemetry_Write_Real(benchmark::State & state) {
+    Telemetry const reals[] = { Telemetry("a", 0.1), Telemetry("b", 3.14159265358979), Telemetry("c", 123456.789), Telemetry("d", 6.02214076e23), Telemetry("e", 1.602176634e-19) };
+    char buffer[256U] = {};
+    for (auto _ : state) {
+        size_t const length = Telemetry::Write_Json_Object(&reals[0U], &reals[0U] + 5U, buffer, sizeof(buffer));
+        benchmark::DoNotOptimize(length);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Telemetry_Write_Real);
@@ -0,0 +1,135 @@
+// Local includes.
+#include "ThingsBoard.h"
+#include "Memory_MQTT_Client.h"
+#include "Server_Side_RPC.h"
+#include "Shared_Attribute_Update.h"
+
+// Library includes.
+#include <benchmark/benchmark.h>
+#include <string>
+
+
+namespace {
+
+size_t received = 0U;
+
+void On_Published(char const * topic, uint8_t const * payload, size_t const & length) {
+    benchmark::DoNotOptimize(payload);
+}
+
+void On_Rpc(JsonVariantConst const & data, JsonDocument & response) {
+    received++;
+    response["ok"] = true;
+}
+
+void On_Attributes(JsonObjectConst const & data) {
+    received++;
+}
+
+char const * const rpc_methods[] = { "getValue", "reboot", "setLed", "setMode", "setValue" };
+
+/// @brief Connected client with the server-side RPC and shared attribute update API subscribed, messages are received over the in-memory client
+class Connected_Client {
+  public:
+    Connected_Client() {
+        m_client.set_published_callback(&On_Published);
+        (void)m_tb.setBufferSize(512U, 512U);
+        m_tb.Subscribe_API_Implementation(m_rpc);
+        m_tb.Subscribe_API_Implementation(m_shared_update);
+        for (char const * method : rpc_methods) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+            (void)m_rpc.RPC_Subscribe(RPC_Callback(method, &On_Rpc, JSON_OBJECT_SIZE(1U)));
+#else
+            (void)m_rpc.RPC_Subscribe(RPC_Callback(method, &On_Rpc));
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        }
+        (void)m_shared_update.Shared_Attributes_Subscribe(m_shared_callback);
+        (void)m_client.connect("client", "user", "password");
+    }
+
+    /// @brief Receives the given message, the payload is copied first, because it is deserialized in place
+    void Receive(std::string const & topic, std::string const & payload) {
+        m_topic = topic;
+        m_payload = payload;
+        (void)m_client.receive(&m_topic[0], reinterpret_cast<uint8_t *>(&m_payload[0]), m_payload.size());
+    }
+
+    ThingsBoardSized<> & Get_Client() {
+        return m_tb;
+    }
+
+  private:
+    Memory_MQTT_Client        m_client = {};
+    ThingsBoardSized<>        m_tb{m_client};
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Server_Side_RPC<>         m_rpc = {};
+    Shared_Attribute_Callback m_shared_callback{&On_Attributes};
+#else
+    Server_Side_RPC<5U, 1U>   m_rpc = {};
+    Shared_Attribute_Callback<> m_shared_callback{&On_Attributes};
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    Shared_Attribute_Update<> m_shared_update = {};
+    std::string               m_topic = {};
+    std::string               m_payload = {};
+};
+
+} // namespace
+
+static void BM_RPC_Dispatch(benchmark::State & state) {
+    Connected_Client client;
+    std::string const payload = "{\"method\":\"setValue\",\"params\":{\"value\":3,\"unit\":\"celsius\"}}";
+    for (auto _ : state) {
+        client.Receive("v1/devices/me/rpc/request/7", payload);
+    }
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_RPC_Dispatch);
+
+static void BM_Shared_Attribute_Dispatch(benchmark::State & state) {
+    Connected_Client client;
+    std::string payload = "{";
+    for (int64_t i = 0; i < state.range(0); i++) {
+        payload += (i == 0 ? "\"key" : ",\"key") + std::to_string(i) + "\":" + std::to_string(i);
+    }
+    payload += "}";
+    for (auto _ : state) {
+        client.Receive(ATTRIBUTE_TOPIC, payload);
+    }
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_Shared_Attribute_Dispatch)->Arg(1)->Arg(8);
+
+static void BM_Unknown_Topic(benchmark::State & state) {
+    Connected_Client client;
+    for (auto _ : state) {
+        client.Receive("v1/devices/me/unknown", "{\"a\":1}");
+    }
+}
+BENCHMARK(BM_Unknown_Topic);
+
+static void BM_Send_Json(benchmark::State & state) {
+    Connected_Client client;
+    StaticJsonDocument<JSON_OBJECT_SIZE(4U)> document;
+    document["temperature"] = 21.5;
+    document["humidity"] = 40;
+    document["active"] = true;
+    document["mode"] = "auto";
+    size_t const size = Helper::Measure_Json(document);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(client.Get_Client().Send_Json(TELEMETRY_TOPIC, document, size));
+    }
+}
+BENCHMARK(BM_Send_Json);
+
+static void BM_Send_Telemetry(benchmark::State & state) {
+    Connected_Client client;
+    Telemetry const telemetry[] = { Telemetry("temperature", 21.5), Telemetry("humidity", 40), Telemetry("active", true), Telemetry("mode", "auto") };
+    for (auto _ : state) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        benchmark::DoNotOptimize(client.Get_Client().sendTelemetry(&telemetry[0], &telemetry[0] + 4U));
+#else
+        benchmark::DoNotOptimize(client.Get_Client().sendTelemetry<4U>(&telemetry[0], &telemetry[0] + 4U));
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+}
+BENCHMARK(BM_Send_Telemetry);
@@ -7,10 +7,13 @@
 
 /// @brief Possible processing types an API Implementation uses to handle responses from the server.
 /// Only ever uses one at the time, because the response is either unserialized data which we need to process as such (OTA Firmware Update)
-/// or actually JSON which needs to be serialized (everything else)
+/// or actually JSON which needs to be serialized (everything else), which can optionally be streamed instead of being deserialized into a JsonDocument first
 enum class API_Process_Type : uint8_t {
-    RAW, ///< Passes the data into the process method as a copy but in its raw uint8_t array form
-    JSON ///< Passes the data into the process method as a copy and in a serialized manner
+    RAW,   ///< Passes the data into the process method as a copy but in its raw uint8_t array form
+    JSON,  ///< Passes the data into the process method as a copy and in a serialized manner
+    STREAM ///< Passes the writeable raw json into the raw process method, which parses it in place with the Json_Stream_Parser instead of requiring a JsonDocument.
+           ///< Only done if the api implementation is the only one that handles the received topic, because parsing in place modifies the data,
+           ///< otherwise the data is deserialized once and passed into the json process method instead, the same as for JSON
 };
 
 #endif // API_Process_Type_h
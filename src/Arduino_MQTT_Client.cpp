@@ -4,8 +4,12 @@
 #ifdef ARDUINO
 
 Arduino_MQTT_Client::Arduino_MQTT_Client(Client & transport_client) :
+#if THINGSBOARD_ENABLE_STL
+    m_received_data_callback(),
+#endif // THINGSBOARD_ENABLE_STL
     m_connected_callback(),
-    m_mqtt_client(transport_client)
+    m_mqtt_client(transport_client),
+    m_clean_session(true)
 {
     // Nothing to do
 }
@@ -15,7 +19,16 @@ void Arduino_MQTT_Client::set_client(Client & transport_client) {
 }
 
 void Arduino_MQTT_Client::set_data_callback(Callback<void, char *, uint8_t *, unsigned int>::function callback) {
+#if THINGSBOARD_ENABLE_STL
+    m_received_data_callback.Set_Callback(callback);
+    // The underlying client expects a std::function, a lambda only capturing this is small enough to be stored inline, meaning it does not allocate any memory on the heap,
+    // which would not be the case for the given callback, because it contains its own inline buffer that is bigger than the one of std::function
+    m_mqtt_client.setCallback([this](char * topic, uint8_t * payload, unsigned int length) {
+        m_received_data_callback.Call_Callback(topic, payload, length);
+    });
+#else
     m_mqtt_client.setCallback(callback);
+#endif // THINGSBOARD_ENABLE_STL
 }
 
 void Arduino_MQTT_Client::set_connect_callback(Callback<void>::function callback) {
@@ -38,8 +51,14 @@ void Arduino_MQTT_Client::set_server(char const * domain, uint16_t port) {
     m_mqtt_client.setServer(domain, port);
 }
 
+bool Arduino_MQTT_Client::set_clean_session(bool clean_session) {
+    m_clean_session = clean_session;
+    return true;
+}
+
 bool Arduino_MQTT_Client::connect(char const * client_id, char const * user_name, char const * password) {
-    bool const result = m_mqtt_client.connect(client_id, user_name, password);
+    // Only the overload that additionally accepts a last will allows to pass the cleanSession flag, therefore an empty last will is passed
+    bool const result = m_mqtt_client.connect(client_id, user_name, password, nullptr, 0U, false, nullptr, m_clean_session);
     m_connected_callback.Call_Callback();
     return result;
 }
@@ -39,6 +39,10 @@ class Arduino_MQTT_Client : public IMQTT_Client {
 
     void set_server(char const * domain, uint16_t port) override;
 
+    /// @brief Persistent sessions are supported, but the PubSubClient does not expose the session present flag of the CONNACK packet,
+    /// therefore the default implementation of get_session_present() is kept and every topic is still subscribed again once the connection is established
+    bool set_clean_session(bool clean_session) override;
+
     bool connect(char const * client_id, char const * user_name, char const * password) override;
 
     void disconnect() override;
@@ -70,8 +74,12 @@ class Arduino_MQTT_Client : public IMQTT_Client {
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
 
   private:
-    Callback<void> m_connected_callback = {}; // Callback that will be called as soon as the mqtt client has connected
-    PubSubClient   m_mqtt_client = {};        // Underlying MQTT client instance used to send data
+#if THINGSBOARD_ENABLE_STL
+    Callback<void, char *, uint8_t *, unsigned int> m_received_data_callback = {}; // Callback that will be called as soon as the mqtt client receives any data
+#endif // THINGSBOARD_ENABLE_STL
+    Callback<void>                                  m_connected_callback = {};     // Callback that will be called as soon as the mqtt client has connected
+    PubSubClient                                    m_mqtt_client = {};            // Underlying MQTT client instance used to send data
+    bool                                            m_clean_session = true;        // Whether connections are established with the cleanSession flag set
 };
 
 #endif // ARDUINO
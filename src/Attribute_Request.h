@@ -3,7 +3,9 @@
 
 // Local includes.
 #include "Attribute_Request_Callback.h"
+#include "Request_Table.h"
 #include "IAPI_Implementation.h"
+#include "Subscription_Reference.h"
 
 
 // Attribute request API topics.
@@ -21,9 +23,7 @@ char constexpr NO_KEYS_TO_REQUEST[] = "No keys to request were given";
 char constexpr ATT_KEY_NOT_FOUND[] = "Attribute key in Attribute_Request_Callback is NULL";
 char constexpr ATT_KEY_IS_NULL[] = "Requested attribute key is NULL";
 #endif // THINGSBOARD_ENABLE_DEBUG
-#if !THINGSBOARD_ENABLE_DYNAMIC
 char constexpr CLIENT_SHARED_ATTRIBUTE_SUBSCRIPTIONS[] = "client or shared attribute request";
-#endif // THINGSBOARD_ENABLE_DYNAMIC
 
 
 /// @brief Handles the internal implementation of the ThingsBoard shared and server-side Attribute API.
@@ -38,7 +38,7 @@ template <typename Logger = DefaultLogger>
 /// @tparam MaxAttributes Maximum amount of attributes that will ever be requested with the Attribute_Request_Callback, allows to use an array on the stack in the background, default = Default_Attributes_Amount (5)
 template<size_t MaxSubscriptions = Default_Subscriptions_Amount, size_t MaxAttributes = Default_Attributes_Amount, typename Logger = DefaultLogger>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
-class Attribute_Request : public IAPI_Implementation {
+class Attribute_Request : public IAPI_Implementation, public ITimeout_Listener {
   public:
     /// @brief Constructor
     Attribute_Request() = default;
@@ -85,25 +85,10 @@ class Attribute_Request : public IAPI_Implementation {
         size_t const request_id = Helper::parseRequestId(ATTRIBUTE_RESPONSE_TOPIC, topic);
         JsonObjectConst object = data.template as<JsonObjectConst>();
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_DYNAMIC
-        auto it = std::find_if(m_attribute_request_callbacks.begin(), m_attribute_request_callbacks.end(), [&request_id](Attribute_Request_Callback & attribute_request) {
-#else
-        auto it = std::find_if(m_attribute_request_callbacks.begin(), m_attribute_request_callbacks.end(), [&request_id](Attribute_Request_Callback<MaxAttributes> & attribute_request) {
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-            return attribute_request.Get_Request_ID() == request_id;
-        });
-        if (it != m_attribute_request_callbacks.end()) {
-            auto & attribute_request = *it;
-#else
-        for (auto it = m_attribute_request_callbacks.begin(); it != m_attribute_request_callbacks.end(); ++it) {
-            auto & attribute_request = *it;
-
-            if (attribute_request.Get_Request_ID() != request_id) {
-                continue;
-            }
-#endif // THINGSBOARD_ENABLE_STL
-            char const * attribute_response_key = attribute_request.Get_Attribute_Key();
+        // Responses to requests that are not pending anymore, because they have been removed since, are ignored
+        auto attribute_request = m_attribute_request_callbacks.Find(request_id);
+        if (attribute_request != nullptr) {
+            char const * attribute_response_key = attribute_request->Get_Attribute_Key();
             if (attribute_response_key == nullptr) {
 #if THINGSBOARD_ENABLE_DEBUG
                 Logger::printfln(ATT_KEY_NOT_FOUND);
@@ -115,15 +100,13 @@ class Attribute_Request : public IAPI_Implementation {
                 object = object[attribute_response_key];
             }
 
-            attribute_request.Stop_Timeout_Timer();
-            attribute_request.Call_Callback(object);
+            attribute_request->Stop_Timeout_Timer();
+            attribute_request->Call_Callback(object);
 
             delete_callback:
-            // Delete callback because the changes have been requested and the callback is no longer needed
-            Helper::remove(m_attribute_request_callbacks, it);
-#if !THINGSBOARD_ENABLE_STL
-            break;
-#endif // !THINGSBOARD_ENABLE_STL
+            // Delete callback because the changes have been requested and the callback is no longer needed.
+            // Removed with the id instead of the pointer, because the callback might have sent another request, which could have relocated the pending requests
+            (void)m_attribute_request_callbacks.Remove(request_id);
         }
 
         // Unsubscribe from the shared attribute request topic,
@@ -138,6 +121,11 @@ class Attribute_Request : public IAPI_Implementation {
         return strncmp(ATTRIBUTE_RESPONSE_TOPIC, topic, strlen(ATTRIBUTE_RESPONSE_TOPIC)) == 0;
     }
 
+    char const * Get_Response_Topic(bool & is_prefix) const override {
+        is_prefix = true;
+        return ATTRIBUTE_RESPONSE_TOPIC;
+    }
+
     bool Unsubscribe() override {
         return Attributes_Request_Unsubscribe();
     }
@@ -148,9 +136,7 @@ class Attribute_Request : public IAPI_Implementation {
 
 #if !THINGSBOARD_USE_ESP_TIMER
     void loop() override {
-        for (auto & attribute_request : m_attribute_request_callbacks) {
-            attribute_request.Update_Timeout_Timer();
-        }
+        // Nothing to do, because the timeouts of the sent requests are handled by the timer queue of the client
     }
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
@@ -158,11 +144,17 @@ class Attribute_Request : public IAPI_Implementation {
         // Nothing to do
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
-        m_send_json_callback.Set_Callback(send_json_callback);
-        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
-        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
-        m_get_request_id_callback.Set_Callback(get_request_id_callback);
+    void Set_Client(IThingsBoard_Client & client) override {
+        m_client = &client;
+    }
+
+    void Timeout_Expired(size_t const & request_id) override {
+        // Removed once the timeout callback has been called, because the server will not respond anymore or the response is ignored,
+        // which frees the slot for the next request and rejects a late response, because the generation of the slot does not match anymore
+        (void)m_attribute_request_callbacks.Remove(request_id);
+        if (m_attribute_request_callbacks.empty()) {
+            (void)Attributes_Request_Unsubscribe();
+        }
     }
 
   private:
@@ -193,18 +185,6 @@ class Attribute_Request : public IAPI_Implementation {
             return false;
         }
 
-#if THINGSBOARD_ENABLE_DYNAMIC
-        Attribute_Request_Callback * registered_callback = nullptr;
-#else
-        Attribute_Request_Callback<MaxAttributes> * registered_callback = nullptr;
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-        if (!Attributes_Request_Subscribe(callback, registered_callback)) {
-            return false;
-        }
-        else if (registered_callback == nullptr) {
-            return false;
-        }
-
         // String are const char* and therefore stored as a pointer --> zero copy, meaning the size for the strings is 0 bytes,
         // Data structure size depends on the amount of key value pairs passed + the default clientKeys or sharedKeys
         // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
@@ -243,43 +223,63 @@ class Attribute_Request : public IAPI_Implementation {
         // and because there is not enough space the value would simply be "undefined" instead. Which would cause the request to not be sent correctly
         request_buffer[attribute_request_key] = static_cast<const char*>(request);
 
-        size_t * p_request_id = m_get_request_id_callback.Call_Callback();
-        if (p_request_id == nullptr) {
-            Logger::printfln(REQUEST_ID_NULL);
+#if THINGSBOARD_ENABLE_DYNAMIC
+        Attribute_Request_Callback * registered_callback = nullptr;
+#else
+        Attribute_Request_Callback<MaxAttributes> * registered_callback = nullptr;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        size_t request_id = 0U;
+        if (!Attributes_Request_Subscribe(callback, registered_callback, request_id)) {
+            return false;
+        }
+        else if (registered_callback == nullptr) {
             return false;
         }
-        auto & request_id = *p_request_id;
 
-        registered_callback->Set_Request_ID(++request_id);
+        registered_callback->Set_Request_ID(request_id);
         registered_callback->Set_Attribute_Key(attribute_response_key);
-        registered_callback->Start_Timeout_Timer();
-
-        char topic[Helper::detectSize(ATTRIBUTE_REQUEST_TOPIC, request_id)] = {};
-        (void)snprintf(topic, sizeof(topic), ATTRIBUTE_REQUEST_TOPIC, request_id);
-        return m_send_json_callback.Call_Callback(topic, request_buffer, Helper::Measure_Json(request_buffer));
+        registered_callback->Set_Timeout_Listener(this, request_id);
+        registered_callback->Start_Timeout_Timer(&m_client->getTimerQueue());
+
+        // Request ids are limited to 32-bit by the request table, therefore they always fit into the unsigned int expected by the topic format
+        unsigned int const topic_id = static_cast<unsigned int>(request_id);
+        char topic[Helper::detectSize(ATTRIBUTE_REQUEST_TOPIC, topic_id)] = {};
+        (void)snprintf(topic, sizeof(topic), ATTRIBUTE_REQUEST_TOPIC, topic_id);
+        if (!m_client->Send_Json(topic, request_buffer, Helper::Measure_Json(request_buffer))) {
+            // Request is removed directly, because the server will never respond to a request that was not sent
+            (void)m_attribute_request_callbacks.Remove(request_id);
+            if (m_attribute_request_callbacks.empty()) {
+                (void)Attributes_Request_Unsubscribe();
+            }
+            return false;
+        }
+        return true;
     }
 
     /// @brief Subscribes to attribute response topic
     /// @param callback Callback method that will be called
     /// @param registered_callback Editable pointer to a reference of the local version that was copied from the passed callback
+    /// @param request_id Id the request has to be sent with, encodes the slot the local version was copied into
     /// @return Whether requesting the given callback was successful or not
 #if THINGSBOARD_ENABLE_DYNAMIC
-    bool Attributes_Request_Subscribe(Attribute_Request_Callback const & callback, Attribute_Request_Callback * & registered_callback) {
+    bool Attributes_Request_Subscribe(Attribute_Request_Callback const & callback, Attribute_Request_Callback * & registered_callback, size_t & request_id) {
 #else
-    bool Attributes_Request_Subscribe(Attribute_Request_Callback<MaxAttributes> const & callback, Attribute_Request_Callback<MaxAttributes> * & registered_callback) {
+    bool Attributes_Request_Subscribe(Attribute_Request_Callback<MaxAttributes> const & callback, Attribute_Request_Callback<MaxAttributes> * & registered_callback, size_t & request_id) {
 #endif // THINGSBOARD_ENABLE_DYNAMIC
-#if !THINGSBOARD_ENABLE_DYNAMIC
-        if (m_attribute_request_callbacks.size() + 1 > m_attribute_request_callbacks.capacity()) {
+        if (m_attribute_request_callbacks.full()) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+            Logger::printfln(TOO_MANY_PENDING_REQUESTS, CLIENT_SHARED_ATTRIBUTE_SUBSCRIPTIONS, REQUEST_TABLE_MAX_SLOTS);
+#else
             Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, MAX_SUBSCRIPTIONS_TEMPLATE_NAME, CLIENT_SHARED_ATTRIBUTE_SUBSCRIPTIONS);
+#endif // THINGSBOARD_ENABLE_DYNAMIC
             return false;
         }
-#endif // !THINGSBOARD_ENABLE_DYNAMIC
-        if (!m_subscribe_topic_callback.Call_Callback(ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC)) {
+        if (!m_response_subscription.Acquire(m_client)) {
             Logger::printfln(SUBSCRIBE_TOPIC_FAILED, ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC);
           return false;
         }
-        m_attribute_request_callbacks.push_back(callback);
-        registered_callback = &m_attribute_request_callbacks.back();
+        // Generation is taken from the request id shared by every request type, which is persisted with the session state and therefore never reused after a restart
+        registered_callback = m_attribute_request_callbacks.Insert(callback, *m_client->getRequestID(), request_id);
         return true;
     }
 
@@ -288,15 +288,13 @@ class Attribute_Request : public IAPI_Implementation {
     /// and from the  attribute response topic, was successful or not
     bool Attributes_Request_Unsubscribe() {
         m_attribute_request_callbacks.clear();
-        return m_unsubscribe_topic_callback.Call_Callback(ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC);
+        return m_response_subscription.Release(m_client);
     }
 
-    Callback<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};          // Send json document callback
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};    // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {};  // Unubscribe mqtt topic client callback
-    Callback<size_t *>                                                       m_get_request_id_callback = {};     // Get internal request id callback
+    IThingsBoard_Client                                                     *m_client = {};                      // Client the api implementation communicates with the cloud over
+    Subscription_Reference                                                  m_response_subscription = Subscription_Reference(ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC); // Reference to the attribute response topic, acquired while requests are pending
 
-    // Vectors or array (depends on wheter if THINGSBOARD_ENABLE_DYNAMIC is set to 1 or 0), hold copy of the actual passed data, this is to ensure they stay valid,
+    // Request table backed by a vector or array (depends on wheter if THINGSBOARD_ENABLE_DYNAMIC is set to 1 or 0), hold copy of the actual passed data, this is to ensure they stay valid,
     // even if the user only temporarily created the object before the method was called.
     // This can be done because all Callback methods mostly consists of pointers to actual object so copying them
     // does not require a huge memory overhead and is acceptable especially in comparsion to possible problems that could
@@ -305,9 +303,9 @@ class Attribute_Request : public IAPI_Implementation {
     // Therefore copy-by-value has been choosen as for this specific use case it is more advantageous,
     // especially because at most we copy internal vectors or array, that will only ever contain a few pointers
 #if THINGSBOARD_ENABLE_DYNAMIC
-    Vector<Attribute_Request_Callback>                                       m_attribute_request_callbacks = {}; // Client-side or shared attribute request callback vector
+    Request_Table<Attribute_Request_Callback>                                m_attribute_request_callbacks = {}; // Pending client-side or shared attribute requests, indexed by the request id
 #else
-    Array<Attribute_Request_Callback<MaxAttributes>, MaxSubscriptions>       m_attribute_request_callbacks = {}; // Client-side or shared attribute request callback array
+    Request_Table<Attribute_Request_Callback<MaxAttributes>, MaxSubscriptions> m_attribute_request_callbacks = {}; // Pending client-side or shared attribute requests, indexed by the request id
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 };
 
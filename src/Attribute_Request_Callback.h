@@ -143,10 +143,16 @@ class Attribute_Request_Callback : public Callback<void, JsonObjectConst const &
 
     /// @brief Starts the internal timeout timer if we actually received a configured valid timeout time and a valid callback.
     /// Is called as soon as the request is actually sent
-    void Start_Timeout_Timer() {
+    /// @param timer_queue Queue the timeout should be scheduled in, which then calls the timeout callback from its own update() method.
+    /// If nullptr is passed the timeout is handled by the internal timer of the watchdog instead, default = nullptr
+    void Start_Timeout_Timer(Timer_Queue * timer_queue = nullptr) {
         if (m_timeout_microseconds == 0U) {
             return;
         }
+        if (timer_queue != nullptr) {
+            m_timeout_callback.once(*timer_queue, m_timeout_microseconds);
+            return;
+        }
         m_timeout_callback.once(m_timeout_microseconds);
     }
 
@@ -162,6 +168,14 @@ class Attribute_Request_Callback : public Callback<void, JsonObjectConst const &
         m_timeout_callback.Set_Callback(timeout_callback);
     }
 
+    /// @brief Sets the listener that is informed once the request timed out, after the timeout callback has been called.
+    /// Used internally by the api implementation to remove the request that timed out, only applies if the timeout is scheduled in a Timer_Queue
+    /// @param listener Listener that should be informed, has to be kept alive for as long as the timeout timer is started
+    /// @param id Id the listener is informed with, the id the request was sent with
+    void Set_Timeout_Listener(ITimeout_Listener * listener, size_t const & id) {
+        m_timeout_callback.Set_Listener(listener, id);
+    }
+
   private:
 #if THINGSBOARD_ENABLE_DYNAMIC
     Vector<char const *>               m_attributes = {};           // Attribute we want to request
@@ -3,6 +3,7 @@
 
 // Local includes.
 #include "Configuration.h"
+#include "Inplace_Function.h"
 #if !THINGSBOARD_ENABLE_STL && THINGSBOARD_ENABLE_DYNAMIC
 #include "Vector.h"
 #else
@@ -12,7 +13,6 @@
 // Library includes.
 #include <ArduinoJson.h>
 #if THINGSBOARD_ENABLE_STL
-#include <functional>
 #include <vector>
 #endif // THINGSBOARD_ENABLE_STL
 
@@ -25,7 +25,8 @@ using Vector = std::vector<T>;
 
 
 /// @brief General purpose safe callback wrapper. Expects either c-style or c++ style function pointer,
-/// depending on if the C++ STL has been implemented on the given device or not.
+/// depending on if the C++ STL has been implemented on the given device or not. If it has, the c++ style callable is stored in an Inplace_Function instead of a std::function,
+/// which ensures that creating, copying and calling the callback never allocates any memory on the heap.
 /// Simply wraps that function pointer and before calling it ensures it actually exists
 /// @tparam return_typ Type the given callback method should return
 /// @tparam argument_types Types the given callback method should receive
@@ -34,7 +35,7 @@ class Callback {
   public:
     /// @brief Callback signature
 #if THINGSBOARD_ENABLE_STL
-    using function = std::function<return_typ(argument_types... arguments)>;
+    using function = Inplace_Function<return_typ(argument_types... arguments)>;
 #else
     using function = return_typ (*)(argument_types... arguments);
 #endif // THINGSBOARD_ENABLE_STL
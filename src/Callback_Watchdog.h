@@ -2,11 +2,13 @@
 #define Callback_Watchdog_h
 
 // Local includes.
-#include "Callback.h"
+#include "Timer_Queue.h"
 
 // Library includes.
 #if THINGSBOARD_USE_ESP_TIMER
 #include <esp_timer.h>
+#elif THINGSBOARD_USE_STD_CHRONO
+#include <chrono>
 #else
 #include <arduino-timer.h>
 #endif // THINGSBOARD_USE_ESP_TIMER
@@ -23,12 +25,15 @@ constexpr char WATCHDOG_TIMER_NAME[] = "watchdog_timer";
 /// This is done because it uses FreeRTOS to start the actual timer in the background, which removes the need for a Hardware Timer with Interrupts but still achieve the advantage of accurate timings and no need for active polling.
 /// For all other use cases where the esp timer does not exists we instead use the Arduino timer as a fallback, because is is a simple software timer with active polling that works on all Arduino based devices,
 /// because it simply uses the millis() method per default but can be configured over template arguments to use other methods that return the current time.
+/// When built natively for a host without Arduino, like Linux, a deadline is actively polled against std::chrono::steady_clock instead, which behaves the same as the Arduino timer.
+/// Alternatively the watchdog can be started in a Timer_Queue, which is what the api implementations do with the queue owned by ThingsBoardSized, in that case no internal timer is created or polled at all,
+/// instead the queue calls the callback from its own update() method, which is called from the ThingsBoardSized::loop() method.
 /// The class instance is meant to be started with once() which will then call the registered callback after the timeout has passed.
 /// if the detach() method has not been called yet.
 /// This results in behaviour similair to a esp task watchdog but without as high of an accuracy and without restarting the device,
 /// allowing to let it fail and handle the error case silently by the user in the callback method.
 /// Documentation about the specific use and caviates of the ESP Timer implementation can be found here https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/system/esp_timer.html
-class Callback_Watchdog : public Callback<void> {
+class Callback_Watchdog : public Timer_Queue_Entry {
   public:
     /// @brief Constructs empty timeout timer callback, will result in never being called. Internals are simply default constructed as nullptr
     Callback_Watchdog() = default;
@@ -36,9 +41,12 @@ class Callback_Watchdog : public Callback<void> {
     /// @brief Constructs callback, will be called if the timeout time passes without detach() being called
     /// @param callback Callback method that will be called as soon as the internal software timers have processed that the given timeout time passed
     explicit Callback_Watchdog(function callback)
-      : Callback(callback)
+      : Timer_Queue_Entry(callback)
 #if THINGSBOARD_USE_ESP_TIMER
       , m_oneshot_timer(nullptr)
+#elif THINGSBOARD_USE_STD_CHRONO
+      , m_deadline(0U)
+      , m_started(false)
 #else
       , m_oneshot_timer()
 #endif // THINGSBOARD_USE_ESP_TIMER
@@ -59,33 +67,98 @@ class Callback_Watchdog : public Callback<void> {
     /// @brief Starts the watchdog timer once for the given timeout
     /// @param timeout_microseconds Amount of microseconds until the detach() method is excpected to have been called or the initally given callback method will be called
     void once(uint64_t const & timeout_microseconds) {
+        Cancel();
 #if THINGSBOARD_USE_ESP_TIMER
         create_timer();
         (void)esp_timer_start_once(m_oneshot_timer, timeout_microseconds);
+#elif THINGSBOARD_USE_STD_CHRONO
+        m_deadline = now() + timeout_microseconds;
+        m_started = true;
 #else
         m_oneshot_timer.in(timeout_microseconds, &Callback_Watchdog::oneshot_timer_callback, this);
 #endif // THINGSBOARD_USE_ESP_TIMER
     }
 
+    /// @brief Starts the watchdog timer once for the given timeout in the given queue instead of the internal timer,
+    /// meaning the callback is called from Timer_Queue::update() and no internal timer has to be created or updated
+    /// @param timer_queue Queue the watchdog should be scheduled in, has to be kept alive for as long as the watchdog is scheduled
+    /// @param timeout_microseconds Amount of microseconds until the detach() method is excpected to have been called or the initally given callback method will be called
+    void once(Timer_Queue & timer_queue, uint64_t const & timeout_microseconds) {
+        stop_internal_timer();
+        timer_queue.Schedule(*this, timeout_microseconds);
+    }
+
     /// @brief Stops the currently ongoing watchdog timer and ensures the callback is not called. Timer can simply be restarted with calling once() again
     void detach() {
+        Cancel();
+        stop_internal_timer();
+    }
+
+    /// @brief Gets the current time of the same clock that is used internally by the watchdog timer,
+    /// allows to compare multiple points in time with each other, without having to start a separate watchdog for each of them
+    /// On Arduino without the esp timer, micros() overflows every 2^32 microseconds (about 71 minutes), therefore the overflows are counted to extend it to 64-bit,
+    /// this requires the method to be called atleast once per overflow, which is done by ThingsBoardSized::loop() through the timer queue
+    /// @return Current time in microseconds since the device has been started
+    static uint64_t now() {
 #if THINGSBOARD_USE_ESP_TIMER
-        (void)esp_timer_stop(m_oneshot_timer);
+        return static_cast<uint64_t>(esp_timer_get_time());
+#elif THINGSBOARD_USE_STD_CHRONO
+        static std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
 #else
-        m_oneshot_timer.cancel();
+        static uint32_t last_micros = 0U;
+        static uint32_t overflows = 0U;
+        return extend_micros(static_cast<uint32_t>(micros()), last_micros, overflows);
 #endif // THINGSBOARD_USE_ESP_TIMER
     }
 
+    /// @brief Extends the given value of a 32-bit microsecond counter, which overflows every 2^32 microseconds, to a 64-bit time that does not overflow.
+    /// An overflow is detected if the given value is smaller than the previously given one, meaning the method has to be called atleast once per overflow, to not miss any of them
+    /// @param current Current value of the 32-bit microsecond counter
+    /// @param last Value of the counter the method was last called with, is updated to the current value
+    /// @param overflows Amount of overflows counted so far, is incremented if the counter overflowed since the last call
+    /// @return Current time in microseconds, including all counted overflows
+    static uint64_t extend_micros(uint32_t const & current, uint32_t & last, uint32_t & overflows) {
+        if (current < last) {
+            overflows++;
+        }
+        last = current;
+        return (static_cast<uint64_t>(overflows) << 32U) | current;
+    }
+
 #if !THINGSBOARD_USE_ESP_TIMER
     /// @brief Internally checks if the time already passed, has to be done because we are using a simple software timer.
     /// Indirectly called from the interal processing loop of this library, so we expect the user to recently often call the library loop() function.
     /// In the worst case the actuall call of the callback might be massively delayed compared to the original timer time
     void update() {
+#if THINGSBOARD_USE_STD_CHRONO
+        if (!m_started || now() < m_deadline) {
+            return;
+        }
+        m_started = false;
+        (void)oneshot_timer_callback(this);
+#else
         m_oneshot_timer.tick<void>();
+#endif // THINGSBOARD_USE_STD_CHRONO
     }
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
   private:
+    /// @brief Stops the internal timer, without removing the watchdog from the queue it might be scheduled in
+    void stop_internal_timer() {
+#if THINGSBOARD_USE_ESP_TIMER
+        // Timer does not have to be stopped if it has never been created, because the watchdog has only been started in a queue
+        if (m_oneshot_timer == nullptr) {
+            return;
+        }
+        (void)esp_timer_stop(m_oneshot_timer);
+#elif THINGSBOARD_USE_STD_CHRONO
+        m_started = false;
+#else
+        m_oneshot_timer.cancel();
+#endif // THINGSBOARD_USE_ESP_TIMER
+    }
+
 #if THINGSBOARD_USE_ESP_TIMER
     /// @brief Creates and initally configures the timer, has to be done once before either esp_timer_start_once or esp_timer_stop is called
     /// It can not be created in the constructor, because that would possibly be called before we have executed the main app code, meaning the esp timer base is not initalized yet.
@@ -136,6 +209,9 @@ class Callback_Watchdog : public Callback<void> {
 
 #if THINGSBOARD_USE_ESP_TIMER
     esp_timer_handle_t m_oneshot_timer = {}; // ESP Timer handle that is used to start and stop the oneshot timer
+#elif THINGSBOARD_USE_STD_CHRONO
+    uint64_t           m_deadline = {};       // Time in microseconds the callback should be called at, if detach() has not been called until then
+    bool               m_started = {};        // Whether the timer has been started with once() and neither expired nor stopped with detach() yet
 #else
     Timer<1, micros>   m_oneshot_timer = {}; // Ticker instance that handles the timer under the hood, if possible we directly use esp timer instead because it is more efficient
 #endif // THINGSBOARD_USE_ESP_TIMER
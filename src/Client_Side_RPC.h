@@ -3,7 +3,9 @@
 
 // Local includes.
 #include "RPC_Request_Callback.h"
+#include "Request_Table.h"
 #include "IAPI_Implementation.h"
+#include "Subscription_Reference.h"
 
 
 // Client side RPC topics.
@@ -14,8 +16,8 @@ char constexpr RPC_SEND_REQUEST_TOPIC[] = "v1/devices/me/rpc/request/%u";
 char constexpr CLIENT_RPC_METHOD_NULL[] = "Client-side RPC method name is NULL";
 #if !THINGSBOARD_ENABLE_DYNAMIC
 char constexpr RPC_REQUEST_OVERFLOWED[] = "Client-side RPC request overflowed, increase MaxRequestRPC (%u)";
-char constexpr CLIENT_SIDE_RPC_SUBSCRIPTIONS[] = "client-side RPC";
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
+char constexpr CLIENT_SIDE_RPC_SUBSCRIPTIONS[] = "client-side RPC";
 char constexpr RPC_EMPTY_PARAMS_VALUE[] = "{}";
 
 
@@ -33,7 +35,7 @@ template <typename Logger = DefaultLogger>
 /// See https://arduinojson.org/v6/assistant/ for more information on how to estimate the required size and divide the result by 16 and add 2 to receive the required MaxRequestRPC value, default = Default_Request_RPC_Amount (2)
 template<size_t MaxSubscriptions = Default_Subscriptions_Amount, size_t MaxRequestRPC = Default_Request_RPC_Amount, typename Logger = DefaultLogger>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
-class Client_Side_RPC : public IAPI_Implementation {
+class Client_Side_RPC : public IAPI_Implementation, public ITimeout_Listener {
   public:
     /// @brief Constructor
     Client_Side_RPC() = default;
@@ -52,14 +54,6 @@ class Client_Side_RPC : public IAPI_Implementation {
             Logger::printfln(CLIENT_RPC_METHOD_NULL);
             return false;
         }
-        RPC_Request_Callback * registered_callback = nullptr;
-        if (!RPC_Request_Subscribe(callback, registered_callback)) {
-            return false;
-        }
-        else if (registered_callback == nullptr) {
-            return false;
-        }
-
         JsonArray const * parameters = callback.Get_Parameters();
 
 #if THINGSBOARD_ENABLE_DYNAMIC
@@ -88,19 +82,32 @@ class Client_Side_RPC : public IAPI_Implementation {
         }
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
 
-        size_t * p_request_id = m_get_request_id_callback.Call_Callback();
-        if (p_request_id == nullptr) {
-            Logger::printfln(REQUEST_ID_NULL);
+        RPC_Request_Callback * registered_callback = nullptr;
+        size_t request_id = 0U;
+        if (!RPC_Request_Subscribe(callback, registered_callback, request_id)) {
+            return false;
+        }
+        else if (registered_callback == nullptr) {
             return false;
         }
-        auto & request_id = *p_request_id;
-
-        registered_callback->Set_Request_ID(++request_id);
-        registered_callback->Start_Timeout_Timer();
 
-        char topic[Helper::detectSize(RPC_SEND_REQUEST_TOPIC, request_id)] = {};
-        (void)snprintf(topic, sizeof(topic), RPC_SEND_REQUEST_TOPIC, request_id);
-        return m_send_json_callback.Call_Callback(topic, request_buffer, Helper::Measure_Json(request_buffer));
+        registered_callback->Set_Request_ID(request_id);
+        registered_callback->Set_Timeout_Listener(this, request_id);
+        registered_callback->Start_Timeout_Timer(&m_client->getTimerQueue());
+
+        // Request ids are limited to 32-bit by the request table, therefore they always fit into the unsigned int expected by the topic format
+        unsigned int const topic_id = static_cast<unsigned int>(request_id);
+        char topic[Helper::detectSize(RPC_SEND_REQUEST_TOPIC, topic_id)] = {};
+        (void)snprintf(topic, sizeof(topic), RPC_SEND_REQUEST_TOPIC, topic_id);
+        if (!m_client->Send_Json(topic, request_buffer, Helper::Measure_Json(request_buffer))) {
+            // Request is removed directly, because the server will never respond to a request that was not sent
+            (void)m_rpc_request_callbacks.Remove(request_id);
+            if (m_rpc_request_callbacks.empty()) {
+                (void)RPC_Request_Unsubscribe();
+            }
+            return false;
+        }
+        return true;
     }
 
     API_Process_Type Get_Process_Type() const override {
@@ -114,28 +121,15 @@ class Client_Side_RPC : public IAPI_Implementation {
     void Process_Json_Response(char const * topic, JsonDocument const & data) override {
         size_t const request_id = Helper::parseRequestId(RPC_RESPONSE_TOPIC, topic);
 
-#if THINGSBOARD_ENABLE_STL
-        auto it = std::find_if(m_rpc_request_callbacks.begin(), m_rpc_request_callbacks.end(), [&request_id](RPC_Request_Callback & rpc_request) {
-            return rpc_request.Get_Request_ID() == request_id;
-        });
-        if (it != m_rpc_request_callbacks.end()) {
-            auto & rpc_request = *it;
-#else
-        for (auto it = m_rpc_request_callbacks.begin(); it != m_rpc_request_callbacks.end(); ++it) {
-            auto & rpc_request = *it;
+        // Responses to requests that are not pending anymore, because they have been removed since, are ignored
+        RPC_Request_Callback * rpc_request = m_rpc_request_callbacks.Find(request_id);
+        if (rpc_request != nullptr) {
+            rpc_request->Stop_Timeout_Timer();
+            rpc_request->Call_Callback(data);
 
-            if (rpc_request.Get_Request_ID() != request_id) {
-                continue;
-            }
-#endif // THINGSBOARD_ENABLE_STL
-            rpc_request.Stop_Timeout_Timer();
-            rpc_request.Call_Callback(data);
-
-            // Delete callback because the changes have been requested and the callback is no longer needed
-            Helper::remove(m_rpc_request_callbacks, it);
-#if !THINGSBOARD_ENABLE_STL
-            break;
-#endif // !THINGSBOARD_ENABLE_STL
+            // Delete callback because the changes have been requested and the callback is no longer needed.
+            // Removed with the id instead of the pointer, because the callback might have sent another request, which could have relocated the pending requests
+            (void)m_rpc_request_callbacks.Remove(request_id);
         }
 
         // Attempt to unsubscribe from the shared attribute request topic,
@@ -150,6 +144,11 @@ class Client_Side_RPC : public IAPI_Implementation {
         return strncmp(RPC_RESPONSE_TOPIC, topic, strlen(RPC_RESPONSE_TOPIC)) == 0;
     }
 
+    char const * Get_Response_Topic(bool & is_prefix) const override {
+        is_prefix = true;
+        return RPC_RESPONSE_TOPIC;
+    }
+
     bool Unsubscribe() override {
         return RPC_Request_Unsubscribe();
     }
@@ -160,9 +159,7 @@ class Client_Side_RPC : public IAPI_Implementation {
 
 #if !THINGSBOARD_USE_ESP_TIMER
     void loop() override {
-        for (auto & rpc_request : m_rpc_request_callbacks) {
-            rpc_request.Update_Timeout_Timer();
-        }
+        // Nothing to do, because the timeouts of the sent requests are handled by the timer queue of the client
     }
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
@@ -170,11 +167,17 @@ class Client_Side_RPC : public IAPI_Implementation {
         // Nothing to do
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
-        m_send_json_callback.Set_Callback(send_json_callback);
-        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
-        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
-        m_get_request_id_callback.Set_Callback(get_request_id_callback);
+    void Set_Client(IThingsBoard_Client & client) override {
+        m_client = &client;
+    }
+
+    void Timeout_Expired(size_t const & request_id) override {
+        // Removed once the timeout callback has been called, because the server will not respond anymore or the response is ignored,
+        // which frees the slot for the next request and rejects a late response, because the generation of the slot does not match anymore
+        (void)m_rpc_request_callbacks.Remove(request_id);
+        if (m_rpc_request_callbacks.empty()) {
+            (void)RPC_Request_Unsubscribe();
+        }
     }
 
   private:
@@ -183,20 +186,23 @@ class Client_Side_RPC : public IAPI_Implementation {
     /// See https://thingsboard.io/docs/user-guide/rpc/#client-side-rpc for more information
     /// @param callback Callback method that will be called
     /// @param registered_callback Editable pointer to a reference of the local version that was copied from the passed callback
+    /// @param request_id Id the request has to be sent with, encodes the slot the local version was copied into
     /// @return Whether requesting the given callback was successful or not
-    bool RPC_Request_Subscribe(RPC_Request_Callback const & callback, RPC_Request_Callback * & registered_callback) {
-#if !THINGSBOARD_ENABLE_DYNAMIC
-        if (m_rpc_request_callbacks.size() + 1 > m_rpc_request_callbacks.capacity()) {
+    bool RPC_Request_Subscribe(RPC_Request_Callback const & callback, RPC_Request_Callback * & registered_callback, size_t & request_id) {
+        if (m_rpc_request_callbacks.full()) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+            Logger::printfln(TOO_MANY_PENDING_REQUESTS, CLIENT_SIDE_RPC_SUBSCRIPTIONS, REQUEST_TABLE_MAX_SLOTS);
+#else
             Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, MAX_SUBSCRIPTIONS_TEMPLATE_NAME, CLIENT_SIDE_RPC_SUBSCRIPTIONS);
+#endif // THINGSBOARD_ENABLE_DYNAMIC
             return false;
         }
-#endif // !THINGSBOARD_ENABLE_DYNAMIC
-        if (!m_subscribe_topic_callback.Call_Callback(RPC_RESPONSE_SUBSCRIBE_TOPIC)) {
+        if (!m_response_subscription.Acquire(m_client)) {
             Logger::printfln(SUBSCRIBE_TOPIC_FAILED, RPC_RESPONSE_SUBSCRIBE_TOPIC);
             return false;
         }
-        m_rpc_request_callbacks.push_back(callback);
-        registered_callback = &m_rpc_request_callbacks.back();
+        // Generation is taken from the request id shared by every request type, which is persisted with the session state and therefore never reused after a restart
+        registered_callback = m_rpc_request_callbacks.Insert(callback, *m_client->getRequestID(), request_id);
         return true;
     }
 
@@ -205,15 +211,13 @@ class Client_Side_RPC : public IAPI_Implementation {
     /// and from the client-side RPC response topic, was successful or not
     bool RPC_Request_Unsubscribe() {
         m_rpc_request_callbacks.clear();
-        return m_unsubscribe_topic_callback.Call_Callback(RPC_RESPONSE_SUBSCRIBE_TOPIC);
+        return m_response_subscription.Release(m_client);
     }
 
-    Callback<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};          // Send json document callback
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};    // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {};  // Unubscribe mqtt topic client callback
-    Callback<size_t *>                                                       m_get_request_id_callback = {};     // Get internal request id callback
+    IThingsBoard_Client                                                     *m_client = {};                      // Client the api implementation communicates with the cloud over
+    Subscription_Reference                                                  m_response_subscription = Subscription_Reference(RPC_RESPONSE_SUBSCRIBE_TOPIC); // Reference to the client side RPC response topic, acquired while requests are pending
 
-    // Vectors or array (depends on wheter if THINGSBOARD_ENABLE_DYNAMIC is set to 1 or 0), hold copy of the actual passed data, this is to ensure they stay valid,
+    // Request table backed by a vector or array (depends on wheter if THINGSBOARD_ENABLE_DYNAMIC is set to 1 or 0), hold copy of the actual passed data, this is to ensure they stay valid,
     // even if the user only temporarily created the object before the method was called.
     // This can be done because all Callback methods mostly consists of pointers to actual object so copying them
     // does not require a huge memory overhead and is acceptable especially in comparsion to possible problems that could
@@ -222,9 +226,9 @@ class Client_Side_RPC : public IAPI_Implementation {
     // Therefore copy-by-value has been choosen as for this specific use case it is more advantageous,
     // especially because at most we copy internal vectors or array, that will only ever contain a few pointers
 #if THINGSBOARD_ENABLE_DYNAMIC
-    Vector<RPC_Request_Callback>                                             m_rpc_request_callbacks = {};       // Server side RPC callbacks vector
+    Request_Table<RPC_Request_Callback>                                      m_rpc_request_callbacks = {};       // Pending client side RPC requests, indexed by the request id
 #else
-    Array<RPC_Request_Callback, MaxSubscriptions>                            m_rpc_request_callbacks = {};       // Server side RPC callbacks array
+    Request_Table<RPC_Request_Callback, MaxSubscriptions>                    m_rpc_request_callbacks = {};       // Pending client side RPC requests, indexed by the request id
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 };
 
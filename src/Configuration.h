@@ -42,6 +42,46 @@
 #    endif
 #  endif
 
+// Size in bytes of the inline buffer every callback stores the passed callable in, if the C++ STL is used, because callbacks are then stored in an Inplace_Function instead of a std::function.
+// Every callback therefore never allocates any memory on the heap, when it is created, copied into the internal Array or Vector of the api implementations or called.
+// Is big enough to store a std::function, a std::bind to a member method or a lambda capturing up to four pointers. If a passed callable is bigger compilation fails instead,
+// in that case the amount of captured variables has to be reduced or the size has to be increased with a #define before including ThingsBoard.
+#  ifndef THINGSBOARD_CALLBACK_BUFFER_SIZE
+#    define THINGSBOARD_CALLBACK_BUFFER_SIZE (4U * sizeof(void *))
+#  endif
+
+// Maximum amount of key-value pairs a single object or array value can contain, when a received response is streamed (API_Process_Type::STREAM) and THINGSBOARD_ENABLE_DYNAMIC is not set.
+// When streaming only values that are actually passed to a subscribed callback are deserialized, and only one at a time, which therefore requires a StaticJsonDocument big enough for the biggest of those values,
+// instead of one big enough for the complete response. Scalar values like strings or numbers never require any capacity, the size can be increased with a #define before including ThingsBoard.
+#  ifndef THINGSBOARD_STREAM_MAX_VALUE_FIELDS
+#    define THINGSBOARD_STREAM_MAX_VALUE_FIELDS 8U
+#  endif
+
+// Maximum length of the keys the statistics of a Telemetry_Aggregator channel are sent with, including the suffix and the null terminator.
+// Every channel keeps its suffixed keys in fixed arrays of this size, because they have to outlive the message they are sent in. Statistics whose key does not fit are never sent,
+// the size can be increased with a #define before including ThingsBoard.
+#  ifndef THINGSBOARD_AGGREGATOR_MAX_KEY_SIZE
+#    define THINGSBOARD_AGGREGATOR_MAX_KEY_SIZE 32U
+#  endif
+
+// Maximum amount of statistics a single window of the Telemetry_Aggregator can contain when THINGSBOARD_ENABLE_DYNAMIC is not set, meaning the amount of channels times the amount of statistics sent per channel.
+// Only limits the size of the StaticJsonDocument the statistics are copied into, if they can not be written directly into the send buffer, the size can be increased with a #define before including ThingsBoard.
+#  ifndef THINGSBOARD_AGGREGATOR_MAX_VALUES
+#    define THINGSBOARD_AGGREGATOR_MAX_VALUES 16U
+#  endif
+
+// Maximum amount of windows a single limit of the Rate_Limiter can consist of, for example "10:1,300:60" consists of two windows.
+// Every limit keeps its windows in a fixed array of this size, limits with more windows are rejected, the size can be increased with a #define before including ThingsBoard.
+#  ifndef THINGSBOARD_RATE_LIMIT_MAX_WINDOWS
+#    define THINGSBOARD_RATE_LIMIT_MAX_WINDOWS 4U
+#  endif
+
+// Maximum amount of different topics that can be subscribed at once, which the Subscription_Manager counts the references of and which the broker is remembered to hold a subscription for in the MQTT_Session_State.
+// Is big enough for every topic of the api implementations contained in the library, subscribing more topics fails, the size can be increased with a #define before including ThingsBoard.
+#  ifndef THINGSBOARD_SESSION_MAX_TOPICS
+#    define THINGSBOARD_SESSION_MAX_TOPICS 8U
+#  endif
+
 // Use advanced STL features if they are supported by the compiler (std::ranges::view, template constraints and concepts).
 // Currently only the case for ESP IDF when using a major version following 5 and when using Arduino following a major version 3.
 // Allows to improve performance significantly, because to filter arrays or vectors we do not have to make copies of them anymore.
@@ -83,6 +123,21 @@
 #    endif
 #  endif
 
+// Use the chrono header internally for handling timeouts and callbacks, if neither the esp_timer header exists nor the code is compiled with Arduino,
+// which is the case when the library is built natively for a host like Linux, to run it against an in-memory client without requiring an actual device.
+// Works the same as the Arduino timer implementation, meaning the timeouts are actively polled in the loop() method, but uses the monotonic std::chrono::steady_clock as the time source instead of micros().
+#  ifndef THINGSBOARD_USE_STD_CHRONO
+#    ifdef __has_include
+#      if !THINGSBOARD_USE_ESP_TIMER && !defined(ARDUINO) && __has_include(<chrono>)
+#        define THINGSBOARD_USE_STD_CHRONO 1
+#      else
+#        define THINGSBOARD_USE_STD_CHRONO 0
+#      endif
+#    else
+#      define THINGSBOARD_USE_STD_CHRONO 0
+#    endif
+#  endif
+
 // Use the mbed_tls header internally for handling the creation of hashes from binary data, as long as the header exists,
 // because if it is already included we do not need to rely on and incude external lbiraries like Seeed_mbedtls.h, which implements the same features.
 // Only exists following major version 0 minor version 9 on ESP32 (https://github.com/espressif/esp-idf/releases/v0.9) and major version 3 minor version 3 on ESP8266 (https://github.com/espressif/ESP8266_RTOS_SDK/releases/tag/v3.3-rc1).
@@ -0,0 +1,143 @@
+// Header include.
+#include "Deadband_Filter.h"
+
+// Local include.
+#include "Helper.h"
+
+// Library includes.
+#include <math.h>
+
+/// @brief Calculates the hash of the given key, 0 is reserved to mark unused entries and therefore replaced with 1
+/// @param key Key that should be hashed
+/// @return Hash of the key, never 0
+uint32_t Deadband_Key_Hash(char const * key) {
+    uint32_t const hash = Helper::hashString(key);
+    return hash != 0U ? hash : 1U;
+}
+
+Deadband_Filter::Deadband_Filter(Deadband_Entry * entries, size_t const & entries_size, double const & absolute, double const & relative, uint64_t const & max_silence_microseconds)
+  : m_entries(entries)
+  , m_entries_size(entries != nullptr ? entries_size : 0U)
+  , m_absolute(absolute)
+  , m_relative(relative)
+  , m_max_silence(max_silence_microseconds)
+{
+    for (size_t index = 0U; index < m_entries_size; index++) {
+        m_entries[index] = Deadband_Entry();
+    }
+}
+
+bool Deadband_Filter::Set_Deadband(char const * key, double const & absolute, double const & relative) {
+    if (key == nullptr) {
+        return false;
+    }
+    uint32_t const hash = Deadband_Key_Hash(key);
+    Deadband_Entry * const entry = Find_Entry(hash, true);
+    if (entry == nullptr) {
+        return false;
+    }
+    entry->hash = hash;
+    entry->absolute = absolute;
+    entry->relative = relative;
+    return true;
+}
+
+bool Deadband_Filter::Should_Report(Telemetry const & data, uint64_t const & now) const {
+    if (data.m_key == nullptr || data.m_type == Telemetry::DataType::TYPE_NONE) {
+        return true;
+    }
+    Deadband_Entry const * const entry = Find_Entry(Deadband_Key_Hash(data.m_key), false);
+    if (entry == nullptr || !entry->reported) {
+        return true;
+    }
+    else if (m_max_silence != 0U && now - entry->last_reported >= m_max_silence) {
+        return true;
+    }
+
+    double number = 0.0;
+    bool const is_number = Get_Number(data, number);
+    if (is_number != entry->is_number) {
+        return true;
+    }
+    else if (!is_number) {
+        return Get_Value_Hash(data) != entry->last_value_hash;
+    }
+    else if (number == entry->last_number) {
+        return false;
+    }
+    // Not a number never compares equal, therefore it is only reported when it first appears or disappears, instead of every single time
+    else if (isnan(number) || isnan(entry->last_number)) {
+        return !(isnan(number) && isnan(entry->last_number));
+    }
+    double const difference = fabs(number - entry->last_number);
+    double const relative_deadband = fabs(entry->last_number) * entry->relative;
+    double const deadband = entry->absolute > relative_deadband ? entry->absolute : relative_deadband;
+    return difference > deadband;
+}
+
+void Deadband_Filter::Reported(Telemetry const & data, uint64_t const & now) {
+    if (data.m_key == nullptr || data.m_type == Telemetry::DataType::TYPE_NONE) {
+        return;
+    }
+    uint32_t const hash = Deadband_Key_Hash(data.m_key);
+    Deadband_Entry * const entry = Find_Entry(hash, true);
+    if (entry == nullptr) {
+        return;
+    }
+    else if (entry->hash == 0U) {
+        entry->hash = hash;
+        entry->absolute = m_absolute;
+        entry->relative = m_relative;
+    }
+
+    entry->is_number = Get_Number(data, entry->last_number);
+    if (!entry->is_number) {
+        entry->last_value_hash = Get_Value_Hash(data);
+    }
+    entry->last_reported = now;
+    entry->reported = true;
+}
+
+void Deadband_Filter::clear() {
+    for (size_t index = 0U; index < m_entries_size; index++) {
+        m_entries[index].reported = false;
+    }
+}
+
+Deadband_Entry * Deadband_Filter::Find_Entry(uint32_t const & hash, bool const & insert) const {
+    if (m_entries_size == 0U) {
+        return nullptr;
+    }
+    // Linear probing, entries are never removed, which means the first unused entry always ends the search for a key
+    size_t index = hash % m_entries_size;
+    for (size_t probes = 0U; probes < m_entries_size; probes++) {
+        Deadband_Entry & entry = m_entries[index];
+        if (entry.hash == hash) {
+            return &entry;
+        }
+        else if (entry.hash == 0U) {
+            return insert ? &entry : nullptr;
+        }
+        index = index + 1U < m_entries_size ? index + 1U : 0U;
+    }
+    return nullptr;
+}
+
+bool Deadband_Filter::Get_Number(Telemetry const & data, double & number) {
+    if (data.m_type == Telemetry::DataType::TYPE_INT) {
+        number = static_cast<double>(data.m_value.integer);
+        return true;
+    }
+    else if (data.m_type == Telemetry::DataType::TYPE_REAL) {
+        number = data.m_value.real;
+        return true;
+    }
+    return false;
+}
+
+uint64_t Deadband_Filter::Get_Value_Hash(Telemetry const & data) {
+    if (data.m_type == Telemetry::DataType::TYPE_BOOL) {
+        return data.m_value.boolean ? 1U : 0U;
+    }
+    return Helper::hashString64(data.m_value.str);
+}
@@ -0,0 +1,89 @@
+#ifndef Deadband_Filter_h
+#define Deadband_Filter_h
+
+// Local include.
+#include "Telemetry.h"
+
+
+/// @brief State of a single telemetry key tracked by the Deadband_Filter, an array of these entries has to be passed to the filter,
+/// which allows to decide how many keys can be tracked at once, without the filter having to allocate any memory itself
+struct Deadband_Entry {
+    uint32_t hash = {};            // Hash of the key, 0 if the entry is not used by any key
+    uint64_t last_value_hash = {}; // 64-bit hash of the last reported string or boolean value
+    double   absolute = {};        // Minimum absolute change of a numeric value before it is reported again
+    double   relative = {};        // Minimum change of a numeric value relative to the last reported value before it is reported again, 0.05 means 5 percent
+    double   last_number = {};     // Last reported numeric value
+    uint64_t last_reported = {};   // Time in microseconds the value was last reported at
+    bool     reported = {};        // Whether any value has been reported for the key yet
+    bool     is_number = {};       // Whether the last reported value was numeric, contained in last_number, or a string or boolean, contained in last_value_hash
+};
+
+
+/// @brief Report-by-exception filter, that decides for every telemetry key whether its value changed enough since it was last reported, to be worth sending again.
+/// Numeric values are only reported once they differ from the last reported value by more than the absolute deadband or more than the relative deadband of the last reported value, whichever is bigger.
+/// String and boolean values are reported as soon as they are not equal to the last reported value anymore, they are compared with a 64-bit hash so that the last value does not have to be copied.
+/// A changed string is therefore only suppressed if its hash collides with the hash of the last reported string, which is negligibly unlikely, and is still reported once the max silence has passed.
+/// Additionally every key is reported again after the max silence has passed, even if it did not change, so that the server can distinguish a device with a constant value from a device that is not sending anymore.
+/// The state of every key is kept in the passed array of entries as an open-addressed hash table with linear probing, keys are identified by the hash of their content, not their address,
+/// meaning keys do not have to be kept alive and the same key can be passed from different buffers. Keys that do not fit into the table anymore are never filtered and always reported.
+/// Passed to ThingsBoardSized::Set_Telemetry_Filter(), which drops unchanged keys in sendTelemetryData() and sendTelemetry() before any json is built,
+/// and only updates the last reported value once sending was successful, so values that failed to send are reported again on the next call
+class Deadband_Filter {
+  public:
+    /// @brief Constructor
+    /// @param entries Array the state of every tracked key is kept in, has to be kept alive for as long as the instance of this class.
+    /// Should be atleast a quarter bigger than the amount of tracked keys, because the lookup of keys slows down the fuller the table gets
+    /// @param entries_size Amount of entries in the given array
+    /// @param absolute Default absolute deadband of keys that were not configured with Set_Deadband(), 0 means every change is reported, default = 0
+    /// @param relative Default relative deadband of keys that were not configured with Set_Deadband(), 0.05 means 5 percent, 0 means every change is reported, default = 0
+    /// @param max_silence_microseconds Maximum amount of microseconds a key is not reported, before it is reported again even if it did not change, 0 means unchanged keys are never reported again, default = 0
+    Deadband_Filter(Deadband_Entry * entries, size_t const & entries_size, double const & absolute = 0.0, double const & relative = 0.0, uint64_t const & max_silence_microseconds = 0U);
+
+    /// @brief Configures the deadband of the given key, overwriting the default deadband passed to the constructor
+    /// @param key Key the deadband should be configured for
+    /// @param absolute Minimum absolute change of a numeric value before it is reported again, 0 means every change is reported
+    /// @param relative Minimum change of a numeric value relative to the last reported value before it is reported again, 0.05 means 5 percent, 0 means every change is reported
+    /// @return Whether the key could be inserted into the table or not, because every entry is already used by another key
+    bool Set_Deadband(char const * key, double const & absolute, double const & relative);
+
+    /// @brief Whether the given value changed enough since the value of the same key was last reported, or the max silence has passed, to be reported again
+    /// @param data Key-value pair that should be checked, values without a key are always reported
+    /// @param now Current time in microseconds, passed so that every key of the same message is checked against the same time
+    /// @return Whether the value should be reported
+    bool Should_Report(Telemetry const & data, uint64_t const & now) const;
+
+    /// @brief Remembers the given value as the last reported value of its key, has to be called once the value has been sent successfully
+    /// @param data Key-value pair that has been reported
+    /// @param now Time in microseconds the value has been reported at
+    void Reported(Telemetry const & data, uint64_t const & now);
+
+    /// @brief Forgets the last reported value of every key, so that every key is reported again on its next call, the configured deadbands are kept.
+    /// Should be called if the server might have lost the previously reported values
+    void clear();
+
+  private:
+    /// @brief Searches the entry of the key with the given hash
+    /// @param hash Hash of the key
+    /// @param insert Whether an unused entry should be returned if the key is not contained in the table yet
+    /// @return Entry of the key, an unused entry if the key was not found and insert is set, or nullptr if the key was not found and the table is full or insert is not set
+    Deadband_Entry * Find_Entry(uint32_t const & hash, bool const & insert) const;
+
+    /// @brief Gets the value of the given key-value pair as a number, integers bigger than 2^53 lose precision, which only affects whether very small changes of them are detected
+    /// @param data Key-value pair containing the value
+    /// @param number Value as a number, only valid if the value is numeric
+    /// @return Whether the value is numeric or a string or boolean instead
+    static bool Get_Number(Telemetry const & data, double & number);
+
+    /// @brief Calculates the hash of a string or boolean value, which is compared instead of the value itself, so that the last reported string does not have to be copied
+    /// @param data Key-value pair containing the string or boolean value
+    /// @return 64-bit hash of the value
+    static uint64_t Get_Value_Hash(Telemetry const & data);
+
+    Deadband_Entry *m_entries = {};      // Array the state of every tracked key is kept in
+    size_t         m_entries_size = {};  // Amount of entries in the array
+    double         m_absolute = {};      // Default absolute deadband of keys that were not configured
+    double         m_relative = {};      // Default relative deadband of keys that were not configured
+    uint64_t       m_max_silence = {};   // Maximum amount of microseconds a key is not reported, before it is reported again
+};
+
+#endif // Deadband_Filter_h
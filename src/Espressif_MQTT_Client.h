@@ -39,6 +39,7 @@ class Espressif_MQTT_Client : public IMQTT_Client {
       : m_received_data_callback()
       , m_connected_callback()
       , m_connected(false)
+      , m_session_present(false)
       , m_enqueue_messages(false)
       , m_mqtt_configuration()
       , m_mqtt_client(nullptr)
@@ -275,6 +276,19 @@ class Espressif_MQTT_Client : public IMQTT_Client {
 #endif // ESP_IDF_VERSION_MAJOR < 5
     }
 
+    bool set_clean_session(bool clean_session) override {
+#if ESP_IDF_VERSION_MAJOR < 5
+        m_mqtt_configuration.disable_clean_session = !clean_session;
+#else
+        m_mqtt_configuration.session.disable_clean_session = !clean_session;
+#endif // ESP_IDF_VERSION_MAJOR < 5
+        return update_configuration();
+    }
+
+    bool get_session_present() override {
+        return m_session_present;
+    }
+
     bool connect(char const * client_id, char const * user_name, char const * password) override {
 #if ESP_IDF_VERSION_MAJOR < 5
         m_mqtt_configuration.client_id = client_id;
@@ -346,6 +360,22 @@ class Espressif_MQTT_Client : public IMQTT_Client {
         return message_id > MQTT_FAILURE_MESSAGE_ID;
     }
 
+#if ESP_IDF_VERSION_MAJOR > 5 || (ESP_IDF_VERSION_MAJOR == 5 && ESP_IDF_VERSION_MINOR >= 1)
+    bool subscribe_multiple(char const * const * topics, size_t const & count) override {
+        // Same check as for subscribe(), because esp_mqtt_client_subscribe_multiple does not return false either if we are not connected to a broker
+        if (!connected()) {
+            return false;
+        }
+        esp_mqtt_topic_t topic_list[count] = {};
+        for (size_t index = 0U; index < count; index++) {
+            topic_list[index].filter = topics[index];
+            topic_list[index].qos = 0;
+        }
+        int const message_id = esp_mqtt_client_subscribe_multiple(m_mqtt_client, topic_list, count);
+        return message_id > MQTT_FAILURE_MESSAGE_ID;
+    }
+#endif // ESP_IDF_VERSION_MAJOR > 5 || (ESP_IDF_VERSION_MAJOR == 5 && ESP_IDF_VERSION_MINOR >= 1)
+
     bool unsubscribe(char const * topic) override {
         // The esp_mqtt_client_unsubscribe method does not return false, if we send a unsubscribe request while not being connected to a broker,
         // so we have to check for that case to ensure the end user is informed that their unsubscribe request could not be sent and has been ignored.
@@ -421,6 +451,7 @@ private:
         switch (event_id) {
             case esp_mqtt_event_id_t::MQTT_EVENT_CONNECTED:
                 m_connected = true;
+                m_session_present = event->session_present != 0;
                 m_connected_callback.Call_Callback();
                 break;
             case esp_mqtt_event_id_t::MQTT_EVENT_DISCONNECTED:
@@ -457,6 +488,7 @@ private:
     Callback<void, char *, uint8_t *, unsigned int> m_received_data_callback = {}; // Callback that will be called as soon as the mqtt client receives any data
     Callback<void>                                  m_connected_callback = {};     // Callback that will be called as soon as the mqtt client has connected
     bool                                            m_connected = {};              // Whether the client has received the connected or disconnected event
+    bool                                            m_session_present = {};        // Whether the broker still held the session of the client id, when the last connected event was received
     bool                                            m_enqueue_messages = {};       // Whether we enqueue messages making nearly all ThingsBoard calls non blocking or wheter we publish instead
     esp_mqtt_client_config_t                        m_mqtt_configuration = {};     // Configuration of the underlying mqtt client, saved as a private variable to allow changes after inital configuration with the same options for all non changed settings
     esp_mqtt_client_handle_t                        m_mqtt_client = {};            // Handle to the underlying mqtt client, used to establish the communication
@@ -0,0 +1,71 @@
+#ifndef Espressif_Outbox_Storage_h
+#define Espressif_Outbox_Storage_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_USE_ESP_PARTITION
+
+// Local include.
+#include "IOutbox_Storage.h"
+#include "DefaultLogger.h"
+
+// Library include.
+#include <esp_partition.h>
+
+constexpr char MISSING_OUTBOX_PARTITION[] = "Failed to find outbox data partition (%s), ensure it is contained in the partition table";
+
+
+/// @brief IOutbox_Storage implementation that uses the Partitions API from Espressif (https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/storage/partition.html),
+/// under the hood to write the outbox directly into a data partition of the flash, without requiring a file system.
+/// The sector size is the erase size of the flash, because the outbox only appends to the erased sectors and erases a complete sector before reusing it, the wear is spread evenly over the whole partition
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
+template <typename Logger = DefaultLogger>
+class Espressif_Outbox_Storage : public IOutbox_Storage {
+  public:
+    /// @brief Constructor
+    /// @param partition_label Label of the data partition in the partition table, that the outbox should be written into
+    Espressif_Outbox_Storage(char const * partition_label)
+      : m_label(partition_label)
+      , m_partition(nullptr)
+    {
+        // Nothing to do
+    }
+
+    bool begin() override {
+        m_partition = esp_partition_find_first(esp_partition_type_t::ESP_PARTITION_TYPE_DATA, esp_partition_subtype_t::ESP_PARTITION_SUBTYPE_ANY, m_label);
+        if (m_partition == nullptr) {
+            Logger::printfln(MISSING_OUTBOX_PARTITION, m_label);
+            return false;
+        }
+        return true;
+    }
+
+    size_t get_size() const override {
+        return m_partition != nullptr ? m_partition->size : 0U;
+    }
+
+    size_t get_sector_size() const override {
+        return SPI_FLASH_SEC_SIZE;
+    }
+
+    bool read(size_t const & offset, uint8_t * buffer, size_t const & size) override {
+        return esp_partition_read(m_partition, offset, buffer, size) == ESP_OK;
+    }
+
+    bool write(size_t const & offset, uint8_t const * buffer, size_t const & size) override {
+        return esp_partition_write(m_partition, offset, buffer, size) == ESP_OK;
+    }
+
+    bool erase_sector(size_t const & offset) override {
+        return esp_partition_erase_range(m_partition, offset, SPI_FLASH_SEC_SIZE) == ESP_OK;
+    }
+
+  private:
+    char const            *m_label = {};     // Label of the data partition the outbox is written into
+    esp_partition_t const *m_partition = {}; // Data partition the outbox is written into, found in begin()
+};
+
+#endif // THINGSBOARD_USE_ESP_PARTITION
+
+#endif // Espressif_Outbox_Storage_h
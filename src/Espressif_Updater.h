@@ -26,18 +26,9 @@ class Espressif_Updater : public IUpdater {
     Espressif_Updater() = default;
 
     bool begin(size_t const & firmware_size) override {
-        esp_partition_t const * running = esp_ota_get_running_partition();
-        esp_partition_t const * configured = esp_ota_get_boot_partition();
-
-        if (configured != running) {
-            Logger::printfln(INVALID_OTA_PARTIION);
-            return false;
-        }
-
-        esp_partition_t const * update_partition = esp_ota_get_next_update_partition(nullptr);
+        esp_partition_t const * update_partition = Get_Update_Partition();
 
         if (update_partition == nullptr) {
-            Logger::printfln(MISSING_OTA_APP);
             return false;
         }
 
@@ -57,6 +48,38 @@ class Espressif_Updater : public IUpdater {
         return true;
     }
 
+#if !defined(ESP8266) && (ESP_IDF_VERSION_MAJOR > 5 || (ESP_IDF_VERSION_MAJOR == 5 && ESP_IDF_VERSION_MINOR >= 5))
+    bool resume(size_t const & firmware_size, size_t const & offset) override {
+        esp_partition_t const * update_partition = Get_Update_Partition();
+
+        if (update_partition == nullptr || offset > firmware_size) {
+            return false;
+        }
+
+        // Resuming keeps the data already written in front of the offset and lets any following esp_ota_write continue directly after it,
+        // older versions do not support resuming an update at all, therefore the default implementation is used and the update is restarted from the first chunk instead
+        esp_ota_handle_t ota_handle;
+        esp_err_t const error = esp_ota_resume(update_partition, firmware_size, offset, &ota_handle);
+
+        if (error != ESP_OK) {
+            Logger::printfln(BEGIN_UPDATE_FAILED, esp_err_to_name(error));
+            return false;
+        }
+
+        m_ota_handle = ota_handle;
+        m_update_partition = update_partition;
+        return true;
+    }
+
+    size_t read(size_t const & offset, uint8_t * buffer, size_t const & length) override {
+        if (m_update_partition == nullptr) {
+            return 0U;
+        }
+        esp_err_t const error = esp_partition_read(m_update_partition, offset, buffer, length);
+        return (error == ESP_OK) ? length : 0U;
+    }
+#endif // !defined(ESP8266) && (ESP_IDF_VERSION_MAJOR > 5 || (ESP_IDF_VERSION_MAJOR == 5 && ESP_IDF_VERSION_MINOR >= 5))
+
     size_t write(uint8_t * payload, size_t const & total_bytes) override {
         esp_err_t const error = esp_ota_write(m_ota_handle, payload, total_bytes);
         size_t const written_bytes = (error == ESP_OK) ? total_bytes : 0U;
@@ -82,6 +105,26 @@ class Espressif_Updater : public IUpdater {
     }
 
   private:
+    /// @brief Gets the partition the update should be written into, additionally ensures that the device did not fall back to the previous partition,
+    /// because that would mean the previous update failed and we would overwrite the only working partition
+    /// @return Non active OTA partition that we write our data into, nullptr if there is none or the previous update failed
+    esp_partition_t const * Get_Update_Partition() const {
+        esp_partition_t const * running = esp_ota_get_running_partition();
+        esp_partition_t const * configured = esp_ota_get_boot_partition();
+
+        if (configured != running) {
+            Logger::printfln(INVALID_OTA_PARTIION);
+            return nullptr;
+        }
+
+        esp_partition_t const * update_partition = esp_ota_get_next_update_partition(nullptr);
+
+        if (update_partition == nullptr) {
+            Logger::printfln(MISSING_OTA_APP);
+        }
+        return update_partition;
+    }
+
     uint32_t               m_ota_handle = {};       // ESP OTA hanle that is used to to access the underlying updater
     esp_partition_t const *m_update_partition = {}; // Non active OTA partition that we write our data into
 };
@@ -0,0 +1,141 @@
+#ifndef File_Checkpoint_Storage_h
+#define File_Checkpoint_Storage_h
+
+// Local include.
+#include "Configuration.h"
+
+// Local include.
+#include "IOTA_Checkpoint_Storage.h"
+#include "DefaultLogger.h"
+
+// Library include.
+#include <stdio.h>
+#include <string.h>
+
+
+constexpr char OPEN_CHECKPOINT_FAILED[] = "Failed to open checkpoint file (%s), ensure path is correct and the file system is mounted";
+// Identifies files written by File_Checkpoint_Storage, is "TBCP" when read as little endian bytes
+uint32_t constexpr CHECKPOINT_FILE_MAGIC = 0x50434254U;
+// Version of the file format, has to be increased whenever the layout of the written checkpoint changes, files with any other version are ignored
+uint8_t constexpr CHECKPOINT_FILE_VERSION = 1U;
+// Size of the header in front of the checkpoint, consisting of the magic, the version and the size of the following checkpoint
+size_t constexpr CHECKPOINT_FILE_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint16_t);
+// Size of the written checkpoint, consisting of the title, version, checksum, checksum algorithm, firmware size, chunk size and amount of written chunks
+size_t constexpr CHECKPOINT_FILE_BODY_SIZE = (CHECKPOINT_STRING_SIZE * 2U) + FIRMWARE_HASH_SIZE + sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint32_t);
+
+
+/// @brief IOTA_Checkpoint_Storage implementation that uses the c fopen function (https://cplusplus.com/reference/cstdio/fopen/),
+/// under the hood to write the given checkpoint into a file. Can be used with any file system that is mounted into the virtual file system (SPIFFS, LittleFS, FAT on an SD card, ...).
+/// The checkpoint is written field by field as fixed width little endian integers behind a versioned header, instead of copying the structure as is,
+/// so that the file stays readable independent of the padding and integer sizes the firmware has been compiled with
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
+template <typename Logger = DefaultLogger>
+class File_Checkpoint_Storage : public IOTA_Checkpoint_Storage {
+  public:
+    File_Checkpoint_Storage(char const * file_path)
+      : m_path(file_path)
+    {
+        // Nothing to do
+    }
+
+    bool load(OTA_Checkpoint & checkpoint) override {
+        FILE* file = fopen(m_path, "rb");
+        if (file == nullptr) {
+            // Not an error, simply means that there is no update that could be resumed
+            return false;
+        }
+        uint8_t buffer[CHECKPOINT_FILE_HEADER_SIZE + CHECKPOINT_FILE_BODY_SIZE] = {};
+        size_t const bytes_read = fread(buffer, 1, sizeof(buffer), file);
+        fclose(file);
+        if (bytes_read != sizeof(buffer)) {
+            return false;
+        }
+
+        uint8_t const * position = buffer;
+        if (Read_Unsigned(position, sizeof(uint32_t)) != CHECKPOINT_FILE_MAGIC || Read_Unsigned(position, sizeof(uint8_t)) != CHECKPOINT_FILE_VERSION || Read_Unsigned(position, sizeof(uint16_t)) != CHECKPOINT_FILE_BODY_SIZE) {
+            return false;
+        }
+        Read_String(position, checkpoint.fw_title, sizeof(checkpoint.fw_title));
+        Read_String(position, checkpoint.fw_version, sizeof(checkpoint.fw_version));
+        Read_String(position, checkpoint.fw_checksum, sizeof(checkpoint.fw_checksum));
+        checkpoint.fw_checksum_algorithm = static_cast<mbedtls_md_type_t>(Read_Unsigned(position, sizeof(uint8_t)));
+        checkpoint.fw_size = Read_Unsigned(position, sizeof(uint32_t));
+        checkpoint.chunk_size = static_cast<uint16_t>(Read_Unsigned(position, sizeof(uint16_t)));
+        checkpoint.written_chunks = Read_Unsigned(position, sizeof(uint32_t));
+        return true;
+    }
+
+    bool store(OTA_Checkpoint const & checkpoint) override {
+        uint8_t buffer[CHECKPOINT_FILE_HEADER_SIZE + CHECKPOINT_FILE_BODY_SIZE] = {};
+        uint8_t * position = buffer;
+        Write_Unsigned(position, CHECKPOINT_FILE_MAGIC, sizeof(uint32_t));
+        Write_Unsigned(position, CHECKPOINT_FILE_VERSION, sizeof(uint8_t));
+        Write_Unsigned(position, CHECKPOINT_FILE_BODY_SIZE, sizeof(uint16_t));
+        Write_String(position, checkpoint.fw_title, sizeof(checkpoint.fw_title));
+        Write_String(position, checkpoint.fw_version, sizeof(checkpoint.fw_version));
+        Write_String(position, checkpoint.fw_checksum, sizeof(checkpoint.fw_checksum));
+        Write_Unsigned(position, static_cast<uint32_t>(checkpoint.fw_checksum_algorithm), sizeof(uint8_t));
+        Write_Unsigned(position, checkpoint.fw_size, sizeof(uint32_t));
+        Write_Unsigned(position, checkpoint.chunk_size, sizeof(uint16_t));
+        Write_Unsigned(position, checkpoint.written_chunks, sizeof(uint32_t));
+
+        FILE* file = fopen(m_path, "wb");
+        if (file == nullptr) {
+            Logger::printfln(OPEN_CHECKPOINT_FAILED, m_path);
+            return false;
+        }
+        size_t const bytes_written = fwrite(buffer, 1, sizeof(buffer), file);
+        fclose(file);
+        return bytes_written == sizeof(buffer);
+    }
+
+    void erase() override {
+        (void)remove(m_path);
+    }
+
+  private:
+    /// @brief Writes the given value as a little endian integer with the given width and advances the position behind it
+    /// @param position Position in the buffer the value should be written at
+    /// @param value Value that should be written, has to fit into the given width
+    /// @param width Amount of bytes the value is written with
+    static void Write_Unsigned(uint8_t * & position, uint32_t const & value, size_t const & width) {
+        for (size_t i = 0U; i < width; i++) {
+            *position++ = static_cast<uint8_t>(value >> (i * 8U));
+        }
+    }
+
+    /// @brief Reads a little endian integer with the given width and advances the position behind it
+    /// @param position Position in the buffer the value should be read from
+    /// @param width Amount of bytes the value was written with
+    /// @return Read value
+    static uint32_t Read_Unsigned(uint8_t const * & position, size_t const & width) {
+        uint32_t value = 0U;
+        for (size_t i = 0U; i < width; i++) {
+            value |= static_cast<uint32_t>(*position++) << (i * 8U);
+        }
+        return value;
+    }
+
+    /// @brief Writes the given string with the given fixed size and advances the position behind it
+    /// @param position Position in the buffer the string should be written at
+    /// @param value String that should be written, is always written completely including the null termination and any unused bytes behind it
+    /// @param size Fixed size the string is written with
+    static void Write_String(uint8_t * & position, char const * value, size_t const & size) {
+        (void)memcpy(position, value, size);
+        position += size;
+    }
+
+    /// @brief Reads a string with the given fixed size and advances the position behind it, the read string is always null terminated
+    /// @param position Position in the buffer the string should be read from
+    /// @param value Output string the read string is copied into
+    /// @param size Fixed size the string was written with
+    static void Read_String(uint8_t const * & position, char * value, size_t const & size) {
+        (void)memcpy(value, position, size);
+        value[size - 1U] = '\0';
+        position += size;
+    }
+
+    char const * m_path = {}; // Path to the file the checkpoint is written into
+};
+
+#endif // File_Checkpoint_Storage_h
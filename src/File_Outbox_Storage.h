@@ -0,0 +1,114 @@
+#ifndef File_Outbox_Storage_h
+#define File_Outbox_Storage_h
+
+// Local include.
+#include "Configuration.h"
+
+// Local include.
+#include "IOutbox_Storage.h"
+#include "DefaultLogger.h"
+
+// Library include.
+#include <stdio.h>
+#include <string.h>
+
+
+constexpr char OPEN_OUTBOX_FAILED[] = "Failed to open outbox file (%s), ensure path is correct and the file system is mounted";
+
+
+/// @brief IOutbox_Storage implementation that uses the c fopen function (https://cplusplus.com/reference/cstdio/fopen/),
+/// under the hood to persist the outbox into a single file of a fixed size. Can be used with any file system that is mounted into the virtual file system (SPIFFS, LittleFS, FAT on an SD card, ...)
+/// or on any operating system with a c standard library, which allows to use the outbox on Linux as well.
+/// Bytes that have never been written, because the file is shorter than the storage region, read as erased 0xFF bytes
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
+template <typename Logger = DefaultLogger>
+class File_Outbox_Storage : public IOutbox_Storage {
+  public:
+    /// @brief Constructor
+    /// @param file_path Path to the file the outbox is written into, the file is created if it does not exist yet
+    /// @param size Total size the file is allowed to grow to, has to be a multiple of the sector size
+    /// @param sector_size Size of a single sector, decides how many of the oldest messages are dropped at once if the outbox is full.
+    /// Messages bigger than the sector size can not be stored, default = 512
+    File_Outbox_Storage(char const * file_path, size_t const & size, size_t const & sector_size = 512U)
+      : m_path(file_path)
+      , m_size(size)
+      , m_sector_size(sector_size)
+      , m_file(nullptr)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Destructor
+    ~File_Outbox_Storage() {
+        if (m_file != nullptr) {
+            (void)fclose(m_file);
+            m_file = nullptr;
+        }
+    }
+
+    bool begin() override {
+        if (m_file != nullptr) {
+            return true;
+        }
+        // Attempt to open the existing file first, because w+b would truncate the messages that were persisted before the restart
+        m_file = fopen(m_path, "r+b");
+        if (m_file == nullptr) {
+            m_file = fopen(m_path, "w+b");
+        }
+        if (m_file == nullptr) {
+            Logger::printfln(OPEN_OUTBOX_FAILED, m_path);
+            return false;
+        }
+        return true;
+    }
+
+    size_t get_size() const override {
+        return m_size;
+    }
+
+    size_t get_sector_size() const override {
+        return m_sector_size;
+    }
+
+    bool read(size_t const & offset, uint8_t * buffer, size_t const & size) override {
+        if (m_file == nullptr || fseek(m_file, offset, SEEK_SET) != 0) {
+            return false;
+        }
+        size_t const bytes_read = fread(buffer, 1, size, m_file);
+        // Reading past the end of the file is not an error, it simply means that the region has never been written
+        (void)memset(buffer + bytes_read, 0xFF, size - bytes_read);
+        return true;
+    }
+
+    bool write(size_t const & offset, uint8_t const * buffer, size_t const & size) override {
+        if (m_file == nullptr || fseek(m_file, offset, SEEK_SET) != 0) {
+            return false;
+        }
+        size_t const bytes_written = fwrite(buffer, 1, size, m_file);
+        // Flushed after every write, to ensure the message is persisted even if the device is restarted directly afterwards
+        return fflush(m_file) == 0 && bytes_written == size;
+    }
+
+    bool erase_sector(size_t const & offset) override {
+        if (m_file == nullptr || fseek(m_file, offset, SEEK_SET) != 0) {
+            return false;
+        }
+        uint8_t erased[32U] = {};
+        (void)memset(erased, 0xFF, sizeof(erased));
+        for (size_t erased_bytes = 0U; erased_bytes < m_sector_size; erased_bytes += sizeof(erased)) {
+            size_t const size = m_sector_size - erased_bytes < sizeof(erased) ? m_sector_size - erased_bytes : sizeof(erased);
+            if (fwrite(erased, 1, size, m_file) != size) {
+                return false;
+            }
+        }
+        return fflush(m_file) == 0;
+    }
+
+  private:
+    char const * m_path = {};        // Path to the file the outbox is written into
+    size_t       m_size = {};        // Total size the file is allowed to grow to
+    size_t       m_sector_size = {}; // Size of a single sector
+    FILE         *m_file = {};       // Handle to the opened file, kept open for the lifetime of the instance so that every write does not have to reopen the file
+};
+
+#endif // File_Outbox_Storage_h
@@ -0,0 +1,505 @@
+#ifndef Gateway_h
+#define Gateway_h
+
+// Local includes.
+#include "Gateway_Device.h"
+#include "IAPI_Implementation.h"
+#include "Subscription_Reference.h"
+#include "Telemetry.h"
+
+
+// Gateway topics.
+char constexpr GATEWAY_CONNECT_TOPIC[] = "v1/gateway/connect";
+char constexpr GATEWAY_DISCONNECT_TOPIC[] = "v1/gateway/disconnect";
+char constexpr GATEWAY_TELEMETRY_TOPIC[] = "v1/gateway/telemetry";
+char constexpr GATEWAY_ATTRIBUTES_TOPIC[] = "v1/gateway/attributes";
+char constexpr GATEWAY_RPC_TOPIC[] = "v1/gateway/rpc";
+// Gateway data keys.
+char constexpr GATEWAY_DEVICE_KEY[] = "device";
+char constexpr GATEWAY_TYPE_KEY[] = "type";
+char constexpr GATEWAY_DATA_KEY[] = "data";
+char constexpr GATEWAY_ID_KEY[] = "id";
+char constexpr GATEWAY_TIMESTAMPED_ROW_PREFIX[] = "{\"ts\":%llu,\"values\":";
+// Log messages.
+char constexpr GATEWAY_DEVICE_NOT_CONNECTED[] = "Device (%s) has not been connected, call Connect_Device before sending data for it";
+char constexpr GATEWAY_BUFFER_NOT_SET[] = "Gateway telemetry buffer has not been set, call Set_Telemetry_Buffer before appending telemetry";
+char constexpr GATEWAY_BUFFER_TOO_SMALL[] = "Gateway telemetry does not fit into an empty buffer, increase the size of the buffer passed to Set_Telemetry_Buffer";
+char constexpr GATEWAY_RPC_RESPONSE_OVERFLOWED[] = "Gateway RPC response overflowed, increase MaxRPC (%u)";
+#if !THINGSBOARD_ENABLE_DYNAMIC
+char constexpr MAX_DEVICES_TEMPLATE_NAME[] = "MaxDevices";
+char constexpr GATEWAY_DEVICE_SUBSCRIPTIONS[] = "gateway device";
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+#if THINGSBOARD_ENABLE_DEBUG
+char constexpr GATEWAY_DEVICE_UNKNOWN[] = "Received gateway message for device (%s), which has not been connected";
+char constexpr CALLING_GATEWAY_RPC_CB[] = "Calling subscribed callback for gateway rpc with methodname (%s) of device (%s)";
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+
+/// @brief Handles the internal implementation of the ThingsBoard gateway API, which allows a single device to send data for and receive requests of many other devices,
+/// that are not able to connect to the server themselves, over its own connection. Instead of every device requiring its own MQTT connection, the data is sent over the gateway topics with the name of the device it belongs to.
+/// Received RPC requests and shared attribute updates are matched to the connected devices with the hash of their name, the devices are kept sorted by that hash,
+/// which allows to find the device of a received message with a binary search, instead of comparing the name of every single connected device.
+/// Telemetry of multiple devices can additionally be accumulated in a preallocated buffer and then sent as a single message, instead of a message per device.
+/// See https://thingsboard.io/docs/reference/gateway-mqtt-api/ for more information
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
+#if THINGSBOARD_ENABLE_DYNAMIC
+template <typename Logger = DefaultLogger>
+#else
+/// @tparam MaxDevices Maximum amount of simultaneously connected devices.
+/// Once the maximum amount has been reached it is not possible to increase the size, this is done because it allows to allcoate the memory on the stack instead of the heap, default = Default_Subscriptions_Amount (1)
+/// @tparam MaxRPC Maximum amount of key-value pairs that will ever be sent in the subscribed RPC callback method of a Gateway_Device, allows to use a StaticJsonDocument on the stack in the background.
+/// See https://arduinojson.org/v6/assistant/ for more information on how to estimate the required size and divide the result by 16 to receive the required MaxRPC value, default = Default_RPC_Amount (0)
+template<size_t MaxDevices = Default_Subscriptions_Amount, size_t MaxRPC = Default_RPC_Amount, typename Logger = DefaultLogger>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+class Gateway : public IAPI_Implementation {
+  public:
+    /// @brief Constructor
+    Gateway() = default;
+
+    /// @brief Connects the given device to the server through the gateway, which creates the device on the server if it does not exist yet and marks it as active.
+    /// Additionally registers the callbacks of the device, so that they are called for RPC requests and shared attribute updates sent to it.
+    /// Connecting a device with the same name again replaces the previously connected one.
+    /// See https://thingsboard.io/docs/reference/gateway-mqtt-api/#connect-api for more information
+    /// @param device Device that should be connected, is copied, but its name and type have to be kept alive for as long as it is connected
+    /// @return Whether connecting the device was successful or not
+    bool Connect_Device(Gateway_Device const & device) {
+        if (Helper::stringIsNullorEmpty(device.Get_Name())) {
+            return false;
+        }
+        Device_Entry * const existing = Find_Device(device.Get_Name());
+        if (existing != nullptr) {
+            existing->device = device;
+        }
+        else {
+#if !THINGSBOARD_ENABLE_DYNAMIC
+            if (m_devices.size() + 1 > m_devices.capacity()) {
+                Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, MAX_DEVICES_TEMPLATE_NAME, GATEWAY_DEVICE_SUBSCRIPTIONS);
+                return false;
+            }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+            // Topics are only subscribed with the first device, because every device receives its messages over the same topics
+            if (m_devices.empty()) {
+                (void)m_rpc_subscription.Acquire(m_client);
+                (void)m_attributes_subscription.Acquire(m_client);
+            }
+            Insert_Sorted(device);
+        }
+
+        StaticJsonDocument<JSON_OBJECT_SIZE(2)> request_buffer;
+        request_buffer[GATEWAY_DEVICE_KEY] = device.Get_Name();
+        if (device.Get_Type() != nullptr) {
+            request_buffer[GATEWAY_TYPE_KEY] = device.Get_Type();
+        }
+        return m_client != nullptr && m_client->Send_Json(GATEWAY_CONNECT_TOPIC, request_buffer, Helper::Measure_Json(request_buffer));
+    }
+
+    /// @brief Disconnects the device with the given name, which marks it as inactive on the server and stops calling its callbacks.
+    /// Telemetry of the device that is still contained in the buffer is sent beforehand, so it is not received after the device has already been disconnected.
+    /// See https://thingsboard.io/docs/reference/gateway-mqtt-api/#disconnect-api for more information
+    /// @param device_name Name of the device that should be disconnected
+    /// @return Whether disconnecting the device was successful or not
+    bool Disconnect_Device(char const * device_name) {
+        Device_Entry * const entry = Find_Device(device_name);
+        if (entry == nullptr) {
+            Logger::printfln(GATEWAY_DEVICE_NOT_CONNECTED, device_name);
+            return false;
+        }
+        else if (entry->batch_generation == m_batch_generation && m_batch_length != 0U) {
+            (void)Flush_Telemetry();
+        }
+        size_t const index = entry - &m_devices[0U];
+        Helper::remove(m_devices, m_devices.begin() + index);
+
+        StaticJsonDocument<JSON_OBJECT_SIZE(1)> request_buffer;
+        request_buffer[GATEWAY_DEVICE_KEY] = device_name;
+        return m_client != nullptr && m_client->Send_Json(GATEWAY_DISCONNECT_TOPIC, request_buffer, Helper::Measure_Json(request_buffer));
+    }
+
+    /// @brief Immediately sends the given telemetry data of the device with the given name, expects iterators to a container containing Telemetry class instances.
+    /// See https://thingsboard.io/docs/reference/gateway-mqtt-api/#telemetry-upload-api for more information
+    /// @tparam InputIterator Class that points to the begin and end iterator
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param device_name Name of the device the telemetry data belongs to, has to be connected with Connect_Device() beforehand
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether sending the telemetry data was successful or not
+#if THINGSBOARD_ENABLE_DYNAMIC
+    template<typename InputIterator>
+#else
+    /// @tparam MaxKeyValuePairAmount Maximum amount of json key value pairs, which will ever be sent with this method to the cloud.
+    /// Should simply be the biggest distance between first and last iterator this method is ever called with
+    template<size_t MaxKeyValuePairAmount, typename InputIterator>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    bool Send_Telemetry(char const * device_name, InputIterator const & first, InputIterator const & last) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        return Send_Device_Data(device_name, first, last, true);
+#else
+        return Send_Device_Data<MaxKeyValuePairAmount>(device_name, first, last, true);
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
+    /// @brief Immediately sends the given client-side attributes of the device with the given name, expects iterators to a container containing Attribute class instances.
+    /// See https://thingsboard.io/docs/reference/gateway-mqtt-api/#publish-attribute-update-to-the-server for more information
+    /// @tparam InputIterator Class that points to the begin and end iterator
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param device_name Name of the device the attributes belong to, has to be connected with Connect_Device() beforehand
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether sending the attributes was successful or not
+#if THINGSBOARD_ENABLE_DYNAMIC
+    template<typename InputIterator>
+#else
+    /// @tparam MaxKeyValuePairAmount Maximum amount of json key value pairs, which will ever be sent with this method to the cloud.
+    /// Should simply be the biggest distance between first and last iterator this method is ever called with
+    template<size_t MaxKeyValuePairAmount, typename InputIterator>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    bool Send_Attributes(char const * device_name, InputIterator const & first, InputIterator const & last) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        return Send_Device_Data(device_name, first, last, false);
+#else
+        return Send_Device_Data<MaxKeyValuePairAmount>(device_name, first, last, false);
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
+    /// @brief Sets the buffer that the telemetry of multiple devices appended with Append_Telemetry() is accumulated in, before it is sent as a single message with Flush_Telemetry().
+    /// The buffer should not be bigger than the send buffer size of the client, because the complete message has to be sent at once.
+    /// Ensure the actual variable is kept alive for as long as the instance of this class
+    /// @param buffer Buffer the telemetry is written into
+    /// @param buffer_size Size of the given buffer, the last three bytes are reserved for the closing brackets and the null terminator
+    void Set_Telemetry_Buffer(char * buffer, size_t const & buffer_size) {
+        m_batch_buffer = buffer;
+        m_batch_size = buffer != nullptr && buffer_size > 3U ? buffer_size : 0U;
+        m_batch_length = 0U;
+        m_batch_generation++;
+    }
+
+    /// @brief Appends the given telemetry data of the device with the given name to the previously set buffer, expects iterators to a container containing Telemetry class instances.
+    /// The data is written directly as json into the buffer without a JsonDocument, rows of the same device appended directly after each other are sent as one array of that device.
+    /// Because a json object can not contain the same device twice, the buffer is sent first if the device already appended rows before rows of a different device were appended,
+    /// meaning devices should be polled in the same order and appended once per cycle, followed by a call to Flush_Telemetry(). The buffer is additionally sent automatically once it is full
+    /// @tparam InputIterator Class that points to the begin and end iterator
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param device_name Name of the device the telemetry data belongs to, has to be connected with Connect_Device() beforehand
+    /// @param timestamp Unix timestamp in milliseconds the values were sampled at, 0 to use the time the server receives the message instead
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether appending the telemetry data, and sending the buffer if required, was successful or not
+    template<typename InputIterator>
+    bool Append_Telemetry(char const * device_name, uint64_t const & timestamp, InputIterator const & first, InputIterator const & last) {
+        if (m_batch_size == 0U) {
+            Logger::printfln(GATEWAY_BUFFER_NOT_SET);
+            return false;
+        }
+        Device_Entry * const entry = Find_Device(device_name);
+        if (entry == nullptr) {
+            Logger::printfln(GATEWAY_DEVICE_NOT_CONNECTED, device_name);
+            return false;
+        }
+        else if (m_batch_length != 0U && entry->batch_generation == m_batch_generation && strcmp(entry->device.Get_Name(), m_batch_device) != 0 && !Flush_Telemetry()) {
+            return false;
+        }
+
+        // Rows that do not fit into the remaining buffer are appended to the then empty buffer, after the current buffer has been sent
+        if (!Write_Row(*entry, timestamp, first, last)) {
+            if (m_batch_length == 0U || !Flush_Telemetry() || !Write_Row(*entry, timestamp, first, last)) {
+                Logger::printfln(GATEWAY_BUFFER_TOO_SMALL);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Sends the telemetry of every device accumulated in the previously set buffer as a single message.
+    /// The telemetry is only removed from the buffer if sending it was successful
+    /// @return Whether sending the telemetry was successful or not, true if the buffer was empty
+    bool Flush_Telemetry() {
+        if (m_batch_length == 0U) {
+            return true;
+        }
+        // Space for the closing brackets and the null terminator is always kept free, closing them does not change the length, so more rows can be appended if sending fails
+        memcpy(m_batch_buffer + m_batch_length, "]}", 3U);
+        if (m_client == nullptr || !m_client->Send_Json_String(GATEWAY_TELEMETRY_TOPIC, m_batch_buffer)) {
+            return false;
+        }
+        m_batch_length = 0U;
+        m_batch_generation++;
+        return true;
+    }
+
+    API_Process_Type Get_Process_Type() const override {
+        return API_Process_Type::JSON;
+    }
+
+    void Process_Response(char const * topic, uint8_t * payload, unsigned int length) override {
+        // Nothing to do
+    }
+
+    void Process_Json_Response(char const * topic, JsonDocument const & data) override {
+        char const * const device_name = data[GATEWAY_DEVICE_KEY];
+        Device_Entry const * const entry = Find_Device(device_name);
+        if (entry == nullptr) {
+#if THINGSBOARD_ENABLE_DEBUG
+            Logger::printfln(GATEWAY_DEVICE_UNKNOWN, device_name != nullptr ? device_name : "");
+#endif // THINGSBOARD_ENABLE_DEBUG
+            return;
+        }
+
+        JsonObjectConst const payload = data[GATEWAY_DATA_KEY];
+        if (strcmp(topic, GATEWAY_ATTRIBUTES_TOPIC) == 0) {
+            entry->device.Call_Attribute_Callback(payload);
+            return;
+        }
+        Call_RPC_Callback(entry->device, payload);
+    }
+
+    bool Compare_Response_Topic(char const * topic) const override {
+        return strcmp(GATEWAY_RPC_TOPIC, topic) == 0 || strcmp(GATEWAY_ATTRIBUTES_TOPIC, topic) == 0;
+    }
+
+    bool Unsubscribe() override {
+        m_devices.clear();
+        bool const rpc_unsubscribed = m_rpc_subscription.Release(m_client);
+        return m_attributes_subscription.Release(m_client) && rpc_unsubscribed;
+    }
+
+    bool Resubscribe_Topic() override {
+        if (m_devices.empty()) {
+            return true;
+        }
+        else if (!m_rpc_subscription.Acquire(m_client)) {
+            Logger::printfln(SUBSCRIBE_TOPIC_FAILED, GATEWAY_RPC_TOPIC);
+            return false;
+        }
+        else if (!m_attributes_subscription.Acquire(m_client)) {
+            Logger::printfln(SUBSCRIBE_TOPIC_FAILED, GATEWAY_ATTRIBUTES_TOPIC);
+            return false;
+        }
+        return true;
+    }
+
+#if !THINGSBOARD_USE_ESP_TIMER
+    void loop() override {
+        // Nothing to do
+    }
+#endif // !THINGSBOARD_USE_ESP_TIMER
+
+    void Initialize() override {
+        // Nothing to do
+    }
+
+    void Set_Client(IThingsBoard_Client & client) override {
+        m_client = &client;
+    }
+
+  private:
+    /// @brief Connected device together with the generation of the telemetry buffer it last appended rows to
+    struct Device_Entry {
+        Gateway_Device device = {};           // Connected device
+        uint32_t       batch_generation = {}; // Generation of the telemetry buffer the device last appended rows to, equal to the current generation if the buffer contains rows of the device
+    };
+
+    /// @brief Attempts to send the given key-value pairs of the device with the given name as telemetry or attributes
+    /// @tparam InputIterator Class that points to the begin and end iterator
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param device_name Name of the device the data belongs to
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @param telemetry Whether the data should be sent as telemetry or as attributes
+    /// @return Whether sending the data was successful or not
+#if THINGSBOARD_ENABLE_DYNAMIC
+    template<typename InputIterator>
+#else
+    template<size_t MaxKeyValuePairAmount, typename InputIterator>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    bool Send_Device_Data(char const * device_name, InputIterator const & first, InputIterator const & last, bool const & telemetry) {
+        if (Find_Device(device_name) == nullptr) {
+            Logger::printfln(GATEWAY_DEVICE_NOT_CONNECTED, device_name);
+            return false;
+        }
+#if THINGSBOARD_ENABLE_DYNAMIC
+        size_t const size = Helper::distance(first, last);
+        // Telemetry is sent as an array containing a single object, attributes directly as the object
+        TBJsonDocument json_buffer(JSON_OBJECT_SIZE(1U) + JSON_ARRAY_SIZE(1U) + JSON_OBJECT_SIZE(size));
+#else
+        size_t const size = Helper::distance(first, last);
+        if (size > MaxKeyValuePairAmount) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, size, "MaxKeyValuePairAmount", MaxKeyValuePairAmount);
+            return false;
+        }
+        StaticJsonDocument<JSON_OBJECT_SIZE(1U) + JSON_ARRAY_SIZE(1U) + JSON_OBJECT_SIZE(MaxKeyValuePairAmount)> json_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        // Passed as a variant, because SerializeKeyValue() additionally instantiates setting the value directly, which JsonObject does not support
+        JsonVariant values = telemetry ? json_buffer.createNestedArray(device_name).createNestedObject() : json_buffer.createNestedObject(device_name);
+        for (auto it = first; it != last; ++it) {
+            auto const & data = *it;
+            if (!data.SerializeKeyValue(values)) {
+                Logger::printfln(UNABLE_TO_SERIALIZE);
+                return false;
+            }
+        }
+        return m_client != nullptr && m_client->Send_Json(telemetry ? GATEWAY_TELEMETRY_TOPIC : GATEWAY_ATTRIBUTES_TOPIC, json_buffer, Helper::Measure_Json(json_buffer));
+    }
+
+    /// @brief Writes the given telemetry data as a new row of the given device directly into the remaining telemetry buffer, either continuing the array of the device if it appended the previous row,
+    /// or starting a new array for the device. The length of the buffer is only increased if the complete row fit, meaning a row that did not fit is simply discarded
+    /// @tparam InputIterator Class that points to the begin and end iterator
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param entry Connected device the row belongs to
+    /// @param timestamp Unix timestamp in milliseconds the values were sampled at, 0 to not write a timestamp
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether the row fit into the remaining buffer and was appended successfully or not
+    template<typename InputIterator>
+    bool Write_Row(Device_Entry & entry, uint64_t const & timestamp, InputIterator const & first, InputIterator const & last) {
+        char * current = m_batch_buffer + m_batch_length;
+        // Space for the closing brackets and the null terminator is always kept free
+        char const * const end = m_batch_buffer + m_batch_size - 3U;
+        if (end - current < 2) {
+            return false;
+        }
+        else if (m_batch_length != 0U && entry.batch_generation == m_batch_generation) {
+            *current++ = ',';
+        }
+        else {
+            // The first device opens the object, every following device closes the array of the previous device
+            if (m_batch_length == 0U) {
+                *current++ = '{';
+            }
+            else {
+                *current++ = ']';
+                *current++ = ',';
+            }
+            current = Telemetry::Write_Json_String(current, end, entry.device.Get_Name());
+            if (current == nullptr || end - current < 2) {
+                return false;
+            }
+            *current++ = ':';
+            *current++ = '[';
+        }
+
+        bool const timestamped = timestamp != 0U;
+        if (timestamped) {
+            int const prefix_size = snprintf(current, end - current, GATEWAY_TIMESTAMPED_ROW_PREFIX, static_cast<unsigned long long>(timestamp));
+            if (prefix_size < 0 || prefix_size >= end - current) {
+                return false;
+            }
+            current += prefix_size;
+        }
+        // Null terminator written after the values is either overwritten by the closing bracket of the timestamped row or lies inside the reserved space
+        size_t const values_size = Telemetry::Write_Json_Object(first, last, current, end - current);
+        if (values_size == 0U) {
+            return false;
+        }
+        current += values_size;
+        if (timestamped) {
+            *current++ = '}';
+        }
+
+        m_batch_length = current - m_batch_buffer;
+        m_batch_device = entry.device.Get_Name();
+        entry.batch_generation = m_batch_generation;
+        return true;
+    }
+
+    /// @brief Calls the RPC callback of the given device with the received request and sends the response created by the callback, if there is any
+    /// @param device Device the request was sent to
+    /// @param request Object containing the id, method name and parameters of the received request
+    void Call_RPC_Callback(Gateway_Device const & device, JsonObjectConst const & request) {
+        char const * const method_name = request[RPC_METHOD_KEY];
+#if THINGSBOARD_ENABLE_DEBUG
+        Logger::printfln(CALLING_GATEWAY_RPC_CB, method_name != nullptr ? method_name : "", device.Get_Name());
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+        size_t const & rpc_response_size = device.Get_Response_Size();
+        TBJsonDocument response_buffer(rpc_response_size);
+#else
+        size_t constexpr rpc_response_size = MaxRPC;
+        StaticJsonDocument<JSON_OBJECT_SIZE(MaxRPC)> response_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        device.Call_RPC_Callback(method_name, request[RPC_PARAMS_KEY], response_buffer);
+
+        if (response_buffer.isNull()) {
+            return;
+        }
+        else if (response_buffer.overflowed()) {
+            Logger::printfln(GATEWAY_RPC_RESPONSE_OVERFLOWED, rpc_response_size);
+            return;
+        }
+
+        // Response has to be wrapped into an object containing the device name and the request id, which copies the response into that object
+#if THINGSBOARD_ENABLE_DYNAMIC
+        TBJsonDocument json_buffer(JSON_OBJECT_SIZE(3U) + response_buffer.memoryUsage());
+#else
+        StaticJsonDocument<JSON_OBJECT_SIZE(3U) + JSON_OBJECT_SIZE(MaxRPC)> json_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        json_buffer[GATEWAY_DEVICE_KEY] = device.Get_Name();
+        json_buffer[GATEWAY_ID_KEY] = request[GATEWAY_ID_KEY];
+        json_buffer[GATEWAY_DATA_KEY] = response_buffer.template as<JsonVariantConst>();
+        if (m_client != nullptr) {
+            (void)m_client->Send_Json(GATEWAY_RPC_TOPIC, json_buffer, Helper::Measure_Json(json_buffer));
+        }
+    }
+
+    /// @brief Inserts the given device at its position sorted by the hash of its name, so that received messages can be matched with a binary search instead of comparing every connected device
+    /// @param device Device that will be inserted
+    void Insert_Sorted(Gateway_Device const & device) {
+        Device_Entry entry;
+        entry.device = device;
+        m_devices.push_back(entry);
+        for (size_t i = m_devices.size() - 1U; i > 0U && m_devices[i].device.Get_Hash() < m_devices[i - 1U].device.Get_Hash(); i--) {
+            Device_Entry const previous = m_devices[i - 1U];
+            m_devices[i - 1U] = m_devices[i];
+            m_devices[i] = previous;
+        }
+    }
+
+    /// @brief Searches the connected device with the given name, with a binary search over the hashes of the connected devices, followed by comparing the names of the devices with the same hash
+    /// @param device_name Name of the device
+    /// @return Connected device with the given name or nullptr if there is none
+    Device_Entry * Find_Device(char const * device_name) {
+        if (Helper::stringIsNullorEmpty(device_name)) {
+            return nullptr;
+        }
+        uint32_t const hash = Helper::hashString(device_name);
+        size_t lower = 0U;
+        size_t upper = m_devices.size();
+        while (lower < upper) {
+            size_t const middle = lower + ((upper - lower) / 2U);
+            if (m_devices[middle].device.Get_Hash() < hash) {
+                lower = middle + 1U;
+            }
+            else {
+                upper = middle;
+            }
+        }
+        for (; lower < m_devices.size() && m_devices[lower].device.Get_Hash() == hash; lower++) {
+            if (strcmp(m_devices[lower].device.Get_Name(), device_name) == 0) {
+                return &m_devices[lower];
+            }
+        }
+        return nullptr;
+    }
+
+    IThingsBoard_Client                                  *m_client = {};          // Client the api implementation communicates with the cloud over
+    Subscription_Reference                               m_rpc_subscription = Subscription_Reference(GATEWAY_RPC_TOPIC);               // Reference to the gateway RPC topic, acquired while devices are connected
+    Subscription_Reference                               m_attributes_subscription = Subscription_Reference(GATEWAY_ATTRIBUTES_TOPIC); // Reference to the gateway attributes topic, acquired while devices are connected
+    char                                                 *m_batch_buffer = {};    // Buffer the telemetry of multiple devices is accumulated in
+    size_t                                               m_batch_size = {};       // Size of the buffer
+    size_t                                               m_batch_length = {};     // Amount of bytes written into the buffer without the closing brackets
+    uint32_t                                             m_batch_generation = {}; // Generation of the current content of the buffer, increased every time the buffer is sent
+    char const                                           *m_batch_device = {};    // Name of the device that appended the last row to the buffer
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Vector<Device_Entry>                                 m_devices = {};          // Connected devices vector, sorted by the hash of their name
+#else
+    Array<Device_Entry, MaxDevices>                      m_devices = {};          // Connected devices array, sorted by the hash of their name
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+};
+
+#endif // Gateway_h
@@ -0,0 +1,99 @@
+#ifndef Gateway_Device_h
+#define Gateway_Device_h
+
+// Local includes.
+#include "Callback.h"
+#include "Constants.h"
+#include "Helper.h"
+
+
+/// @brief Device connected to ThingsBoard through the Gateway api implementation, instead of over its own connection.
+/// Contains the name the device is identified with on the server and the optional callbacks that are called when the server sends an RPC request or a shared attribute update to this specific device.
+/// Documentation about the gateway api in ThingsBoard can be found here https://thingsboard.io/docs/reference/gateway-mqtt-api/
+class Gateway_Device {
+  public:
+    /// @brief RPC callback signature, receives the method name, the parameters and the JsonDocument the response should be entered into
+    using RPC_Function = Callback<void, char const *, JsonVariantConst const &, JsonDocument &>::function;
+    /// @brief Shared attribute update callback signature, receives the object containing the changed shared attributes
+    using Attribute_Function = Callback<void, JsonObjectConst const &>::function;
+
+    /// @brief Constructs empty device, will result in never being matched. Internals are simply default constructed as nullptr
+    Gateway_Device() = default;
+
+    /// @brief Constructs device with the given name and optional callbacks
+    /// @param name Name of the device, has to be unique across every device of the gateway and has to be kept alive for as long as the instance of this class
+    /// @param type Name of the device profile the device is created with on the server if it does not exist yet, nullptr to use the default profile, default = nullptr
+    /// @param rpc_callback Callback method that will be called upon an RPC request for this device, with the method name and the parameters of the request,
+    /// should enter the response into the passed JsonDocument, which is left empty if the RPC widget does not expect any response, default = nullptr
+    /// @param attribute_callback Callback method that will be called upon a shared attribute update for this device, with the object containing the changed shared attributes, default = nullptr
+#if THINGSBOARD_ENABLE_DYNAMIC
+    /// @param response_size Internal size the JsonDocument should be able to hold to contain the response to an RPC request.
+    /// Use JSON_OBJECT_SIZE() and pass the amount of key value pair to calculate the estimated size. See https://arduinojson.org/v6/assistant/ for more information on how to estimate the required size, default = Default_RPC_Amount (0)
+    Gateway_Device(char const * name, char const * type = nullptr, RPC_Function rpc_callback = nullptr, Attribute_Function attribute_callback = nullptr, size_t const & response_size = JSON_OBJECT_SIZE(Default_RPC_Amount))
+#else
+    Gateway_Device(char const * name, char const * type = nullptr, RPC_Function rpc_callback = nullptr, Attribute_Function attribute_callback = nullptr)
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+      : m_name(name)
+      , m_type(type)
+      , m_hash(Helper::hashString(name))
+      , m_rpc_callback(rpc_callback)
+      , m_attribute_callback(attribute_callback)
+#if THINGSBOARD_ENABLE_DYNAMIC
+      , m_response_size(response_size)
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    {
+        // Nothing to do
+    }
+
+    /// @brief Gets the name of the device
+    /// @return Pointer to the passed name
+    char const * Get_Name() const {
+        return m_name;
+    }
+
+    /// @brief Gets the name of the device profile the device is created with
+    /// @return Pointer to the passed device profile name or nullptr if the default profile is used
+    char const * Get_Type() const {
+        return m_type;
+    }
+
+    /// @brief Gets the hash of the name of the device, calculated once when constructed, which the gateway sorts and searches its devices by
+    /// @return Hash of the name
+    uint32_t const & Get_Hash() const {
+        return m_hash;
+    }
+
+    /// @brief Calls the subscribed RPC callback, if there is any
+    /// @param method_name Method name of the received request
+    /// @param params Parameters of the received request
+    /// @param response JsonDocument the response should be entered into
+    void Call_RPC_Callback(char const * method_name, JsonVariantConst const & params, JsonDocument & response) const {
+        m_rpc_callback.Call_Callback(method_name, params, response);
+    }
+
+    /// @brief Calls the subscribed shared attribute update callback, if there is any
+    /// @param data Object containing the changed shared attributes
+    void Call_Attribute_Callback(JsonObjectConst const & data) const {
+        m_attribute_callback.Call_Callback(data);
+    }
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    /// @brief Gets the internal size the JsonDocument needs to have to contain the response to an RPC request
+    /// @return Internal JsonDocument size
+    size_t const & Get_Response_Size() const {
+        return m_response_size;
+    }
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+  private:
+    char const                                                             *m_name = {};               // Name of the device
+    char const                                                             *m_type = {};               // Name of the device profile of the device
+    uint32_t                                                               m_hash = {};                // Hash of the name of the device
+    Callback<void, char const *, JsonVariantConst const &, JsonDocument &> m_rpc_callback = {};        // Callback called upon an RPC request for this device
+    Callback<void, JsonObjectConst const &>                                m_attribute_callback = {};  // Callback called upon a shared attribute update for this device
+#if THINGSBOARD_ENABLE_DYNAMIC
+    size_t                                                                 m_response_size = {};       // Required size to contain the response to an RPC request
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+};
+
+#endif // Gateway_Device_h
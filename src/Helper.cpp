@@ -5,6 +5,7 @@
 #include "Constants.h"
 
 // Library includes.
+#include <stdlib.h>
 #include <string.h>
 
 size_t Helper::getOccurences(uint8_t const * bytes, char symbol, unsigned int length) {
@@ -20,13 +21,111 @@ size_t Helper::getOccurences(uint8_t const * bytes, char symbol, unsigned int le
     return count;
 }
 
+size_t Helper::getJsonNodeCount(uint8_t const * bytes, size_t const & length) {
+    size_t count = 0;
+    if (bytes == nullptr) {
+        return count;
+    }
+    uint8_t const * current = bytes;
+    uint8_t const * const end = bytes + length;
+    bool container_opened = false;
+    while (current < end) {
+        uint8_t const symbol = *current++;
+        if (symbol == ' ' || symbol == '\t' || symbol == '\r' || symbol == '\n') {
+            continue;
+        }
+        // First symbol following an opening bracket decides whether the object or array contains atleast one node,
+        // all further nodes are then seperated by commas
+        if (container_opened) {
+            container_opened = false;
+            if (symbol != '}' && symbol != ']') {
+                count++;
+            }
+        }
+        if (symbol == '"') {
+            current = skipJsonString(current, end);
+        }
+        else if (symbol == ',') {
+            count++;
+        }
+        else if (symbol == '{' || symbol == '[') {
+            container_opened = true;
+        }
+    }
+    return count;
+}
+
+uint8_t const * Helper::skipJsonString(uint8_t const * string_start, uint8_t const * end) {
+    uint8_t const * current = string_start;
+    while (current < end) {
+        // Search for the next quote with memchr instead of comparing byte by byte,
+        // because it is implemented to compare multiple bytes at once on most platforms
+        uint8_t const * quote = static_cast<uint8_t const *>(memchr(current, '"', end - current));
+        if (quote == nullptr) {
+            return end;
+        }
+        // Quote is escaped if it is preceded by an odd amount of backslashes
+        size_t backslashes = 0;
+        for (uint8_t const * previous = quote; previous > string_start && *(previous - 1) == '\\'; --previous) {
+            backslashes++;
+        }
+        current = quote + 1;
+        if (backslashes % 2 == 0) {
+            return current;
+        }
+    }
+    return end;
+}
+
 bool Helper::stringIsNullorEmpty(char const * str) {
     return str == nullptr || str[0] == '\0';
 }
 
+uint32_t Helper::calculateCrc32(uint8_t const * bytes, size_t const & length, uint32_t crc) {
+    static uint32_t constexpr CRC32_NIBBLE_TABLE[16U] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    crc = ~crc;
+    for (size_t i = 0U; i < length; i++) {
+        crc = CRC32_NIBBLE_TABLE[(crc ^ bytes[i]) & 0x0F] ^ (crc >> 4U);
+        crc = CRC32_NIBBLE_TABLE[(crc ^ (bytes[i] >> 4U)) & 0x0F] ^ (crc >> 4U);
+    }
+    return ~crc;
+}
+
+uint32_t Helper::hashString(char const * string) {
+    // Parameters of the 32-bit FNV-1a hash
+    static uint32_t constexpr FNV_OFFSET_BASIS = 2166136261U;
+    static uint32_t constexpr FNV_PRIME = 16777619U;
+    uint32_t hash = FNV_OFFSET_BASIS;
+    if (string == nullptr) {
+        return hash;
+    }
+    for (; *string != '\0'; string++) {
+        hash = (hash ^ static_cast<uint8_t>(*string)) * FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t Helper::hashString64(char const * string) {
+    // Parameters of the 64-bit FNV-1a hash
+    static uint64_t constexpr FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    static uint64_t constexpr FNV_PRIME = 1099511628211ULL;
+    uint64_t hash = FNV_OFFSET_BASIS;
+    if (string == nullptr) {
+        return hash;
+    }
+    for (; *string != '\0'; string++) {
+        hash = (hash ^ static_cast<uint8_t>(*string)) * FNV_PRIME;
+    }
+    return hash;
+}
+
 size_t Helper::parseRequestId(char const * base_topic, char const * received_topic) {
     // Remove the not needed part of the received topic string, which is everything before the request id,
     // therefore we ignore the section before that which is the base topic, that seperates the topic from the request id.
     // Meaning the index we attempt to parse at, is simply the length of the base topic
-    return atoi(received_topic + strlen(base_topic));
+    // Parsed as an unsigned long instead of an int, because request ids can use the complete range of size_t
+    return static_cast<size_t>(strtoul(received_topic + strlen(base_topic), nullptr, 10));
 }
@@ -40,6 +40,17 @@ class Helper {
     /// @return Amount of occurences of the given symbol
     static size_t getOccurences(uint8_t const * bytes, char symbol, unsigned int length);
 
+    /// @brief Returns the amount of nodes (key-value pairs in objects and elements in arrays) contained in the given json payload,
+    /// which is exactly the amount of slots the JsonDocument requires to deserialize the payload in zero copy mode, see https://arduinojson.org/v6/assistant/ for more information.
+    /// Counted in a single pass over the payload, where every comma and every non empty object or array adds one node,
+    /// the content of strings is skipped completely, so that symbols inside of keys or values do not inflate the count.
+    /// Does not validate the payload, invalid json simply results in a count that will then fail deserialization anyway
+    /// @param bytes Byte payload containing json that we want to count the nodes of
+    /// @param length Length of the byte payload.
+    /// Ensure to never pass a length that is longer than the actualy payload, because this will cause this method to read outside of the bounds of the buffer
+    /// @return Amount of nodes contained in the json payload
+    static size_t getJsonNodeCount(uint8_t const * bytes, size_t const & length);
+
     /// @brief Returns wheter the given string is either a nullptr or is an empty string,
     /// meaning it only contains a null terminator and no other characters
     /// @param str String that we want to check for emptiness
@@ -54,6 +65,27 @@ class Helper {
     /// @return Converted integral request id if possible or 0 if parsing as an integer failed
     static size_t parseRequestId(char const * base_topic, char const * received_topic);
 
+    /// @brief Calculates the CRC-32 (IEEE 802.3, same as zlib) checksum of the given bytes, can be called multiple times to continue the calculation over data that is split into multiple parts.
+    /// Uses a small table with one entry per nibble instead of per byte, which keeps the flash usage at 64 bytes while still being faster than calculating the checksum bit by bit
+    /// @param bytes Byte payload that we want to calculate the checksum of
+    /// @param length Length of the byte payload.
+    /// Ensure to never pass a length that is longer than the actualy payload, because this will cause this method to read outside of the bounds of the buffer
+    /// @param crc Checksum of the previous part of the data that should be continued, or 0 to start a new calculation, default = 0
+    /// @return Checksum over the given bytes and all previous parts
+    static uint32_t calculateCrc32(uint8_t const * bytes, size_t const & length, uint32_t crc = 0U);
+
+    /// @brief Calculates the 32-bit FNV-1a hash of the given null terminated string, which is fast to calculate and distributes short strings like keys or names well enough to be used in hash based lookups.
+    /// See http://www.isthe.com/chongo/tech/comp/fnv/ for more information
+    /// @param string String that should be hashed, nullptr is hashed like an empty string
+    /// @return Hash of the given string
+    static uint32_t hashString(char const * string);
+
+    /// @brief Calculates the 64-bit FNV-1a hash of the given null terminated string, used instead of the 32-bit hash if the hash is stored in place of the string itself,
+    /// because the bigger range makes it negligibly unlikely that two different strings compare equal. See http://www.isthe.com/chongo/tech/comp/fnv/ for more information
+    /// @param string String that should be hashed, nullptr is hashed like an empty string
+    /// @return Hash of the given string
+    static uint64_t hashString64(char const * string);
+
     /// @brief Calculates the total size of the string the serializeJson method would produce including the null end terminator.
     /// Be aware that null terminator will later not be serialied in the serializeJson() call,
     /// meaning the returned written amount of bytes is the return value of this method - 1.
@@ -100,6 +132,12 @@ class Helper {
         return size;
 #endif // THINGSBOARD_ENABLE_STL
     }
+
+    /// @brief Skips the content of a json string, including any escaped quotes it contains
+    /// @param string_start Pointer to the first byte after the opening quote of the string
+    /// @param end Pointer to the end of the byte payload (last byte + 1)
+    /// @return Pointer to the first byte after the closing quote of the string or end if the string is not terminated
+    static uint8_t const * skipJsonString(uint8_t const * string_start, uint8_t const * end);
 };
 
 #endif // Helper
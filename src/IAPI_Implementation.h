@@ -6,6 +6,7 @@
 #include "Constants.h"
 #include "DefaultLogger.h"
 #include "API_Process_Type.h"
+#include "IThingsBoard_Client.h"
 
 // Library include.
 #if THINGSBOARD_ENABLE_STL
@@ -63,6 +64,17 @@ class IAPI_Implementation {
     /// @return Whether the received response topic matches the topic this api implementation handles responses on
     virtual bool Compare_Response_Topic(char const * topic) const = 0;
 
+    /// @brief Returns the constant topic this api implementation handles responses on, used to build the topic router once when the api implementation is subscribed,
+    /// which then maps received topics to the api implementations that handle them, without having to call Compare_Response_Topic on every single api implementation.
+    /// Optional, implementations whose response topic is not constant do not have to override this method, in that case Compare_Response_Topic is called for every received message instead
+    /// @param is_prefix Variable that will be set to whether the received topic only has to start with the returned topic, because it includes additional parameters (v1/devices/me/attributes/response/1),
+    /// or if it has to match the returned topic exactly (v1/devices/me/attributes)
+    /// @return Constant topic this api implementation handles responses on or nullptr if the topic can only be compared with Compare_Response_Topic
+    virtual char const * Get_Response_Topic(bool & is_prefix) const {
+        is_prefix = false;
+        return nullptr;
+    }
+
     /// @brief Unsubcribes all callbacks, to clear up any ongoing subscriptions and stop receiving information over the previously subscribed topic
     /// @return Whether unsubcribing all the previously subscribed callbacks
     /// and from the previously subscribed topic, was successful or not
@@ -82,23 +94,16 @@ class IAPI_Implementation {
 
     /// @brief Method that allows to construct internal objects, after the required callback member methods have been set already.
     /// Required for API Implementations that subscribe further API calls, because immediately calling in the constructor can lead,
-    /// to attempted subscriptions before the m_subscribe_api_callback is actually subscribed. Therefore we have to call methods like that,
+    /// to attempted subscriptions before the client is actually set with Set_Client(). Therefore we have to call methods like that,
     /// in this method instead, because it ensures all member methods are instantiated already
     virtual void Initialize() = 0;
 
-    /// @brief Sets the underlying callbacks that are required for the different API Implementation to communicate with the cloud.
-    /// Directly set by the used ThingsBoard client to its internal methods, therefore calling again and overriding
+    /// @brief Sets the client that is required for the different API Implementation to communicate with the cloud.
+    /// Directly set by the used ThingsBoard client to itself, therefore calling again and overriding
     /// as a user ist not recommended, unless you know what you are doing
-    /// @param subscribe_api_callback Method which allows to subscribe additional API endpoints, points to Subscribe_API_Implementation per default
-    /// @param send_json_callback Method which allows to send arbitrary JSON payload, points to Send_Json per default
-    /// @param send_json_string_callback Method which allows to send arbitrary JSON string payload, points to Send_Json_String per default
-    /// @param subscribe_topic_callback Method which allows to subscribe to arbitrary topics, points to m_client.subscribe per default
-    /// @param unsubscribe_topic_callback Method which allows to unsubscribe from arbitrary topics, points to m_client.unsubscribe per default
-    /// @param get_receive_size_callback Method which allows to get the current underlying receive size of the buffer, points to m_client.get_receive_buffer_size per default
-    /// @param get_send_size_callback Method which allows to get the current underlying send size of the buffer, points to m_client.get_send_buffer_size per default
-    /// @param set_buffer_size_callback Method which allows to set the current underlying size of the buffer, points to m_client.set_buffer_size per default
-    /// @param get_request_id_callback Method which allows to get the current request id as a mutable reference, points to getRequestID per default
-    virtual void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) = 0;
+    /// @param client Client which allows to subscribe additional API endpoints, send arbitrary JSON payloads, subscribe and unsubscribe arbitrary topics,
+    /// get and set the size of the underlying buffer and get the current request id, has to be kept alive for as long as the instance of this class
+    virtual void Set_Client(IThingsBoard_Client & client) = 0;
 };
 
 #endif // IAPI_Implementation_h
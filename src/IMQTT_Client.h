@@ -75,6 +75,23 @@ class IMQTT_Client {
     /// See https://stackoverflow.blog/2020/12/14/security-considerations-for-ota-software-updates-for-iot-gateway-devices/ for more information on the aforementioned security risk
     virtual void set_server(char const * domain, uint16_t port) = 0;
 
+    /// @brief Configures whether the following connections are established with the cleanSession flag set or not. If the flag is not set the broker keeps the subscriptions of the client id,
+    /// after the connection has been lost and resumes delivering to them once the same client id connects again, meaning the client id passed to connect() has to stay the same across connections.
+    /// Clients that can not establish persistent sessions keep the default implementation, in which case every connection is established with the cleanSession flag set
+    /// @param clean_session Whether the broker should discard the session of the client id once the connection is established or lost
+    /// @return Whether the given session mode is supported by the client or not, default = clean_session
+    virtual bool set_clean_session(bool clean_session) {
+        return clean_session;
+    }
+
+    /// @brief Gets whether the broker still held the session of the client id when the last connection was established, as reported by the session present flag of the CONNACK packet.
+    /// Only ever true if the connection was established without the cleanSession flag, in which case the broker still holds the previous subscriptions and they do not have to be subscribed again.
+    /// Clients that can not read the flag keep the default implementation, in which case the broker is expected to have lost the session and every topic is subscribed again
+    /// @return Whether the broker still held the session of the client id, default = false
+    virtual bool get_session_present() {
+        return false;
+    }
+
     /// @brief Connects to the previously with set_server configured server instance that should be connected to over the previously defined port
     /// @param client_id Client identification code, that allows to differentiate which MQTT device is sending the traffic to the MQTT broker
     /// @param user_name Client username that is used to authenticate, who is connecting over MQTT
@@ -103,6 +120,19 @@ class IMQTT_Client {
     /// @return Wheter subscribing the given topic was possible or not, should return false and a warning should be printed,
     /// if the connection has been lost or the topic does not exist
     virtual bool subscribe(char const * topic) = 0;
+
+    /// @brief Subscribes to MQTT messages on all the given topics, which allows to send every topic filter in a single subscribe request, instead of sending one request per topic.
+    /// Clients that can not send multiple topic filters in a single request keep the default implementation, in which case every topic is subscribed with its own request
+    /// @param topics Array of topics we want to receive a notification about if messages are sent by the server
+    /// @param count Amount of topics in the array
+    /// @return Whether subscribing all the given topics was possible or not, default = result of subscribe() for every topic
+    virtual bool subscribe_multiple(char const * const * topics, size_t const & count) {
+        bool result = true;
+        for (size_t index = 0U; index < count; index++) {
+            result = subscribe(topics[index]) && result;
+        }
+        return result;
+    }
   
     /// @brief Unsubscribes to previously subscribed MQTT message on the given topic
     /// @param topic Topic we want to stop receiving a notification about if messages are sent by the server
@@ -0,0 +1,27 @@
+#ifndef IOTA_Checkpoint_Storage_h
+#define IOTA_Checkpoint_Storage_h
+
+// Local include.
+#include "Configuration.h"
+#include "OTA_Checkpoint.h"
+
+
+/// @brief Storage interface that contains the methods that a class, which can be used to persist the progress of an OTA firmware update, has to implement.
+/// Allows to continue an interrupted update after a restart or lost connection, as long as the used IUpdater implementation supports resuming as well
+class IOTA_Checkpoint_Storage {
+  public:
+    /// @brief Reads the previously stored checkpoint
+    /// @param checkpoint Checkpoint the stored progress will be copied into
+    /// @return Whether a checkpoint has been stored previously and could be read successfully or not
+    virtual bool load(OTA_Checkpoint & checkpoint) = 0;
+
+    /// @brief Stores the given checkpoint, overwriting any previously stored checkpoint
+    /// @param checkpoint Current progress of the ongoing update
+    /// @return Whether storing the checkpoint was successful or not
+    virtual bool store(OTA_Checkpoint const & checkpoint) = 0;
+
+    /// @brief Removes the previously stored checkpoint, called once the update finished or had to be restarted from the first chunk
+    virtual void erase() = 0;
+};
+
+#endif // IOTA_Checkpoint_Storage_h
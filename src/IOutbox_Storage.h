@@ -0,0 +1,50 @@
+#ifndef IOutbox_Storage_h
+#define IOutbox_Storage_h
+
+// Local include.
+#include "Configuration.h"
+
+// Library include.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Storage interface that contains the methods that a class, which can be used to persist the messages of the outbox, has to implement.
+/// The storage is a fixed size region of bytes, that is split into sectors of equal size. Behaves like NOR flash, meaning erased bytes read as 0xFF
+/// and the outbox ensures that a sector is always erased before it is written again, which allows to use flash partitions directly without an additional file system
+class IOutbox_Storage {
+  public:
+    /// @brief Prepares the storage for usage, for example by opening the underlying file, is called once before any other method
+    /// @return Whether the storage could be prepared successfully or not
+    virtual bool begin() = 0;
+
+    /// @brief Gets the total size of the storage region, has to be a multiple of the sector size
+    /// @return Total size of the storage region in bytes
+    virtual size_t get_size() const = 0;
+
+    /// @brief Gets the size of the smallest region that can be erased at once, records are never written across the boundary between two sectors
+    /// @return Size of a single sector in bytes
+    virtual size_t get_sector_size() const = 0;
+
+    /// @brief Reads the given amount of bytes from the given offset in the storage region
+    /// @param offset Offset from the start of the storage region to start reading at
+    /// @param buffer Buffer the read bytes will be copied into
+    /// @param size Amount of bytes that should be read
+    /// @return Whether reading was successful or not
+    virtual bool read(size_t const & offset, uint8_t * buffer, size_t const & size) = 0;
+
+    /// @brief Writes the given bytes at the given offset in the storage region, the region will have been erased before,
+    /// with the only exception being single bytes that are overwritten with a value that only clears bits, which is allowed for NOR flash as well
+    /// @param offset Offset from the start of the storage region to start writing at
+    /// @param buffer Buffer containing the bytes that should be written
+    /// @param size Amount of bytes that should be written
+    /// @return Whether writing was successful or not
+    virtual bool write(size_t const & offset, uint8_t const * buffer, size_t const & size) = 0;
+
+    /// @brief Erases the sector starting at the given offset, afterwards all bytes in the sector have to read as 0xFF
+    /// @param offset Offset from the start of the storage region to the start of the sector, always a multiple of the sector size
+    /// @return Whether erasing was successful or not
+    virtual bool erase_sector(size_t const & offset) = 0;
+};
+
+#endif // IOutbox_Storage_h
@@ -0,0 +1,56 @@
+#ifndef IPayload_Codec_h
+#define IPayload_Codec_h
+
+// Local include.
+#include "Configuration.h"
+
+// Library include.
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Codec interface that contains the methods that a class, which converts the payload of messages from and into a different format than json, has to implement.
+/// The api implementations and the public send methods keep working with JsonDocument, the codec is only applied directly before a message is published or directly after it has been received,
+/// meaning sendTelemetry(), sendAttributes() and the callbacks of every api implementation work unchanged independent of the payload format that is used on the wire.
+/// Topics the codec does not encode or decode keep using json, which allows to only convert the topics the server actually expects in the different format
+class IPayload_Codec {
+  public:
+    /// @brief Whether messages that are published over the given topic are encoded with this codec instead of being serialized as json
+    /// @param topic Topic the message will be published over
+    /// @return Whether the message has to be encoded with Encode()
+    virtual bool Is_Encoded_Topic(char const * topic) const = 0;
+
+    /// @brief Whether messages that are received over the given topic are decoded with this codec instead of being deserialized as json
+    /// @param topic Topic the message was received over
+    /// @return Whether the message has to be decoded with Decode()
+    virtual bool Is_Decoded_Topic(char const * topic) const = 0;
+
+    /// @brief Encodes the given json into the given buffer, is only called for topics where Is_Encoded_Topic() returned true
+    /// @param topic Topic the message will be published over, allows to use a different schema for each topic
+    /// @param source JsonDocument containing the key value pairs that should be encoded
+    /// @param buffer Buffer the encoded payload should be written into
+    /// @param buffer_size Size of the given buffer, which is the current send buffer size of the client
+    /// @return Length of the encoded payload, or 0 if the json could not be encoded or the encoded payload did not fit into the buffer
+    virtual size_t Encode(char const * topic, JsonDocument const & source, uint8_t * buffer, size_t const & buffer_size) const = 0;
+
+    /// @brief Gets the amount of key-value pairs the given payload contains once it is decoded, is only called for topics where Is_Decoded_Topic() returned true.
+    /// Allows to calculate the capacity the JsonDocument passed to Decode() requires, with JSON_OBJECT_SIZE(Get_Decoded_Node_Count())
+    /// @param topic Topic the message was received over
+    /// @param payload Payload that was received over the given topic
+    /// @param length Total length of the received payload
+    /// @return Amount of key-value pairs in the decoded payload, or 0 if the payload is invalid
+    virtual size_t Get_Decoded_Node_Count(char const * topic, uint8_t const * payload, size_t const & length) const = 0;
+
+    /// @brief Decodes the given payload into the given JsonDocument, is only called for topics where Is_Decoded_Topic() returned true.
+    /// The payload is writeable and allowed to be modified while it is decoded, which allows strings to be linked into the JsonDocument instead of being copied, similar to the zero copy mode of ArduinoJson
+    /// @param topic Topic the message was received over, allows to use a different schema for each topic
+    /// @param payload Payload that was received over the given topic
+    /// @param length Total length of the received payload
+    /// @param destination JsonDocument the decoded key value pairs should be written into,
+    /// has the capacity calculated from the value returned by Get_Decoded_Node_Count()
+    /// @return Whether the payload was valid and could be decoded successfully
+    virtual bool Decode(char const * topic, uint8_t * payload, size_t const & length, JsonDocument & destination) const = 0;
+};
+
+#endif // IPayload_Codec_h
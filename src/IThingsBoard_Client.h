@@ -0,0 +1,75 @@
+#ifndef IThingsBoard_Client_h
+#define IThingsBoard_Client_h
+
+// Local includes.
+#include "Configuration.h"
+#include "Timer_Queue.h"
+
+// Library includes.
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+// Forward declaration, because the api implementations themselves receive the client they communicate over
+class IAPI_Implementation;
+
+
+/// @brief Client interface that contains the methods the api implementations require to communicate with the cloud, implemented by ThingsBoardSized.
+/// Passed once to every api implementation as a single non-owning reference with IAPI_Implementation::Set_Client(), instead of binding a separate callback for every single method,
+/// which removes the need for every api implementation to store its own copy of each of those callbacks and allows every call to be a direct virtual call instead of going through a type-erased callback
+class IThingsBoard_Client {
+  public:
+    /// @brief Copies a non-owning pointer to the given API implementation, which allows api implementations to subscribe additional API endpoints they require internally.
+    /// Ensure the actual variable is kept alive for as long as the client
+    /// @param api Additional API that we want to be handled
+    virtual void Subscribe_API_Implementation(IAPI_Implementation & api) = 0;
+
+    /// @brief Attempts to send key value pairs from custom source over the given topic to the server
+    /// @param topic Topic we want to send the data over
+    /// @param source JsonDocument containing our json key value pairs we want to send
+    /// @param json_size Size of the data inside the source
+    /// @return Whether sending the data was successful or not
+    virtual bool Send_Json(char const * topic, JsonDocument const & source, size_t const & json_size) = 0;
+
+    /// @brief Attempts to send custom json string over the given topic to the server
+    /// @param topic Topic we want to send the data over
+    /// @param json String containing our json key value pairs we want to attempt to send
+    /// @return Whether sending the data was successful or not
+    virtual bool Send_Json_String(char const * topic, char const * json) = 0;
+
+    /// @brief Subscribes the given topic with the underlying MQTT client
+    /// @param topic Topic that should be subscribed
+    /// @return Whether subscribing was successfull or not
+    virtual bool clientSubscribe(char const * topic) = 0;
+
+    /// @brief Unsubscribes the given topic with the underlying MQTT client
+    /// @param topic Topic that should be unsubscribed
+    /// @return Whether unsubscribing was successfull or not
+    virtual bool clientUnsubscribe(char const * topic) = 0;
+
+    /// @brief Returns the current receive buffer size of the underlying MQTT client
+    /// @return Current internal receive buffer size
+    virtual uint16_t getClientReceiveBufferSize() = 0;
+
+    /// @brief Returns the current send buffer size of the underlying MQTT client
+    /// @return Current internal send buffer size
+    virtual uint16_t getClientSendBufferSize() = 0;
+
+    /// @brief Changes the size of the buffer for sent and received MQTT messages of the underlying MQTT client
+    /// @param receive_buffer_size Maximum amount of data that can be received at once
+    /// @param send_buffer_size Maximum amount of data that can be sent at once
+    /// @return Whether allocating the needed memory for the given buffer sizes was successful or not
+    virtual bool setBufferSize(uint16_t receive_buffer_size, uint16_t send_buffer_size) = 0;
+
+    /// @brief Gets a mutable pointer to the request id shared by all request types, the current value is the id of the last sent request
+    /// @return Mutable pointer to the request id
+    virtual size_t * getRequestID() = 0;
+
+    /// @brief Gets the queue the timeouts of sent requests should be scheduled in, which is updated by the client itself,
+    /// instead of every request having to start and update its own timer
+    /// @return Reference to the timer queue
+    virtual Timer_Queue & getTimerQueue() = 0;
+};
+
+#endif // IThingsBoard_Client_h
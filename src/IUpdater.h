@@ -27,6 +27,27 @@ class IUpdater {
     /// @brief Resets the writing of the given data so it can be restarted with begin
     virtual void reset() = 0;
   
+    /// @brief Continues a previously interrupted writing of the given data, instead of restarting it with begin.
+    /// Any following calls to write will continue at the given offset, already written data in front of the offset has to be kept as is.
+    /// Optional, implementations that can not continue an interrupted write do not have to override this method, in that case the update is always restarted with begin
+    /// @param firmware_size Total size of the data that should be written, has to be the same as the size the interrupted write was initalized with
+    /// @param offset Amount of bytes that have already been written successfully previously
+    /// @return Whether continuing the update was successful or not
+    virtual bool resume(size_t const & firmware_size, size_t const & offset) {
+        return false;
+    }
+
+    /// @brief Reads back data that has already been written, used after resume() to hash the data written before the update was interrupted again,
+    /// because the state of the hash calculation can not be persisted.
+    /// Optional, implementations that do not override this method can not resume an update, in that case the update is always restarted with begin
+    /// @param offset Position in the written data the bytes should be read from
+    /// @param buffer Output buffer the read bytes are copied into
+    /// @param length Amount of bytes that should be read
+    /// @return Amount of bytes that were read successfully
+    virtual size_t read(size_t const & offset, uint8_t * buffer, size_t const & length) {
+        return 0U;
+    }
+
     /// @brief Ends the update and returns wheter it was successfully completed
     /// @return Whether the complete amount of bytes initally given was successfully written or not
     virtual bool end() = 0;
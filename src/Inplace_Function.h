@@ -0,0 +1,240 @@
+#ifndef Inplace_Function_h
+#define Inplace_Function_h
+
+// Local includes.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_STL
+
+// Library includes.
+#include <functional>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+
+
+/// @brief Callable wrapper that behaves like std::function, but stores the wrapped callable directly inside of a fixed size inline buffer instead of on the heap.
+/// Meaning copying, moving and calling the wrapper never allocates any memory, regardless of the size of the wrapped callable. If the wrapped callable does not fit into the inline buffer,
+/// because it captures too many variables, compilation fails instead of silently falling back to a heap allocation, the buffer size can be increased with THINGSBOARD_CALLBACK_BUFFER_SIZE if that is the case.
+/// Callables that are trivially copyable, which is the case for function pointers, std::bind on a member method and lambdas only capturing pointers or references, are copied and moved with a simple memcpy of the inline buffer,
+/// instead of having to call their copy constructor over a function pointer
+/// @tparam Signature Signature of the wrapped callable, in the same format as std::function, for example void(int)
+/// @tparam Capacity Size in bytes of the inline buffer the wrapped callable is stored in, default = THINGSBOARD_CALLBACK_BUFFER_SIZE
+template <typename Signature, size_t Capacity = THINGSBOARD_CALLBACK_BUFFER_SIZE>
+class Inplace_Function;
+
+template <typename return_typ, typename... argument_types, size_t Capacity>
+class Inplace_Function<return_typ(argument_types...), Capacity> {
+  private:
+    /// @brief Whether the given type can be wrapped, which is only the case if it is callable with the argument types and not the wrapper itself, because then the copy or move constructor has to be used
+    /// @tparam Functor Type of the callable that should be wrapped
+    template <typename Functor, typename Decayed = typename std::decay<Functor>::type>
+    using Enable_If_Callable = typename std::enable_if<!std::is_same<Decayed, Inplace_Function>::value && !std::is_same<Decayed, std::nullptr_t>::value
+      && (std::is_void<return_typ>::value || std::is_convertible<decltype(std::declval<Decayed &>()(std::declval<argument_types>()...)), return_typ>::value)>::type;
+
+  public:
+    /// @brief Constructs an empty wrapper, will result in the wrapper being empty and returning false when checked with operator bool
+    Inplace_Function()
+      : m_operations(nullptr)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Constructs an empty wrapper, allows to pass nullptr as a default argument in the same way as with std::function or a c-style function pointer
+    Inplace_Function(std::nullptr_t)
+      : m_operations(nullptr)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Constructs a wrapper containing a copy of the given callable, stored directly inside of the inline buffer.
+    /// If the given callable is a function pointer that is nullptr or an empty std::function, the wrapper is empty instead
+    /// @tparam Functor Type of the callable that should be wrapped, has to fit into the inline buffer, otherwise compilation fails
+    /// @param functor Callable that should be wrapped
+    template <typename Functor, typename = Enable_If_Callable<Functor>>
+    Inplace_Function(Functor && functor)
+      : m_operations(nullptr)
+    {
+        using Decayed = typename std::decay<Functor>::type;
+        static_assert(sizeof(Decayed) <= Capacity, "Callable is too big to be stored inside of the inline buffer, reduce the amount of captured variables or increase THINGSBOARD_CALLBACK_BUFFER_SIZE");
+        static_assert(alignof(Decayed) <= ALIGNMENT, "Callable requires a stricter alignment than the inline buffer provides");
+        Decayed * stored = new (m_storage) Decayed(std::forward<Functor>(functor));
+        if (Is_Empty(*stored)) {
+            stored->~Decayed();
+            return;
+        }
+        m_operations = &Get_Operations<Decayed>();
+    }
+
+    /// @brief Copy constructor
+    /// @param other Wrapper whose wrapped callable should be copied into this instance
+    Inplace_Function(Inplace_Function const & other)
+      : m_operations(other.m_operations)
+    {
+        Copy_From(other);
+    }
+
+    /// @brief Move constructor, relocates the wrapped callable into this instance and leaves the other instance empty
+    /// @param other Wrapper whose wrapped callable should be moved into this instance
+    Inplace_Function(Inplace_Function && other)
+      : m_operations(other.m_operations)
+    {
+        Relocate_From(other);
+    }
+
+    /// @brief Destructor
+    ~Inplace_Function() {
+        clear();
+    }
+
+    /// @brief Copy assignment operator
+    /// @param other Wrapper whose wrapped callable should be copied into this instance
+    /// @return Reference to this instance
+    Inplace_Function & operator=(Inplace_Function const & other) {
+        if (this != &other) {
+            clear();
+            m_operations = other.m_operations;
+            Copy_From(other);
+        }
+        return *this;
+    }
+
+    /// @brief Move assignment operator, relocates the wrapped callable into this instance and leaves the other instance empty
+    /// @param other Wrapper whose wrapped callable should be moved into this instance
+    /// @return Reference to this instance
+    Inplace_Function & operator=(Inplace_Function && other) {
+        if (this != &other) {
+            clear();
+            m_operations = other.m_operations;
+            Relocate_From(other);
+        }
+        return *this;
+    }
+
+    /// @brief Destroys the wrapped callable, leaving the wrapper empty
+    /// @return Reference to this instance
+    Inplace_Function & operator=(std::nullptr_t) {
+        clear();
+        return *this;
+    }
+
+    /// @brief Whether the wrapper contains a callable or not
+    /// @return Whether the wrapper contains a callable that can be called
+    explicit operator bool() const {
+        return m_operations != nullptr;
+    }
+
+    /// @brief Calls the wrapped callable with the given arguments, has to contain a callable, which can be checked with operator bool beforehand
+    /// @param ...arguments Arguments that are simply forwarded to the wrapped callable
+    /// @return Value returned by the wrapped callable
+    return_typ operator()(argument_types... arguments) const {
+        return m_operations->invoke(const_cast<unsigned char *>(m_storage), std::forward<argument_types>(arguments)...);
+    }
+
+  private:
+    static constexpr size_t ALIGNMENT = alignof(uint64_t) > alignof(void *) ? alignof(uint64_t) : alignof(void *);
+
+    /// @brief Type-erased operations for a specific callable type, callables that are trivially copyable leave copy, relocate and destroy as nullptr,
+    /// because they can simply be copied with memcpy and do not have to be destroyed at all
+    struct Operations {
+        return_typ (*invoke)(void * storage, argument_types &&... arguments);
+        void       (*copy)(void * destination, void const * source);
+        void       (*relocate)(void * destination, void * source);
+        void       (*destroy)(void * storage);
+    };
+
+    template <typename Functor>
+    static return_typ Invoke(void * storage, argument_types &&... arguments) {
+        // Cast allows to wrap callables that return a value, even if the signature returns void, the same as std::function does
+        return static_cast<return_typ>((*static_cast<Functor *>(storage))(std::forward<argument_types>(arguments)...));
+    }
+
+    template <typename Functor>
+    static void Copy(void * destination, void const * source) {
+        new (destination) Functor(*static_cast<Functor const *>(source));
+    }
+
+    template <typename Functor>
+    static void Relocate(void * destination, void * source) {
+        Functor * moved = static_cast<Functor *>(source);
+        new (destination) Functor(std::move(*moved));
+        moved->~Functor();
+    }
+
+    template <typename Functor>
+    static void Destroy(void * storage) {
+        static_cast<Functor *>(storage)->~Functor();
+    }
+
+    /// @brief Gets the operations for the given callable type, initalized as a constant so no guard is required for the local static variable
+    /// @tparam Functor Type of the wrapped callable
+    /// @return Operations shared by every wrapper containing a callable of the given type
+    template <typename Functor>
+    static Operations const & Get_Operations() {
+        static Operations const operations = std::is_trivially_copyable<Functor>::value
+          ? Operations{&Invoke<Functor>, nullptr, nullptr, nullptr}
+          : Operations{&Invoke<Functor>, &Copy<Functor>, &Relocate<Functor>, &Destroy<Functor>};
+        return operations;
+    }
+
+    template <typename Functor>
+    static bool Is_Empty(Functor const &) {
+        return false;
+    }
+
+    template <typename function_return_typ, typename... function_argument_types>
+    static bool Is_Empty(function_return_typ (* const & function)(function_argument_types...)) {
+        return function == nullptr;
+    }
+
+    template <typename function_signature>
+    static bool Is_Empty(std::function<function_signature> const & function) {
+        return !function;
+    }
+
+    /// @brief Copies the callable wrapped by the given instance into the inline buffer, expects the operations to have already been copied
+    /// @param other Wrapper whose wrapped callable should be copied
+    void Copy_From(Inplace_Function const & other) {
+        if (m_operations == nullptr) {
+            return;
+        }
+        else if (m_operations->copy == nullptr) {
+            (void)memcpy(m_storage, other.m_storage, Capacity);
+            return;
+        }
+        m_operations->copy(m_storage, other.m_storage);
+    }
+
+    /// @brief Relocates the callable wrapped by the given instance into the inline buffer and leaves the given instance empty, expects the operations to have already been copied
+    /// @param other Wrapper whose wrapped callable should be relocated
+    void Relocate_From(Inplace_Function & other) {
+        if (m_operations == nullptr) {
+            return;
+        }
+        else if (m_operations->relocate == nullptr) {
+            (void)memcpy(m_storage, other.m_storage, Capacity);
+        }
+        else {
+            m_operations->relocate(m_storage, other.m_storage);
+        }
+        other.m_operations = nullptr;
+    }
+
+    /// @brief Destroys the wrapped callable if there is any, leaving the wrapper empty
+    void clear() {
+        if (m_operations != nullptr && m_operations->destroy != nullptr) {
+            m_operations->destroy(m_storage);
+        }
+        m_operations = nullptr;
+    }
+
+    Operations const                 *m_operations = {};    // Type-erased operations of the wrapped callable, nullptr if the wrapper is empty
+    alignas(ALIGNMENT) unsigned char m_storage[Capacity]; // Inline buffer the wrapped callable is stored in
+};
+
+#endif // THINGSBOARD_ENABLE_STL
+
+#endif // Inplace_Function_h
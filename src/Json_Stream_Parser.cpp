@@ -0,0 +1,222 @@
+// Header include.
+#include "Json_Stream_Parser.h"
+
+// Local includes.
+#include "Helper.h"
+
+// Library includes.
+#include <errno.h>
+#include <stdlib.h>
+
+// Longest number text that is converted, which is enough for every int64_t and every double that is serialized with the shortest round trip representation
+constexpr size_t MAX_NUMBER_LENGTH = 32U;
+
+size_t Json_Stream_Value::Get_Node_Count() const {
+    if (!Is_Container()) {
+        return 0U;
+    }
+    return Helper::getJsonNodeCount(reinterpret_cast<uint8_t const *>(begin), length);
+}
+
+DeserializationError Json_Stream_Value::Deserialize(JsonDocument & document) const {
+    return deserializeJson(document, begin, length);
+}
+
+Json_Stream_Parser::Json_Stream_Parser(char * payload, size_t const & length)
+  : m_current(payload)
+  , m_end(payload != nullptr ? payload + length : nullptr)
+  , m_depth(0U)
+  , m_object_bits(0U)
+  , m_first_in_container(false)
+{
+    // Nothing to do
+}
+
+void Json_Stream_Parser::Skip_Whitespace() {
+    while (m_current < m_end && (*m_current == ' ' || *m_current == '\t' || *m_current == '\r' || *m_current == '\n')) {
+        m_current++;
+    }
+}
+
+bool Json_Stream_Parser::Parse_String(char const * & string) {
+    // Skips the opening quote, the unescaped string is written starting at the same position, because unescaping never makes the string longer
+    char * read = ++m_current;
+    char * write = read;
+    string = read;
+    while (read < m_end) {
+        char symbol = *read++;
+        if (symbol == '"') {
+            *write = '\0';
+            m_current = read;
+            return true;
+        }
+        else if (symbol != '\\') {
+            *write++ = symbol;
+            continue;
+        }
+        else if (read >= m_end) {
+            return false;
+        }
+
+        symbol = *read++;
+        switch (symbol) {
+            case 'b':
+                *write++ = '\b';
+                break;
+            case 'f':
+                *write++ = '\f';
+                break;
+            case 'n':
+                *write++ = '\n';
+                break;
+            case 'r':
+                *write++ = '\r';
+                break;
+            case 't':
+                *write++ = '\t';
+                break;
+            case 'u': {
+                // Escaped unicode code point, written as utf-8, which always requires less bytes than the 6 bytes of the escape sequence.
+                // Surrogate pairs consist of two escape sequences and are combined into a single code point that requires 4 utf-8 bytes
+                uint32_t code_point = 0U;
+                for (size_t i = 0U; i < 4U; i++) {
+                    if (read >= m_end) {
+                        return false;
+                    }
+                    char const digit = *read++;
+                    code_point <<= 4U;
+                    if (digit >= '0' && digit <= '9') {
+                        code_point |= digit - '0';
+                    }
+                    else if (digit >= 'a' && digit <= 'f') {
+                        code_point |= digit - 'a' + 10;
+                    }
+                    else if (digit >= 'A' && digit <= 'F') {
+                        code_point |= digit - 'A' + 10;
+                    }
+                    else {
+                        return false;
+                    }
+                }
+                if (code_point >= 0xD800U && code_point <= 0xDBFFU && m_end - read >= 6 && read[0] == '\\' && read[1] == 'u') {
+                    char * low_end = nullptr;
+                    char low_digits[5U] = { read[2], read[3], read[4], read[5], '\0' };
+                    uint32_t const low_surrogate = strtoul(low_digits, &low_end, 16);
+                    if (low_end == low_digits + 4U && low_surrogate >= 0xDC00U && low_surrogate <= 0xDFFFU) {
+                        code_point = 0x10000U + ((code_point - 0xD800U) << 10U) + (low_surrogate - 0xDC00U);
+                        read += 6U;
+                    }
+                }
+                if (code_point < 0x80U) {
+                    *write++ = static_cast<char>(code_point);
+                }
+                else if (code_point < 0x800U) {
+                    *write++ = static_cast<char>(0xC0U | (code_point >> 6U));
+                    *write++ = static_cast<char>(0x80U | (code_point & 0x3FU));
+                }
+                else if (code_point < 0x10000U) {
+                    *write++ = static_cast<char>(0xE0U | (code_point >> 12U));
+                    *write++ = static_cast<char>(0x80U | ((code_point >> 6U) & 0x3FU));
+                    *write++ = static_cast<char>(0x80U | (code_point & 0x3FU));
+                }
+                else {
+                    *write++ = static_cast<char>(0xF0U | (code_point >> 18U));
+                    *write++ = static_cast<char>(0x80U | ((code_point >> 12U) & 0x3FU));
+                    *write++ = static_cast<char>(0x80U | ((code_point >> 6U) & 0x3FU));
+                    *write++ = static_cast<char>(0x80U | (code_point & 0x3FU));
+                }
+                break;
+            }
+            default:
+                // Covers the escaped quote, backslash and slash, which are simply written without the preceding backslash
+                *write++ = symbol;
+                break;
+        }
+    }
+    return false;
+}
+
+bool Json_Stream_Parser::Parse_Literal(Json_Stream_Value & value) {
+    size_t const remaining = m_end - m_current;
+    if (remaining >= 4U && strncmp(m_current, "null", 4U) == 0) {
+        value.type = Json_Stream_Type::NULL_VALUE;
+        m_current += 4U;
+    }
+    else if (remaining >= 4U && strncmp(m_current, "true", 4U) == 0) {
+        value.type = Json_Stream_Type::BOOLEAN;
+        value.boolean = true;
+        m_current += 4U;
+    }
+    else if (remaining >= 5U && strncmp(m_current, "false", 5U) == 0) {
+        value.type = Json_Stream_Type::BOOLEAN;
+        value.boolean = false;
+        m_current += 5U;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+bool Json_Stream_Parser::Parse_Number(Json_Stream_Value & value) {
+    char number[MAX_NUMBER_LENGTH + 1U] = {};
+    size_t length = 0U;
+    bool is_integer = true;
+    while (m_current < m_end) {
+        char const symbol = *m_current;
+        if (symbol == '.' || symbol == 'e' || symbol == 'E') {
+            is_integer = false;
+        }
+        else if ((symbol < '0' || symbol > '9') && symbol != '-' && symbol != '+') {
+            break;
+        }
+        if (length >= MAX_NUMBER_LENGTH) {
+            return false;
+        }
+        number[length++] = symbol;
+        m_current++;
+    }
+    if (length == 0U) {
+        return false;
+    }
+
+    char * number_end = nullptr;
+    if (is_integer) {
+        value.type = Json_Stream_Type::INTEGER;
+        errno = 0;
+        value.integer = strtoll(number, &number_end, 10);
+        // Integers that do not fit into an int64_t are instead kept as a decimal, the same as ArduinoJson does
+        if (number_end == number + length && errno != ERANGE) {
+            return true;
+        }
+    }
+    value.type = Json_Stream_Type::DECIMAL;
+    value.decimal = strtod(number, &number_end);
+    return number_end == number + length;
+}
+
+bool Json_Stream_Parser::Skip_Container() {
+    size_t depth = 0U;
+    while (m_current < m_end) {
+        char const symbol = *m_current++;
+        if (symbol == '"') {
+            m_current = reinterpret_cast<char *>(const_cast<uint8_t *>(Helper::skipJsonString(reinterpret_cast<uint8_t const *>(m_current), reinterpret_cast<uint8_t const *>(m_end))));
+        }
+        else if (symbol == '{' || symbol == '[') {
+            depth++;
+        }
+        else if ((symbol == '}' || symbol == ']') && --depth == 0U) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Json_Stream_Parser::Is_Object(size_t const & depth) const {
+    return (m_object_bits & (1U << (depth - 1U))) != 0U;
+}
+
+void Json_Stream_Parser::Set_Object(size_t const & depth, bool const & is_object) {
+    uint32_t const bit = 1U << (depth - 1U);
+    m_object_bits = is_object ? (m_object_bits | bit) : (m_object_bits & ~bit);
+}
@@ -0,0 +1,242 @@
+#ifndef Json_Stream_Parser_h
+#define Json_Stream_Parser_h
+
+// Local includes.
+#include "Configuration.h"
+
+// Library includes.
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+
+// Maximum nesting depth of containers that can be streamed, because whether each open container is an object or an array is kept in a single bit of an uint32_t.
+// Containers that are skipped by the handler do not count towards the depth, because their content is only scanned for the closing bracket
+size_t constexpr JSON_STREAM_MAX_DEPTH = 32U;
+// Log messages.
+char constexpr UNABLE_TO_STREAM_JSON[] = "Unable to stream received json data, because it is invalid or nested deeper than (%u)";
+char constexpr UNABLE_TO_DE_SERIALIZE_STREAMED_VALUE[] = "Unable to de-serialize streamed json value with error (DeserializationError::%s)";
+#if THINGSBOARD_ENABLE_DYNAMIC
+char constexpr STREAMED_VALUE_ALLOCATION_FAILED[] = "Failed allocating required size (%u) for JsonDocument of streamed json value. Ensure there is enough heap memory left";
+#else
+char constexpr STREAM_MAX_VALUE_FIELDS_NAME[] = "THINGSBOARD_STREAM_MAX_VALUE_FIELDS";
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+
+/// @brief Possible types of a value reported by the Json_Stream_Parser
+enum class Json_Stream_Type : uint8_t {
+    NULL_VALUE, ///< Literal null
+    BOOLEAN,    ///< Literal true or false, contained in boolean
+    INTEGER,    ///< Number without fraction or exponent that fits into an int64_t, contained in integer
+    DECIMAL,    ///< Any other number, contained in decimal
+    STRING,     ///< Unescaped and null terminated string, pointed to by begin with the length excluding the null terminator
+    OBJECT,     ///< Object that has been skipped, begin points to the unmodified raw json of the object with the given length including both brackets
+    ARRAY       ///< Array that has been skipped, begin points to the unmodified raw json of the array with the given length including both brackets
+};
+
+
+/// @brief Single value reported by the Json_Stream_Parser, strings and skipped containers point directly into the parsed payload and are only valid as long as the payload is
+struct Json_Stream_Value {
+    Json_Stream_Type type = {};    // Type of the value, decides which of the other members is valid
+    char             *begin = {};  // Start of the string or the raw json of the skipped container
+    size_t           length = {};  // Length of the string or the raw json of the skipped container
+    bool             boolean = {}; // Value of the boolean
+    int64_t          integer = {}; // Value of the integer
+    double           decimal = {}; // Value of the decimal
+
+    /// @brief Whether the value is a container that has been skipped and is therefore still contained as raw json, which has to be deserialized separately
+    /// @return Whether the value is an object or array
+    bool Is_Container() const {
+        return type == Json_Stream_Type::OBJECT || type == Json_Stream_Type::ARRAY;
+    }
+
+    /// @brief Copies the value into the given variant. Strings are only linked and not copied, because they are passed as a const char pointer,
+    /// meaning the document the variant belongs to does not require any additional capacity for them. Containers are not copied, because they first have to be deserialized with Deserialize()
+    /// @tparam TVariant Type of the variant, either JsonVariant or the proxy returned when accessing a member of a JsonObject or JsonDocument
+    /// @param variant Variant the value should be copied into
+    /// @return Whether the value could be copied, which is not the case for containers
+    template <typename TVariant>
+    bool Copy_To(TVariant variant) const {
+        switch (type) {
+            case Json_Stream_Type::NULL_VALUE:
+                return variant.set(static_cast<char const *>(nullptr));
+            case Json_Stream_Type::BOOLEAN:
+                return variant.set(boolean);
+            case Json_Stream_Type::INTEGER:
+                return variant.set(integer);
+            case Json_Stream_Type::DECIMAL:
+                return variant.set(decimal);
+            case Json_Stream_Type::STRING:
+                return variant.set(const_cast<char const *>(begin));
+            default:
+                return false;
+        }
+    }
+
+    /// @brief Gets the amount of key-value pairs contained in the skipped container, including the ones of nested containers.
+    /// Allows to calculate the capacity the JsonDocument passed to Deserialize() requires, with JSON_OBJECT_SIZE(Get_Node_Count())
+    /// @return Amount of key-value pairs in the container or 0 if the value is not a container
+    size_t Get_Node_Count() const;
+
+    /// @brief Deserializes the raw json of the skipped container into the given document, uses the zero copy mode of ArduinoJson, because the container is contained in the writeable payload.
+    /// Strings in the container are therefore unescaped in place as well, meaning the container can only be deserialized once
+    /// @param document Document the container should be deserialized into
+    /// @return Error that occured while deserializing
+    DeserializationError Deserialize(JsonDocument & document) const;
+};
+
+
+/// @brief Event-driven (SAX-style) parser for json payloads, that reports every value directly to a handler while it is read, instead of deserializing the complete payload into a JsonDocument first.
+/// Peak memory therefore only depends on the nesting depth of the payload and not on its size or the amount of contained values. The payload is parsed in place, similar to the zero copy mode of ArduinoJson,
+/// strings are unescaped directly inside of the payload and are null terminated where their closing quote used to be, which means the payload can not be parsed a second time afterwards.
+/// The handler can decide for every container whether its values should be streamed as well or whether the container should be skipped, which only searches for the matching closing bracket without modifying the container.
+/// Skipped containers are reported as a single value containing their raw json, which allows to deserialize only the parts of a payload that are actually required
+class Json_Stream_Parser {
+  public:
+    /// @brief Constructor
+    /// @param payload Writeable json payload that should be parsed in place, does not need to be null terminated
+    /// @param length Total length of the payload
+    Json_Stream_Parser(char * payload, size_t const & length);
+
+    /// @brief Parses the complete payload and reports every contained value to the given handler
+    /// @tparam Handler Class that has to implement On_Container(depth, key, type), which returns whether the values of the object or array that is about to be read should be streamed as well or whether it should be skipped,
+    /// and On_Value(depth, key, value), which receives every scalar value and every skipped container and returns whether parsing should continue.
+    /// The depth is the amount of containers enclosing the value or container, meaning the root has a depth of 0 and the values of the root object a depth of 1. The key is nullptr for the elements of arrays and the root itself
+    /// @param handler Handler the values should be reported to
+    /// @return Whether the complete payload was valid json and parsed successfully, false if it was invalid or the handler stopped parsing
+    template <typename Handler>
+    bool Parse(Handler & handler) {
+        Skip_Whitespace();
+        if (!Parse_Value(handler, nullptr)) {
+            return false;
+        }
+        while (m_depth > 0U) {
+            Skip_Whitespace();
+            if (m_current >= m_end) {
+                return false;
+            }
+            char const closing_bracket = Is_Object(m_depth) ? '}' : ']';
+            if (*m_current == closing_bracket) {
+                m_current++;
+                m_depth--;
+                m_first_in_container = false;
+                continue;
+            }
+            else if (!m_first_in_container) {
+                if (*m_current != ',') {
+                    return false;
+                }
+                m_current++;
+                Skip_Whitespace();
+            }
+            m_first_in_container = false;
+
+            char const * key = nullptr;
+            if (Is_Object(m_depth)) {
+                if (m_current >= m_end || *m_current != '"' || !Parse_String(key)) {
+                    return false;
+                }
+                Skip_Whitespace();
+                if (m_current >= m_end || *m_current != ':') {
+                    return false;
+                }
+                m_current++;
+                Skip_Whitespace();
+            }
+            if (!Parse_Value(handler, key)) {
+                return false;
+            }
+        }
+        // Trailing whitespace or a null terminator following the root value are permitted, anything else is not valid json
+        Skip_Whitespace();
+        return m_current == m_end || *m_current == '\0';
+    }
+
+  private:
+    /// @brief Reads the value at the current position and reports it to the handler, or if it is a container that should be streamed, enters the container instead
+    /// @tparam Handler Class implementing On_Container and On_Value, see Parse() for more information
+    /// @param handler Handler the value should be reported to
+    /// @param key Null terminated key of the value or nullptr if it is an element of an array or the root value
+    /// @return Whether the value was valid json and the handler wants to continue parsing
+    template <typename Handler>
+    bool Parse_Value(Handler & handler, char const * key) {
+        if (m_current >= m_end) {
+            return false;
+        }
+        Json_Stream_Value value = {};
+        char const symbol = *m_current;
+        if (symbol == '{' || symbol == '[') {
+            value.type = symbol == '{' ? Json_Stream_Type::OBJECT : Json_Stream_Type::ARRAY;
+            if (handler.On_Container(m_depth, key, value.type)) {
+                if (m_depth >= JSON_STREAM_MAX_DEPTH) {
+                    return false;
+                }
+                m_depth++;
+                Set_Object(m_depth, symbol == '{');
+                m_first_in_container = true;
+                m_current++;
+                return true;
+            }
+            value.begin = m_current;
+            if (!Skip_Container()) {
+                return false;
+            }
+            value.length = m_current - value.begin;
+        }
+        else if (symbol == '"') {
+            char const * string = nullptr;
+            if (!Parse_String(string)) {
+                return false;
+            }
+            value.type = Json_Stream_Type::STRING;
+            value.begin = const_cast<char *>(string);
+            value.length = strlen(string);
+        }
+        else if (!Parse_Literal(value) && !Parse_Number(value)) {
+            return false;
+        }
+        return handler.On_Value(m_depth, key, value);
+    }
+
+    /// @brief Skips all whitespace at the current position
+    void Skip_Whitespace();
+
+    /// @brief Unescapes the string starting at the opening quote at the current position in place and null terminates it, moves the current position behind the closing quote
+    /// @param string Set to the start of the unescaped and null terminated string
+    /// @return Whether the string was valid and closed before the end of the payload
+    bool Parse_String(char const * & string);
+
+    /// @brief Reads one of the literals null, true or false at the current position
+    /// @param value Value the read literal should be written into
+    /// @return Whether there was a valid literal at the current position
+    bool Parse_Literal(Json_Stream_Value & value);
+
+    /// @brief Reads the number at the current position, the number is copied into a small buffer before it is converted,
+    /// instead of null terminating it in place, because the symbol following the number still has to be read afterwards
+    /// @param value Value the read number should be written into
+    /// @return Whether there was a valid number at the current position
+    bool Parse_Number(Json_Stream_Value & value);
+
+    /// @brief Moves the current position behind the closing bracket matching the opening bracket at the current position, without modifying the skipped content
+    /// @return Whether the matching closing bracket was found before the end of the payload
+    bool Skip_Container();
+
+    /// @brief Whether the container at the given depth is an object or an array
+    /// @param depth Depth of the container, has to be between 1 and JSON_STREAM_MAX_DEPTH
+    /// @return Whether the container is an object
+    bool Is_Object(size_t const & depth) const;
+
+    /// @brief Sets whether the container at the given depth is an object or an array
+    /// @param depth Depth of the container, has to be between 1 and JSON_STREAM_MAX_DEPTH
+    /// @param is_object Whether the container is an object
+    void Set_Object(size_t const & depth, bool const & is_object);
+
+    char       *m_current = {};           // Current read position inside of the payload
+    char       *m_end = {};               // End of the payload
+    size_t     m_depth = {};              // Amount of containers that are currently open and being streamed
+    uint32_t   m_object_bits = {};        // Whether each of the currently open containers is an object (bit set) or an array (bit not set), bit 0 contains the container at depth 1
+    bool       m_first_in_container = {}; // Whether the next value is the first value of the most recently opened container, meaning it is not preceded by a comma
+};
+
+#endif // Json_Stream_Parser_h
@@ -0,0 +1,23 @@
+#ifndef MQTT_Session_State_h
+#define MQTT_Session_State_h
+
+// Local include.
+#include "Configuration.h"
+
+// Library include.
+#include <stdint.h>
+#include <stddef.h>
+
+
+/// @brief State of a persistent MQTT session, meaning a connection established with the cleanSession flag set to false, that has to outlive a restart of the device,
+/// for the broker to keep delivering to the subscriptions it still holds for the client id, instead of the device subscribing every topic again.
+/// Contains the hashes of the topics the broker currently holds a subscription for and the id of the last sent request, which attribute and client-side RPC requests additionally take the generation encoded into their id from,
+/// so that requests sent after the restart never reuse the id of a request whose response might still be delivered.
+/// Only contains plain data so it can simply be written and read byte by byte, for example into RTC memory before entering deep sleep. Read with ThingsBoardSized::Get_Session_State() and restored with ThingsBoardSized::Restore_Session_State()
+struct MQTT_Session_State {
+    size_t   request_id = {};                                 // Id or generation of the last request that was sent to the server
+    size_t   topics_size = {};                                // Amount of topics the broker holds a subscription for
+    uint32_t topics[THINGSBOARD_SESSION_MAX_TOPICS] = {};     // Hashes of the topics the broker holds a subscription for
+};
+
+#endif // MQTT_Session_State_h
@@ -0,0 +1,79 @@
+#ifndef Memory_HTTP_Client_h
+#define Memory_HTTP_Client_h
+
+// Local includes.
+#include "IHTTP_Client.h"
+#include "Callback.h"
+
+
+/// @brief HTTP Client interface implementation that does not establish any actual network connection, but instead passes every request to a callback
+/// and answers it with the response that has been configured with set_response() beforehand.
+/// Meant to run the ThingsBoardHttp client natively on a host like Linux, to verify the exact requests that would be sent without requiring a connection to the server
+class Memory_HTTP_Client : public IHTTP_Client {
+  public:
+    /// @brief Constructs a IHTTP_Client implementation that answers every request with an empty body and status code 200
+    Memory_HTTP_Client()
+      : m_request_callback()
+      , m_status_code(200)
+      , m_response_body(nullptr)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Sets the callback that is called with the url path and the body of every request, that would have been sent to the server. The body is nullptr for GET requests
+    /// @param callback Method that should be called for every sent request
+    void set_request_callback(Callback<void, char const *, char const *>::function callback) {
+        m_request_callback.Set_Callback(callback);
+    }
+
+    /// @brief Sets the response every following request is answered with
+    /// @param status_code HTTP status code of the response
+    /// @param response_body Null terminated body of the response, is not copied and has to be kept alive until the response has been read
+    void set_response(int status_code, char const * response_body) {
+        m_status_code = status_code;
+        m_response_body = response_body;
+    }
+
+    void set_keep_alive(bool keep_alive) override {
+        // Nothing to do
+    }
+
+    int connect(char const * host, uint16_t port) override {
+        return 0;
+    }
+
+    void stop() override {
+        // Nothing to do
+    }
+
+    int post(char const * url_path, char const * content_type, char const * request_body) override {
+        m_request_callback.Call_Callback(url_path, request_body);
+        return 0;
+    }
+
+    int get_response_status_code() override {
+        return m_status_code;
+    }
+
+    int get(const char *url_path) override {
+        m_request_callback.Call_Callback(url_path, nullptr);
+        return 0;
+    }
+
+#if THINGSBOARD_ENABLE_STL
+    std::string get_response_body() override {
+        return m_response_body != nullptr ? std::string(m_response_body) : std::string();
+    }
+#else
+    String get_response_body() override {
+        return m_response_body != nullptr ? String(m_response_body) : String();
+    }
+#endif // THINGSBOARD_ENABLE_STL
+
+  private:
+    Callback<void, char const *, char const *> m_request_callback = {}; // Callback that will be called for every sent request
+    int                                        m_status_code = {};      // HTTP status code every request is answered with
+    char const                                 *m_response_body = {};   // Body every request is answered with
+};
+
+#endif // Memory_HTTP_Client_h
@@ -0,0 +1,232 @@
+#ifndef Memory_MQTT_Client_h
+#define Memory_MQTT_Client_h
+
+// Local includes.
+#include "IMQTT_Client.h"
+
+// Library includes.
+#include <string.h>
+
+
+/// @brief MQTT Client interface implementation that does not establish any actual network connection, but instead passes every published message to a callback
+/// and allows to inject received messages directly into the ThingsBoard client, as if they had been sent by the broker.
+/// Meant to run the library natively on a host like Linux, to verify the exact payloads that would be sent and to measure the time spent in the library itself,
+/// without the results being influenced by the network or the broker. Can be used on a device as well, to replay responses without requiring a connection to the server
+class Memory_MQTT_Client : public IMQTT_Client {
+  public:
+    /// @brief Constructs a IMQTT_Client implementation that is disconnected, until connect() is called
+    Memory_MQTT_Client()
+      : m_received_data_callback()
+      , m_connected_callback()
+      , m_published_callback()
+      , m_receive_buffer_size(0U)
+      , m_send_buffer_size(0U)
+      , m_connected(false)
+      , m_clean_session(true)
+      , m_session_stored(false)
+      , m_session_present(false)
+      , m_published_messages(0U)
+      , m_subscribe_requests(0U)
+      , m_unsubscribe_requests(0U)
+      , m_stream_buffer(nullptr)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Destructor
+    ~Memory_MQTT_Client() {
+        free_stream_buffer();
+    }
+
+    /// @brief Sets the callback that is called with the topic and payload of every message, that would have been sent to the broker
+    /// @param callback Method that should be called for every published message, the payload is only valid for the duration of the call and not null terminated
+    void set_published_callback(Callback<void, char const *, uint8_t const *, size_t const &>::function callback) {
+        m_published_callback.Set_Callback(callback);
+    }
+
+    /// @brief Passes the given message to the data callback as if it had been received from the broker over the given topic
+    /// @param topic Topic the message should be received over
+    /// @param payload Payload of the received message, is passed as is to the data callback, meaning it has to be mutable and might be modified while it is parsed
+    /// @param length Length of the payload
+    /// @return Whether the message was passed to the data callback, fails if the client is not connected or the payload is bigger than the receive buffer size
+    bool receive(char * topic, uint8_t * payload, unsigned int length) {
+        if (!m_connected || length > m_receive_buffer_size) {
+            return false;
+        }
+        m_received_data_callback.Call_Callback(topic, payload, length);
+        return true;
+    }
+
+    /// @brief Gets the amount of messages that have been published successfully since the client has been created
+    /// @return Amount of published messages
+    size_t const & get_published_messages() const {
+        return m_published_messages;
+    }
+
+    /// @brief Gets the amount of subscribe requests that would have been sent to the broker since the client has been created
+    /// @return Amount of subscribe requests
+    size_t const & get_subscribe_requests() const {
+        return m_subscribe_requests;
+    }
+
+    /// @brief Gets the amount of unsubscribe requests that would have been sent to the broker since the client has been created
+    /// @return Amount of unsubscribe requests
+    size_t const & get_unsubscribe_requests() const {
+        return m_unsubscribe_requests;
+    }
+
+    void set_data_callback(Callback<void, char *, uint8_t *, unsigned int>::function callback) override {
+        m_received_data_callback.Set_Callback(callback);
+    }
+
+    void set_connect_callback(Callback<void>::function callback) override {
+        m_connected_callback.Set_Callback(callback);
+    }
+
+    bool set_buffer_size(uint16_t receive_buffer_size, uint16_t send_buffer_size) override {
+        free_stream_buffer();
+        m_receive_buffer_size = receive_buffer_size;
+        m_send_buffer_size = send_buffer_size;
+        return true;
+    }
+
+    uint16_t get_receive_buffer_size() override {
+        return m_receive_buffer_size;
+    }
+
+    uint16_t get_send_buffer_size() override {
+        return m_send_buffer_size;
+    }
+
+    void set_server(char const * domain, uint16_t port) override {
+        // Nothing to do
+    }
+
+    bool set_clean_session(bool clean_session) override {
+        m_clean_session = clean_session;
+        return true;
+    }
+
+    bool get_session_present() override {
+        return m_session_present;
+    }
+
+    bool connect(char const * client_id, char const * user_name, char const * password) override {
+        // Behaves like a broker that keeps the session of any previous connection established without the cleanSession flag, regardless of the client id
+        m_session_present = !m_clean_session && m_session_stored;
+        m_session_stored = !m_clean_session;
+        m_connected = true;
+        m_connected_callback.Call_Callback();
+        return true;
+    }
+
+    void disconnect() override {
+        m_connected = false;
+    }
+
+    bool loop() override {
+        return m_connected;
+    }
+
+    bool publish(char const * topic, uint8_t const * payload, size_t const & length) override {
+        if (!m_connected || length > m_send_buffer_size) {
+            return false;
+        }
+        m_published_callback.Call_Callback(topic, payload, length);
+        m_published_messages++;
+        return true;
+    }
+
+    bool subscribe(char const * topic) override {
+        if (!m_connected) {
+            return false;
+        }
+        m_subscribe_requests++;
+        return true;
+    }
+
+    bool subscribe_multiple(char const * const * topics, size_t const & count) override {
+        if (!m_connected) {
+            return false;
+        }
+        // Counted as a single request, because every topic filter would be sent in the same packet
+        m_subscribe_requests++;
+        return true;
+    }
+
+    bool unsubscribe(char const * topic) override {
+        if (!m_connected) {
+            return false;
+        }
+        m_unsubscribe_requests++;
+        return true;
+    }
+
+    bool connected() override {
+        return m_connected;
+    }
+
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+
+    bool begin_publish(char const * topic, size_t const & length) override {
+        if (!m_connected || length > m_send_buffer_size) {
+            return false;
+        }
+        if (m_stream_buffer == nullptr) {
+            m_stream_buffer = new uint8_t[m_send_buffer_size]();
+        }
+        m_stream_topic = topic;
+        m_stream_length = 0U;
+        return true;
+    }
+
+    bool end_publish() override {
+        return m_stream_topic != nullptr && publish(m_stream_topic, m_stream_buffer, m_stream_length);
+    }
+
+    //----------------------------------------------------------------------------
+    // Print interface
+    //----------------------------------------------------------------------------
+
+    size_t write(uint8_t payload_byte) override {
+        return write(&payload_byte, 1U);
+    }
+
+    size_t write(uint8_t const * buffer, size_t const & size) override {
+        if (m_stream_topic == nullptr || m_stream_length + size > m_send_buffer_size) {
+            return 0U;
+        }
+        (void)memcpy(m_stream_buffer + m_stream_length, buffer, size);
+        m_stream_length += size;
+        return size;
+    }
+
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+
+  private:
+    /// @brief Frees the buffer streamed messages are collected in, it is allocated again with the current send buffer size the next time a message is streamed
+    void free_stream_buffer() {
+        delete[] m_stream_buffer;
+        m_stream_buffer = nullptr;
+    }
+
+    Callback<void, char *, uint8_t *, unsigned int>              m_received_data_callback = {}; // Callback that will be called as soon as a message is injected with receive()
+    Callback<void>                                               m_connected_callback = {};     // Callback that will be called as soon as connect() is called
+    Callback<void, char const *, uint8_t const *, size_t const &> m_published_callback = {};     // Callback that will be called for every published message
+    uint16_t                                                     m_receive_buffer_size = {};    // Maximum size of a message that can be injected with receive()
+    uint16_t                                                     m_send_buffer_size = {};       // Maximum size of a message that can be published
+    bool                                                         m_connected = {};              // Whether connect() has been called without disconnect() being called afterwards
+    bool                                                         m_clean_session = {};          // Whether connections are established with the cleanSession flag set
+    bool                                                         m_session_stored = {};         // Whether the last connection was established without the cleanSession flag, meaning the next one resumes its session
+    bool                                                         m_session_present = {};        // Whether the last connection resumed the session of the previous connection
+    size_t                                                       m_published_messages = {};     // Amount of messages that have been published successfully
+    size_t                                                       m_subscribe_requests = {};     // Amount of subscribe requests that have been sent successfully
+    size_t                                                       m_unsubscribe_requests = {};   // Amount of unsubscribe requests that have been sent successfully
+    uint8_t                                                      *m_stream_buffer = {};         // Buffer the payload written between begin_publish() and end_publish() is collected in, before it is passed to the published callback
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+    char const                                                   *m_stream_topic = {};          // Topic passed to begin_publish(), the streamed payload is published over once end_publish() is called
+    size_t                                                       m_stream_length = {};          // Amount of bytes written into the publish buffer since begin_publish() has been called
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+};
+
+#endif // Memory_MQTT_Client_h
@@ -0,0 +1,73 @@
+#ifndef Memory_Updater_h
+#define Memory_Updater_h
+
+// Local include.
+#include "IUpdater.h"
+
+// Library include.
+#include <string.h>
+
+
+/// @brief IUpdater implementation that writes the given binary firmware data into a buffer in memory, which is passed by the user and has to be kept alive for as long as the instance of this class.
+/// Does not actually update the device, but allows to run the complete OTA firmware update process natively on a host like Linux and compare the received binary with the expected firmware afterwards
+class Memory_Updater : public IUpdater {
+  public:
+    /// @brief Constructor
+    /// @param buffer Buffer the binary firmware data is written into
+    /// @param size Size of the given buffer, updates with a bigger firmware size are refused in begin()
+    Memory_Updater(uint8_t * buffer, size_t const & size)
+      : m_buffer(buffer)
+      , m_size(size)
+      , m_offset(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Gets the amount of bytes written into the buffer since the update has been started or resumed
+    /// @return Position in the buffer the next binary data is written at
+    size_t const & get_offset() const {
+        return m_offset;
+    }
+
+    bool begin(size_t const & firmware_size) override {
+        m_offset = 0U;
+        return m_buffer != nullptr && firmware_size <= m_size;
+    }
+
+    bool resume(size_t const & firmware_size, size_t const & offset) override {
+        m_offset = offset;
+        return m_buffer != nullptr && firmware_size <= m_size && offset <= firmware_size;
+    }
+
+    size_t write(uint8_t * payload, size_t const & total_bytes) override {
+        if (m_offset + total_bytes > m_size) {
+            return 0U;
+        }
+        (void)memcpy(m_buffer + m_offset, payload, total_bytes);
+        m_offset += total_bytes;
+        return total_bytes;
+    }
+
+    size_t read(size_t const & offset, uint8_t * buffer, size_t const & length) override {
+        if (m_buffer == nullptr || offset + length > m_size) {
+            return 0U;
+        }
+        (void)memcpy(buffer, m_buffer + offset, length);
+        return length;
+    }
+
+    void reset() override {
+        m_offset = 0U;
+    }
+
+    bool end() override {
+        return true;
+    }
+
+  private:
+    uint8_t *m_buffer = {}; // Buffer the binary firmware data is written into
+    size_t  m_size = {};    // Size of the given buffer
+    size_t  m_offset = {};  // Position in the buffer the next binary data is written at
+};
+
+#endif // Memory_Updater_h
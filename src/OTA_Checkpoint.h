@@ -0,0 +1,30 @@
+#ifndef OTA_Checkpoint_h
+#define OTA_Checkpoint_h
+
+// Local include.
+#include "HashGenerator.h"
+
+// Library include.
+#include <stdint.h>
+#include <stddef.h>
+
+
+// Maximum size of the firmware title and version saved in the checkpoint, longer strings are truncated
+size_t constexpr CHECKPOINT_STRING_SIZE = 64U;
+
+
+/// @brief Progress of an ongoing OTA firmware update, that can be persisted so the update can be continued after a restart or lost connection,
+/// instead of having to download the complete firmware binary from the first chunk again. The state of the hash calculation is not part of the checkpoint,
+/// because the internal state of Mbed TLS is not portable and might even be held by a hardware accelerator, instead the already written data is read back from the updater and hashed again when resuming.
+/// Is only ever used to resume an update if the firmware title, version, size, checksum and chunk size are the same as for the newly started update
+struct OTA_Checkpoint {
+    char              fw_title[CHECKPOINT_STRING_SIZE] = {};         // Title of the firmware that is being downloaded
+    char              fw_version[CHECKPOINT_STRING_SIZE] = {};       // Version of the firmware that is being downloaded
+    char              fw_checksum[FIRMWARE_HASH_SIZE] = {};          // Checksum of the complete firmware binary that is being downloaded
+    mbedtls_md_type_t fw_checksum_algorithm = {};                    // Algorithm type used to hash the firmware binary
+    uint32_t          fw_size = {};                                  // Total size of the firmware binary that is being downloaded
+    uint16_t          chunk_size = {};                               // Size of the chunks the firmware binary was split into
+    uint32_t          written_chunks = {};                           // Amount of chunks that have been written by the updater
+};
+
+#endif // OTA_Checkpoint_h
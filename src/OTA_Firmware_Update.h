@@ -6,6 +6,7 @@
 #include "Shared_Attribute_Update.h"
 #include "OTA_Handler.h"
 #include "IAPI_Implementation.h"
+#include "Subscription_Reference.h"
 
 
 uint8_t constexpr MAX_FW_TOPIC_SIZE = 33U;
@@ -14,6 +15,7 @@ char constexpr NO_FW_REQUEST_RESPONSE[] = "Did not receive requested shared attr
 // Firmware topics.
 char constexpr FIRMWARE_RESPONSE_TOPIC[] = "v2/fw/response/%u/chunk/";
 char constexpr FIRMWARE_RESPONSE_SUBSCRIBE_TOPIC[] = "v2/fw/response/+";
+char constexpr FIRMWARE_RESPONSE_TOPIC_PREFIX[] = "v2/fw/response/";
 char constexpr FIRMWARE_REQUEST_TOPIC[] = "v2/fw/request/%u/chunk/%u";
 // Firmware data keys.
 char constexpr CURR_FW_TITLE_KEY[] = "current_fw_title";
@@ -53,15 +55,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
   public:
     /// @brief Constructor
     OTA_Firmware_Update()
-      : m_subscribe_api_callback()
-      , m_send_json_callback()
-      , m_send_json_string_callback()
-      , m_subscribe_topic_callback()
-      , m_unsubscribe_topic_callback()
-      , m_get_receive_size_callback()
-      , m_get_send_size_callback()
-      , m_set_buffer_size_callback()
-      , m_get_request_id_callback()
+      : m_client(nullptr)
       , m_fw_callback()
       , m_previous_buffer_size(0U)
       , m_changed_buffer_size(false)
@@ -161,7 +155,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         StaticJsonDocument<JSON_OBJECT_SIZE(2)> current_firmware_info;
         current_firmware_info[CURR_FW_TITLE_KEY] = current_fw_title;
         current_firmware_info[CURR_FW_VER_KEY] = current_fw_version;
-        return m_send_json_callback.Call_Callback(TELEMETRY_TOPIC, current_firmware_info, Helper::Measure_Json(current_firmware_info));
+        return m_client != nullptr && m_client->Send_Json(TELEMETRY_TOPIC, current_firmware_info, Helper::Measure_Json(current_firmware_info));
     }
 
     /// @brief Sends the given firmware state to the cloud.
@@ -174,7 +168,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         StaticJsonDocument<JSON_OBJECT_SIZE(2)> current_firmware_state;
         current_firmware_state[FW_ERROR_KEY] = fw_error;
         current_firmware_state[FW_STATE_KEY] = current_fw_state;
-        return m_send_json_callback.Call_Callback(TELEMETRY_TOPIC, current_firmware_state, Helper::Measure_Json(current_firmware_state));
+        return m_client != nullptr && m_client->Send_Json(TELEMETRY_TOPIC, current_firmware_state, Helper::Measure_Json(current_firmware_state));
     }
 
     API_Process_Type Get_Process_Type() const override {
@@ -182,6 +176,10 @@ class OTA_Firmware_Update : public IAPI_Implementation {
     }
 
     void Process_Response(char const * topic, uint8_t * payload, unsigned int length) override {
+        // Topic router only compares the constant part of the topic, therefore we still have to ensure the response is for the currently ongoing firmware request
+        if (!Compare_Response_Topic(topic)) {
+            return;
+        }
         size_t const & request_id = m_fw_callback.Get_Request_ID();
         char response_topic[Helper::detectSize(FIRMWARE_RESPONSE_TOPIC, request_id)] = {};
         (void)snprintf(response_topic, sizeof(response_topic), FIRMWARE_RESPONSE_TOPIC, request_id);
@@ -197,6 +195,11 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         return strncmp(m_response_topic, topic, strlen(m_response_topic)) == 0;
     }
 
+    char const * Get_Response_Topic(bool & is_prefix) const override {
+        is_prefix = true;
+        return FIRMWARE_RESPONSE_TOPIC_PREFIX;
+    }
+
     bool Unsubscribe() override {
         Stop_Firmware_Update();
         return true;
@@ -213,20 +216,16 @@ class OTA_Firmware_Update : public IAPI_Implementation {
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
     void Initialize() override {
-        m_subscribe_api_callback.Call_Callback(m_fw_attribute_update);
-        m_subscribe_api_callback.Call_Callback(m_fw_attribute_request);
+        if (m_client == nullptr) {
+            return;
+        }
+        m_client->Subscribe_API_Implementation(m_fw_attribute_update);
+        m_client->Subscribe_API_Implementation(m_fw_attribute_request);
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
-        m_subscribe_api_callback.Set_Callback(subscribe_api_callback);
-        m_send_json_callback.Set_Callback(send_json_callback);
-        m_send_json_string_callback.Set_Callback(send_json_string_callback);
-        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
-        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
-        m_get_receive_size_callback.Set_Callback(get_receive_size_callback);
-        m_get_send_size_callback.Set_Callback(get_send_size_callback);
-        m_set_buffer_size_callback.Set_Callback(set_buffer_size_callback);
-        m_get_request_id_callback.Set_Callback(get_request_id_callback);
+    void Set_Client(IThingsBoard_Client & client) override {
+        m_client = &client;
+        m_ota.Set_Timer_Queue(&client.getTimerQueue());
     }
 
   private:
@@ -245,7 +244,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
             return false;
         }
 
-        size_t * p_request_id = m_get_request_id_callback.Call_Callback();
+        size_t * p_request_id = m_client != nullptr ? m_client->getRequestID() : nullptr;
         if (p_request_id == nullptr) {
             Logger::printfln(REQUEST_ID_NULL);
             return false;
@@ -261,7 +260,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
     /// @brief Subscribes to the firmware response topic
     /// @return Whether subscribing to the firmware response topic was successful or not
     bool Firmware_OTA_Subscribe() {
-        if (!m_subscribe_topic_callback.Call_Callback(FIRMWARE_RESPONSE_SUBSCRIBE_TOPIC)) {
+        if (!m_response_subscription.Acquire(m_client)) {
             char message[strlen(SUBSCRIBE_TOPIC_FAILED) + strlen(FIRMWARE_RESPONSE_SUBSCRIBE_TOPIC) + 2] = {};
             (void)snprintf(message, sizeof(message), SUBSCRIBE_TOPIC_FAILED, FIRMWARE_RESPONSE_SUBSCRIBE_TOPIC);
             Logger::printfln(message);
@@ -278,13 +277,13 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         // Buffer size has been set to another value before the update,
         // to allow to receive ota chunck packets that might be much bigger than the normal
         // buffer size would allow, therefore we return to the previous value to decrease overall memory usage
-        if (m_changed_buffer_size) {
-            (void)m_set_buffer_size_callback.Call_Callback(m_previous_buffer_size, m_get_send_size_callback.Call_Callback());
+        if (m_changed_buffer_size && m_client != nullptr) {
+            (void)m_client->setBufferSize(m_previous_buffer_size, m_client->getClientSendBufferSize());
         }
         // Reset now not needed private member variables
         m_fw_callback = OTA_Update_Callback();
         // Unsubscribe from the topic
-        return m_unsubscribe_topic_callback.Call_Callback(FIRMWARE_RESPONSE_SUBSCRIBE_TOPIC);
+        return m_response_subscription.Release(m_client);
     }
 
     /// @brief Publishes a request for the given firmware chunk
@@ -302,7 +301,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
 
         char topic[Helper::detectSize(FIRMWARE_REQUEST_TOPIC, request_id, request_chunck)] = {};
         (void)snprintf(topic, sizeof(topic), FIRMWARE_REQUEST_TOPIC, request_id, request_chunck);
-        return m_send_json_string_callback.Call_Callback(topic, size);
+        return m_client != nullptr && m_client->Send_Json_String(topic, size);
     }
 
     /// @brief Handler if the firmware shared attribute request times out without getting a response.
@@ -396,18 +395,18 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         const uint16_t& chunk_size = m_fw_callback.Get_Chunk_Size();
 
         // Get the previous buffer size and cache it so the previous settings can be restored.
-        m_previous_buffer_size = m_get_receive_size_callback.Call_Callback();
+        m_previous_buffer_size = m_client != nullptr ? m_client->getClientReceiveBufferSize() : 0U;
         m_changed_buffer_size = m_previous_buffer_size < (chunk_size + 50U);
 
         // Increase size of receive buffer
-        if (m_changed_buffer_size && !m_set_buffer_size_callback.Call_Callback(chunk_size + 50U, m_get_send_size_callback.Call_Callback())) {
+        if (m_changed_buffer_size && (m_client == nullptr || !m_client->setBufferSize(chunk_size + 50U, m_client->getClientSendBufferSize()))) {
             Logger::printfln(NOT_ENOUGH_RAM);
             Firmware_Send_State(FW_STATE_FAILED, NOT_ENOUGH_RAM);
             m_fw_callback.Call_Callback(false);
             return;
         }
 
-        m_ota.Start_Firmware_Update(m_fw_callback, fw_size, fw_checksum, fw_checksum_algorithm);
+        m_ota.Start_Firmware_Update(m_fw_callback, fw_title, fw_version, fw_size, fw_checksum, fw_checksum_algorithm);
     }
 
 #if !THINGSBOARD_ENABLE_STL
@@ -452,15 +451,8 @@ class OTA_Firmware_Update : public IAPI_Implementation {
     static OTA_Firmware_Update                                               *m_subscribedInstance;
 #endif // !THINGSBOARD_ENABLE_STL
 
-    Callback<void, IAPI_Implementation &>                                    m_subscribe_api_callback = {};            // Subscribe additional api callback
-    Callback<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};                // Send json document callback
-    Callback<bool, char const * const, char const * const>                   m_send_json_string_callback = {};         // Send json string callback
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};          // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {};        // Unubscribe mqtt topic client callback
-    Callback<uint16_t>                                                       m_get_receive_size_callback = {};         // Get client receive buffer size callback
-    Callback<uint16_t>                                                       m_get_send_size_callback = {};            // Get client send buffer size callback
-    Callback<bool, uint16_t, uint16_t>                                       m_set_buffer_size_callback = {};          // Set client buffer size callback
-    Callback<size_t *>                                                       m_get_request_id_callback = {};           // Get internal request id callback
+    IThingsBoard_Client                                                     *m_client = {};                            // Client the api implementation communicates with the cloud over
+    Subscription_Reference                                                  m_response_subscription = Subscription_Reference(FIRMWARE_RESPONSE_SUBSCRIBE_TOPIC); // Reference to the firmware response topic, acquired while an update is running
 
     OTA_Update_Callback                                                      m_fw_callback = {};                       // OTA update response callback
     uint16_t                                                                 m_previous_buffer_size = {};              // Previous buffer size of the underlying client, used to revert to the previously configured buffer size if it was temporarily increased by the OTA update
@@ -12,9 +12,13 @@
 #include "Helper.h"
 
 // Library includes.
+#include <new>
 #include <string.h>
 
 
+// Size of the buffer on the stack, that the already written firmware binary is read back into in chunks, to hash it again when resuming an interrupted update
+size_t constexpr RESUME_HASH_BUFFER_SIZE = 64U;
+
 // Firmware data keys.
 char constexpr FW_STATE_DOWNLOADING[] = "DOWNLOADING";
 char constexpr FW_STATE_DOWNLOADED[] = "DOWNLOADED";
@@ -25,22 +29,25 @@ char constexpr FW_STATE_UPDATED[] = "UPDATED";
 // Log messages.
 char constexpr OTA_CB_IS_NULL[] = "OTA update callback is NULL, has it been deleted";
 char constexpr UNABLE_TO_REQUEST_CHUNCKS[] = "Unable to request firmware chunk";
-char constexpr RECEIVED_UNEXPECTED_CHUNK[] = "Received chunk (%u), not the same as requested chunk (%u)";
+char constexpr RECEIVED_UNEXPECTED_CHUNK[] = "Received chunk (%u), not inside of the currently requested chunk window (%u - %u)";
 char constexpr RECEIVED_UNEXPECTED_CHUNK_SIZE[] = "Received chunk size (%u), not the same as expected chunk size (%u)";
 char constexpr ERROR_UPDATE_BEGIN[] = "Failed to initalize flash updater, ensure that the partition scheme has two app sections";
 char constexpr ERROR_UPDATE_WRITE[] = "Only wrote (%u) bytes of binary data instead of expected (%u)";
 char constexpr ERROR_UPDATE_END[] = "Error during flash updater not all bytes written";
 char constexpr CHECKSUM_VERIFICATION_FAILED[] = "Calculated checksum (%s), not the same as expected checksum (%s)";
 char constexpr FW_UPDATE_ABORTED[] = "Firmware update aborted";
+char constexpr UNABLE_TO_ALLOCATE_CHUNK_WINDOW[] = "Failed to allocate (%u) bytes for the chunk window, decrease the chunk window or chunk size";
+char constexpr UNABLE_TO_STORE_CHECKPOINT[] = "Failed to store checkpoint of the firmware update after chunk (%u)";
+char constexpr UNABLE_TO_RESUME_UPDATE[] = "Failed to resume firmware update at chunk (%u), restarting from the first chunk";
 char constexpr CHUNK_REQUEST_TIMED_OUT[] = "Failed to receive requested chunk (%u) in (%llu) us. Internet connection might have been lost";
 #if THINGSBOARD_ENABLE_DEBUG
 char constexpr FW_CHUNK[] = "Receive chunk (%u), with size (%u) bytes";
+char constexpr RESUMING_UPDATE[] = "Resuming firmware update at chunk (%u) of (%u)";
+char constexpr FW_CHUNK_BUFFERED[] = "Buffered chunk (%u), waiting for chunk (%u) to be received first";
 char constexpr HASH_EXPECTED[] = "Expected checksum: (%s)";
 char constexpr CHECKSUM_VERIFICATION_SUCCESS[] = "Checksum is the same as expected";
 char constexpr FW_UPDATE_SUCCESS[] = "Update success";
 #endif // THINGSBOARD_ENABLE_DEBUG
-// Maximum size consists of size required for byte representation of the hash * 2 because every byte is 2 hex characters + 1 for null termination
-size_t constexpr FIRMWARE_HASH_SIZE = (MBEDTLS_MD_MAX_SIZE * 2U) + 1;
 
 
 /// @brief Handles the complete processing of received binary firmware data, including flashing it onto the device,
@@ -64,25 +71,44 @@ class OTA_Handler {
       , m_hash()
       , m_total_chunks(0U)
       , m_requested_chunks(0U)
+      , m_next_request_chunk(0U)
       , m_retries(0U)
+      , m_window_size(0U)
+      , m_window(nullptr)
+      , m_window_buffer(nullptr)
+      , m_checkpoint()
       , m_watchdog(std::bind(&OTA_Handler::Handle_Request_Timeout, this))
+      , m_timer_queue(nullptr)
     {
         // Nothing to do
     }
 
+    /// @brief Destructor
+    ~OTA_Handler() {
+        Free_Chunk_Window();
+    }
+
     /// @brief Starts the firmware update with requesting the first firmware packet and initalizes the underlying needed components
+    /// If a checkpoint storage has been configured and it contains the progress of a previously interrupted download of the same firmware binary, the update is instead resumed from that checkpoint
     /// @param fw_callback Callback method that contains configuration information, about the over the air update
+    /// @param fw_title Title of the firmware binary that will be downloaded, used to decide if a stored checkpoint belongs to the same firmware binary
+    /// @param fw_version Version of the firmware binary that will be downloaded, used to decide if a stored checkpoint belongs to the same firmware binary
     /// @param fw_size Complete size of the firmware binary that will be downloaded and flashed onto this device
     /// @param fw_checksum Checksum of the complete firmware binary, should be the same as the actually written data in the end
     /// @param fw_checksum_algorithm Algorithm type used to hash the firmware binary
-    void Start_Firmware_Update(OTA_Update_Callback const & fw_callback, size_t const & fw_size, char const * fw_checksum, mbedtls_md_type_t const & fw_checksum_algorithm) {
+    void Start_Firmware_Update(OTA_Update_Callback const & fw_callback, char const * fw_title, char const * fw_version, size_t const & fw_size, char const * fw_checksum, mbedtls_md_type_t const & fw_checksum_algorithm) {
         m_fw_callback = &fw_callback;
         m_fw_size = fw_size;
         m_total_chunks = (m_fw_size / m_fw_callback->Get_Chunk_Size()) + 1U;
         (void)strncpy(m_fw_checksum, fw_checksum, sizeof(m_fw_checksum));
         m_fw_checksum_algorithm = fw_checksum_algorithm;
         m_fw_updater = m_fw_callback->Get_Updater();
-        Request_First_Firmware_Packet();
+        if (!Allocate_Chunk_Window()) {
+            return;
+        }
+        if (!Resume_Firmware_Update(fw_title, fw_version)) {
+            Request_First_Firmware_Packet();
+        }
         (void)m_send_fw_state_callback.Call_Callback(FW_STATE_DOWNLOADING, "");
     }
 
@@ -98,41 +124,186 @@ class OTA_Handler {
     }
 
     /// @brief Uses the given firmware packet data and process it. Starting with writing the given amount of bytes of the packet data into flash memory and
-    /// into a hash function that will be used to compare the expected complete binary file and the actually received binary file
+    /// into a hash function that will be used to compare the expected complete binary file and the actually received binary file.
+    /// If the received chunk is not the next one that has to be written, because a previous chunk inside of the requested window is still missing,
+    /// the packet data is instead copied into the chunk window and only written once all preceding chunks have been received
     /// @param current_chunk Index of the chunk we recieved the binary data for
     /// @param payload Firmware packet data of the current chunk
     /// @param total_bytes Amount of bytes in the current firmware packet data
     void Process_Firmware_Packet(size_t const & current_chunk, uint8_t * payload, size_t const & total_bytes)  {
-        if (current_chunk != m_requested_chunks) {
-            Logger::printfln(RECEIVED_UNEXPECTED_CHUNK, current_chunk, m_requested_chunks);
+        if (current_chunk < m_requested_chunks || current_chunk >= m_next_request_chunk) {
+            Logger::printfln(RECEIVED_UNEXPECTED_CHUNK, current_chunk, m_requested_chunks, m_next_request_chunk);
             return;
         }
         size_t expected_chunk_size = 0U;
-        if (!Received_Valid_Chunk_Size(total_bytes, expected_chunk_size)) {
+        if (!Received_Valid_Chunk_Size(current_chunk, total_bytes, expected_chunk_size)) {
             Logger::printfln(RECEIVED_UNEXPECTED_CHUNK_SIZE, expected_chunk_size, total_bytes);
             return;
         }
 
-        m_watchdog.detach();
     #if THINGSBOARD_ENABLE_DEBUG
         Logger::printfln(FW_CHUNK, current_chunk, total_bytes);
     #endif // THINGSBOARD_ENABLE_DEBUG
 
+        if (current_chunk != m_requested_chunks) {
+            Buffer_Firmware_Packet(current_chunk, payload, total_bytes);
+            return;
+        }
+
+        m_watchdog.detach();
+        if (!Write_Firmware_Packet(current_chunk, payload, total_bytes)) {
+            return;
+        }
+
+        // Write any chunks that arrived out of order and were waiting for the chunk that has just been written
+        while (m_requested_chunks < m_next_request_chunk) {
+            Chunk_Slot & slot = Get_Chunk_Slot(m_requested_chunks);
+            if (!slot.received) {
+                break;
+            }
+            slot.received = false;
+            if (!Write_Firmware_Packet(m_requested_chunks, slot.payload, slot.size)) {
+                return;
+            }
+        }
+
+        Request_Next_Firmware_Packet();
+    }
+
+    /// @brief Sets the queue the timeout of the outstanding chunk requests is scheduled in, instead of using the internal timer of the watchdog.
+    /// Additionally the time the chunks were requested at is read from the clock of the queue
+    /// @param timer_queue Queue the timeout should be scheduled in, nullptr to use the internal timer of the watchdog instead
+    void Set_Timer_Queue(Timer_Queue * timer_queue) {
+        m_watchdog.detach();
+        m_timer_queue = timer_queue;
+    }
+
+#if !THINGSBOARD_USE_ESP_TIMER
+    /// @brief Used to update the watchdog timer which uses a simple software time in the background. Ensure to call recently often for higher precision.
+    /// Meaning the timer is actually triggered closer to the specified waiting time
+    void update() {
+        m_watchdog.update();
+    }
+#endif // !THINGSBOARD_USE_ESP_TIMER
+
+  private:
+    /// @brief Bookkeeping of a single chunk inside of the chunk window, that has been requested but not written yet
+    struct Chunk_Slot {
+        uint64_t request_time = {}; // Point in time the chunk has last been requested at, used to decide if the request timed out
+        uint8_t  *payload = {};     // Memory the chunk is buffered in if it arrives out of order, only allocated if the window is bigger than 1
+        size_t   size = {};         // Amount of bytes of the buffered chunk
+        bool     received = {};     // Whether the chunk has been received and buffered but not written yet
+    };
+
+    /// @brief Checks whether the received chunk size matches the expected chunk size, should be the configured chunk size of the OTA_Update_Callback, CHUNK_SIZE (4096) per default
+    /// and it should be the remaining bytes to fill the total firmware size with the last received chunk. If that is not the case then something went wrong with the request and we have to rerequest that specific chunk,
+    /// because if we do not do that we would write missing or only partial binary data to flash and into the hash, meaning the complete OTA update will be invalidated at the end and has to be restarted
+    /// @param current_chunk Index of the chunk we received the binary data for
+    /// @param received_chunk_size Size in bytes of the received chunk
+    /// @param expected_chunk_size Variable the expected chunk size for the currently requested chunk will be copied into
+    /// @return Whether the received chunk has the expected size or not
+    bool Received_Valid_Chunk_Size(size_t const & current_chunk, size_t const & received_chunk_size, size_t & expected_chunk_size) {
+        bool const is_last_chunk = current_chunk + 1 >= m_total_chunks;
+        if (is_last_chunk) {
+            size_t const last_chunk_expected_size = m_fw_size % m_fw_callback->Get_Chunk_Size();
+            expected_chunk_size = last_chunk_expected_size;
+            return received_chunk_size == last_chunk_expected_size;
+        }
+        expected_chunk_size = m_fw_callback->Get_Chunk_Size();
+        return received_chunk_size == m_fw_callback->Get_Chunk_Size();
+    }
+
+    /// @brief Allocates the chunk window, which keeps track of all chunks that have been requested but not written yet.
+    /// The additional memory to buffer chunks that arrive out of order is only allocated if more than one chunk is requested at the same time
+    /// @return Whether allocating the chunk window was successful or not, if it was not the update has already been marked as failed
+    bool Allocate_Chunk_Window() {
+        Free_Chunk_Window();
+        m_window_size = m_fw_callback->Get_Chunk_Window() > 0U ? m_fw_callback->Get_Chunk_Window() : 1U;
+        size_t const buffer_size = m_window_size > 1U ? m_window_size * m_fw_callback->Get_Chunk_Size() : 0U;
+        // Allocated without exceptions, because they are disabled on most devices and a failed allocation has to fail the update instead of aborting
+        m_window = new (std::nothrow) Chunk_Slot[m_window_size]();
+        if (m_window != nullptr && buffer_size != 0U) {
+            m_window_buffer = new (std::nothrow) uint8_t[buffer_size];
+        }
+
+        if (m_window == nullptr || (buffer_size != 0U && m_window_buffer == nullptr)) {
+            char message[Helper::detectSize(UNABLE_TO_ALLOCATE_CHUNK_WINDOW, static_cast<unsigned int>(buffer_size))] = {};
+            (void)snprintf(message, sizeof(message), UNABLE_TO_ALLOCATE_CHUNK_WINDOW, static_cast<unsigned int>(buffer_size));
+            Logger::printfln(message);
+            Free_Chunk_Window();
+            m_retries = 0U;
+            Handle_Failure(OTA_Failure_Response::RETRY_NOTHING, message);
+            return false;
+        }
+
+        for (size_t i = 0U; m_window_buffer != nullptr && i < m_window_size; i++) {
+            m_window[i].payload = m_window_buffer + (i * m_fw_callback->Get_Chunk_Size());
+        }
+        return true;
+    }
+
+    /// @brief Releases the memory of the chunk window and stops any ongoing request timeout,
+    /// called once the update has either finished or failed so that no memory remains reserved while no update is ongoing
+    void Free_Chunk_Window() {
+        m_watchdog.detach();
+        delete[] m_window;
+        m_window = nullptr;
+        delete[] m_window_buffer;
+        m_window_buffer = nullptr;
+        m_window_size = 0U;
+        // Ensure no further chunks are accepted, because they are not inside of the requested window anymore
+        m_next_request_chunk = m_requested_chunks;
+    }
+
+    /// @brief Gets the slot in the chunk window that is used to keep track of the given chunk,
+    /// all chunks inside of the window are guaranteed to use different slots, because the window never contains more than m_window_size consecutive chunks
+    /// @param chunk Index of the chunk we want to get the slot for
+    /// @return Slot in the chunk window for the given chunk
+    Chunk_Slot & Get_Chunk_Slot(size_t const & chunk) {
+        return m_window[chunk % m_window_size];
+    }
+
+    /// @brief Copies the given firmware packet data into the chunk window, so it can be written once all preceding chunks have been received and written
+    /// @param current_chunk Index of the chunk we recieved the binary data for
+    /// @param payload Firmware packet data of the current chunk
+    /// @param total_bytes Amount of bytes in the current firmware packet data
+    void Buffer_Firmware_Packet(size_t const & current_chunk, uint8_t const * payload, size_t const & total_bytes) {
+        Chunk_Slot & slot = Get_Chunk_Slot(current_chunk);
+        // Chunk might be received twice if the response arrived after the request already timed out and was therefore sent again
+        if (slot.received || slot.payload == nullptr) {
+            return;
+        }
+        (void)memcpy(slot.payload, payload, total_bytes);
+        slot.size = total_bytes;
+        slot.received = true;
+    #if THINGSBOARD_ENABLE_DEBUG
+        Logger::printfln(FW_CHUNK_BUFFERED, current_chunk, m_requested_chunks);
+    #endif // THINGSBOARD_ENABLE_DEBUG
+    }
+
+    /// @brief Writes the given firmware packet data into flash memory and into the hash function and informs the user about the increased progress
+    /// @param current_chunk Index of the chunk we want to write the binary data for, has to be the chunk directly following the previously written chunk
+    /// @param payload Firmware packet data of the current chunk
+    /// @param total_bytes Amount of bytes in the current firmware packet data
+    /// @return Whether writing was successful and the update can be continued, if it was not the failure has already been handled
+    bool Write_Firmware_Packet(size_t const & current_chunk, uint8_t * payload, size_t const & total_bytes) {
         if (current_chunk == 0U) {
             // Initialize Flash
             if (!m_fw_updater->begin(m_fw_size)) {
                 Logger::printfln(ERROR_UPDATE_BEGIN);
-                return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_UPDATE_BEGIN);
+                Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_UPDATE_BEGIN);
+                return false;
             }
         }
 
         // Write received binary data to flash partition
         size_t const written_bytes = m_fw_updater->write(payload, total_bytes);
         if (written_bytes != total_bytes) {
-            char message[Helper::detectSize(ERROR_UPDATE_WRITE, written_bytes, total_bytes)] = {};
-            (void)snprintf(message, sizeof(message), ERROR_UPDATE_WRITE, written_bytes, total_bytes);
+            char message[Helper::detectSize(ERROR_UPDATE_WRITE, static_cast<unsigned int>(written_bytes), static_cast<unsigned int>(total_bytes))] = {};
+            (void)snprintf(message, sizeof(message), ERROR_UPDATE_WRITE, static_cast<unsigned int>(written_bytes), static_cast<unsigned int>(total_bytes));
             Logger::printfln(message);
-            return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, message);
+            Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, message);
+            return false;
         }
 
         // Update value only if writing to flash was a success, result is ignored,
@@ -146,69 +317,215 @@ class OTA_Handler {
         // if it was the callback variable was reset and there is no need to request the next firmware packet
         if (m_fw_callback == nullptr) {
             Logger::printfln(OTA_CB_IS_NULL);
-            return Handle_Failure(OTA_Failure_Response::RETRY_NOTHING, OTA_CB_IS_NULL);
+            Handle_Failure(OTA_Failure_Response::RETRY_NOTHING, OTA_CB_IS_NULL);
+            return false;
         }
 
         // Reset retries as the current chunk has been downloaded and handled successfully
         m_retries = m_fw_callback->Get_Chunk_Retries();
+        uint16_t const checkpoint_interval = m_fw_callback->Get_Checkpoint_Interval() > 0U ? m_fw_callback->Get_Checkpoint_Interval() : 1U;
+        if (m_requested_chunks % checkpoint_interval == 0U && m_requested_chunks < m_total_chunks) {
+            Store_Checkpoint();
+        }
+        return true;
+    }
+
+    /// @brief Attempts to resume a previously interrupted download of the same firmware binary, from the checkpoint persisted in the configured storage.
+    /// Additionally prepares the checkpoint of the new update, so that it can be stored with each checkpoint interval
+    /// @param fw_title Title of the firmware binary that will be downloaded
+    /// @param fw_version Version of the firmware binary that will be downloaded
+    /// @return Whether the update has been resumed and the next chunks have been requested, if it was not the update has to be started from the first chunk instead
+    bool Resume_Firmware_Update(char const * fw_title, char const * fw_version) {
+        IOTA_Checkpoint_Storage * checkpoint_storage = m_fw_callback->Get_Checkpoint_Storage();
+        if (checkpoint_storage == nullptr) {
+            return false;
+        }
+
+        m_checkpoint = OTA_Checkpoint();
+        (void)strncpy(m_checkpoint.fw_title, fw_title, sizeof(m_checkpoint.fw_title) - 1U);
+        (void)strncpy(m_checkpoint.fw_version, fw_version, sizeof(m_checkpoint.fw_version) - 1U);
+        (void)strncpy(m_checkpoint.fw_checksum, m_fw_checksum, sizeof(m_checkpoint.fw_checksum) - 1U);
+        m_checkpoint.fw_checksum_algorithm = m_fw_checksum_algorithm;
+        m_checkpoint.fw_size = static_cast<uint32_t>(m_fw_size);
+        m_checkpoint.chunk_size = m_fw_callback->Get_Chunk_Size();
+
+        OTA_Checkpoint stored_checkpoint = {};
+        if (!checkpoint_storage->load(stored_checkpoint) || !Is_Same_Firmware(stored_checkpoint) || stored_checkpoint.written_chunks == 0U || stored_checkpoint.written_chunks >= m_total_chunks) {
+            return false;
+        }
+
+        size_t const written_chunks = stored_checkpoint.written_chunks;
+        m_watchdog.detach();
+        if (!m_fw_updater->resume(m_fw_size, written_chunks * m_checkpoint.chunk_size) || !Hash_Written_Firmware(written_chunks * m_checkpoint.chunk_size)) {
+            Logger::printfln(UNABLE_TO_RESUME_UPDATE, written_chunks);
+            return false;
+        }
+
+    #if THINGSBOARD_ENABLE_DEBUG
+        Logger::printfln(RESUMING_UPDATE, written_chunks, m_total_chunks);
+    #endif // THINGSBOARD_ENABLE_DEBUG
+        m_requested_chunks = written_chunks;
+        m_next_request_chunk = written_chunks;
+        m_retries = m_fw_callback->Get_Chunk_Retries();
+        for (size_t i = 0U; i < m_window_size; i++) {
+            m_window[i].received = false;
+        }
+        m_fw_callback->Call_Progress_Callback(m_requested_chunks, m_total_chunks);
         Request_Next_Firmware_Packet();
+        return true;
     }
 
-#if !THINGSBOARD_USE_ESP_TIMER
-    /// @brief Used to update the watchdog timer which uses a simple software time in the background. Ensure to call recently often for higher precision.
-    /// Meaning the timer is actually triggered closer to the specified waiting time
-    void update() {
-        m_watchdog.update();
+    /// @brief Restarts the hash calculation and adds the data that has already been written before the update was interrupted, by reading it back from the updater.
+    /// Is done instead of persisting the state of the hash calculation, because that state is internal to Mbed TLS and might even be held by a hardware accelerator
+    /// @param written_bytes Amount of bytes that have already been written by the updater
+    /// @return Whether all written bytes could be read back and hashed or not, if they could not the update has to be started from the first chunk instead
+    bool Hash_Written_Firmware(size_t const & written_bytes) {
+        if (!m_hash.start(m_fw_checksum_algorithm)) {
+            return false;
+        }
+        uint8_t buffer[RESUME_HASH_BUFFER_SIZE] = {};
+        for (size_t offset = 0U; offset < written_bytes; offset += sizeof(buffer)) {
+            size_t const length = written_bytes - offset < sizeof(buffer) ? written_bytes - offset : sizeof(buffer);
+            if (m_fw_updater->read(offset, buffer, length) != length || !m_hash.update(buffer, length)) {
+                return false;
+            }
+        }
+        return true;
     }
-#endif // !THINGSBOARD_USE_ESP_TIMER
 
-  private:
-    /// @brief Checks whether the received chunk size matches the expected chunk size, should be the configured chunk size of the OTA_Update_Callback, CHUNK_SIZE (4096) per default
-    /// and it should be the remaining bytes to fill the total firmware size with the last received chunk. If that is not the case then something went wrong with the request and we have to rerequest that specific chunk,
-    /// because if we do not do that we would write missing or only partial binary data to flash and into the hash, meaning the complete OTA update will be invalidated at the end and has to be restarted
-    /// @param received_chunk_size Size in bytes of the received chunk
-    /// @param expected_chunk_size Variable the expected chunk size for the currently requested chunk will be copied into
-    /// @return Whether the received chunk has the expected size or not
-    bool Received_Valid_Chunk_Size(size_t const & received_chunk_size, size_t & expected_chunk_size) {
-        bool const is_last_chunk = m_requested_chunks + 1 >= m_total_chunks;
-        if (is_last_chunk) {
-            size_t const last_chunk_expected_size = m_fw_size % m_fw_callback->Get_Chunk_Size();
-            expected_chunk_size = last_chunk_expected_size;
-            return received_chunk_size == last_chunk_expected_size;
+    /// @brief Checks whether the given stored checkpoint belongs to the same firmware binary as the currently started update
+    /// @param stored_checkpoint Checkpoint that has been read from the configured storage
+    /// @return Whether the stored checkpoint can be used to resume the currently started update
+    bool Is_Same_Firmware(OTA_Checkpoint const & stored_checkpoint) const {
+        return strncmp(stored_checkpoint.fw_title, m_checkpoint.fw_title, sizeof(m_checkpoint.fw_title)) == 0
+            && strncmp(stored_checkpoint.fw_version, m_checkpoint.fw_version, sizeof(m_checkpoint.fw_version)) == 0
+            && strncmp(stored_checkpoint.fw_checksum, m_checkpoint.fw_checksum, sizeof(m_checkpoint.fw_checksum)) == 0
+            && stored_checkpoint.fw_checksum_algorithm == m_checkpoint.fw_checksum_algorithm
+            && stored_checkpoint.fw_size == m_checkpoint.fw_size
+            && stored_checkpoint.chunk_size == m_checkpoint.chunk_size;
+    }
+
+    /// @brief Persists the amount of already written chunks into the configured storage,
+    /// has to be called directly after a chunk has been written, so that the persisted state is consistent with the data written by the updater
+    void Store_Checkpoint() {
+        IOTA_Checkpoint_Storage * checkpoint_storage = m_fw_callback->Get_Checkpoint_Storage();
+        if (checkpoint_storage == nullptr) {
+            return;
         }
-        expected_chunk_size = m_fw_callback->Get_Chunk_Size();
-        return received_chunk_size == m_fw_callback->Get_Chunk_Size();
+
+        m_checkpoint.written_chunks = static_cast<uint32_t>(m_requested_chunks);
+        if (!checkpoint_storage->store(m_checkpoint)) {
+            Logger::printfln(UNABLE_TO_STORE_CHECKPOINT, m_requested_chunks);
+        }
+    }
+
+    /// @brief Removes any checkpoint persisted into the configured storage, because the update has either been finished or has to be restarted from the first chunk
+    void Erase_Checkpoint() {
+        IOTA_Checkpoint_Storage * checkpoint_storage = m_fw_callback->Get_Checkpoint_Storage();
+        if (checkpoint_storage == nullptr) {
+            return;
+        }
+        checkpoint_storage->erase();
     }
 
-    /// @brief Restarts or starts the firmware update and its needed components and then requests the first firmware chunk
+    /// @brief Restarts or starts the firmware update and its needed components and then requests the first firmware chunks
     void Request_First_Firmware_Packet()  {
         m_requested_chunks = 0U;
+        m_next_request_chunk = 0U;
         m_retries = m_fw_callback->Get_Chunk_Retries();
+        for (size_t i = 0U; i < m_window_size; i++) {
+            m_window[i].received = false;
+        }
         // Hash start result is ignored, because it can only fail if the input parameters are invalid
         (void)m_hash.start(m_fw_checksum_algorithm);
         m_watchdog.detach();
         m_fw_updater->reset();
+        Erase_Checkpoint();
         Request_Next_Firmware_Packet();
     }
 
-    /// @brief Requests the next firmware chunk of the OTA firmware if there are any left
-    /// and starts the timer that ensures we request the same chunk again if we have not received a response yet
+    /// @brief Requests the next firmware chunks of the OTA firmware if there are any left, until the chunk window is filled
+    /// and starts the timer that ensures we request the same chunks again if we have not received a response yet
     void Request_Next_Firmware_Packet()  {
         // Check if we have already requested and handled the last remaining chunk
         if (m_requested_chunks >= m_total_chunks) {
-            Finish_Firmware_Update();   
+            m_watchdog.detach();
+            Finish_Firmware_Update();
             return;
         }
 
-        if (!m_publish_callback.Call_Callback(m_fw_callback->Get_Request_ID(), m_requested_chunks)) {
-            Logger::printfln(UNABLE_TO_REQUEST_CHUNCKS);
+        for (; m_next_request_chunk < m_total_chunks && m_next_request_chunk < m_requested_chunks + m_window_size; m_next_request_chunk++) {
+            Chunk_Slot & slot = Get_Chunk_Slot(m_next_request_chunk);
+            slot.received = false;
+            Publish_Firmware_Packet_Request(m_next_request_chunk, slot);
         }
 
-        // Watchdog gets started no matter if publishing request was successful or not in hopes,
-        // that after the given timeout the callback calls this method again and can then publish the request successfully.
+        Start_Request_Timeout();
+    }
+
+    /// @brief Publishes the request for the given firmware chunk and remembers when it has been sent, so it can be requested again if it times out
+    /// @param chunk Index of the chunk that should be requested from the server
+    /// @param slot Slot in the chunk window that keeps track of the given chunk
+    void Publish_Firmware_Packet_Request(size_t const & chunk, Chunk_Slot & slot) {
+        // Request time gets updated no matter if publishing request was successful or not in hopes,
+        // that after the given timeout the watchdog calls the timeout handler and the request can then be published successfully.
         // This works because the request fails most of the time, because the internet connection might have been temporarily disconnected.
         // Therefore waiting a while and then retrying, means we might be reconnected again
-        m_watchdog.once(m_fw_callback->Get_Timeout());
+        slot.request_time = now();
+        if (!m_publish_callback.Call_Callback(m_fw_callback->Get_Request_ID(), chunk)) {
+            Logger::printfln(UNABLE_TO_REQUEST_CHUNCKS);
+        }
+    }
+
+    /// @brief Gets the time in microseconds that passed since the given chunk slot has been requested.
+    /// If the underlying clock overflowed in the meantime, the request is simply handled as if it timed out
+    /// @param slot Slot in the chunk window that keeps track of the requested chunk
+    /// @return Time in microseconds since the chunk has been requested
+    uint64_t Get_Elapsed_Request_Time(Chunk_Slot const & slot) const {
+        uint64_t const current_time = now();
+        return current_time >= slot.request_time ? current_time - slot.request_time : m_fw_callback->Get_Timeout();
+    }
+
+    /// @brief Starts the watchdog so that it times out once the oldest still outstanding chunk request times out
+    void Start_Request_Timeout() {
+        m_watchdog.detach();
+        uint64_t const & timeout = m_fw_callback->Get_Timeout();
+        uint64_t remaining_time = timeout;
+        for (size_t chunk = m_requested_chunks; chunk < m_next_request_chunk; chunk++) {
+            Chunk_Slot const & slot = Get_Chunk_Slot(chunk);
+            if (slot.received) {
+                continue;
+            }
+            uint64_t const elapsed_time = Get_Elapsed_Request_Time(slot);
+            uint64_t const slot_remaining_time = elapsed_time >= timeout ? 0U : timeout - elapsed_time;
+            remaining_time = slot_remaining_time < remaining_time ? slot_remaining_time : remaining_time;
+        }
+        // Ensure the timer is not started with a timeout of 0, because that might cause the callback to never be called
+        remaining_time = remaining_time > 0U ? remaining_time : 1U;
+        if (m_timer_queue != nullptr) {
+            m_watchdog.once(*m_timer_queue, remaining_time);
+            return;
+        }
+        m_watchdog.once(remaining_time);
+    }
+
+    /// @brief Gets the current time of the clock used to timeout the chunk requests, which is the clock of the timer queue if one has been set
+    /// @return Current time in microseconds
+    uint64_t now() const {
+        return m_timer_queue != nullptr ? m_timer_queue->now() : Callback_Watchdog::now();
+    }
+
+    /// @brief Requests all outstanding chunks inside of the chunk window again, that did not receive a response in the configured timeout time
+    void Request_Timed_Out_Firmware_Packets() {
+        uint64_t const & timeout = m_fw_callback->Get_Timeout();
+        for (size_t chunk = m_requested_chunks; chunk < m_next_request_chunk; chunk++) {
+            Chunk_Slot & slot = Get_Chunk_Slot(chunk);
+            if (slot.received || Get_Elapsed_Request_Time(slot) < timeout) {
+                continue;
+            }
+            Publish_Firmware_Packet_Request(chunk, slot);
+        }
+        Start_Request_Timeout();
     }
 
     /// @brief Completes the firmware update, which consists of checking the complete hash of the firmware binary if the initally received value,
@@ -242,6 +559,8 @@ class OTA_Handler {
         Logger::printfln(FW_UPDATE_SUCCESS);
     #endif // THINGSBOARD_ENABLE_DEBUG
 
+        Free_Chunk_Window();
+        Erase_Checkpoint();
         (void)m_send_fw_state_callback.Call_Callback(FW_STATE_UPDATING, "");
         m_fw_callback->Call_Callback(true);
         (void)m_finish_callback.Call_Callback();
@@ -253,6 +572,7 @@ class OTA_Handler {
     /// @param error_message Error message that should be printed if we abort the update
     void Handle_Failure(OTA_Failure_Response const & failure_response, char const * error_message)  {
         if (m_retries <= 0) {
+            Free_Chunk_Window();
             (void)m_send_fw_state_callback.Call_Callback(FW_STATE_FAILED, error_message);
             m_fw_callback->Call_Callback(false);
             (void)m_finish_callback.Call_Callback();
@@ -265,12 +585,13 @@ class OTA_Handler {
 
         switch (failure_response) {
             case OTA_Failure_Response::RETRY_CHUNK:
-                Request_Next_Firmware_Packet();
+                Request_Timed_Out_Firmware_Packets();
                 break;
             case OTA_Failure_Response::RETRY_UPDATE:
                 Request_First_Firmware_Packet();
                 break;
             case OTA_Failure_Response::RETRY_NOTHING:
+                Free_Chunk_Window();
                 (void)m_send_fw_state_callback.Call_Callback(FW_STATE_FAILED, error_message);
                 m_fw_callback->Call_Callback(false);
                 (void)m_finish_callback.Call_Callback();
@@ -284,8 +605,13 @@ class OTA_Handler {
     /// @brief Callback that will be called if we did not receive the firmware chunk response in the given timeout time
     void Handle_Request_Timeout()  {
         uint64_t const & timeout = m_fw_callback->Get_Timeout();
-        char message[Helper::detectSize(CHUNK_REQUEST_TIMED_OUT, m_requested_chunks, timeout)] = {};
-        (void)snprintf(message, sizeof(message), CHUNK_REQUEST_TIMED_OUT, m_requested_chunks, timeout);
+        // Report the oldest chunk inside of the window that has not been received yet, because it is the one blocking any further progress
+        size_t timed_out_chunk = m_requested_chunks;
+        while (timed_out_chunk + 1U < m_next_request_chunk && Get_Chunk_Slot(timed_out_chunk).received) {
+            timed_out_chunk++;
+        }
+        char message[Helper::detectSize(CHUNK_REQUEST_TIMED_OUT, static_cast<unsigned int>(timed_out_chunk), static_cast<unsigned long long>(timeout))] = {};
+        (void)snprintf(message, sizeof(message), CHUNK_REQUEST_TIMED_OUT, static_cast<unsigned int>(timed_out_chunk), static_cast<unsigned long long>(timeout));
         Logger::printfln(message);
         Handle_Failure(OTA_Failure_Response::RETRY_CHUNK, message);
     }
@@ -300,9 +626,15 @@ class OTA_Handler {
     IUpdater                                               *m_fw_updater = {};                     // Interface implementation that writes received firmware binary data onto the given device
     HashGenerator                                          m_hash = {};                            // Class instance that allows to generate a hash from received firmware binary data
     size_t                                                 m_total_chunks = {};                    // Total amount of chunks that need to be received to get the complete firmware binary
-    size_t                                                 m_requested_chunks = {};                // Amount of successfully requested and received firmware binary chunks
+    size_t                                                 m_requested_chunks = {};                // Amount of successfully requested, received and written firmware binary chunks
+    size_t                                                 m_next_request_chunk = {};              // Index of the next firmware binary chunk that has not been requested yet, all chunks between the written and this chunk are outstanding
     uint8_t                                                m_retries = {};                         // Amount of request retries we attempt for each chunk, increasing makes the connection more stable
+    size_t                                                 m_window_size = {};                     // Maximum amount of chunks that are requested at the same time without having received a response yet
+    Chunk_Slot                                             *m_window = {};                         // Slots keeping track of each outstanding chunk inside of the window, indexed by the chunk index modulo the window size
+    uint8_t                                                *m_window_buffer = {};                  // Memory used to buffer chunks that arrive out of order, split evenly between all slots
+    OTA_Checkpoint                                         m_checkpoint = {};                      // Progress of the ongoing update, persisted into the configured checkpoint storage with each checkpoint interval
     Callback_Watchdog                                      m_watchdog = {};                        // Class instances that allows to timeout if we do not receive a response for a requested chunk in the given time
+    Timer_Queue                                            *m_timer_queue = {};                    // Optional queue the watchdog is scheduled in instead of using its internal timer
 };
 
 #endif // OTA_Handler_h
@@ -1,7 +1,7 @@
 // Header include.
 #include "OTA_Update_Callback.h"
 
-OTA_Update_Callback::OTA_Update_Callback(char const * current_fw_title, char const * current_fw_version, IUpdater * updater, function finished_callback, Callback<void, size_t const &, size_t const &>::function progress_callback, Callback<void>::function update_starting_callback, uint8_t chunk_retries, uint16_t chunk_size, uint64_t const & timeout_microseconds)
+OTA_Update_Callback::OTA_Update_Callback(char const * current_fw_title, char const * current_fw_version, IUpdater * updater, function finished_callback, Callback<void, size_t const &, size_t const &>::function progress_callback, Callback<void>::function update_starting_callback, uint8_t chunk_retries, uint16_t chunk_size, uint64_t const & timeout_microseconds, uint8_t chunk_window)
   : Callback(finished_callback)
   , m_current_fw_title(current_fw_title)
   , m_current_fw_version(current_fw_version)
@@ -11,6 +11,9 @@ OTA_Update_Callback::OTA_Update_Callback(char const * current_fw_title, char con
   , m_chunk_retries(chunk_retries)
   , m_chunk_size(chunk_size)
   , m_timeout_microseconds(timeout_microseconds)
+  , m_chunk_window(chunk_window)
+  , m_checkpoint_storage(nullptr)
+  , m_checkpoint_interval(CHECKPOINT_INTERVAL)
 {
     // Nothing to do
 }
@@ -86,3 +89,27 @@ uint64_t const & OTA_Update_Callback::Get_Timeout() const {
 void OTA_Update_Callback::Set_Timeout(const uint64_t & timeout_microseconds) {
     m_timeout_microseconds = timeout_microseconds;
 }
+
+uint8_t OTA_Update_Callback::Get_Chunk_Window() const {
+    return m_chunk_window;
+}
+
+void OTA_Update_Callback::Set_Chunk_Window(uint8_t chunk_window) {
+    m_chunk_window = chunk_window;
+}
+
+IOTA_Checkpoint_Storage * OTA_Update_Callback::Get_Checkpoint_Storage() const {
+    return m_checkpoint_storage;
+}
+
+void OTA_Update_Callback::Set_Checkpoint_Storage(IOTA_Checkpoint_Storage * checkpoint_storage) {
+    m_checkpoint_storage = checkpoint_storage;
+}
+
+uint16_t OTA_Update_Callback::Get_Checkpoint_Interval() const {
+    return m_checkpoint_interval;
+}
+
+void OTA_Update_Callback::Set_Checkpoint_Interval(uint16_t checkpoint_interval) {
+    m_checkpoint_interval = checkpoint_interval;
+}
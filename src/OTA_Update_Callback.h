@@ -6,12 +6,15 @@
 
 // Local includes.
 #include "IUpdater.h"
+#include "IOTA_Checkpoint_Storage.h"
 
 
 // OTA default values.
 uint8_t constexpr CHUNK_RETRIES = 12U;
 uint16_t constexpr CHUNK_SIZE = (4U * 1024U);
 uint64_t constexpr REQUEST_TIMEOUT = (5U * 1000U * 1000U);
+uint8_t constexpr CHUNK_WINDOW = 1U;
+uint16_t constexpr CHECKPOINT_INTERVAL = 16U;
 
 
 /// @brief Over the air firmware update callback wrapper,
@@ -45,7 +48,10 @@ class OTA_Update_Callback : public Callback<void, bool const &> {
     // because the whole chunk is saved into the heap before it can be processed and is then erased again after it has been used, default = CHUNK_SIZE
     /// @param timeout Maximum amount of time in microseconds for the OTA firmware update for each seperate chunk,
     /// until that chunk counts as a timeout, retries is then subtraced by one and the download is retried, default = REQUEST_TIMEOUT
-    OTA_Update_Callback(char const * current_fw_title, char const * current_fw_version, IUpdater * updater, function finished_callback, Callback<void, size_t const &, size_t const &>::function progress_callback = nullptr, Callback<void>::function update_starting_callback = nullptr, uint8_t chunk_retries = CHUNK_RETRIES, uint16_t chunk_size = CHUNK_SIZE, uint64_t const & timeout_microseconds = REQUEST_TIMEOUT);
+    /// @param chunk_window Maximum amount of chunks that are requested from the server at the same time without having received a response yet.
+    /// Increasing the window allows to hide the round-trip time of each request on high latency connections, but requires chunk_window * chunk_size bytes of additional heap memory,
+    /// because chunks that arrive before all their preceding chunks have been received are buffered until they can be written in order, default = CHUNK_WINDOW (stop-and-wait)
+    OTA_Update_Callback(char const * current_fw_title, char const * current_fw_version, IUpdater * updater, function finished_callback, Callback<void, size_t const &, size_t const &>::function progress_callback = nullptr, Callback<void>::function update_starting_callback = nullptr, uint8_t chunk_retries = CHUNK_RETRIES, uint16_t chunk_size = CHUNK_SIZE, uint64_t const & timeout_microseconds = REQUEST_TIMEOUT, uint8_t chunk_window = CHUNK_WINDOW);
 
     /// @brief Gets the current firmware title, used to decide if an OTA firmware update is already installed and therefore should not be downladed,
     /// this is only done if the title of the update and the current firmware title are the same because if they are not then this firmware is meant for another device type
@@ -143,6 +149,37 @@ class OTA_Update_Callback : public Callback<void, bool const &> {
     /// @param timeout_microseconds Timeout time until we expect a response from the server
     void Set_Timeout(uint64_t const & timeout_microseconds);
 
+    /// @brief Gets the maximum amount of chunks that are requested from the server at the same time without having received a response yet,
+    /// a window of 1 results in each chunk only being requested once the previous chunk has been received and written
+    /// @return Maximum amount of outstanding chunk requests
+    uint8_t Get_Chunk_Window() const;
+
+    /// @brief Sets the maximum amount of chunks that are requested from the server at the same time without having received a response yet,
+    /// a window of 1 results in each chunk only being requested once the previous chunk has been received and written.
+    /// Requires chunk_window * chunk_size bytes of additional heap memory if it is bigger than 1, to buffer chunks that arrive out of order
+    /// @param chunk_window Maximum amount of outstanding chunk requests, 0 is handled like 1
+    void Set_Chunk_Window(uint8_t chunk_window);
+
+    /// @brief Gets the storage implementation, used to persist the progress of the update so that an interrupted update can be resumed
+    /// after a restart or lost connection, instead of having to download the complete firmware binary again
+    /// @return Storage implementation that persists the progress of the update, nullptr if the progress is not persisted
+    IOTA_Checkpoint_Storage * Get_Checkpoint_Storage() const;
+
+    /// @brief Sets the storage implementation, used to persist the progress of the update so that an interrupted update can be resumed
+    /// after a restart or lost connection, instead of having to download the complete firmware binary again.
+    /// Resuming additionally requires the updater implementation to support it, if it does not the update is simply restarted from the first chunk
+    /// @param checkpoint_storage Storage implementation that persists the progress of the update, nullptr if the progress should not be persisted
+    void Set_Checkpoint_Storage(IOTA_Checkpoint_Storage * checkpoint_storage);
+
+    /// @brief Gets the amount of chunks that have to be written, before the progress of the update is persisted again
+    /// @return Amount of written chunks between persisting the progress
+    uint16_t Get_Checkpoint_Interval() const;
+
+    /// @brief Sets the amount of chunks that have to be written, before the progress of the update is persisted again.
+    /// Decreasing the interval reduces the amount of data that has to be downloaded again when resuming, but increases wear on the underlying storage
+    /// @param checkpoint_interval Amount of written chunks between persisting the progress, 0 is handled like 1
+    void Set_Checkpoint_Interval(uint16_t checkpoint_interval);
+
   private:
     char const                                     *m_current_fw_title = {};        // Current firmware title of device
     char const                                     *m_current_fw_version = {};      // Current firmware version of device
@@ -153,6 +190,9 @@ class OTA_Update_Callback : public Callback<void, bool const &> {
     uint8_t                                        m_chunk_retries = {};            // Maximum amount of retries for a single chunk to be downloaded and flashed successfully
     uint16_t                                       m_chunk_size = {};               // Size of chunks the firmware data will be split into
     uint64_t                                       m_timeout_microseconds = {};     // How long we wait for each chunck to arrive before declaring it as failed
+    uint8_t                                        m_chunk_window = {};             // Maximum amount of chunks requested at the same time without having received a response yet
+    IOTA_Checkpoint_Storage                        *m_checkpoint_storage = {};      // Storage implementation used to persist the progress of the update
+    uint16_t                                       m_checkpoint_interval = {};      // Amount of written chunks between persisting the progress of the update
 };
 
 #endif // OTA_Update_Callback_h
@@ -0,0 +1,300 @@
+#ifndef Outbound_Queue_h
+#define Outbound_Queue_h
+
+// Local includes.
+#include "DefaultLogger.h"
+#include "IMQTT_Client.h"
+#include "Rate_Limiter.h"
+#include "Timer_Queue.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+
+char constexpr OUTBOUND_FIRMWARE_TOPIC_PREFIX[] = "v2/fw/";
+char constexpr OUTBOUND_TELEMETRY_TOPIC_SUFFIX[] = "/telemetry";
+char constexpr OUTBOUND_ATTRIBUTES_TOPIC_SUFFIX[] = "/attributes";
+#define Default_Outbound_Budget_Bytes 1024
+#define Default_Outbound_Budget_Time 0
+
+
+// Log messages.
+char constexpr OUTBOUND_MESSAGE_TOO_BIG[] = "Message (%u) over topic (%s) too big for the outbound queue (%u), increase the size of the buffer passed to the Outbound_Queue";
+char constexpr OUTBOUND_MESSAGE_DROPPED[] = "Outbound queue full, dropped the oldest queued message with priority (%u) to make space for a message with priority (%u)";
+#if THINGSBOARD_ENABLE_DEBUG
+char constexpr OUTBOUND_QUEUE_FULL[] = "Outbound queue full, unable to queue message over topic (%s) without dropping messages with the same or a higher priority";
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+
+/// @brief Priority classes of the messages in the Outbound_Queue, lower values are published first
+enum class Outbound_Priority : uint8_t {
+    CONTROL,    ///< Requests and responses, for example server-side RPC responses, client-side RPC requests, attribute requests, claiming and provisioning
+    OTA,        ///< Firmware chunk requests of an ongoing OTA update
+    ATTRIBUTES, ///< Client-side attributes
+    TELEMETRY,  ///< Telemetry, sent last because it is the bulk of the traffic and the least latency sensitive
+    COUNT       ///< Amount of priority classes, not an actual priority
+};
+
+
+/// @brief Header that is written in front of every message in the outbound queue
+struct Outbound_Record_Header {
+    uint8_t  priority = {};     // Outbound_Priority of the message
+    uint8_t  topic_size = {};   // Length of the topic the message is published on without the null terminator, the topic is stored with the null terminator so it can be published directly
+    uint16_t data_points = {};  // Amount of telemetry or attribute data points contained in the payload, taken from the Rate_Limiter when the message is published
+    uint32_t payload_size = {}; // Length of the payload
+};
+
+
+/// @brief Bounded queue that every message sent by ThingsBoardSized is copied into instead of being published directly on the thread of the caller, once the queue is passed to ThingsBoardSized::Set_Outbound_Queue().
+/// The queued messages are published from loop(), highest priority class first and in the order they were sent within the same class, limited by a budget of bytes and time per call,
+/// so that a burst of telemetry neither blocks the caller nor delays RPC responses or OTA chunk requests that are sent afterwards. The priority is derived from the topic of the message.
+/// Messages are stored one after another in a single buffer passed to the constructor, meaning no memory is ever allocated. Published messages are removed by moving the following messages forward,
+/// which keeps the buffer free of gaps and is cheap for the small amount of bytes such a queue holds. If the queue is full, the oldest messages of lower priority classes are dropped to make space,
+/// messages that still do not fit are rejected, which lets ThingsBoardSized persist telemetry and attributes in the Outbox instead, if one is set, the same happens for messages that fail to be published once the queue is drained
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
+template <typename Logger = DefaultLogger>
+class Outbound_Queue {
+  public:
+    /// @brief Constructor
+    /// @param buffer Buffer the queued messages are stored in, has to be kept alive for as long as the instance of this class.
+    /// Every message requires its payload, its topic and a small header, the buffer therefore has to be bigger than the send buffer size of the client to queue atleast one message of the maximum size
+    /// @param buffer_size Size of the given buffer
+    Outbound_Queue(uint8_t * buffer, size_t const & buffer_size)
+      : m_buffer(buffer)
+      , m_buffer_size(buffer != nullptr ? buffer_size : 0U)
+      , m_length(0U)
+      , m_budget_bytes(Default_Outbound_Budget_Bytes)
+      , m_budget_time(Default_Outbound_Budget_Time)
+      , m_counts()
+    {
+        // Nothing to do
+    }
+
+    /// @brief Gets the priority class of messages sent over the given topic
+    /// @param topic Topic the message is published on
+    /// @return OTA for firmware topics, TELEMETRY and ATTRIBUTES for the device and gateway telemetry and attribute topics and CONTROL for every other topic
+    static Outbound_Priority Get_Priority(char const * topic) {
+        if (strncmp(topic, OUTBOUND_FIRMWARE_TOPIC_PREFIX, strlen(OUTBOUND_FIRMWARE_TOPIC_PREFIX)) == 0) {
+            return Outbound_Priority::OTA;
+        }
+        else if (Ends_With(topic, OUTBOUND_TELEMETRY_TOPIC_SUFFIX)) {
+            return Outbound_Priority::TELEMETRY;
+        }
+        else if (Ends_With(topic, OUTBOUND_ATTRIBUTES_TOPIC_SUFFIX)) {
+            return Outbound_Priority::ATTRIBUTES;
+        }
+        return Outbound_Priority::CONTROL;
+    }
+
+    /// @brief Copies the given message to the end of the queue, if the queue is full the oldest messages with a lower priority than the given message are dropped to make space
+    /// @param topic Topic that the message should be published on once the queue is drained
+    /// @param payload Payload of the message
+    /// @param length Length of the payload in bytes
+    /// @param data_points Amount of telemetry or attribute data points contained in the payload, default = 0
+    /// @return Whether the message was queued successfully or not
+    bool Push(char const * topic, uint8_t const * payload, size_t const & length, size_t const & data_points = 0U) {
+        if (topic == nullptr || (payload == nullptr && length != 0U)) {
+            return false;
+        }
+        size_t const topic_size = strlen(topic);
+        size_t const record_size = Get_Record_Size(topic_size, length);
+        if (topic_size > UINT8_MAX || record_size > m_buffer_size) {
+            Logger::printfln(OUTBOUND_MESSAGE_TOO_BIG, record_size, topic, m_buffer_size);
+            return false;
+        }
+
+        Outbound_Priority const priority = Get_Priority(topic);
+        while (m_length + record_size > m_buffer_size) {
+            if (!Drop_Lower_Priority(priority)) {
+#if THINGSBOARD_ENABLE_DEBUG
+                Logger::printfln(OUTBOUND_QUEUE_FULL, topic);
+#endif // THINGSBOARD_ENABLE_DEBUG
+                return false;
+            }
+        }
+
+        Outbound_Record_Header header = {};
+        header.priority = static_cast<uint8_t>(priority);
+        header.topic_size = static_cast<uint8_t>(topic_size);
+        header.payload_size = static_cast<uint32_t>(length);
+        header.data_points = static_cast<uint16_t>(data_points < UINT16_MAX ? data_points : UINT16_MAX);
+        uint8_t * const record = m_buffer + m_length;
+        // Copied byte by byte, because records are not aligned inside of the buffer
+        (void)memcpy(record, &header, sizeof(header));
+        (void)memcpy(record + sizeof(header), topic, topic_size + 1U);
+        if (length != 0U) {
+            (void)memcpy(record + sizeof(header) + topic_size + 1U, payload, length);
+        }
+        m_length += record_size;
+        m_counts[header.priority]++;
+        return true;
+    }
+
+    /// @brief Publishes the queued messages over the given client, highest priority class first, until the queue is empty or the budget of this call is exhausted.
+    /// Atleast one message is published on every call, even if it alone exceeds the budget, so that the queue never stalls. Stops at the first message that could not be published and continues with it on the next call.
+    /// Stops as well once the given rate limiter does not allow to publish the next message, because publishing a message of a lower priority class instead would reorder the messages
+    /// @param client MQTT Client implementation that is used to publish the messages
+    /// @param timer_queue Timer queue whose clock the time budget is measured with and the rate limiter is updated with
+    /// @param limiter Optional rate limiter every published message and its data points are taken from, default = nullptr
+    /// @return Whether all messages published during this call could be published successfully or not
+    bool Drain(IMQTT_Client & client, Timer_Queue const & timer_queue, Rate_Limiter * limiter = nullptr) {
+        return Drain(client, timer_queue, limiter, [](char const * topic, uint8_t const * payload, size_t const & length) {
+            return false;
+        });
+    }
+
+    /// @brief Publishes the queued messages the same as the other overload, but hands the first message that could not be published to the given method,
+    /// which allows ThingsBoardSized to persist failed telemetry and attributes in its outbox, instead of keeping them in the queue, where they would be lost on a restart or dropped to make space for messages with a higher priority
+    /// @tparam Store Callable with the signature bool(char const * topic, uint8_t const * payload, size_t const & length),
+    /// a template argument instead of a Callback, because it has to capture the instance it stores with even if THINGSBOARD_ENABLE_STL is not set
+    /// @param client MQTT Client implementation that is used to publish the messages
+    /// @param timer_queue Timer queue whose clock the time budget is measured with and the rate limiter is updated with
+    /// @param limiter Optional rate limiter every published message and its data points are taken from
+    /// @param store Method the message that could not be published is passed to, returns whether it took over the message, in which case it is removed from the queue instead of being attempted again on the next call
+    /// @return Whether all messages published during this call could be published successfully or not
+    template<typename Store>
+    bool Drain(IMQTT_Client & client, Timer_Queue const & timer_queue, Rate_Limiter * limiter, Store const & store) {
+        uint64_t const start = timer_queue.now();
+        size_t published_bytes = 0U;
+        while (!Is_Empty()) {
+            size_t const offset = Find_Oldest(Get_Highest_Priority());
+            Outbound_Record_Header header = {};
+            (void)memcpy(&header, m_buffer + offset, sizeof(header));
+            if (published_bytes != 0U) {
+                if (m_budget_bytes != 0U && published_bytes + header.payload_size > m_budget_bytes) {
+                    break;
+                }
+                else if (m_budget_time != 0U && timer_queue.now() - start >= m_budget_time) {
+                    break;
+                }
+            }
+
+            if (limiter != nullptr && !limiter->Try_Consume(1U, header.data_points, start)) {
+                break;
+            }
+
+            char const * const topic = reinterpret_cast<char const *>(m_buffer + offset + sizeof(header));
+            uint8_t const * const payload = m_buffer + offset + sizeof(header) + header.topic_size + 1U;
+            if (!client.publish(topic, payload, header.payload_size)) {
+                if (store(topic, payload, header.payload_size)) {
+                    Remove(offset, header);
+                }
+                return false;
+            }
+            // Messages of the payload size 0 still count towards the budget, so that a queue full of them does not publish everything at once
+            published_bytes += header.payload_size != 0U ? header.payload_size : 1U;
+            Remove(offset, header);
+        }
+        return true;
+    }
+
+    /// @brief Whether there are any messages in the queue that have not been published yet
+    /// @return Whether the queue is empty or not
+    bool Is_Empty() const {
+        return m_length == 0U;
+    }
+
+    /// @brief Gets the amount of messages with the given priority that have not been published yet
+    /// @param priority Priority class the messages are counted for
+    /// @return Amount of queued messages with the given priority
+    size_t Get_Count(Outbound_Priority const & priority) const {
+        return priority < Outbound_Priority::COUNT ? m_counts[static_cast<uint8_t>(priority)] : 0U;
+    }
+
+    /// @brief Sets the budget of a single call to Drain(), to ensure loop() publishes a bounded amount of data and returns in time, even if a big backlog has been queued
+    /// @param budget_bytes Maximum amount of payload bytes that are published with a single call, 0 means no limit, default = Default_Outbound_Budget_Bytes (1024)
+    /// @param budget_microseconds Maximum amount of microseconds after which no further message is published in a single call, 0 means no limit, default = Default_Outbound_Budget_Time (0)
+    void Set_Drain_Budget(size_t const & budget_bytes, uint64_t const & budget_microseconds) {
+        m_budget_bytes = budget_bytes;
+        m_budget_time = budget_microseconds;
+    }
+
+    /// @brief Removes all messages that have not been published yet
+    void clear() {
+        m_length = 0U;
+        (void)memset(m_counts, 0, sizeof(m_counts));
+    }
+
+  private:
+    /// @brief Gets the amount of bytes a record with the given sizes requires in the buffer
+    /// @param topic_size Length of the topic without the null terminator
+    /// @param payload_size Length of the payload
+    /// @return Amount of bytes the record requires in the buffer
+    static size_t Get_Record_Size(size_t const & topic_size, size_t const & payload_size) {
+        return sizeof(Outbound_Record_Header) + topic_size + 1U + payload_size;
+    }
+
+    /// @brief Whether the given string ends with the given suffix
+    /// @param string String that should be checked
+    /// @param suffix Suffix the string should end with
+    /// @return Whether the string ends with the suffix or not
+    static bool Ends_With(char const * string, char const * suffix) {
+        size_t const string_size = strlen(string);
+        size_t const suffix_size = strlen(suffix);
+        return string_size >= suffix_size && strcmp(string + string_size - suffix_size, suffix) == 0;
+    }
+
+    /// @brief Gets the highest priority that atleast one queued message has, the queue has to contain atleast one message
+    /// @return Highest priority of the queued messages
+    uint8_t Get_Highest_Priority() const {
+        uint8_t priority = 0U;
+        while (m_counts[priority] == 0U) {
+            priority++;
+        }
+        return priority;
+    }
+
+    /// @brief Searches the oldest message with the given priority, atleast one message with the given priority has to be queued
+    /// @param priority Priority of the message
+    /// @return Offset of the record of the oldest message with the given priority in the buffer
+    size_t Find_Oldest(uint8_t const & priority) const {
+        size_t offset = 0U;
+        Outbound_Record_Header header = {};
+        for (; offset < m_length; offset += Get_Record_Size(header.topic_size, header.payload_size)) {
+            (void)memcpy(&header, m_buffer + offset, sizeof(header));
+            if (header.priority == priority) {
+                break;
+            }
+        }
+        return offset;
+    }
+
+    /// @brief Drops the oldest message of the lowest queued priority class, if that class is lower than the given priority
+    /// @param priority Priority of the message that space should be made for
+    /// @return Whether a message was dropped or not, false if every queued message has the same or a higher priority
+    bool Drop_Lower_Priority(Outbound_Priority const & priority) {
+        for (uint8_t lowest = static_cast<uint8_t>(Outbound_Priority::COUNT) - 1U; lowest > static_cast<uint8_t>(priority); lowest--) {
+            if (m_counts[lowest] == 0U) {
+                continue;
+            }
+            size_t const offset = Find_Oldest(lowest);
+            Outbound_Record_Header header = {};
+            (void)memcpy(&header, m_buffer + offset, sizeof(header));
+            Logger::printfln(OUTBOUND_MESSAGE_DROPPED, lowest, static_cast<uint8_t>(priority));
+            Remove(offset, header);
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief Removes the record at the given offset, by moving every following record forward
+    /// @param offset Offset of the record in the buffer
+    /// @param header Header of the record
+    void Remove(size_t const & offset, Outbound_Record_Header const & header) {
+        size_t const record_size = Get_Record_Size(header.topic_size, header.payload_size);
+        (void)memmove(m_buffer + offset, m_buffer + offset + record_size, m_length - offset - record_size);
+        m_length -= record_size;
+        m_counts[header.priority]--;
+    }
+
+    uint8_t              *m_buffer = {};        // Buffer the queued messages are stored in
+    size_t               m_buffer_size = {};    // Size of the buffer
+    size_t               m_length = {};         // Amount of bytes used by the queued messages
+    size_t               m_budget_bytes = {};   // Maximum amount of payload bytes published with a single call to Drain()
+    uint64_t             m_budget_time = {};    // Maximum amount of microseconds a single call to Drain() starts publishing messages for
+    size_t               m_counts[static_cast<uint8_t>(Outbound_Priority::COUNT)]; // Amount of queued messages of every priority class, allows to find the highest priority without iterating the whole buffer
+};
+
+#endif // Outbound_Queue_h
@@ -0,0 +1,477 @@
+#ifndef Outbox_h
+#define Outbox_h
+
+// Local includes.
+#include "IOutbox_Storage.h"
+#include "IMQTT_Client.h"
+#include "IAPI_Implementation.h"
+#include "Helper.h"
+
+// Library includes.
+#include <ctype.h>
+#include <stddef.h>
+#include <string.h>
+
+
+uint16_t constexpr OUTBOX_RECORD_MAGIC = 0x7B4FU;
+uint8_t constexpr OUTBOX_RECORD_PENDING = 0xFFU;
+uint8_t constexpr OUTBOX_RECORD_SENT = 0x00U;
+size_t constexpr OUTBOX_RECORD_ALIGNMENT = 4U;
+size_t constexpr OUTBOX_MAX_TOPIC_SIZE = 64U;
+char constexpr OUTBOX_TIMESTAMP_PREFIX[] = "{\"ts\":%llu,\"values\":";
+char constexpr OUTBOX_TIMESTAMP_KEY[] = "\"ts\"";
+#define Default_Outbox_Batch_Size 10
+#define Default_Outbox_Drain_Interval 0
+#define Default_Outbox_Max_Age 0
+
+
+// Log messages.
+char constexpr OUTBOX_STORAGE_INVALID[] = "Outbox storage size (%u) has to be a multiple of the sector size (%u) and contain atleast two sectors";
+char constexpr OUTBOX_RECORD_TOO_BIG[] = "Message (%u) too big for a single outbox sector (%u), increase the sector size of the storage";
+char constexpr OUTBOX_RECORD_EXCEEDS_BUFFER[] = "Discarding message (%u) from outbox, because it is too big for the send buffer (%u), increase with setBufferSize accordingly";
+char constexpr OUTBOX_RECORDS_DROPPED[] = "Outbox full, dropped the oldest sector of messages to make space for new ones";
+char constexpr OUTBOX_WRITE_FAILED[] = "Writing message into outbox storage failed";
+#if THINGSBOARD_ENABLE_DEBUG
+char constexpr OUTBOX_RECORD_EXPIRED[] = "Discarding message from outbox, because it is older than the max age (%llu)";
+char constexpr OUTBOX_RESTORED[] = "Restored outbox with the oldest pending message at (%u) and the newest message ending at (%u)";
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+
+/// @brief Header that is written in front of every message in the outbox storage
+struct Outbox_Record_Header {
+    uint16_t magic = {};         // Always OUTBOX_RECORD_MAGIC for written records, erased storage reads as 0xFFFF instead, which marks the end of the written records in a sector
+    uint8_t  state = {};         // OUTBOX_RECORD_PENDING until the record has been published and is then overwritten with OUTBOX_RECORD_SENT, which only clears bits and is therefore allowed without erasing the sector first
+    uint8_t  topic_size = {};    // Length of the topic the message should be published on without the null terminator
+    uint32_t sequence = {};      // Increasing number of the record, allows to find the newest record after a restart
+    uint64_t timestamp = {};     // Unix timestamp in milliseconds when the message was stored, 0 if the time was not known
+    uint32_t payload_size = {};  // Length of the payload
+    uint32_t crc = {};           // CRC-32 over the header fields from topic_size up to the crc, followed by the topic and the payload. Excludes the state, because it is changed once the message has been sent
+};
+
+
+/// @brief Persistent store-and-forward outbox for messages that could not be published, because the connection was lost or the client buffer was full.
+/// The messages are appended to a ring log on the given storage, which is split into sectors and only ever appends to erased sectors, so that flash partitions can be used directly.
+/// Once the log is full, the sector containing the oldest messages is erased to make space for new ones. Every record is protected with a CRC, which allows to discard messages
+/// that were only partially written, because the device was restarted while writing them, and to find the oldest and newest messages again after a restart by scanning the storage once.
+/// Pending messages are published again in batches after the connection has been reestablished. Telemetry messages are published with the timestamp of when they were stored,
+/// so that the server does not assign the time of the delayed publish instead, messages older than the configurable max age are discarded instead of being published
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
+template <typename Logger = DefaultLogger>
+class Outbox {
+  public:
+    /// @brief Constructor
+    /// @param storage Storage backend the messages are persisted into, has to be kept alive for as long as the instance of this class
+    /// @param get_time_callback Optional callback that returns the current unix timestamp in milliseconds or 0 if the time is not known yet, for example because it has not been synchronized with SNTP.
+    /// Required to publish stored telemetry with the time it was originally sent at, to discard messages that exceed the max age and to limit the drain rate, default = nullptr
+    explicit Outbox(IOutbox_Storage & storage, Callback<uint64_t>::function get_time_callback = nullptr)
+      : m_storage(storage)
+      , m_get_time_callback(get_time_callback)
+      , m_batch_size(Default_Outbox_Batch_Size)
+      , m_drain_interval(Default_Outbox_Drain_Interval)
+      , m_max_age(Default_Outbox_Max_Age)
+      , m_last_drain_time(0U)
+      , m_drain_immediately(true)
+      , m_sequence(0U)
+      , m_head_sector(0U)
+      , m_head_offset(0U)
+      , m_tail_sector(0U)
+      , m_tail_offset(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Prepares the storage and scans it once to restore the messages that were still pending before the device was restarted,
+    /// has to be called once before any other method, is done automatically when the outbox is passed to ThingsBoardSized::Set_Outbox()
+    /// @return Whether the storage could be prepared successfully and is big enough to be used as a ring log
+    bool Initialize() {
+        if (!m_storage.begin()) {
+            return false;
+        }
+        size_t const size = m_storage.get_size();
+        size_t const sector_size = m_storage.get_sector_size();
+        if (sector_size <= sizeof(Outbox_Record_Header) || size % sector_size != 0U || size / sector_size < 2U) {
+            Logger::printfln(OUTBOX_STORAGE_INVALID, size, sector_size);
+            return false;
+        }
+
+        // The newest record is the one with the highest sequence, the head is placed directly after it, because that is where the next record has to be appended
+        bool found = false;
+        uint32_t newest = 0U;
+        m_head_sector = 0U;
+        m_head_offset = 0U;
+        for (size_t sector = 0U; sector < size; sector += sector_size) {
+            Outbox_Record_Header header = {};
+            for (size_t offset = 0U; Read_Valid_Header(sector, offset, header); offset += Get_Record_Size(header)) {
+                // Compares with the difference instead of directly, so that an overflow of the sequence does not break the order
+                if (!found || static_cast<int32_t>(header.sequence - newest) > 0) {
+                    newest = header.sequence;
+                    m_head_sector = sector;
+                    m_head_offset = offset + Get_Record_Size(header);
+                    found = true;
+                }
+            }
+        }
+        m_sequence = found ? newest + 1U : 0U;
+        // Storage that does not contain any records might not have been erased yet, the first record is therefore appended to a freshly erased sector
+        if (!found) {
+            m_head_offset = sector_size;
+        }
+
+        // Bytes directly after the newest record might have been partially written if the device was restarted while storing a message,
+        // because they can not be written again without erasing the sector first, we continue with the next sector instead
+        Outbox_Record_Header header = {};
+        if (m_head_offset + sizeof(header) <= sector_size && m_storage.read(m_head_sector + m_head_offset, reinterpret_cast<uint8_t *>(&header), sizeof(header)) && header.magic != 0xFFFFU) {
+            m_head_offset = sector_size;
+        }
+
+        // The oldest records are stored in the sectors following the sector of the newest record, walk from there until the first record that has not been sent yet
+        m_tail_sector = Get_Next_Sector(m_head_sector);
+        m_tail_offset = 0U;
+        if (!found) {
+            m_tail_sector = m_head_sector;
+            m_tail_offset = m_head_offset;
+        }
+        Skip_Sent_Records();
+#if THINGSBOARD_ENABLE_DEBUG
+        Logger::printfln(OUTBOX_RESTORED, m_tail_sector + m_tail_offset, m_head_sector + m_head_offset);
+#endif // THINGSBOARD_ENABLE_DEBUG
+        return true;
+    }
+
+    /// @brief Appends the given message to the outbox, if the outbox is full the sector containing the oldest messages is dropped to make space
+    /// @param topic Topic that the message should be published on once the outbox is drained
+    /// @param payload Payload of the message
+    /// @param length Length of the payload in bytes
+    /// @return Whether the message was persisted successfully or not
+    bool Store(char const * topic, uint8_t const * payload, size_t const & length) {
+        if (topic == nullptr || payload == nullptr) {
+            return false;
+        }
+        size_t const topic_size = strlen(topic);
+        size_t const sector_size = m_storage.get_sector_size();
+        size_t const record_size = Get_Record_Size(topic_size, length);
+        if (topic_size >= OUTBOX_MAX_TOPIC_SIZE || record_size > sector_size) {
+            Logger::printfln(OUTBOX_RECORD_TOO_BIG, record_size, sector_size);
+            return false;
+        }
+        if (m_head_offset + record_size > sector_size && !Advance_Head_Sector()) {
+            Logger::printfln(OUTBOX_WRITE_FAILED);
+            return false;
+        }
+
+        Outbox_Record_Header header = {};
+        header.magic = OUTBOX_RECORD_MAGIC;
+        header.state = OUTBOX_RECORD_PENDING;
+        header.topic_size = static_cast<uint8_t>(topic_size);
+        header.sequence = m_sequence;
+        header.timestamp = m_get_time_callback.Call_Callback();
+        header.payload_size = static_cast<uint32_t>(length);
+        header.crc = Helper::calculateCrc32(Get_Crc_Start(header), Get_Crc_Size());
+        header.crc = Helper::calculateCrc32(reinterpret_cast<uint8_t const *>(topic), topic_size, header.crc);
+        header.crc = Helper::calculateCrc32(payload, length, header.crc);
+
+        size_t const offset = m_head_sector + m_head_offset;
+        bool const result = m_storage.write(offset, reinterpret_cast<uint8_t const *>(&header), sizeof(header))
+          && m_storage.write(offset + sizeof(header), reinterpret_cast<uint8_t const *>(topic), topic_size)
+          && m_storage.write(offset + sizeof(header) + topic_size, payload, length);
+        m_sequence++;
+        if (!result) {
+            // Partially written bytes can not be overwritten without erasing the sector first, therefore the next record is appended to the next sector instead
+            Logger::printfln(OUTBOX_WRITE_FAILED);
+            m_head_offset = sector_size;
+            return false;
+        }
+        m_head_offset += record_size;
+        return true;
+    }
+
+    /// @brief Publishes the next batch of pending messages over the given client, if the configured drain interval has passed since the last batch.
+    /// Stops at the first message that could not be published and continues with it on the next call
+    /// @param client MQTT Client implementation that is used to publish the messages
+    /// @return Whether all messages of the batch could be published successfully or not
+    bool Drain(IMQTT_Client & client) {
+        return Drain(client.get_send_buffer_size(), [&client](char const * topic, uint8_t const * payload, size_t const & length, size_t const & data_points) {
+            return client.publish(topic, payload, length);
+        });
+    }
+
+    /// @brief Passes the next batch of pending messages to the given method, if the configured drain interval has passed since the last batch.
+    /// Allows ThingsBoardSized to copy the messages into its outbound queue instead of publishing them directly, so that they are published in the order of their priority and within the limits of its rate limiter.
+    /// Stops at the first message the given method failed to publish and continues with it on the next call
+    /// @tparam Publish Callable with the signature bool(char const * topic, uint8_t const * payload, size_t const & length, size_t const & data_points),
+    /// a template argument instead of a Callback, because it has to capture the instance it publishes with even if THINGSBOARD_ENABLE_STL is not set
+    /// @param send_buffer_size Maximum size of a message that can be published, messages that do not fit are discarded
+    /// @param publish Method that publishes a single message, the data points are counted from the stored json or 1 if the payload is not json. Returns whether the message was published successfully
+    /// @return Whether all messages of the batch could be published successfully or not
+    template<typename Publish>
+    bool Drain(size_t const & send_buffer_size, Publish const & publish) {
+        if (Is_Empty()) {
+            return true;
+        }
+        uint64_t const now = m_get_time_callback.Call_Callback();
+        if (!m_drain_immediately && m_drain_interval != 0U && now != 0U && now - m_last_drain_time < m_drain_interval) {
+            return true;
+        }
+        m_drain_immediately = false;
+        m_last_drain_time = now;
+
+        size_t const capacity = send_buffer_size + 1U;
+        uint8_t * buffer = new uint8_t[capacity]();
+
+        bool result = true;
+        size_t published = 0U;
+        Outbox_Record_Header header = {};
+        while (published < m_batch_size && !Is_Empty()) {
+            if (!Read_Valid_Header(m_tail_sector, m_tail_offset, header)) {
+                Advance_Tail_Sector();
+                continue;
+            }
+            if (header.state == OUTBOX_RECORD_PENDING) {
+                if (m_max_age != 0U && header.timestamp != 0U && now > header.timestamp && now - header.timestamp > m_max_age) {
+#if THINGSBOARD_ENABLE_DEBUG
+                    Logger::printfln(OUTBOX_RECORD_EXPIRED, static_cast<unsigned long long>(m_max_age));
+#endif // THINGSBOARD_ENABLE_DEBUG
+                }
+                else if (!Publish_Record(header, buffer, capacity, publish)) {
+                    result = false;
+                    break;
+                }
+                else {
+                    published++;
+                }
+                uint8_t const sent = OUTBOX_RECORD_SENT;
+                (void)m_storage.write(m_tail_sector + m_tail_offset + offsetof(Outbox_Record_Header, state), &sent, sizeof(sent));
+            }
+            m_tail_offset += Get_Record_Size(header);
+        }
+
+        // Ensure to actually delete the memory placed onto the heap, to make sure we do not create a memory leak
+        // and set the pointer to null so we do not have a dangling reference.
+        delete[] buffer;
+        buffer = nullptr;
+        return result;
+    }
+
+    /// @brief Ensures the next call to Drain() publishes a batch immediately, independent of the drain interval.
+    /// Called automatically by ThingsBoardSized once the connection has been reestablished
+    void Start_Draining() {
+        m_drain_immediately = true;
+    }
+
+    /// @brief Whether there are any messages in the outbox that have not been published yet
+    /// @return Whether the outbox is empty or not
+    bool Is_Empty() const {
+        return m_tail_sector == m_head_sector && m_tail_offset == m_head_offset;
+    }
+
+    /// @brief Sets the rate the outbox is drained at, to ensure a big backlog does not exceed the rate limits of the server or starve the sending of live data
+    /// @param batch_size Maximum amount of messages that are published with a single call to Drain(), default = Default_Outbox_Batch_Size (10)
+    /// @param drain_interval_milliseconds Minimum amount of milliseconds between two batches, requires the get_time_callback to be set, 0 means that a batch is published on every call, default = Default_Outbox_Drain_Interval (0)
+    void Set_Drain_Rate(size_t const & batch_size, uint64_t const & drain_interval_milliseconds) {
+        m_batch_size = batch_size;
+        m_drain_interval = drain_interval_milliseconds;
+    }
+
+    /// @brief Sets the maximum age of a message, messages that are older once the outbox is drained are discarded instead of being published.
+    /// Requires the get_time_callback to be set, messages stored while the time was not known are never discarded
+    /// @param max_age_milliseconds Maximum age of a message in milliseconds, 0 means messages never expire, default = Default_Outbox_Max_Age (0)
+    void Set_Max_Age(uint64_t const & max_age_milliseconds) {
+        m_max_age = max_age_milliseconds;
+    }
+
+  private:
+    /// @brief Gets the amount of bytes a record with the given sizes requires in the storage, padded so that every header starts at an aligned offset
+    /// @param topic_size Length of the topic without the null terminator
+    /// @param payload_size Length of the payload
+    /// @return Amount of bytes the record requires in the storage
+    static size_t Get_Record_Size(size_t const & topic_size, size_t const & payload_size) {
+        size_t const size = sizeof(Outbox_Record_Header) + topic_size + payload_size;
+        return (size + OUTBOX_RECORD_ALIGNMENT - 1U) / OUTBOX_RECORD_ALIGNMENT * OUTBOX_RECORD_ALIGNMENT;
+    }
+
+    /// @brief Gets the amount of bytes the record with the given header requires in the storage
+    /// @param header Header of the record
+    /// @return Amount of bytes the record requires in the storage
+    static size_t Get_Record_Size(Outbox_Record_Header const & header) {
+        return Get_Record_Size(header.topic_size, header.payload_size);
+    }
+
+    /// @brief Gets the first byte of the header fields that are included in the CRC
+    /// @param header Header of the record
+    /// @return Pointer to the first byte of the header included in the CRC
+    static uint8_t const * Get_Crc_Start(Outbox_Record_Header const & header) {
+        return reinterpret_cast<uint8_t const *>(&header) + offsetof(Outbox_Record_Header, topic_size);
+    }
+
+    /// @brief Gets the amount of bytes of the header that are included in the CRC
+    /// @return Amount of bytes of the header included in the CRC
+    static size_t constexpr Get_Crc_Size() {
+        return offsetof(Outbox_Record_Header, crc) - offsetof(Outbox_Record_Header, topic_size);
+    }
+
+    /// @brief Gets the start of the sector following the given sector, wrapping around to the first sector at the end of the storage
+    /// @param sector Start of the current sector
+    /// @return Start of the next sector
+    size_t Get_Next_Sector(size_t const & sector) const {
+        size_t const next = sector + m_storage.get_sector_size();
+        return next < m_storage.get_size() ? next : 0U;
+    }
+
+    /// @brief Reads the header at the given position and verifies the CRC of the complete record, which ensures only completely written records are ever published
+    /// @param sector Start of the sector the record is contained in
+    /// @param offset Offset of the record inside of the sector
+    /// @param header Header the read values will be copied into
+    /// @return Whether a completely written record is stored at the given position or not
+    bool Read_Valid_Header(size_t const & sector, size_t const & offset, Outbox_Record_Header & header) {
+        size_t const sector_size = m_storage.get_sector_size();
+        if (offset + sizeof(header) > sector_size || !m_storage.read(sector + offset, reinterpret_cast<uint8_t *>(&header), sizeof(header))) {
+            return false;
+        }
+        if (header.magic != OUTBOX_RECORD_MAGIC || offset + Get_Record_Size(header) > sector_size) {
+            return false;
+        }
+
+        uint32_t crc = Helper::calculateCrc32(Get_Crc_Start(header), Get_Crc_Size());
+        uint8_t chunk[32U] = {};
+        size_t const data_size = header.topic_size + header.payload_size;
+        for (size_t read_bytes = 0U; read_bytes < data_size; read_bytes += sizeof(chunk)) {
+            size_t const size = data_size - read_bytes < sizeof(chunk) ? data_size - read_bytes : sizeof(chunk);
+            if (!m_storage.read(sector + offset + sizeof(header) + read_bytes, chunk, size)) {
+                return false;
+            }
+            crc = Helper::calculateCrc32(chunk, size, crc);
+        }
+        return crc == header.crc;
+    }
+
+    /// @brief Moves the tail to the start of the next sector, called once the tail reaches the end of the written records in its current sector.
+    /// Because writing always continues in the next sector after a failed write, there can not be any further records in the head sector, which means the outbox is empty
+    void Advance_Tail_Sector() {
+        if (m_tail_sector == m_head_sector) {
+            m_tail_offset = m_head_offset;
+            return;
+        }
+        m_tail_sector = Get_Next_Sector(m_tail_sector);
+        m_tail_offset = 0U;
+    }
+
+    /// @brief Moves the tail forward until it points to the oldest record that has not been sent yet or reaches the head
+    void Skip_Sent_Records() {
+        Outbox_Record_Header header = {};
+        while (!Is_Empty()) {
+            if (!Read_Valid_Header(m_tail_sector, m_tail_offset, header)) {
+                Advance_Tail_Sector();
+                continue;
+            }
+            if (header.state == OUTBOX_RECORD_PENDING) {
+                break;
+            }
+            m_tail_offset += Get_Record_Size(header);
+        }
+    }
+
+    /// @brief Moves the head to the start of the next sector and erases it, if the tail still points into that sector, the pending messages in it are dropped
+    /// @return Whether erasing the next sector was successful or not
+    bool Advance_Head_Sector() {
+        size_t const next = Get_Next_Sector(m_head_sector);
+        bool const was_empty = Is_Empty();
+        if (!was_empty && m_tail_sector == next) {
+            Logger::printfln(OUTBOX_RECORDS_DROPPED);
+            m_tail_sector = Get_Next_Sector(next);
+            m_tail_offset = 0U;
+        }
+        if (!m_storage.erase_sector(next)) {
+            return false;
+        }
+        m_head_sector = next;
+        m_head_offset = 0U;
+        if (was_empty) {
+            m_tail_sector = m_head_sector;
+            m_tail_offset = m_head_offset;
+        }
+        return true;
+    }
+
+    /// @brief Checks whether the given json object is already in the timestamped telemetry format, meaning its first key is "ts", whitespace between the tokens is skipped
+    /// @param payload Payload starting with the opening bracket of the object
+    /// @param length Length of the payload
+    /// @return Whether the payload already contains a timestamp and therefore must not be wrapped again
+    static bool Is_Timestamped(uint8_t const * payload, size_t const & length) {
+        size_t index = 1U;
+        while (index < length && isspace(payload[index])) {
+            index++;
+        }
+        size_t const key_length = strlen(OUTBOX_TIMESTAMP_KEY);
+        if (length - index < key_length || memcmp(payload + index, OUTBOX_TIMESTAMP_KEY, key_length) != 0) {
+            return false;
+        }
+        index += key_length;
+        while (index < length && isspace(payload[index])) {
+            index++;
+        }
+        return index < length && payload[index] == ':';
+    }
+
+    /// @brief Reads the record at the tail into the given buffer and publishes it, telemetry that was stored with a timestamp and consists of a single object
+    /// is wrapped into the timestamped telemetry format {"ts":1451649600512,"values":{...}}, so that the server uses the original time instead of the time of the publish.
+    /// Objects that already are in that format, because they were sent with their own timestamp, are published unchanged
+    /// @tparam Publish Callable that publishes a single message, see Drain() for its signature
+    /// @param header Header of the record at the tail
+    /// @param buffer Buffer the payload is read into before it is published
+    /// @param capacity Size of the buffer
+    /// @param publish Method that is used to publish the message
+    /// @return Whether the record can be removed from the outbox, false if publishing failed and it should be attempted again later.
+    /// Records that can never be published, because they exceed the buffer, are removed as well
+    template<typename Publish>
+    bool Publish_Record(Outbox_Record_Header const & header, uint8_t * buffer, size_t const & capacity, Publish const & publish) {
+        size_t const offset = m_tail_sector + m_tail_offset + sizeof(header);
+        char topic[OUTBOX_MAX_TOPIC_SIZE] = {};
+        if (!m_storage.read(offset, reinterpret_cast<uint8_t *>(topic), header.topic_size)) {
+            return false;
+        }
+
+        char prefix[sizeof(OUTBOX_TIMESTAMP_PREFIX) + 20U] = {};
+        size_t prefix_size = 0U;
+        if (header.timestamp != 0U && strncmp(topic, TELEMETRY_TOPIC, sizeof(TELEMETRY_TOPIC)) == 0) {
+            prefix_size = snprintf(prefix, sizeof(prefix), OUTBOX_TIMESTAMP_PREFIX, static_cast<unsigned long long>(header.timestamp));
+        }
+        // Space for the closing bracket of the wrapped object and the null terminator
+        if (prefix_size + header.payload_size + 2U > capacity) {
+            Logger::printfln(OUTBOX_RECORD_EXCEEDS_BUFFER, prefix_size + header.payload_size + 1U, capacity - 1U);
+            return true;
+        }
+        if (!m_storage.read(offset + header.topic_size, buffer + prefix_size, header.payload_size)) {
+            return false;
+        }
+
+        size_t length = header.payload_size;
+        if (prefix_size != 0U && header.payload_size != 0U && buffer[prefix_size] == '{' && !Is_Timestamped(buffer + prefix_size, header.payload_size)) {
+            (void)memcpy(buffer, prefix, prefix_size);
+            length += prefix_size;
+            buffer[length++] = '}';
+        }
+        else if (prefix_size != 0U) {
+            // Payload is already timestamped or not a single object, therefore it is published as is
+            (void)memmove(buffer, buffer + prefix_size, header.payload_size);
+        }
+        buffer[length] = '\0';
+        // Only json can be counted, encoded payloads are counted as a single data point instead
+        size_t const data_points = length != 0U && (buffer[0] == '{' || buffer[0] == '[') ? Helper::getJsonNodeCount(buffer, length) : 1U;
+        return publish(topic, buffer, length, data_points);
+    }
+
+    IOutbox_Storage      &m_storage;               // Storage backend the messages are persisted into
+    Callback<uint64_t>   m_get_time_callback = {}; // Callback that returns the current unix timestamp in milliseconds
+    size_t               m_batch_size = {};        // Maximum amount of messages that are published with a single call to Drain()
+    uint64_t             m_drain_interval = {};    // Minimum amount of milliseconds between two batches
+    uint64_t             m_max_age = {};           // Maximum age of a message in milliseconds before it is discarded instead of published
+    uint64_t             m_last_drain_time = {};   // Timestamp the last batch was published at
+    bool                 m_drain_immediately = {}; // Whether the next batch should be published independent of the drain interval
+    uint32_t             m_sequence = {};          // Sequence of the next record that is stored
+    size_t               m_head_sector = {};       // Start of the sector the next record is appended to
+    size_t               m_head_offset = {};       // Offset inside of the head sector the next record is appended at
+    size_t               m_tail_sector = {};       // Start of the sector containing the oldest pending record
+    size_t               m_tail_offset = {};       // Offset inside of the tail sector of the oldest pending record
+};
+
+#endif // Outbox_h
@@ -0,0 +1,528 @@
+// Header include.
+#include "Protobuf_Codec.h"
+
+// Local includes.
+#include "Client_Side_RPC.h"
+#include "Server_Side_RPC.h"
+
+// Library includes.
+#include <string.h>
+
+// Wire types of the protobuf encoding, see https://protobuf.dev/programming-guides/encoding/#structure for more information
+constexpr uint8_t PROTOBUF_WIRE_VARINT = 0U;
+constexpr uint8_t PROTOBUF_WIRE_FIXED64 = 1U;
+constexpr uint8_t PROTOBUF_WIRE_LENGTH_DELIMITED = 2U;
+constexpr uint8_t PROTOBUF_WIRE_FIXED32 = 5U;
+// Longest possible varint, which is required for every negative int32 or int64
+constexpr size_t PROTOBUF_MAX_VARINT_LENGTH = 10U;
+// Field numbers of the AttributeUpdateNotificationMsg, TsKvProto and KeyValueProto messages the server sends shared attribute updates as
+constexpr uint32_t ATTRIBUTE_UPDATE_SHARED_UPDATED_FIELD = 1U;
+constexpr uint32_t ATTRIBUTE_UPDATE_SHARED_DELETED_FIELD = 2U;
+constexpr uint32_t TS_KV_KV_FIELD = 2U;
+constexpr uint32_t KEY_VALUE_KEY_FIELD = 1U;
+constexpr uint32_t KEY_VALUE_TYPE_FIELD = 2U;
+constexpr uint32_t KEY_VALUE_BOOL_FIELD = 3U;
+constexpr uint32_t KEY_VALUE_LONG_FIELD = 4U;
+constexpr uint32_t KEY_VALUE_DOUBLE_FIELD = 5U;
+constexpr uint32_t KEY_VALUE_STRING_FIELD = 6U;
+constexpr uint32_t KEY_VALUE_JSON_FIELD = 7U;
+// Values of the KeyValueType enum, that decides which value of the KeyValueProto message is set
+constexpr uint64_t KEY_VALUE_TYPE_BOOLEAN = 0U;
+constexpr uint64_t KEY_VALUE_TYPE_LONG = 1U;
+constexpr uint64_t KEY_VALUE_TYPE_DOUBLE = 2U;
+// Field numbers of the default RpcRequestMsg and RpcResponseMsg schema of the device profile
+constexpr uint32_t RPC_REQUEST_METHOD_FIELD = 1U;
+constexpr uint32_t RPC_REQUEST_PARAMS_FIELD = 3U;
+constexpr uint32_t RPC_RESPONSE_PAYLOAD_FIELD = 1U;
+// Amount of key-value pairs a decoded RPC request consists of, which are the method and the params
+constexpr size_t RPC_REQUEST_NODE_COUNT = 2U;
+
+
+/// @brief Sequential reader over a protobuf encoded message, every read method moves the current position behind the read value and fails if the message ends before the value does
+struct Protobuf_Reader {
+    uint8_t *current = {}; // Current read position inside of the message
+    uint8_t *end = {};     // End of the message
+
+    /// @brief Whether the complete message has been read
+    /// @return Whether the current position is at the end of the message
+    bool At_End() const {
+        return current >= end;
+    }
+
+    /// @brief Reads a varint, which stores 7 bits of the value in each byte, starting with the least significant bits, as long as the most significant bit of the byte is set
+    /// @param value Read value
+    /// @return Whether a valid varint was read
+    bool Read_Varint(uint64_t & value) {
+        value = 0U;
+        for (size_t i = 0U; i < PROTOBUF_MAX_VARINT_LENGTH && current < end; i++) {
+            uint8_t const byte = *current++;
+            value |= static_cast<uint64_t>(byte & 0x7FU) << (7U * i);
+            if ((byte & 0x80U) == 0U) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Reads the tag preceding every field, which contains the field number and the wire type
+    /// @param number Read field number
+    /// @param wire_type Read wire type, decides how the value of the field is encoded
+    /// @return Whether a valid tag was read
+    bool Read_Tag(uint32_t & number, uint8_t & wire_type) {
+        uint64_t tag = 0U;
+        if (!Read_Varint(tag)) {
+            return false;
+        }
+        number = static_cast<uint32_t>(tag >> 3U);
+        wire_type = static_cast<uint8_t>(tag & 0x07U);
+        return number != 0U;
+    }
+
+    /// @brief Reads a value with a fixed size, which is stored in little endian
+    /// @param size Size of the value in bytes, either 4 or 8
+    /// @param value Read value
+    /// @return Whether the message contained enough bytes
+    bool Read_Fixed(size_t const & size, uint64_t & value) {
+        if (static_cast<size_t>(end - current) < size) {
+            return false;
+        }
+        value = 0U;
+        for (size_t i = 0U; i < size; i++) {
+            value |= static_cast<uint64_t>(current[i]) << (8U * i);
+        }
+        current += size;
+        return true;
+    }
+
+    /// @brief Reads a length delimited value, which is either a string or a nested message
+    /// @param begin Start of the value inside of the message
+    /// @param length Length of the value
+    /// @return Whether the message contained the complete value
+    bool Read_Length_Delimited(uint8_t * & begin, size_t & length) {
+        uint64_t value = 0U;
+        if (!Read_Varint(value) || value > static_cast<uint64_t>(end - current)) {
+            return false;
+        }
+        begin = current;
+        length = static_cast<size_t>(value);
+        current += length;
+        return true;
+    }
+
+    /// @brief Reads a string and null terminates it in place. The bytes of the string are moved one byte to the front, over the last byte of its length, which has already been read,
+    /// meaning the null terminator can be written into the last byte of the string without overwriting the following field
+    /// @param string Start of the null terminated string
+    /// @return Whether the message contained the complete string
+    bool Read_String(char const * & string) {
+        uint8_t * begin = nullptr;
+        size_t length = 0U;
+        if (!Read_Length_Delimited(begin, length)) {
+            return false;
+        }
+        char * const moved = reinterpret_cast<char *>(begin - 1U);
+        memmove(moved, begin, length);
+        moved[length] = '\0';
+        string = moved;
+        return true;
+    }
+
+    /// @brief Skips the value of a field that is not required
+    /// @param wire_type Wire type of the field
+    /// @return Whether the value was valid and skipped successfully, groups are deprecated and therefore not supported
+    bool Skip_Value(uint8_t const & wire_type) {
+        uint64_t value = 0U;
+        uint8_t * begin = nullptr;
+        size_t length = 0U;
+        switch (wire_type) {
+            case PROTOBUF_WIRE_VARINT:
+                return Read_Varint(value);
+            case PROTOBUF_WIRE_FIXED64:
+                return Read_Fixed(8U, value);
+            case PROTOBUF_WIRE_LENGTH_DELIMITED:
+                return Read_Length_Delimited(begin, length);
+            case PROTOBUF_WIRE_FIXED32:
+                return Read_Fixed(4U, value);
+            default:
+                return false;
+        }
+    }
+};
+
+
+/// @brief Writes the given value as a varint into the given buffer
+/// @param current Position in the buffer the varint should be written at
+/// @param end End of the buffer
+/// @param value Value that should be written
+/// @return Position directly after the written varint, or nullptr if it did not fit
+uint8_t * Protobuf_Write_Varint(uint8_t * current, uint8_t const * end, uint64_t value) {
+    do {
+        if (current >= end) {
+            return nullptr;
+        }
+        uint8_t const byte = static_cast<uint8_t>(value & 0x7FU);
+        value >>= 7U;
+        *current++ = value != 0U ? (byte | 0x80U) : byte;
+    } while (value != 0U);
+    return current;
+}
+
+/// @brief Writes the tag of a field into the given buffer
+/// @param current Position in the buffer the tag should be written at
+/// @param end End of the buffer
+/// @param number Number of the field
+/// @param wire_type Wire type the value of the field is encoded with
+/// @return Position directly after the written tag, or nullptr if it did not fit
+uint8_t * Protobuf_Write_Tag(uint8_t * current, uint8_t const * end, uint32_t const & number, uint8_t const & wire_type) {
+    return Protobuf_Write_Varint(current, end, (static_cast<uint64_t>(number) << 3U) | wire_type);
+}
+
+/// @brief Writes the given value with a fixed size in little endian into the given buffer
+/// @param current Position in the buffer the value should be written at
+/// @param end End of the buffer
+/// @param value Value that should be written
+/// @param size Size of the value in bytes, either 4 or 8
+/// @return Position directly after the written value, or nullptr if it did not fit
+uint8_t * Protobuf_Write_Fixed(uint8_t * current, uint8_t const * end, uint64_t const & value, size_t const & size) {
+    if (current == nullptr || static_cast<size_t>(end - current) < size) {
+        return nullptr;
+    }
+    for (size_t i = 0U; i < size; i++) {
+        *current++ = static_cast<uint8_t>(value >> (8U * i));
+    }
+    return current;
+}
+
+/// @brief Writes the given json value as a string field, strings are written as is and every other value as its serialized json
+/// @param current Position in the buffer the field should be written at
+/// @param end End of the buffer
+/// @param number Number of the field
+/// @param value Json value that should be written
+/// @return Position directly after the written field, or nullptr if it did not fit
+uint8_t * Protobuf_Write_String(uint8_t * current, uint8_t const * end, uint32_t const & number, JsonVariantConst const & value) {
+    char const * const string = value.is<char const *>() ? value.as<char const *>() : nullptr;
+    size_t const length = string != nullptr ? strlen(string) : measureJson(value);
+    current = Protobuf_Write_Tag(current, end, number, PROTOBUF_WIRE_LENGTH_DELIMITED);
+    if (current != nullptr) {
+        current = Protobuf_Write_Varint(current, end, length);
+    }
+    // Serializing always writes a null terminator after the json, which therefore requires one additional byte that is overwritten by the following field
+    if (current == nullptr || static_cast<size_t>(end - current) < length + (string != nullptr ? 0U : 1U)) {
+        return nullptr;
+    }
+    if (string != nullptr) {
+        memcpy(current, string, length);
+    }
+    else if (serializeJson(value, reinterpret_cast<char *>(current), length + 1U) != length) {
+        return nullptr;
+    }
+    return current + length;
+}
+
+/// @brief Writes the given json value as the given field
+/// @param current Position in the buffer the field should be written at
+/// @param end End of the buffer
+/// @param field Field the value should be written as
+/// @param value Json value that should be written
+/// @return Position directly after the written field, or nullptr if it did not fit or the value does not match the type of the field
+uint8_t * Protobuf_Write_Field(uint8_t * current, uint8_t const * end, Protobuf_Field const & field, JsonVariantConst const & value) {
+    if (field.type == Protobuf_Field_Type::STRING) {
+        return Protobuf_Write_String(current, end, field.number, value);
+    }
+    else if (field.type == Protobuf_Field_Type::BOOL) {
+        if (!value.is<bool>()) {
+            return nullptr;
+        }
+        current = Protobuf_Write_Tag(current, end, field.number, PROTOBUF_WIRE_VARINT);
+        return current != nullptr ? Protobuf_Write_Varint(current, end, value.as<bool>() ? 1U : 0U) : nullptr;
+    }
+    else if (value.is<bool>() || !(value.is<int64_t>() || value.is<uint64_t>() || value.is<double>())) {
+        return nullptr;
+    }
+
+    switch (field.type) {
+        case Protobuf_Field_Type::INT32:
+        case Protobuf_Field_Type::INT64:
+            current = Protobuf_Write_Tag(current, end, field.number, PROTOBUF_WIRE_VARINT);
+            return current != nullptr ? Protobuf_Write_Varint(current, end, static_cast<uint64_t>(value.as<int64_t>())) : nullptr;
+        case Protobuf_Field_Type::UINT32:
+        case Protobuf_Field_Type::UINT64:
+            current = Protobuf_Write_Tag(current, end, field.number, PROTOBUF_WIRE_VARINT);
+            return current != nullptr ? Protobuf_Write_Varint(current, end, value.as<uint64_t>()) : nullptr;
+        case Protobuf_Field_Type::SINT32:
+        case Protobuf_Field_Type::SINT64: {
+            // Zigzag encoding maps signed to unsigned integers, so that values with a small absolute value have a short varint, 0 = 0, -1 = 1, 1 = 2, -2 = 3, ...
+            int64_t const signed_value = value.as<int64_t>();
+            uint64_t const zigzag = (static_cast<uint64_t>(signed_value) << 1U) ^ static_cast<uint64_t>(signed_value >> 63U);
+            current = Protobuf_Write_Tag(current, end, field.number, PROTOBUF_WIRE_VARINT);
+            return current != nullptr ? Protobuf_Write_Varint(current, end, zigzag) : nullptr;
+        }
+        case Protobuf_Field_Type::FLOAT: {
+            float const real = value.as<float>();
+            uint32_t bits = 0U;
+            memcpy(&bits, &real, sizeof(bits));
+            return Protobuf_Write_Fixed(Protobuf_Write_Tag(current, end, field.number, PROTOBUF_WIRE_FIXED32), end, bits, sizeof(bits));
+        }
+        case Protobuf_Field_Type::DOUBLE: {
+            double const real = value.as<double>();
+            uint64_t bits = 0U;
+            memcpy(&bits, &real, sizeof(bits));
+            return Protobuf_Write_Fixed(Protobuf_Write_Tag(current, end, field.number, PROTOBUF_WIRE_FIXED64), end, bits, sizeof(bits));
+        }
+        default:
+            return nullptr;
+    }
+}
+
+/// @brief Decodes a single KeyValueProto message and writes it as a key-value pair into the given document
+/// @param reader Reader over the nested KeyValueProto message
+/// @param destination JsonDocument the key-value pair should be written into
+/// @return Whether the message was valid and the key-value pair could be written
+bool Protobuf_Decode_Key_Value(Protobuf_Reader & reader, JsonDocument & destination) {
+    char const * key = nullptr;
+    char const * string = nullptr;
+    uint64_t type = KEY_VALUE_TYPE_BOOLEAN;
+    uint64_t integer = 0U;
+    uint64_t real = 0U;
+    while (!reader.At_End()) {
+        uint32_t number = 0U;
+        uint8_t wire_type = 0U;
+        if (!reader.Read_Tag(number, wire_type)) {
+            return false;
+        }
+        bool valid = false;
+        if (number == KEY_VALUE_KEY_FIELD && wire_type == PROTOBUF_WIRE_LENGTH_DELIMITED) {
+            valid = reader.Read_String(key);
+        }
+        else if (number == KEY_VALUE_TYPE_FIELD && wire_type == PROTOBUF_WIRE_VARINT) {
+            valid = reader.Read_Varint(type);
+        }
+        else if ((number == KEY_VALUE_BOOL_FIELD || number == KEY_VALUE_LONG_FIELD) && wire_type == PROTOBUF_WIRE_VARINT) {
+            valid = reader.Read_Varint(integer);
+        }
+        else if (number == KEY_VALUE_DOUBLE_FIELD && wire_type == PROTOBUF_WIRE_FIXED64) {
+            valid = reader.Read_Fixed(sizeof(real), real);
+        }
+        else if ((number == KEY_VALUE_STRING_FIELD || number == KEY_VALUE_JSON_FIELD) && wire_type == PROTOBUF_WIRE_LENGTH_DELIMITED) {
+            valid = reader.Read_String(string);
+        }
+        else {
+            valid = reader.Skip_Value(wire_type);
+        }
+        if (!valid) {
+            return false;
+        }
+    }
+    if (key == nullptr) {
+        return false;
+    }
+
+    // Values that are equal to their default value are omitted by the server, therefore missing values are written as their default value
+    switch (type) {
+        case KEY_VALUE_TYPE_BOOLEAN:
+            return destination[key].set(integer != 0U);
+        case KEY_VALUE_TYPE_LONG:
+            return destination[key].set(static_cast<int64_t>(integer));
+        case KEY_VALUE_TYPE_DOUBLE: {
+            double value = 0.0;
+            memcpy(&value, &real, sizeof(value));
+            return destination[key].set(value);
+        }
+        default:
+            return destination[key].set(string != nullptr ? string : "");
+    }
+}
+
+/// @brief Decodes the AttributeUpdateNotificationMsg the server sends shared attribute updates as, into the same json the server sends if the device profile uses json
+/// @param reader Reader over the complete message
+/// @param destination JsonDocument the updated attributes should be written into, deleted attributes are written into an array with the key PROTOBUF_DELETED_ATTRIBUTES_KEY
+/// @return Whether the message was valid and could be decoded successfully
+bool Protobuf_Decode_Attribute_Update(Protobuf_Reader & reader, JsonDocument & destination) {
+    JsonArray deleted;
+    while (!reader.At_End()) {
+        uint32_t number = 0U;
+        uint8_t wire_type = 0U;
+        if (!reader.Read_Tag(number, wire_type)) {
+            return false;
+        }
+        if (number == ATTRIBUTE_UPDATE_SHARED_UPDATED_FIELD && wire_type == PROTOBUF_WIRE_LENGTH_DELIMITED) {
+            Protobuf_Reader ts_kv = {};
+            size_t length = 0U;
+            if (!reader.Read_Length_Delimited(ts_kv.current, length)) {
+                return false;
+            }
+            ts_kv.end = ts_kv.current + length;
+            // The timestamp of the TsKvProto message is skipped, because it is not part of the json the server sends either
+            while (!ts_kv.At_End()) {
+                if (!ts_kv.Read_Tag(number, wire_type)) {
+                    return false;
+                }
+                if (number != TS_KV_KV_FIELD || wire_type != PROTOBUF_WIRE_LENGTH_DELIMITED) {
+                    if (!ts_kv.Skip_Value(wire_type)) {
+                        return false;
+                    }
+                    continue;
+                }
+                Protobuf_Reader key_value = {};
+                if (!ts_kv.Read_Length_Delimited(key_value.current, length)) {
+                    return false;
+                }
+                key_value.end = key_value.current + length;
+                if (!Protobuf_Decode_Key_Value(key_value, destination)) {
+                    return false;
+                }
+            }
+        }
+        else if (number == ATTRIBUTE_UPDATE_SHARED_DELETED_FIELD && wire_type == PROTOBUF_WIRE_LENGTH_DELIMITED) {
+            char const * key = nullptr;
+            if (!reader.Read_String(key)) {
+                return false;
+            }
+            if (deleted.isNull()) {
+                deleted = destination.createNestedArray(PROTOBUF_DELETED_ATTRIBUTES_KEY);
+            }
+            if (!deleted.add(key)) {
+                return false;
+            }
+        }
+        else if (!reader.Skip_Value(wire_type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief Decodes the RpcRequestMsg of the default RPC request schema, into the same json the server sends if the device profile uses json
+/// @param reader Reader over the complete message
+/// @param destination JsonDocument the method and params of the request should be written into
+/// @return Whether the message was valid and could be decoded successfully
+bool Protobuf_Decode_RPC_Request(Protobuf_Reader & reader, JsonDocument & destination) {
+    while (!reader.At_End()) {
+        uint32_t number = 0U;
+        uint8_t wire_type = 0U;
+        if (!reader.Read_Tag(number, wire_type)) {
+            return false;
+        }
+        bool valid = false;
+        char const * string = nullptr;
+        if ((number == RPC_REQUEST_METHOD_FIELD || number == RPC_REQUEST_PARAMS_FIELD) && wire_type == PROTOBUF_WIRE_LENGTH_DELIMITED) {
+            valid = reader.Read_String(string) && destination[number == RPC_REQUEST_METHOD_FIELD ? RPC_METHOD_KEY : RPC_PARAMS_KEY].set(string);
+        }
+        else {
+            valid = reader.Skip_Value(wire_type);
+        }
+        if (!valid) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief Counts the entries of the AttributeUpdateNotificationMsg, without decoding them
+/// @param reader Reader over the complete message
+/// @return Amount of key-value pairs the decoded message consists of, or 0 if the message is invalid
+size_t Protobuf_Count_Attribute_Update(Protobuf_Reader & reader) {
+    size_t updated = 0U;
+    size_t deleted = 0U;
+    while (!reader.At_End()) {
+        uint32_t number = 0U;
+        uint8_t wire_type = 0U;
+        if (!reader.Read_Tag(number, wire_type) || !reader.Skip_Value(wire_type)) {
+            return 0U;
+        }
+        updated += number == ATTRIBUTE_UPDATE_SHARED_UPDATED_FIELD ? 1U : 0U;
+        deleted += number == ATTRIBUTE_UPDATE_SHARED_DELETED_FIELD ? 1U : 0U;
+    }
+    // The array containing the deleted attributes requires an additional key-value pair in the object itself
+    return updated + (deleted != 0U ? deleted + 1U : 0U);
+}
+
+Protobuf_Codec::Protobuf_Codec(Protobuf_Field const * telemetry_first, Protobuf_Field const * telemetry_last, Protobuf_Field const * attribute_first, Protobuf_Field const * attribute_last)
+  : m_telemetry_first(telemetry_first)
+  , m_telemetry_last(telemetry_last)
+  , m_attribute_first(attribute_first)
+  , m_attribute_last(attribute_last)
+{
+    // Nothing to do
+}
+
+bool Protobuf_Codec::Is_Encoded_Topic(char const * topic) const {
+    return strncmp(topic, TELEMETRY_TOPIC, sizeof(TELEMETRY_TOPIC)) == 0
+        || strncmp(topic, ATTRIBUTE_TOPIC, sizeof(ATTRIBUTE_TOPIC)) == 0
+        || strncmp(topic, RPC_RESPONSE_TOPIC, strlen(RPC_RESPONSE_TOPIC)) == 0;
+}
+
+bool Protobuf_Codec::Is_Decoded_Topic(char const * topic) const {
+    return strncmp(topic, ATTRIBUTE_TOPIC, sizeof(ATTRIBUTE_TOPIC)) == 0
+        || strncmp(topic, RPC_REQUEST_TOPIC, strlen(RPC_REQUEST_TOPIC)) == 0;
+}
+
+size_t Protobuf_Codec::Encode(char const * topic, JsonDocument const & source, uint8_t * buffer, size_t const & buffer_size) const {
+    if (buffer == nullptr) {
+        return 0U;
+    }
+    else if (strncmp(topic, TELEMETRY_TOPIC, sizeof(TELEMETRY_TOPIC)) == 0) {
+        return Encode_Message(m_telemetry_first, m_telemetry_last, source, buffer, buffer_size);
+    }
+    else if (strncmp(topic, ATTRIBUTE_TOPIC, sizeof(ATTRIBUTE_TOPIC)) == 0) {
+        return Encode_Message(m_attribute_first, m_attribute_last, source, buffer, buffer_size);
+    }
+    // Response to an RPC request, which is always sent as its serialized json in the single field of the default RpcResponseMsg schema
+    uint8_t * const end = Protobuf_Write_String(buffer, buffer + buffer_size, RPC_RESPONSE_PAYLOAD_FIELD, source.as<JsonVariantConst>());
+    return end != nullptr ? end - buffer : 0U;
+}
+
+size_t Protobuf_Codec::Get_Decoded_Node_Count(char const * topic, uint8_t const * payload, size_t const & length) const {
+    Protobuf_Reader reader = {};
+    reader.current = const_cast<uint8_t *>(payload);
+    reader.end = reader.current + length;
+    if (strncmp(topic, ATTRIBUTE_TOPIC, sizeof(ATTRIBUTE_TOPIC)) == 0) {
+        return Protobuf_Count_Attribute_Update(reader);
+    }
+    return RPC_REQUEST_NODE_COUNT;
+}
+
+bool Protobuf_Codec::Decode(char const * topic, uint8_t * payload, size_t const & length, JsonDocument & destination) const {
+    Protobuf_Reader reader = {};
+    reader.current = payload;
+    reader.end = payload + length;
+    // Ensures the root is an object, even if the message does not contain any fields, because every value is omitted if it is equal to its default value
+    (void)destination.to<JsonObject>();
+    if (strncmp(topic, ATTRIBUTE_TOPIC, sizeof(ATTRIBUTE_TOPIC)) == 0) {
+        return Protobuf_Decode_Attribute_Update(reader, destination);
+    }
+    return Protobuf_Decode_RPC_Request(reader, destination);
+}
+
+Protobuf_Field const * Protobuf_Codec::Find_Field(Protobuf_Field const * first, Protobuf_Field const * last, char const * key) {
+    for (Protobuf_Field const * field = first; field != last; field++) {
+        if (strcmp(field->key, key) == 0) {
+            return field;
+        }
+    }
+    return nullptr;
+}
+
+size_t Protobuf_Codec::Encode_Message(Protobuf_Field const * first, Protobuf_Field const * last, JsonDocument const & source, uint8_t * buffer, size_t const & buffer_size) {
+    JsonObjectConst const object = source.as<JsonObjectConst>();
+    if (object.isNull()) {
+        return 0U;
+    }
+    uint8_t * current = buffer;
+    uint8_t const * const end = buffer + buffer_size;
+    for (JsonPairConst const & pair : object) {
+        JsonVariantConst const value = pair.value();
+        // Unset fields are simply not written, which is the same as sending null for the key in json
+        if (value.isNull()) {
+            continue;
+        }
+        Protobuf_Field const * const field = Find_Field(first, last, pair.key().c_str());
+        if (field == nullptr) {
+            return 0U;
+        }
+        current = Protobuf_Write_Field(current, end, *field, value);
+        if (current == nullptr) {
+            return 0U;
+        }
+    }
+    return current - buffer;
+}
@@ -0,0 +1,98 @@
+#ifndef Protobuf_Codec_h
+#define Protobuf_Codec_h
+
+// Local includes.
+#include "IPayload_Codec.h"
+
+
+// Key the deleted shared attributes are decoded into, which is the same key the server uses when it sends the notification as json
+char constexpr PROTOBUF_DELETED_ATTRIBUTES_KEY[] = "deleted";
+
+
+/// @brief Scalar value types a field of a protobuf message can be encoded as, see https://protobuf.dev/programming-guides/proto3/#scalar for more information
+enum class Protobuf_Field_Type : uint8_t {
+    BOOL,   ///< Encoded as a varint with the value 0 or 1, the json value has to be a boolean
+    INT32,  ///< Encoded as a varint, negative values always require 10 bytes, the json value has to be a number
+    INT64,  ///< Encoded as a varint, negative values always require 10 bytes, the json value has to be a number
+    UINT32, ///< Encoded as a varint, the json value has to be a number
+    UINT64, ///< Encoded as a varint, the json value has to be a number
+    SINT32, ///< Encoded as a zigzag varint, which is more efficient for negative values, the json value has to be a number
+    SINT64, ///< Encoded as a zigzag varint, which is more efficient for negative values, the json value has to be a number
+    FLOAT,  ///< Encoded as 4 bytes, the json value has to be a number
+    DOUBLE, ///< Encoded as 8 bytes, the json value has to be a number
+    STRING  ///< Encoded as its length followed by the bytes of the string, any json value that is not a string is written as its serialized json instead
+};
+
+
+/// @brief Maps a key of the json key-value pairs to the field number and type of the field it is encoded as in the protobuf message,
+/// has to match the field with the same name in the message schema that is configured in the device profile on the server
+struct Protobuf_Field {
+    char const          *key = {};   // Key of the json key-value pair, has to be the same as the name of the field in the message schema
+    uint32_t            number = {}; // Number of the field in the message schema
+    Protobuf_Field_Type type = {};   // Type of the field in the message schema
+
+    /// @brief Constructor
+    /// @param key Key of the json key-value pair, has to be the same as the name of the field in the message schema
+    /// @param number Number of the field in the message schema, has to be between 1 and 536870911
+    /// @param type Type of the field in the message schema
+    constexpr Protobuf_Field(char const * key, uint32_t const & number, Protobuf_Field_Type const & type)
+      : key(key)
+      , number(number)
+      , type(type)
+    {
+        // Nothing to do
+    }
+};
+
+
+/// @brief Codec that converts telemetry, attributes and server-side RPC from and into protobuf instead of json, the same as nanopb would, but without requiring generated code.
+/// Requires the transport payload type of the device profile on the server to be set to protobuf. Telemetry and attributes are encoded as a single message, with the fields described by the given tables,
+/// which have to match the telemetry and attributes schema configured in the device profile. Only flat objects can be encoded, because nested messages are not supported by the tables,
+/// nested objects or arrays can instead be sent as their serialized json, by mapping them to a field with the type string.
+/// Shared attribute updates are decoded from the fixed AttributeUpdateNotificationMsg the server always sends, RPC requests and responses are decoded and encoded with the default RPC schemas of the device profile,
+/// RpcRequestMsg { string method = 1; int32 requestId = 2; string params = 3; } and RpcResponseMsg { string payload = 1; }.
+/// The params of the request are therefore passed to the RPC callback as the string containing their json and the complete response is sent as its serialized json.
+/// Every other topic, meaning attribute requests, client-side RPC, claiming, provisioning and firmware updates keep using json
+class Protobuf_Codec : public IPayload_Codec {
+  public:
+    /// @brief Constructor, the tables are not copied and have to be kept alive for as long as the instance of this class, which is usually done by declaring them as global constexpr arrays
+    /// @param telemetry_first Pointer to the first field of the telemetry schema
+    /// @param telemetry_last Pointer to the end of the telemetry schema (last field + 1)
+    /// @param attribute_first Pointer to the first field of the attributes schema
+    /// @param attribute_last Pointer to the end of the attributes schema (last field + 1)
+    Protobuf_Codec(Protobuf_Field const * telemetry_first, Protobuf_Field const * telemetry_last, Protobuf_Field const * attribute_first, Protobuf_Field const * attribute_last);
+
+    bool Is_Encoded_Topic(char const * topic) const override;
+
+    bool Is_Decoded_Topic(char const * topic) const override;
+
+    size_t Encode(char const * topic, JsonDocument const & source, uint8_t * buffer, size_t const & buffer_size) const override;
+
+    size_t Get_Decoded_Node_Count(char const * topic, uint8_t const * payload, size_t const & length) const override;
+
+    bool Decode(char const * topic, uint8_t * payload, size_t const & length, JsonDocument & destination) const override;
+
+  private:
+    /// @brief Searches the field with the given key in the given table
+    /// @param first Pointer to the first field of the table
+    /// @param last Pointer to the end of the table (last field + 1)
+    /// @param key Key of the json key-value pair that should be encoded
+    /// @return Pointer to the found field or nullptr if the table does not contain the given key
+    static Protobuf_Field const * Find_Field(Protobuf_Field const * first, Protobuf_Field const * last, char const * key);
+
+    /// @brief Encodes every key-value pair of the given json object as the field with the same key in the given table
+    /// @param first Pointer to the first field of the table
+    /// @param last Pointer to the end of the table (last field + 1)
+    /// @param source JsonDocument containing a flat object with the key value pairs that should be encoded, null values are omitted the same as unset fields
+    /// @param buffer Buffer the encoded message should be written into
+    /// @param buffer_size Size of the given buffer
+    /// @return Length of the encoded message, or 0 if a key is not contained in the table, a value does not match the type of its field or the message did not fit into the buffer
+    static size_t Encode_Message(Protobuf_Field const * first, Protobuf_Field const * last, JsonDocument const & source, uint8_t * buffer, size_t const & buffer_size);
+
+    Protobuf_Field const *m_telemetry_first = {}; // Pointer to the first field of the telemetry schema
+    Protobuf_Field const *m_telemetry_last = {};  // Pointer to the end of the telemetry schema
+    Protobuf_Field const *m_attribute_first = {}; // Pointer to the first field of the attributes schema
+    Protobuf_Field const *m_attribute_last = {};  // Pointer to the end of the attributes schema
+};
+
+#endif // Protobuf_Codec_h
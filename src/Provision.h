@@ -4,6 +4,7 @@
 // Local includes.
 #include "Provision_Callback.h"
 #include "IAPI_Implementation.h"
+#include "Subscription_Reference.h"
 
 
 // Provision topics.
@@ -87,8 +88,8 @@ class Provision : public IAPI_Implementation {
         }
         request_buffer[PROV_DEVICE_KEY] = provision_device_key;
         request_buffer[PROV_DEVICE_SECRET_KEY] = provision_device_secret;
-        m_provision_callback.Start_Timeout_Timer();
-        return m_send_json_callback.Call_Callback(PROV_REQUEST_TOPIC, request_buffer, Helper::Measure_Json(request_buffer));
+        m_provision_callback.Start_Timeout_Timer(m_client != nullptr ? &m_client->getTimerQueue() : nullptr);
+        return m_client != nullptr && m_client->Send_Json(PROV_REQUEST_TOPIC, request_buffer, Helper::Measure_Json(request_buffer));
     }
 
     API_Process_Type Get_Process_Type() const override {
@@ -111,6 +112,11 @@ class Provision : public IAPI_Implementation {
         return strncmp(PROV_RESPONSE_TOPIC, topic, strlen(PROV_RESPONSE_TOPIC) + 1) == 0;
     }
 
+    char const * Get_Response_Topic(bool & is_prefix) const override {
+        is_prefix = false;
+        return PROV_RESPONSE_TOPIC;
+    }
+
     bool Unsubscribe() override {
         return Provision_Unsubscribe();
     }
@@ -118,14 +124,14 @@ class Provision : public IAPI_Implementation {
     bool Resubscribe_Topic() override {
         // Unsubscription required only if we are currently subscribed to the topic
         if (m_provision_callback.Get_Device_Key() != nullptr) {
-            return Unsubscribe() && m_subscribe_topic_callback.Call_Callback(PROV_RESPONSE_TOPIC);
+            return Unsubscribe() && m_response_subscription.Acquire(m_client);
         }
         return true;
     }
 
 #if !THINGSBOARD_USE_ESP_TIMER
     void loop() override {
-        m_provision_callback.Update_Timeout_Timer();
+        // Nothing to do, because the timeout of the sent request is handled by the timer queue of the client
     }
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
@@ -133,10 +139,8 @@ class Provision : public IAPI_Implementation {
         // Nothing to do
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
-        m_send_json_callback.Set_Callback(send_json_callback);
-        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
-        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
+    void Set_Client(IThingsBoard_Client & client) override {
+        m_client = &client;
     }
 
 private:
@@ -145,7 +149,7 @@ private:
     /// @param callback Callback method that will be called
     /// @return Whether requesting the given callback was successful or not
     bool Provision_Subscribe(Provision_Callback const & callback) {
-        if (!m_subscribe_topic_callback.Call_Callback(PROV_RESPONSE_TOPIC)) {
+        if (!m_response_subscription.Acquire(m_client)) {
             Logger::printfln(SUBSCRIBE_TOPIC_FAILED, PROV_RESPONSE_TOPIC);
             return false;
         }
@@ -158,12 +162,11 @@ private:
     /// and from the provision response topic, was successful or not
     bool Provision_Unsubscribe() {
         m_provision_callback = Provision_Callback();
-        return m_unsubscribe_topic_callback.Call_Callback(PROV_RESPONSE_TOPIC);
+        return m_response_subscription.Release(m_client);
     }
 
-    Callback<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};         // Send json document callback
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};   // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {}; // Unubscribe mqtt topic client callback
+    IThingsBoard_Client                                                     *m_client = {};                     // Client the api implementation communicates with the cloud over
+    Subscription_Reference                                                  m_response_subscription = Subscription_Reference(PROV_RESPONSE_TOPIC); // Reference to the provision response topic, acquired while a provision request is pending
 
     Provision_Callback                                                       m_provision_callback = {};         // Provision response callback
 };
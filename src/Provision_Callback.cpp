@@ -155,10 +155,14 @@ void Provision_Callback::Update_Timeout_Timer() {
 }
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
-void Provision_Callback::Start_Timeout_Timer() {
+void Provision_Callback::Start_Timeout_Timer(Timer_Queue * timer_queue) {
     if (m_timeout_microseconds == 0U) {
         return;
     }
+    if (timer_queue != nullptr) {
+        m_timeout_callback.once(*timer_queue, m_timeout_microseconds);
+        return;
+    }
     m_timeout_callback.once(m_timeout_microseconds);
 }
 
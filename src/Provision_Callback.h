@@ -171,7 +171,9 @@ class Provision_Callback : public Callback<void, JsonDocument const &> {
 
     /// @brief Starts the internal timeout timer if we actually received a configured valid timeout time and a valid callback.
     /// Is called as soon as the request is actually sent
-    void Start_Timeout_Timer();
+    /// @param timer_queue Queue the timeout should be scheduled in, which then calls the timeout callback from its own update() method.
+    /// If nullptr is passed the timeout is handled by the internal timer of the watchdog instead, default = nullptr
+    void Start_Timeout_Timer(Timer_Queue * timer_queue = nullptr);
 
     /// @brief Stops the internal timeout timer, is called as soon as an answer is received from the cloud
     /// if it isn't we call the previously subscribed callback instead
@@ -0,0 +1,62 @@
+#ifndef RAM_Outbox_Storage_h
+#define RAM_Outbox_Storage_h
+
+// Local include.
+#include "IOutbox_Storage.h"
+
+// Library include.
+#include <string.h>
+
+
+/// @brief IOutbox_Storage implementation that keeps the outbox in a buffer in memory, which is passed by the user and has to be kept alive for as long as the instance of this class.
+/// Messages are not persisted over a restart of the device, but survive a lost connection, without requiring any file system or flash partition.
+/// If the buffer is placed into memory that survives a software restart (RTC memory on the ESP32), the messages survive that restart as well
+class RAM_Outbox_Storage : public IOutbox_Storage {
+  public:
+    /// @brief Constructor
+    /// @param buffer Buffer the outbox is written into
+    /// @param size Size of the given buffer, has to be a multiple of the sector size
+    /// @param sector_size Size of a single sector, decides how many of the oldest messages are dropped at once if the outbox is full.
+    /// Messages bigger than the sector size can not be stored, default = 256
+    RAM_Outbox_Storage(uint8_t * buffer, size_t const & size, size_t const & sector_size = 256U)
+      : m_buffer(buffer)
+      , m_size(size)
+      , m_sector_size(sector_size)
+    {
+        // Nothing to do
+    }
+
+    bool begin() override {
+        return m_buffer != nullptr;
+    }
+
+    size_t get_size() const override {
+        return m_size;
+    }
+
+    size_t get_sector_size() const override {
+        return m_sector_size;
+    }
+
+    bool read(size_t const & offset, uint8_t * buffer, size_t const & size) override {
+        (void)memcpy(buffer, m_buffer + offset, size);
+        return true;
+    }
+
+    bool write(size_t const & offset, uint8_t const * buffer, size_t const & size) override {
+        (void)memcpy(m_buffer + offset, buffer, size);
+        return true;
+    }
+
+    bool erase_sector(size_t const & offset) override {
+        (void)memset(m_buffer + offset, 0xFF, m_sector_size);
+        return true;
+    }
+
+  private:
+    uint8_t *m_buffer = {};      // Buffer the outbox is written into
+    size_t  m_size = {};         // Size of the given buffer
+    size_t  m_sector_size = {};  // Size of a single sector
+};
+
+#endif // RAM_Outbox_Storage_h
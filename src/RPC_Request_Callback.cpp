@@ -50,10 +50,14 @@ void RPC_Request_Callback::Update_Timeout_Timer() {
 }
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
-void RPC_Request_Callback::Start_Timeout_Timer() {
+void RPC_Request_Callback::Start_Timeout_Timer(Timer_Queue * timer_queue) {
     if (m_timeout_microseconds == 0U) {
         return;
     }
+    if (timer_queue != nullptr) {
+        m_timeout_callback.once(*timer_queue, m_timeout_microseconds);
+        return;
+    }
     m_timeout_callback.once(m_timeout_microseconds);
 }
 
@@ -64,3 +68,7 @@ void RPC_Request_Callback::Stop_Timeout_Timer() {
 void RPC_Request_Callback::Set_Timeout_Callback(Callback_Watchdog::function timeout_callback) {
     m_timeout_callback = Callback_Watchdog(timeout_callback);
 }
+
+void RPC_Request_Callback::Set_Timeout_Listener(ITimeout_Listener * listener, size_t const & id) {
+    m_timeout_callback.Set_Listener(listener, id);
+}
@@ -67,7 +67,9 @@ class RPC_Request_Callback : public Callback<void, JsonDocument const &> {
 
     /// @brief Starts the internal timeout timer if we actually received a configured valid timeout time and a valid callback.
     /// Is called as soon as the request is actually sent
-    void Start_Timeout_Timer();
+    /// @param timer_queue Queue the timeout should be scheduled in, which then calls the timeout callback from its own update() method.
+    /// If nullptr is passed the timeout is handled by the internal timer of the watchdog instead, default = nullptr
+    void Start_Timeout_Timer(Timer_Queue * timer_queue = nullptr);
 
     /// @brief Stops the internal timeout timer, is called as soon as an answer is received from the cloud
     /// if it isn't we call the previously subscribed callback instead
@@ -77,6 +79,12 @@ class RPC_Request_Callback : public Callback<void, JsonDocument const &> {
     /// @param timeout_callback Callback function that will be called
     void Set_Timeout_Callback(Callback_Watchdog::function timeout_callback);
 
+    /// @brief Sets the listener that is informed once the request timed out, after the timeout callback has been called.
+    /// Used internally by the api implementation to remove the request that timed out, only applies if the timeout is scheduled in a Timer_Queue
+    /// @param listener Listener that should be informed, has to be kept alive for as long as the timeout timer is started
+    /// @param id Id the listener is informed with, the id the request was sent with
+    void Set_Timeout_Listener(ITimeout_Listener * listener, size_t const & id);
+
   private:
     char const                    *m_method_name = {};          // Method name
     JsonArray const               *m_parameters = {};          // Parameter json
@@ -0,0 +1,133 @@
+// Header include.
+#include "Rate_Limiter.h"
+
+// Library includes.
+#include <stdlib.h>
+
+/// @brief Amount of microseconds in a second, the durations of the limits are configured in seconds
+uint64_t constexpr RATE_LIMIT_MICROSECONDS_PER_SECOND = 1000000U;
+
+Rate_Limiter::Rate_Limiter(char const * message_limits, char const * data_point_limits)
+  : m_message_windows()
+  , m_message_windows_size(0U)
+  , m_data_point_windows()
+  , m_data_point_windows_size(0U)
+  , m_last_update(0U)
+  , m_started(false)
+{
+    (void)Set_Message_Limits(message_limits);
+    (void)Set_Data_Point_Limits(data_point_limits);
+}
+
+bool Rate_Limiter::Set_Message_Limits(char const * limits) {
+    return Parse_Limits(limits, m_message_windows, m_message_windows_size);
+}
+
+bool Rate_Limiter::Set_Data_Point_Limits(char const * limits) {
+    return Parse_Limits(limits, m_data_point_windows, m_data_point_windows_size);
+}
+
+bool Rate_Limiter::Try_Consume(size_t const & messages, size_t const & data_points, uint64_t const & now) {
+    if (Get_Wait_Time(messages, data_points, now) != 0U) {
+        return false;
+    }
+    Consume(m_message_windows, m_message_windows_size, messages);
+    Consume(m_data_point_windows, m_data_point_windows_size, data_points);
+    return true;
+}
+
+uint64_t Rate_Limiter::Get_Wait_Time(size_t const & messages, size_t const & data_points, uint64_t const & now) {
+    Update(now);
+    uint64_t const message_wait = Get_Wait_Time(m_message_windows, m_message_windows_size, messages);
+    uint64_t const data_point_wait = Get_Wait_Time(m_data_point_windows, m_data_point_windows_size, data_points);
+    return message_wait > data_point_wait ? message_wait : data_point_wait;
+}
+
+void Rate_Limiter::clear() {
+    for (size_t index = 0U; index < m_message_windows_size; index++) {
+        m_message_windows[index].available = m_message_windows[index].capacity * m_message_windows[index].duration;
+    }
+    for (size_t index = 0U; index < m_data_point_windows_size; index++) {
+        m_data_point_windows[index].available = m_data_point_windows[index].capacity * m_data_point_windows[index].duration;
+    }
+}
+
+bool Rate_Limiter::Parse_Limits(char const * limits, Rate_Limit_Window * windows, size_t & windows_size) {
+    windows_size = 0U;
+    if (limits == nullptr) {
+        return true;
+    }
+
+    size_t parsed = 0U;
+    char const * current = limits;
+    while (*current != '\0') {
+        char * end = nullptr;
+        unsigned long const capacity = strtoul(current, &end, 10);
+        if (end == current || *end != ':' || capacity == 0U || capacity > UINT32_MAX) {
+            return false;
+        }
+        current = end + 1U;
+        unsigned long const seconds = strtoul(current, &end, 10);
+        if (end == current || (*end != ',' && *end != '\0') || seconds == 0U || parsed == THINGSBOARD_RATE_LIMIT_MAX_WINDOWS) {
+            return false;
+        }
+        current = *end == ',' ? end + 1U : end;
+
+        Rate_Limit_Window & window = windows[parsed++];
+        window.capacity = static_cast<uint32_t>(capacity);
+        window.duration = seconds * RATE_LIMIT_MICROSECONDS_PER_SECOND;
+        window.available = window.capacity * window.duration;
+    }
+    windows_size = parsed;
+    return true;
+}
+
+void Rate_Limiter::Refill(Rate_Limit_Window * windows, size_t const & windows_size, uint64_t const & elapsed) {
+    for (size_t index = 0U; index < windows_size; index++) {
+        Rate_Limit_Window & window = windows[index];
+        uint64_t const full = window.capacity * window.duration;
+        // Checked before multiplying, because a long enough time without any message would otherwise overflow
+        if (elapsed >= window.duration || full - window.available <= elapsed * window.capacity) {
+            window.available = full;
+            continue;
+        }
+        window.available += elapsed * window.capacity;
+    }
+}
+
+uint64_t Rate_Limiter::Get_Wait_Time(Rate_Limit_Window const * windows, size_t const & windows_size, size_t const & amount) {
+    uint64_t wait = 0U;
+    for (size_t index = 0U; index < windows_size; index++) {
+        Rate_Limit_Window const & window = windows[index];
+        uint64_t const required = Get_Required(window, amount);
+        if (window.available >= required) {
+            continue;
+        }
+        // Rounded up, because the bucket is refilled by the capacity every microsecond
+        uint64_t const window_wait = (required - window.available + window.capacity - 1U) / window.capacity;
+        wait = window_wait > wait ? window_wait : wait;
+    }
+    return wait;
+}
+
+void Rate_Limiter::Consume(Rate_Limit_Window * windows, size_t const & windows_size, size_t const & amount) {
+    for (size_t index = 0U; index < windows_size; index++) {
+        windows[index].available -= Get_Required(windows[index], amount);
+    }
+}
+
+uint64_t Rate_Limiter::Get_Required(Rate_Limit_Window const & window, size_t const & amount) {
+    return (amount < window.capacity ? amount : window.capacity) * window.duration;
+}
+
+void Rate_Limiter::Update(uint64_t const & now) {
+    if (m_started && now > m_last_update) {
+        uint64_t const elapsed = now - m_last_update;
+        Refill(m_message_windows, m_message_windows_size, elapsed);
+        Refill(m_data_point_windows, m_data_point_windows_size, elapsed);
+    }
+    if (!m_started || now > m_last_update) {
+        m_last_update = now;
+    }
+    m_started = true;
+}
@@ -0,0 +1,107 @@
+#ifndef Rate_Limiter_h
+#define Rate_Limiter_h
+
+// Local include.
+#include "Configuration.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Single window of a rate limit of the Rate_Limiter, implemented as a token bucket that holds the capacity of the window and is refilled continuously over the duration of the window
+struct Rate_Limit_Window {
+    uint32_t capacity = {};  // Maximum amount of messages or data points that can be sent during the duration of the window
+    uint64_t duration = {};  // Duration of the window in microseconds
+    uint64_t available = {}; // Amount of tokens currently in the bucket multiplied with the duration, which allows to refill the bucket by a fraction of a token without requiring floating point numbers
+};
+
+
+/// @brief Client-side rate governor, that ensures the device never exceeds the message and data point rate limits configured for it on the server,
+/// which would otherwise disconnect the device and cause it to reconnect and burst its backlog again, exceeding the limits once more.
+/// The limits are configured in the same format as on the server, a comma separated list of windows consisting of the capacity and the duration in seconds, for example "10:1,300:60"
+/// allows 10 messages per second and 300 messages per minute. Every window is a token bucket, that starts full and is refilled continuously with the capacity spread over the duration of the window.
+/// A message can only be sent if every window of both the message and the data point limits contains enough tokens. The current time is always passed by the caller,
+/// which allows to use any monotonic clock, including a simulated one on the host. Passed to ThingsBoardSized::Set_Rate_Limiter(), which defers messages that exceed the limits into the Outbound_Queue,
+/// that therefore has to be set as well, instead of publishing them. The maximum amount of windows per limit is THINGSBOARD_RATE_LIMIT_MAX_WINDOWS
+class Rate_Limiter {
+  public:
+    /// @brief Constructor
+    /// @param message_limits Limits of the amount of published messages, for example "10:1,300:60", nullptr to not limit messages, default = nullptr
+    /// @param data_point_limits Limits of the amount of published telemetry and attribute data points, for example "200:1,6000:60", nullptr to not limit data points, default = nullptr
+    explicit Rate_Limiter(char const * message_limits = nullptr, char const * data_point_limits = nullptr);
+
+    /// @brief Configures the limits of the amount of published messages, replacing the previous limits and refilling every window
+    /// @param limits Comma separated list of windows consisting of the capacity and the duration in seconds, for example "10:1,300:60", nullptr or an empty string to not limit messages
+    /// @return Whether the limits were valid or not, invalid limits remove the previous limits as well
+    bool Set_Message_Limits(char const * limits);
+
+    /// @brief Configures the limits of the amount of published data points, replacing the previous limits and refilling every window
+    /// @param limits Comma separated list of windows consisting of the capacity and the duration in seconds, for example "200:1,6000:60", nullptr or an empty string to not limit data points
+    /// @return Whether the limits were valid or not, invalid limits remove the previous limits as well
+    bool Set_Data_Point_Limits(char const * limits);
+
+    /// @brief Takes the given amount of messages and data points from every window, if every window contains enough tokens, otherwise nothing is taken.
+    /// Amounts bigger than the capacity of a window are allowed once the window is completely full, so that a single big message can not block the sending forever
+    /// @param messages Amount of messages that should be sent
+    /// @param data_points Amount of data points contained in the messages
+    /// @param now Current time in microseconds of a monotonic clock
+    /// @return Whether the messages can be sent or have to be deferred
+    bool Try_Consume(size_t const & messages, size_t const & data_points, uint64_t const & now);
+
+    /// @brief Calculates how long it takes until every window contains enough tokens to send the given amount of messages and data points
+    /// @param messages Amount of messages that should be sent
+    /// @param data_points Amount of data points contained in the messages
+    /// @param now Current time in microseconds of a monotonic clock
+    /// @return Amount of microseconds until the messages can be sent, 0 if they can be sent immediately
+    uint64_t Get_Wait_Time(size_t const & messages, size_t const & data_points, uint64_t const & now);
+
+    /// @brief Refills every window completely, the configured limits are kept
+    void clear();
+
+  private:
+    /// @brief Parses the given limits into the given windows
+    /// @param limits Comma separated list of windows consisting of the capacity and the duration in seconds
+    /// @param windows Array the parsed windows are written into
+    /// @param windows_size Amount of windows that were parsed, 0 if the limits were invalid
+    /// @return Whether the limits were valid or not
+    static bool Parse_Limits(char const * limits, Rate_Limit_Window * windows, size_t & windows_size);
+
+    /// @brief Refills the given windows with the tokens accumulated over the given amount of time
+    /// @param windows Array of windows that should be refilled
+    /// @param windows_size Amount of windows in the array
+    /// @param elapsed Amount of microseconds since the windows were last refilled
+    static void Refill(Rate_Limit_Window * windows, size_t const & windows_size, uint64_t const & elapsed);
+
+    /// @brief Calculates how long it takes until every given window contains enough tokens for the given amount
+    /// @param windows Array of windows that should be checked
+    /// @param windows_size Amount of windows in the array
+    /// @param amount Amount of tokens that should be taken
+    /// @return Amount of microseconds until every window contains enough tokens
+    static uint64_t Get_Wait_Time(Rate_Limit_Window const * windows, size_t const & windows_size, size_t const & amount);
+
+    /// @brief Takes the given amount of tokens from every given window, every window has to contain enough tokens
+    /// @param windows Array of windows the tokens should be taken from
+    /// @param windows_size Amount of windows in the array
+    /// @param amount Amount of tokens that should be taken
+    static void Consume(Rate_Limit_Window * windows, size_t const & windows_size, size_t const & amount);
+
+    /// @brief Gets the amount of tokens that are taken from the given window, multiplied with its duration, amounts bigger than the capacity are taken as the whole capacity
+    /// @param window Window the tokens are taken from
+    /// @param amount Amount of tokens that should be taken
+    /// @return Amount of tokens multiplied with the duration of the window
+    static uint64_t Get_Required(Rate_Limit_Window const & window, size_t const & amount);
+
+    /// @brief Refills every window with the tokens accumulated since the last update
+    /// @param now Current time in microseconds of a monotonic clock
+    void Update(uint64_t const & now);
+
+    Rate_Limit_Window m_message_windows[THINGSBOARD_RATE_LIMIT_MAX_WINDOWS] = {};    // Windows limiting the amount of published messages
+    size_t            m_message_windows_size = {};                                   // Amount of configured message windows
+    Rate_Limit_Window m_data_point_windows[THINGSBOARD_RATE_LIMIT_MAX_WINDOWS] = {}; // Windows limiting the amount of published data points
+    size_t            m_data_point_windows_size = {};                                // Amount of configured data point windows
+    uint64_t          m_last_update = {};                                            // Time in microseconds the windows were last refilled at
+    bool              m_started = {};                                                // Whether the windows have been refilled atleast once, the first call only remembers the time, because every window starts full
+};
+
+#endif // Rate_Limiter_h
@@ -0,0 +1,171 @@
+#ifndef Request_Table_h
+#define Request_Table_h
+
+// Local includes.
+#include "Callback.h"
+
+
+// Amount of lower bits of a request id that contain the index of the slot the request is stored in, the remaining upper bits contain the generation of that slot
+size_t constexpr REQUEST_TABLE_INDEX_BITS = 8U;
+// Maximum amount of requests that can be pending at the same time, because the index of the slot has to fit into the lower bits of the request id
+size_t constexpr REQUEST_TABLE_MAX_SLOTS = 1U << REQUEST_TABLE_INDEX_BITS;
+// Log messages.
+#if THINGSBOARD_ENABLE_DYNAMIC
+char constexpr TOO_MANY_PENDING_REQUESTS[] = "Too many (%s) requests pending at the same time, at most (%u) are supported";
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+
+/// @brief Slab of pending requests, that are waiting for a response from the server, where the request id directly encodes where the request is stored.
+/// The lower bits of the id contain the index of the slot the request has been inserted into and the upper bits contain the generation the request has been inserted with,
+/// which is taken from a counter passed by the caller, that is incremented with every inserted request. Finding the request a received response belongs to is therefore a simple index into the slots instead of searching every pending request,
+/// and responses to requests that have already been removed, for example because they timed out and the slot has been reused since, are detected because the generation does not match anymore.
+/// Because the counter is owned by the caller, it can be persisted and restored after a restart, which ensures requests sent afterwards never reuse the id of a request whose response might still be delivered by a persistent session.
+/// Removed slots are kept in a free list and reused by the next inserted request, meaning removing a request never has to move any of the other pending requests
+#if THINGSBOARD_ENABLE_DYNAMIC
+/// @tparam T Type of the stored request, has to be default constructible and copy assignable
+template <typename T>
+#else
+/// @tparam T Type of the stored request, has to be default constructible and copy assignable
+/// @tparam Capacity Maximum amount of requests that can be pending at the same time, allows to allocate the slots on the stack instead of the heap
+template <typename T, size_t Capacity>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+class Request_Table {
+  public:
+#if !THINGSBOARD_ENABLE_DYNAMIC
+    static_assert(Capacity <= REQUEST_TABLE_MAX_SLOTS, "Request table can contain at most REQUEST_TABLE_MAX_SLOTS pending requests, because the slot index has to fit into the request id");
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+
+    /// @brief Constructor
+    Request_Table()
+      : m_slots()
+      , m_first_free(NO_FREE_SLOT)
+      , m_size(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Copies the given request into a free slot and calculates the id the request has to be sent with
+    /// @param request Request that should be stored until a response is received
+    /// @param generation Generation of the last inserted request, is incremented and then used as the generation of the given request, 0 is skipped when wrapping around,
+    /// to ensure no request is ever sent with an id of 0, which is returned if parsing the id fails
+    /// @param request_id Id the request has to be sent with, so that the response can be correlated with the stored request
+    /// @return Pointer to the stored copy of the request or nullptr if there is no free slot left.
+    /// Only valid until the next request is inserted, because inserting might have to relocate the slots if THINGSBOARD_ENABLE_DYNAMIC is set
+    T * Insert(T const & request, size_t & generation, size_t & request_id) {
+        size_t index = m_first_free;
+        if (index != NO_FREE_SLOT) {
+            m_first_free = m_slots[index].next_free;
+        }
+        else if (full()) {
+            return nullptr;
+        }
+        else {
+            m_slots.push_back(Slot());
+            index = m_slots.size() - 1U;
+        }
+
+        generation = (generation + 1U) & GENERATION_MASK;
+        generation = generation != 0U ? generation : 1U;
+        Slot & slot = m_slots[index];
+        slot.request = request;
+        slot.generation = generation;
+        slot.used = true;
+        m_size++;
+        request_id = (slot.generation << REQUEST_TABLE_INDEX_BITS) | index;
+        return &slot.request;
+    }
+
+    /// @brief Gets the pending request that was sent with the given id
+    /// @param request_id Id the response was received with
+    /// @return Pointer to the pending request or nullptr if there is no pending request with the given id, because it has already been removed
+    T * Find(size_t const & request_id) {
+        size_t const index = request_id & INDEX_MASK;
+        if (index >= m_slots.size()) {
+            return nullptr;
+        }
+        Slot & slot = m_slots[index];
+        if (!slot.used || slot.generation != (request_id >> REQUEST_TABLE_INDEX_BITS)) {
+            return nullptr;
+        }
+        return &slot.request;
+    }
+
+    /// @brief Removes the pending request that was sent with the given id and frees its slot to be reused by the next inserted request.
+    /// The request is replaced with a default constructed instance, which releases the callbacks and stops the timeout timer of the removed request
+    /// @param request_id Id the request was sent with
+    /// @return Whether there was a pending request with the given id that has been removed
+    bool Remove(size_t const & request_id) {
+        if (Find(request_id) == nullptr) {
+            return false;
+        }
+        Release(request_id & INDEX_MASK);
+        return true;
+    }
+
+    /// @brief Removes all pending requests, responses to the removed requests are not mistaken for responses to requests that are inserted afterwards,
+    /// because those are inserted with a newer generation
+    void clear() {
+        for (size_t index = 0U; index < m_slots.size(); index++) {
+            if (m_slots[index].used) {
+                Release(index);
+            }
+        }
+    }
+
+    /// @brief Whether there are any pending requests
+    /// @return Whether the table is empty or not
+    bool empty() const {
+        return m_size == 0U;
+    }
+
+    /// @brief Gets the amount of pending requests
+    /// @return Amount of pending requests
+    size_t size() const {
+        return m_size;
+    }
+
+    /// @brief Whether there is no free slot left for another request
+    /// @return Whether inserting another request would fail
+    bool full() const {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        return m_size >= REQUEST_TABLE_MAX_SLOTS;
+#else
+        return m_size >= Capacity;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
+  private:
+    static constexpr size_t NO_FREE_SLOT = REQUEST_TABLE_MAX_SLOTS;
+    static constexpr size_t INDEX_MASK = REQUEST_TABLE_MAX_SLOTS - 1U;
+    // Request ids are limited to 32-bit, even if size_t is bigger, because the server parses them as a 32-bit integer and they are formatted into topics with %u
+    static constexpr size_t GENERATION_MASK = static_cast<size_t>(static_cast<uint32_t>(-1)) >> REQUEST_TABLE_INDEX_BITS;
+
+    /// @brief Slot that contains a single pending request
+    struct Slot {
+        T      request = {};       // Pending request that is waiting for a response
+        size_t generation = {};    // Generation the pending request has been inserted with
+        size_t next_free = {};     // Index of the next slot in the free list, only valid while the slot is not used
+        bool   used = {};          // Whether the slot currently contains a pending request
+    };
+
+    /// @brief Removes the request from the slot at the given index and pushes the slot onto the free list
+    /// @param index Index of the slot that should be freed, has to be used
+    void Release(size_t const & index) {
+        Slot & slot = m_slots[index];
+        slot.request = T();
+        slot.used = false;
+        slot.next_free = m_first_free;
+        m_first_free = index;
+        m_size--;
+    }
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Vector<Slot>          m_slots = {};      // Slots that have been used at least once, grows until the maximum amount of pending requests has been reached once and is then only reused
+#else
+    Array<Slot, Capacity> m_slots = {};      // Slots that have been used at least once, grows until the capacity has been reached once and is then only reused
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    size_t                m_first_free = {}; // Index of the first slot in the free list, NO_FREE_SLOT if every slot in m_slots is used
+    size_t                m_size = {};       // Amount of pending requests
+};
+
+#endif // Request_Table_h
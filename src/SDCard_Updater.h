@@ -18,6 +18,7 @@ class SDCard_Updater : public IUpdater {
   public:
     SDCard_Updater(char const * file_path)
       : m_path(file_path)
+      , m_offset(0U)
     {
         // Nothing to do
     }
@@ -29,20 +30,47 @@ class SDCard_Updater : public IUpdater {
             return false;
         }
         fclose(file);
+        m_offset = 0U;
         return true;
     }
+
+    bool resume(size_t const & firmware_size, size_t const & offset) override {
+        FILE* file = fopen(m_path, "rb");
+        if (file == nullptr) {
+            Logger::printfln(OPEN_FILE_FAILED, m_path);
+            return false;
+        }
+        // Ensure all bytes in front of the offset have actually been written previously
+        bool const result = fseek(file, 0, SEEK_END) == 0 && ftell(file) >= static_cast<long>(offset) && offset <= firmware_size;
+        fclose(file);
+        m_offset = offset;
+        return result;
+    }
   
     size_t write(uint8_t * payload, size_t const & total_bytes) override {
-        FILE* file = fopen(m_path, "a");
+        // Write at the current offset instead of appending, because the file might contain bytes written after the offset the update was resumed at
+        FILE* file = fopen(m_path, "r+b");
         if (file == nullptr) {
             Logger::printfln(OPEN_FILE_FAILED, m_path);
             return 0;
         }
-        size_t const bytes_written = fwrite(payload, 1, total_bytes, file);
+        size_t const bytes_written = fseek(file, static_cast<long>(m_offset), SEEK_SET) == 0 ? fwrite(payload, 1, total_bytes, file) : 0U;
         fclose(file);
+        m_offset += bytes_written;
         return bytes_written;
     }
 
+    size_t read(size_t const & offset, uint8_t * buffer, size_t const & length) override {
+        FILE* file = fopen(m_path, "rb");
+        if (file == nullptr) {
+            Logger::printfln(OPEN_FILE_FAILED, m_path);
+            return 0U;
+        }
+        size_t const bytes_read = fseek(file, static_cast<long>(offset), SEEK_SET) == 0 ? fread(buffer, 1, length, file) : 0U;
+        fclose(file);
+        return bytes_read;
+    }
+
     void reset() override {
         end();
     }
@@ -52,7 +80,8 @@ class SDCard_Updater : public IUpdater {
     }
 
   private:
-    char const * m_path = {}; // Path to the file the binary data is written into
+    char const * m_path = {};   // Path to the file the binary data is written into
+    size_t       m_offset = {}; // Position in the file the next binary data is written at
 };
 
 #endif // SDCard_Updater_h
@@ -4,6 +4,8 @@
 // Local includes.
 #include "RPC_Callback.h"
 #include "IAPI_Implementation.h"
+#include "Json_Stream_Parser.h"
+#include "Subscription_Reference.h"
 
 
 // Server side RPC topics.
@@ -64,9 +66,10 @@ class Server_Side_RPC : public IAPI_Implementation {
             return false;
         }
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
-        (void)m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
-        // Push back complete vector into our local m_rpc_callbacks vector.
-        m_rpc_callbacks.insert(m_rpc_callbacks.end(), first, last);
+        (void)m_request_subscription.Acquire(m_client);
+        for (auto it = first; it != last; ++it) {
+            Insert_Sorted(*it);
+        }
         return true;
     }
 
@@ -87,8 +90,8 @@ class Server_Side_RPC : public IAPI_Implementation {
             return false;
         }
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
-        (void)m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
-        m_rpc_callbacks.push_back(callback);
+        (void)m_request_subscription.Acquire(m_client);
+        Insert_Sorted(callback);
         return true;
     }
 
@@ -98,89 +101,114 @@ class Server_Side_RPC : public IAPI_Implementation {
     /// and from the rpc topic, was successful or not
     bool RPC_Unsubscribe() {
         m_rpc_callbacks.clear();
-        return m_unsubscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
+        return m_request_subscription.Release(m_client);
     }
 
-    API_Process_Type Get_Process_Type() const override {
-        return API_Process_Type::JSON;
+    /// @brief Enables or disables streaming of received server side RPC requests, instead of deserializing the complete request into a JsonDocument first.
+    /// When streaming, only the method name is read directly from the received request and the parameters are only deserialized if a callback is subscribed for that method,
+    /// scalar parameters like strings or numbers are passed without copying them and therefore do not require a JsonDocument with any capacity.
+    /// Falls back to deserializing the request, if another api implementation handles the same topic, see API_Process_Type::STREAM for more information
+    /// @param enabled Whether received server side RPC requests should be streamed
+    void Set_Stream_Parsing(bool const & enabled) {
+        m_stream_parsing = enabled;
     }
 
-    void Process_Response(char const * topic, uint8_t * payload, unsigned int length) override {
-        // Nothing to do
+    API_Process_Type Get_Process_Type() const override {
+        return m_stream_parsing ? API_Process_Type::STREAM : API_Process_Type::JSON;
     }
 
-    void Process_Json_Response(char const * topic, JsonDocument const & data) override {
-        if (!data.containsKey(RPC_METHOD_KEY)) {
+    void Process_Response(char const * topic, uint8_t * payload, unsigned int length) override {
+        Stream_Handler handler;
+        Json_Stream_Parser parser(reinterpret_cast<char *>(payload), length);
+        if (!parser.Parse(handler)) {
+            Logger::printfln(UNABLE_TO_STREAM_JSON, JSON_STREAM_MAX_DEPTH);
+            return;
+        }
+        else if (handler.Get_Method_Name() == nullptr) {
 #if THINGSBOARD_ENABLE_DEBUG
             Logger::printfln(SERVER_RPC_METHOD_NULL);
 #endif // THINGSBOARD_ENABLE_DEBUG
             return;
         }
-        char const * method_name = data[RPC_METHOD_KEY];
-
-#if THINGSBOARD_ENABLE_STL
-        auto it = std::find_if(m_rpc_callbacks.begin(), m_rpc_callbacks.end(), [&method_name](RPC_Callback const & rpc) {
-            char const * subscribedMethodName = rpc.Get_Name();
-            return (!Helper::stringIsNullorEmpty(subscribedMethodName) && strncmp(subscribedMethodName, method_name, strlen(subscribedMethodName)) == 0);
-        });
-        if (it != m_rpc_callbacks.end()) {
-            auto & rpc = *it;
-#else
-        for (auto const & rpc : m_rpc_callbacks) {
-            char const * subscribedMethodName = rpc.Get_Name();
-            if (Helper::stringIsNullorEmpty(subscribedMethodName) || strncmp(subscribedMethodName, method_name, strlen(subscribedMethodName)) != 0) {
-              continue;
-            }
-#endif // THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_DEBUG
-            if (!data.containsKey(RPC_PARAMS_KEY)) {
-                Logger::printfln(NO_RPC_PARAMS_PASSED);
-            }
-#endif // THINGSBOARD_ENABLE_DEBUG
+        RPC_Callback const * rpc = Find_Callback(handler.Get_Method_Name());
+        if (rpc == nullptr) {
+            return;
+        }
 
 #if THINGSBOARD_ENABLE_DEBUG
-            Logger::printfln(CALLING_RPC_CB, method_name);
+        if (!handler.Received_Params()) {
+            Logger::printfln(NO_RPC_PARAMS_PASSED);
+        }
 #endif // THINGSBOARD_ENABLE_DEBUG
 
-            JsonVariantConst const param = data[RPC_PARAMS_KEY];
+        Json_Stream_Value const & params = handler.Get_Params();
+        size_t const node_count = params.Get_Node_Count();
 #if THINGSBOARD_ENABLE_DYNAMIC
-            size_t const & rpc_response_size = rpc.Get_Response_Size();
-            TBJsonDocument json_buffer(rpc_response_size);
+        size_t const document_size = JSON_OBJECT_SIZE(node_count);
+        TBJsonDocument params_buffer(document_size);
+        if (params_buffer.capacity() != document_size) {
+            Logger::printfln(STREAMED_VALUE_ALLOCATION_FAILED, document_size);
+            return;
+        }
 #else
-            size_t constexpr rpc_response_size = MaxRPC;
-            StaticJsonDocument<JSON_OBJECT_SIZE(MaxRPC)> json_buffer;
+        if (node_count > THINGSBOARD_STREAM_MAX_VALUE_FIELDS) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, node_count, STREAM_MAX_VALUE_FIELDS_NAME, THINGSBOARD_STREAM_MAX_VALUE_FIELDS);
+            return;
+        }
+        StaticJsonDocument<JSON_OBJECT_SIZE(THINGSBOARD_STREAM_MAX_VALUE_FIELDS)> params_buffer;
 #endif // THINGSBOARD_ENABLE_DYNAMIC
-            rpc.Call_Callback(param, json_buffer);
 
-            if (json_buffer.isNull()) {
-#if THINGSBOARD_ENABLE_DEBUG
-                Logger::printfln(RPC_RESPONSE_NULL);
-#endif // THINGSBOARD_ENABLE_DEBUG
-                return;
-            }
-            else if (json_buffer.overflowed()) {
-                Logger::printfln(RPC_RESPONSE_OVERFLOWED, rpc_response_size);
+        if (params.Is_Container()) {
+            DeserializationError const error = params.Deserialize(params_buffer);
+            if (error) {
+                Logger::printfln(UNABLE_TO_DE_SERIALIZE_STREAMED_VALUE, error.c_str());
                 return;
             }
+        }
+        else {
+            (void)params.Copy_To(params_buffer.template to<JsonVariant>());
+        }
+        Call_RPC_Callback(topic, *rpc, handler.Get_Method_Name(), params_buffer.template as<JsonVariantConst>());
+    }
 
-            size_t const request_id = Helper::parseRequestId(RPC_REQUEST_TOPIC, topic);
-            char responseTopic[Helper::detectSize(RPC_SEND_RESPONSE_TOPIC, request_id)] = {};
-            (void)snprintf(responseTopic, sizeof(responseTopic), RPC_SEND_RESPONSE_TOPIC, request_id);
-            (void)m_send_json_callback.Call_Callback(responseTopic, json_buffer, Helper::Measure_Json(json_buffer));
+    void Process_Json_Response(char const * topic, JsonDocument const & data) override {
+        if (!data.containsKey(RPC_METHOD_KEY)) {
+#if THINGSBOARD_ENABLE_DEBUG
+            Logger::printfln(SERVER_RPC_METHOD_NULL);
+#endif // THINGSBOARD_ENABLE_DEBUG
+            return;
+        }
+        char const * method_name = data[RPC_METHOD_KEY];
+        RPC_Callback const * rpc = Find_Callback(method_name);
+        if (rpc == nullptr) {
             return;
         }
+
+#if THINGSBOARD_ENABLE_DEBUG
+        if (!data.containsKey(RPC_PARAMS_KEY)) {
+            Logger::printfln(NO_RPC_PARAMS_PASSED);
+        }
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+        JsonVariantConst const param = data[RPC_PARAMS_KEY];
+        Call_RPC_Callback(topic, *rpc, method_name, param);
     }
 
     bool Compare_Response_Topic(char const * topic) const override {
         return strncmp(RPC_REQUEST_TOPIC, topic, strlen(RPC_REQUEST_TOPIC)) == 0;
     }
 
+    char const * Get_Response_Topic(bool & is_prefix) const override {
+        is_prefix = true;
+        return RPC_REQUEST_TOPIC;
+    }
+
     bool Unsubscribe() override {
         return RPC_Unsubscribe();
     }
 
     bool Resubscribe_Topic() override {
-        if (!m_rpc_callbacks.empty() && !m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC)) {
+        if (!m_rpc_callbacks.empty() && !m_request_subscription.Acquire(m_client)) {
             Logger::printfln(SUBSCRIBE_TOPIC_FAILED, RPC_SUBSCRIBE_TOPIC);
             return false;
         }
@@ -197,16 +225,154 @@ class Server_Side_RPC : public IAPI_Implementation {
         // Nothing to do
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
-        m_send_json_callback.Set_Callback(send_json_callback);
-        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
-        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
+    void Set_Client(IThingsBoard_Client & client) override {
+        m_client = &client;
     }
 
   private:
-    Callback<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};         // Send json document callback
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};   // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {}; // Unubscribe mqtt topic client callback
+    /// @brief Handler passed to the Json_Stream_Parser, that keeps the method name and the parameters of the received request and skips all other values.
+    /// Both point directly into the received payload, because the method name is unescaped and null terminated in place and the parameters, if they are an object or array, are skipped without modifying them
+    class Stream_Handler {
+      public:
+        /// @brief Constructor
+        Stream_Handler()
+          : m_method_name(nullptr)
+          , m_params()
+          , m_received_params(false)
+        {
+            // Nothing to do
+        }
+
+        bool On_Container(size_t const & depth, char const * key, Json_Stream_Type const & type) {
+            return depth == 0U && type == Json_Stream_Type::OBJECT;
+        }
+
+        bool On_Value(size_t const & depth, char const * key, Json_Stream_Value const & value) {
+            if (depth != 1U) {
+                return true;
+            }
+            else if (value.type == Json_Stream_Type::STRING && strncmp(RPC_METHOD_KEY, key, strlen(RPC_METHOD_KEY) + 1) == 0) {
+                m_method_name = value.begin;
+            }
+            else if (strncmp(RPC_PARAMS_KEY, key, strlen(RPC_PARAMS_KEY) + 1) == 0) {
+                m_params = value;
+                m_received_params = true;
+            }
+            return true;
+        }
+
+        /// @brief Gets the method name of the received request
+        /// @return Null terminated method name or nullptr if the request did not contain a method name
+        char const * Get_Method_Name() const {
+            return m_method_name;
+        }
+
+        /// @brief Gets the parameters of the received request
+        /// @return Parameters, which are null if the request did not contain any
+        Json_Stream_Value const & Get_Params() const {
+            return m_params;
+        }
+
+        /// @brief Whether the received request contained any parameters
+        /// @return Whether the request contained parameters
+        bool Received_Params() const {
+            return m_received_params;
+        }
+
+      private:
+        char const        *m_method_name;    // Method name of the received request
+        Json_Stream_Value m_params;          // Parameters of the received request
+        bool              m_received_params; // Whether the received request contained parameters
+    };
+
+    /// @brief Calls the given callback with the given parameters and sends the response created by the callback, if there is any
+    /// @param topic Topic the request was received over, contains the id of the request the response has to be sent with
+    /// @param rpc Callback subscribed for the method name of the received request
+    /// @param method_name Method name of the received request
+    /// @param param Parameters of the received request
+    void Call_RPC_Callback(char const * topic, RPC_Callback const & rpc, char const * method_name, JsonVariantConst const & param) {
+#if THINGSBOARD_ENABLE_DEBUG
+        Logger::printfln(CALLING_RPC_CB, method_name);
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+        size_t const & rpc_response_size = rpc.Get_Response_Size();
+        TBJsonDocument json_buffer(rpc_response_size);
+#else
+        size_t constexpr rpc_response_size = MaxRPC;
+        StaticJsonDocument<JSON_OBJECT_SIZE(MaxRPC)> json_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        rpc.Call_Callback(param, json_buffer);
+
+        if (json_buffer.isNull()) {
+#if THINGSBOARD_ENABLE_DEBUG
+            Logger::printfln(RPC_RESPONSE_NULL);
+#endif // THINGSBOARD_ENABLE_DEBUG
+            return;
+        }
+        else if (json_buffer.overflowed()) {
+            Logger::printfln(RPC_RESPONSE_OVERFLOWED, rpc_response_size);
+            return;
+        }
+
+        // Request ids sent by the server are 32-bit integers, therefore they always fit into the unsigned int the topic format expects
+        unsigned int const request_id = static_cast<unsigned int>(Helper::parseRequestId(RPC_REQUEST_TOPIC, topic));
+        char responseTopic[Helper::detectSize(RPC_SEND_RESPONSE_TOPIC, request_id)] = {};
+        (void)snprintf(responseTopic, sizeof(responseTopic), RPC_SEND_RESPONSE_TOPIC, request_id);
+        if (m_client != nullptr) {
+            (void)m_client->Send_Json(responseTopic, json_buffer, Helper::Measure_Json(json_buffer));
+        }
+    }
+
+    /// @brief Compares the given method names, handles nullptr like an empty string,
+    /// which results in callbacks without a method name being sorted in front of all other callbacks
+    /// @param lhs First method name that should be compared
+    /// @param rhs Second method name that should be compared
+    /// @return Negative value if lhs is sorted in front of rhs, 0 if both are the same and a positive value if lhs is sorted behind rhs
+    static int Compare_Method_Names(char const * lhs, char const * rhs) {
+        return strcmp(lhs != nullptr ? lhs : "", rhs != nullptr ? rhs : "");
+    }
+
+    /// @brief Inserts the given callback at its sorted position, so that received requests can be matched with a binary search instead of comparing every subscribed callback.
+    /// Callbacks with the same method name are inserted behind the already subscribed ones, so the first subscribed callback is still the one that will be called
+    /// @param callback Callback method that will be inserted
+    void Insert_Sorted(RPC_Callback const & callback) {
+        m_rpc_callbacks.push_back(callback);
+        for (size_t i = m_rpc_callbacks.size() - 1U; i > 0U && Compare_Method_Names(m_rpc_callbacks[i].Get_Name(), m_rpc_callbacks[i - 1U].Get_Name()) < 0; i--) {
+            RPC_Callback const previous = m_rpc_callbacks[i - 1U];
+            m_rpc_callbacks[i - 1U] = m_rpc_callbacks[i];
+            m_rpc_callbacks[i] = previous;
+        }
+    }
+
+    /// @brief Searches the subscribed callback for the given method name with a binary search over the sorted callbacks.
+    /// The method name has to match exactly, meaning a callback subscribed for (set) is not called for a request with the method name (setValue)
+    /// @param method_name Method name of the received request
+    /// @return Subscribed callback for the given method name or nullptr if there is none
+    RPC_Callback const * Find_Callback(char const * method_name) const {
+        if (Helper::stringIsNullorEmpty(method_name)) {
+            return nullptr;
+        }
+        size_t lower = 0U;
+        size_t upper = m_rpc_callbacks.size();
+        while (lower < upper) {
+            size_t const middle = lower + ((upper - lower) / 2U);
+            if (Compare_Method_Names(m_rpc_callbacks[middle].Get_Name(), method_name) < 0) {
+                lower = middle + 1U;
+            }
+            else {
+                upper = middle;
+            }
+        }
+        if (lower >= m_rpc_callbacks.size() || Compare_Method_Names(m_rpc_callbacks[lower].Get_Name(), method_name) != 0) {
+            return nullptr;
+        }
+        return &m_rpc_callbacks[lower];
+    }
+
+    IThingsBoard_Client                                                     *m_client = {};                     // Client the api implementation communicates with the cloud over
+    Subscription_Reference                                                  m_request_subscription = Subscription_Reference(RPC_SUBSCRIBE_TOPIC); // Reference to the server side RPC request topic, acquired while callbacks are subscribed
+    bool                                                                     m_stream_parsing = {};             // Whether received server side RPC requests are streamed instead of deserialized into a JsonDocument
 
     // Vectors or array (depends on wheter if THINGSBOARD_ENABLE_DYNAMIC is set to 1 or 0), hold copy of the actual passed data, this is to ensure they stay valid,
     // even if the user only temporarily created the object before the method was called.
@@ -217,9 +383,9 @@ class Server_Side_RPC : public IAPI_Implementation {
     // Therefore copy-by-value has been choosen as for this specific use case it is more advantageous,
     // especially because at most we copy internal vectors or array, that will only ever contain a few pointers
 #if THINGSBOARD_ENABLE_DYNAMIC
-    Vector<RPC_Callback>                                                     m_rpc_callbacks = {};              // Server side RPC callbacks vector
+    Vector<RPC_Callback>                                                     m_rpc_callbacks = {};              // Server side RPC callbacks vector, sorted by their method name
 #else
-    Array<RPC_Callback, MaxSubscriptions>                                    m_rpc_callbacks = {};              // Server side RPC callbacks array
+    Array<RPC_Callback, MaxSubscriptions>                                    m_rpc_callbacks = {};              // Server side RPC callbacks array, sorted by their method name
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 };
 
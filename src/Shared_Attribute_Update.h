@@ -4,6 +4,8 @@
 // Local includes.
 #include "Shared_Attribute_Callback.h"
 #include "IAPI_Implementation.h"
+#include "Json_Stream_Parser.h"
+#include "Subscription_Reference.h"
 
 
 // Log messages.
@@ -51,9 +53,10 @@ class Shared_Attribute_Update : public IAPI_Implementation {
             return false;
         }
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
-        (void)m_subscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC);
-        // Push back complete vector into our local m_shared_attribute_update_callbacks vector.
-        m_shared_attribute_update_callbacks.insert(m_shared_attribute_update_callbacks.end(), first, last);
+        (void)m_attribute_subscription.Acquire(m_client);
+        for (auto it = first; it != last; ++it) {
+            Add_Callback(*it);
+        }
         return true;
     }
 
@@ -78,8 +81,8 @@ class Shared_Attribute_Update : public IAPI_Implementation {
             return false;
         }
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
-        (void)m_subscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC);
-        m_shared_attribute_update_callbacks.push_back(callback);
+        (void)m_attribute_subscription.Acquire(m_client);
+        Add_Callback(callback);
         return true;
     }
 
@@ -89,15 +92,32 @@ class Shared_Attribute_Update : public IAPI_Implementation {
     /// and from the attribute topic, was successful or not
     bool Shared_Attributes_Unsubscribe() {
         m_shared_attribute_update_callbacks.clear();
-        return m_unsubscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC);
+        m_matched_callbacks.clear();
+        m_attribute_key_index.clear();
+        return m_attribute_subscription.Release(m_client);
+    }
+
+    /// @brief Enables or disables streaming of received shared attribute updates, instead of deserializing the complete update into a JsonDocument first.
+    /// When streaming, every received shared attribute is passed on its own to the callbacks that subscribed its key, meaning a callback subscribed to multiple keys is called once per received key,
+    /// with an object that only contains that single key-value pair. Attributes that no callback subscribed are skipped without ever being deserialized,
+    /// and because scalar values are passed without copying them, only object or array values require a JsonDocument with the size of that value.
+    /// Peak memory therefore no longer depends on the size of the complete update, which is especially useful for big updates containing kilobytes of configuration.
+    /// Falls back to deserializing the update, if another api implementation handles the same topic, see API_Process_Type::STREAM for more information
+    /// @param enabled Whether received shared attribute updates should be streamed
+    void Set_Stream_Parsing(bool const & enabled) {
+        m_stream_parsing = enabled;
     }
 
     API_Process_Type Get_Process_Type() const override {
-        return API_Process_Type::JSON;
+        return m_stream_parsing ? API_Process_Type::STREAM : API_Process_Type::JSON;
     }
 
     void Process_Response(char const * topic, uint8_t * payload, unsigned int length) override {
-        // Nothing to do
+        Stream_Handler handler(*this);
+        Json_Stream_Parser parser(reinterpret_cast<char *>(payload), length);
+        if (!parser.Parse(handler)) {
+            Logger::printfln(UNABLE_TO_STREAM_JSON, JSON_STREAM_MAX_DEPTH);
+        }
     }
 
     void Process_Json_Response(char const * topic, JsonDocument const & data) override {
@@ -106,70 +126,29 @@ class Shared_Attribute_Update : public IAPI_Implementation {
             object = object[SHARED_RESPONSE_KEY];
         }
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_CXX20
-#if THINGSBOARD_ENABLE_DYNAMIC
-        auto filtered_shared_attribute_update_callbacks = m_shared_attribute_update_callbacks | std::views::filter([&object](Shared_Attribute_Callback const & shared_attribute) {
-#else
-        auto filtered_shared_attribute_update_callbacks = m_shared_attribute_update_callbacks | std::views::filter([&object](Shared_Attribute_Callback<MaxAttributes> const & shared_attribute) {
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-#else
-#if THINGSBOARD_ENABLE_DYNAMIC
-        Vector<Shared_Attribute_Callback> filtered_shared_attribute_update_callbacks = {};
-        std::copy_if(m_shared_attribute_update_callbacks.begin(), m_shared_attribute_update_callbacks.end(), std::back_inserter(filtered_shared_attribute_update_callbacks), [&object](Shared_Attribute_Callback const & shared_attribute) {
-#else
-        Array<Shared_Attribute_Callback<MaxAttributes>, MaxSubscriptions> filtered_shared_attribute_update_callbacks = {};
-        std::copy_if(m_shared_attribute_update_callbacks.begin(), m_shared_attribute_update_callbacks.end(), std::back_inserter(filtered_shared_attribute_update_callbacks), [&object](Shared_Attribute_Callback<MaxAttributes> const & shared_attribute) {
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-#endif // THINGSBOARD_ENABLE_CXX20
-            return (shared_attribute.Get_Attributes().empty() || std::find_if(shared_attribute.Get_Attributes().begin(), shared_attribute.Get_Attributes().end(), [&object](const char * att) {
-                return object.containsKey(att);
-            }) != shared_attribute.Get_Attributes().end());
-        });
-
-        for (auto const & shared_attribute : filtered_shared_attribute_update_callbacks) {
-#else
-        for (auto const & shared_attribute : m_shared_attribute_update_callbacks) {
-            if (shared_attribute.Get_Attributes().empty()) {
-                // No specifc keys were subscribed so we call the callback anyway, assumed to be subscribed to any update
-                shared_attribute.Call_Callback(object);
-                continue;
-            }
-
-            char const * requested_att = nullptr;
-
-            for (auto const & att : shared_attribute.Get_Attributes()) {
-                if (Helper::stringIsNullorEmpty(att)) {
-                    continue;
-                }
-                // Check if the request contained any of our requested keys and
-                // break early if the key was requested from this callback.
-                if (object.containsKey(att)) {
-                    requested_att = att;
-                    break;
-                }
-            }
-
-            // Check if this callback did not request any keys that were in this response,
-            // if there were not we simply continue with the next subscribed callback.
-            if (requested_att == nullptr) {
-                continue;
-            }
-#endif // THINGSBOARD_ENABLE_STL
-            shared_attribute.Call_Callback(object);
+        // Resets the matches of the previous update, before marking every callback that subscribed atleast one of the received keys
+        Reset_Matched_Callbacks();
+        for (JsonPairConst const & pair : object) {
+            Mark_Matched_Callbacks(pair.key().c_str());
         }
+        Call_Matched_Callbacks(object);
     }
 
     bool Compare_Response_Topic(char const * topic) const override {
         return strncmp(ATTRIBUTE_TOPIC, topic, strlen(ATTRIBUTE_TOPIC) + 1) == 0;
     }
 
+    char const * Get_Response_Topic(bool & is_prefix) const override {
+        is_prefix = false;
+        return ATTRIBUTE_TOPIC;
+    }
+
     bool Unsubscribe() override {
         return Shared_Attributes_Unsubscribe();
     }
 
     bool Resubscribe_Topic() override {
-        if (!m_shared_attribute_update_callbacks.empty() && !m_subscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC)) {
+        if (!m_shared_attribute_update_callbacks.empty() && !m_attribute_subscription.Acquire(m_client)) {
             Logger::printfln(SUBSCRIBE_TOPIC_FAILED, ATTRIBUTE_TOPIC);
             return false;
         }
@@ -186,14 +165,186 @@ class Shared_Attribute_Update : public IAPI_Implementation {
         // Nothing to do
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
-        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
-        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
+    void Set_Client(IThingsBoard_Client & client) override {
+        m_client = &client;
     }
 
   private:
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};          // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {};        // Unubscribe mqtt topic client callback
+    /// @brief Handler passed to the Json_Stream_Parser, that passes every received shared attribute to Process_Streamed_Attribute() and skips all nested objects and arrays,
+    /// besides the additional object the shared attributes are contained in, if they were received as the response to an attribute request
+    class Stream_Handler {
+      public:
+        /// @brief Constructor
+        /// @param update Instance the received shared attributes are passed to
+        Stream_Handler(Shared_Attribute_Update & update)
+          : m_update(update)
+          , m_attribute_depth(1U)
+        {
+            // Nothing to do
+        }
+
+        bool On_Container(size_t const & depth, char const * key, Json_Stream_Type const & type) {
+            if (depth == 0U) {
+                return type == Json_Stream_Type::OBJECT;
+            }
+            else if (depth == 1U && type == Json_Stream_Type::OBJECT && strncmp(SHARED_RESPONSE_KEY, key, strlen(SHARED_RESPONSE_KEY) + 1) == 0) {
+                m_attribute_depth = 2U;
+                return true;
+            }
+            return false;
+        }
+
+        bool On_Value(size_t const & depth, char const * key, Json_Stream_Value const & value) {
+            if (depth == m_attribute_depth && key != nullptr) {
+                m_update.Process_Streamed_Attribute(key, value);
+            }
+            return true;
+        }
+
+      private:
+        Shared_Attribute_Update &m_update;         // Instance the received shared attributes are passed to
+        size_t                  m_attribute_depth; // Depth the shared attributes are received at, 2 if they are contained in the additional shared object of an attribute response
+    };
+
+    /// @brief Single entry of the inverted key index, connects one subscribed shared attribute key to the callback that subscribed it
+    struct Attribute_Key_Entry {
+        char const *key = {};            // Shared attribute key that was subscribed by the callback
+        size_t     callback_index = {};  // Index of the callback in the subscribed shared attribute update callbacks
+    };
+
+    /// @brief Copies the given callback into the subscribed callbacks and adds all its shared attribute keys to the inverted key index.
+    /// The index is kept sorted by the key, which is more expensive than simply appending the entries, but only happens once when subscribing instead of for every received update.
+    /// Because callbacks are only ever appended and only removed all at once, the index of a callback stays valid for as long as it is subscribed
+    /// @param callback Callback that should be subscribed
+#if THINGSBOARD_ENABLE_DYNAMIC
+    void Add_Callback(Shared_Attribute_Callback const & callback) {
+#else
+    void Add_Callback(Shared_Attribute_Callback<MaxAttributes> const & callback) {
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        size_t const callback_index = m_shared_attribute_update_callbacks.size();
+        m_shared_attribute_update_callbacks.push_back(callback);
+        m_matched_callbacks.push_back(false);
+
+        for (auto const & att : callback.Get_Attributes()) {
+            if (Helper::stringIsNullorEmpty(att)) {
+                continue;
+            }
+            Attribute_Key_Entry entry = {};
+            entry.key = att;
+            entry.callback_index = callback_index;
+            m_attribute_key_index.push_back(entry);
+            for (size_t i = m_attribute_key_index.size() - 1U; i > 0U && strcmp(m_attribute_key_index[i].key, m_attribute_key_index[i - 1U].key) < 0; i--) {
+                Attribute_Key_Entry const previous = m_attribute_key_index[i - 1U];
+                m_attribute_key_index[i - 1U] = m_attribute_key_index[i];
+                m_attribute_key_index[i] = previous;
+            }
+        }
+    }
+
+    /// @brief Passes the given streamed shared attribute to all callbacks that subscribed its key, as an object that only contains the single key-value pair.
+    /// The attribute is only copied into a JsonDocument if atleast one callback is interested in it, strings and numbers are linked and therefore do not require any capacity,
+    /// objects and arrays are deserialized in place into a separate JsonDocument first and then copied into the object passed to the callbacks
+    /// @param key Key of the received shared attribute
+    /// @param value Value of the received shared attribute
+    void Process_Streamed_Attribute(char const * key, Json_Stream_Value const & value) {
+        Reset_Matched_Callbacks();
+        Mark_Matched_Callbacks(key);
+        if (!Has_Matched_Callbacks()) {
+            return;
+        }
+
+        size_t const node_count = value.Get_Node_Count();
+#if THINGSBOARD_ENABLE_DYNAMIC
+        size_t const document_size = JSON_OBJECT_SIZE(node_count);
+        TBJsonDocument value_buffer(document_size);
+        TBJsonDocument attribute_buffer(JSON_OBJECT_SIZE(1U) + document_size);
+        if (value_buffer.capacity() != document_size || attribute_buffer.capacity() != JSON_OBJECT_SIZE(1U) + document_size) {
+            Logger::printfln(STREAMED_VALUE_ALLOCATION_FAILED, JSON_OBJECT_SIZE(1U) + 2U * document_size);
+            return;
+        }
+#else
+        if (node_count > THINGSBOARD_STREAM_MAX_VALUE_FIELDS) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, node_count, STREAM_MAX_VALUE_FIELDS_NAME, THINGSBOARD_STREAM_MAX_VALUE_FIELDS);
+            return;
+        }
+        StaticJsonDocument<JSON_OBJECT_SIZE(THINGSBOARD_STREAM_MAX_VALUE_FIELDS)> value_buffer;
+        StaticJsonDocument<JSON_OBJECT_SIZE(1U + THINGSBOARD_STREAM_MAX_VALUE_FIELDS)> attribute_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+        JsonObject attribute = attribute_buffer.template to<JsonObject>();
+        if (value.Is_Container()) {
+            DeserializationError const error = value.Deserialize(value_buffer);
+            if (error) {
+                Logger::printfln(UNABLE_TO_DE_SERIALIZE_STREAMED_VALUE, error.c_str());
+                return;
+            }
+            attribute[key] = value_buffer.template as<JsonVariantConst>();
+        }
+        else {
+            (void)value.Copy_To(attribute[key]);
+        }
+        Call_Matched_Callbacks(attribute);
+    }
+
+    /// @brief Resets the matches of the previously processed update
+    void Reset_Matched_Callbacks() {
+        for (size_t i = 0U; i < m_matched_callbacks.size(); i++) {
+            m_matched_callbacks[i] = false;
+        }
+    }
+
+    /// @brief Whether atleast one callback would be called with the currently marked matches, which is always the case if any callback did not subscribe specific keys
+    /// @return Whether Call_Matched_Callbacks() would call atleast one callback
+    bool Has_Matched_Callbacks() const {
+        for (size_t i = 0U; i < m_shared_attribute_update_callbacks.size(); i++) {
+            if (m_shared_attribute_update_callbacks[i].Get_Attributes().empty() || m_matched_callbacks[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Calls every callback that has been marked as matched with the given object, callbacks are called in the order they were subscribed in.
+    /// Callbacks without any specific keys are assumed to be subscribed to any update
+    /// @param object Object containing the received shared attributes
+    void Call_Matched_Callbacks(JsonObjectConst const & object) const {
+        for (size_t i = 0U; i < m_shared_attribute_update_callbacks.size(); i++) {
+            auto const & shared_attribute = m_shared_attribute_update_callbacks[i];
+            if (!shared_attribute.Get_Attributes().empty() && !m_matched_callbacks[i]) {
+                continue;
+            }
+            shared_attribute.Call_Callback(object);
+        }
+    }
+
+    /// @brief Marks all callbacks that subscribed the given received key as matched, by searching the inverted key index with a binary search.
+    /// Multiple callbacks can subscribe the same key, which are then stored next to each other in the index
+    /// @param key Key of the received shared attribute
+    void Mark_Matched_Callbacks(char const * key) {
+        if (key == nullptr) {
+            return;
+        }
+
+        size_t lower = 0U;
+        size_t upper = m_attribute_key_index.size();
+        while (lower < upper) {
+            size_t const middle = lower + (upper - lower) / 2U;
+            if (strcmp(m_attribute_key_index[middle].key, key) < 0) {
+                lower = middle + 1U;
+            }
+            else {
+                upper = middle;
+            }
+        }
+
+        for (; lower < m_attribute_key_index.size() && strcmp(m_attribute_key_index[lower].key, key) == 0; lower++) {
+            m_matched_callbacks[m_attribute_key_index[lower].callback_index] = true;
+        }
+    }
+
+    IThingsBoard_Client                                                     *m_client = {};                            // Client the api implementation communicates with the cloud over
+    Subscription_Reference                                                  m_attribute_subscription = Subscription_Reference(ATTRIBUTE_TOPIC); // Reference to the shared attribute topic, acquired while callbacks are subscribed
+    bool                                                                     m_stream_parsing = {};                    // Whether received shared attribute updates are streamed instead of deserialized into a JsonDocument
 
     // Vectors or array (depends on wheter if THINGSBOARD_ENABLE_DYNAMIC is set to 1 or 0), hold copy of the actual passed data, this is to ensure they stay valid,
     // even if the user only temporarily created the object before the method was called.
@@ -208,6 +359,16 @@ class Shared_Attribute_Update : public IAPI_Implementation {
 #else
     Array<Shared_Attribute_Callback<MaxAttributes>, MaxSubscriptions>        m_shared_attribute_update_callbacks = {}; // Shared attribute update callbacks array
 #endif // THINGSBOARD_ENABLE_DYNAMIC
+
+    // Inverted index from the subscribed shared attribute keys to the callbacks that subscribed them, allows to find all interested callbacks with a single pass over the received keys,
+    // instead of checking every key of every callback against the received object. Only the key pointers and the callback index are stored, the callbacks themselves are never copied
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Vector<bool>                                                             m_matched_callbacks = {};                 // Whether the callback at the same index subscribed atleast one key of the currently processed update
+    Vector<Attribute_Key_Entry>                                              m_attribute_key_index = {};               // Subscribed shared attribute keys sorted by the key
+#else
+    Array<bool, MaxSubscriptions>                                            m_matched_callbacks = {};                 // Whether the callback at the same index subscribed atleast one key of the currently processed update
+    Array<Attribute_Key_Entry, MaxSubscriptions * MaxAttributes>             m_attribute_key_index = {};               // Subscribed shared attribute keys sorted by the key
+#endif // THINGSBOARD_ENABLE_DYNAMIC
 };
 
 #endif // Shared_Attribute_Update_h
@@ -0,0 +1,232 @@
+#ifndef Subscription_Manager_h
+#define Subscription_Manager_h
+
+// Local includes.
+#include "Configuration.h"
+#include "Helper.h"
+#include "IMQTT_Client.h"
+#include "MQTT_Session_State.h"
+
+
+/// @brief Default amount of time in microseconds a topic is kept subscribed after its last reference has been released, 30 seconds
+#define Default_Subscription_Linger_Time 30000000U
+
+
+// Log messages.
+char constexpr SUBSCRIPTION_TOPICS_FULL[] = "Unable to subscribe topic (%s), because the maximum amount of subscribed topics (%u) is reached, increase THINGSBOARD_SESSION_MAX_TOPICS";
+
+
+/// @brief Topic subscribed with the Subscription_Manager
+struct Subscription_Entry {
+    char const * topic = {};           // Topic that is subscribed, nullptr if the entry has been restored from a persisted session and the topic has not been referenced since
+    uint32_t     hash = {};            // Hash of the topic, which the entries are compared with
+    uint16_t     references = {};      // Amount of api implementations that currently require the topic to be subscribed
+    bool         held = {};            // Whether the broker currently holds a subscription for the topic
+    uint64_t     linger_deadline = {}; // Time in microseconds the topic is unsubscribed at, if it has not been referenced again since its last reference has been released
+};
+
+
+/// @brief Counts the references of every topic subscribed by the api implementations, so that a topic shared by multiple api implementations is only subscribed once the first of them requires it
+/// and only unsubscribed once none of them require it anymore. Topics whose last reference has been released are additionally kept subscribed for the linger time,
+/// so that api implementations sending requests regularly, which subscribe their response topic before and unsubscribe it after every request, do not send a subscribe and unsubscribe request each time.
+/// Topics that are referenced while not being connected are subscribed once the connection is established, together with every other topic in a single subscribe request.
+/// Used internally by ThingsBoardSized, which passes the subscribe and unsubscribe calls of every api implementation to it. The maximum amount of topics is THINGSBOARD_SESSION_MAX_TOPICS
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set
+template <typename Logger>
+class Subscription_Manager {
+  public:
+    /// @brief Constructor
+    /// @param client MQTT Client implementation the topics are subscribed and unsubscribed with
+    explicit Subscription_Manager(IMQTT_Client & client)
+      : m_client(client)
+      , m_entries()
+      , m_entries_size(0U)
+      , m_linger_time(Default_Subscription_Linger_Time)
+      , m_resubscribing(false)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Sets the amount of time topics are kept subscribed after their last reference has been released
+    /// @param linger_time Amount of time in microseconds, 0 to unsubscribe topics immediately once their last reference has been released
+    void Set_Linger_Time(uint64_t const & linger_time) {
+        m_linger_time = linger_time;
+    }
+
+    /// @brief Takes a reference to the given topic, the topic is only subscribed if it is not referenced or kept subscribed yet.
+    /// If we are not connected or the connection is currently being established, the topic is subscribed once the connection has been established instead
+    /// @param topic Topic that should be subscribed, has to be kept alive for as long as it is referenced, which is always the case for the constant topics of the api implementations
+    /// @return Whether the topic is or will be subscribed, false if subscribing failed or the maximum amount of topics is reached
+    bool Subscribe(char const * topic) {
+        uint32_t const hash = Helper::hashString(topic);
+        size_t const index = Find_Entry(hash);
+        if (index != m_entries_size) {
+            Subscription_Entry & entry = m_entries[index];
+            entry.topic = topic;
+            entry.references++;
+            return true;
+        }
+        else if (m_entries_size == THINGSBOARD_SESSION_MAX_TOPICS) {
+            Logger::printfln(SUBSCRIPTION_TOPICS_FULL, topic, THINGSBOARD_SESSION_MAX_TOPICS);
+            return false;
+        }
+
+        bool const subscribe_now = m_client.connected() && !m_resubscribing;
+        if (subscribe_now && !m_client.subscribe(topic)) {
+            return false;
+        }
+        Subscription_Entry & entry = m_entries[m_entries_size++];
+        entry = Subscription_Entry();
+        entry.topic = topic;
+        entry.hash = hash;
+        entry.references = 1U;
+        entry.held = subscribe_now;
+        return true;
+    }
+
+    /// @brief Releases a previously taken reference to the given topic, if it was the last reference the topic is unsubscribed once the linger time has passed
+    /// @param topic Topic that should be unsubscribed
+    /// @param now Current time in microseconds of a monotonic clock
+    /// @return Whether releasing the reference was successful or not, false if the topic had to be unsubscribed immediately and unsubscribing failed
+    bool Unsubscribe(char const * topic, uint64_t const & now) {
+        size_t const index = Find_Entry(Helper::hashString(topic));
+        if (index == m_entries_size || m_entries[index].references == 0U) {
+            return true;
+        }
+
+        Subscription_Entry & entry = m_entries[index];
+        if (--entry.references != 0U) {
+            return true;
+        }
+        else if (!entry.held) {
+            Remove_Entry(index);
+            return true;
+        }
+        else if (m_linger_time == 0U) {
+            return Unsubscribe_Entry(index);
+        }
+        entry.linger_deadline = now + m_linger_time;
+        return true;
+    }
+
+    /// @brief Has to be called once the connection has been established, defers every topic subscribed afterwards until Resubscribe() is called.
+    /// If the broker did not hold the session anymore, topics that are not referenced anymore are forgotten and the referenced ones are marked to be subscribed again
+    /// @param session_present Whether the broker still held the session of the previous connection
+    void Begin_Connection(bool const & session_present) {
+        m_resubscribing = true;
+        if (session_present) {
+            return;
+        }
+        for (size_t index = m_entries_size; index > 0U; index--) {
+            Subscription_Entry & entry = m_entries[index - 1U];
+            if (entry.references == 0U) {
+                Remove_Entry(index - 1U);
+                continue;
+            }
+            entry.held = false;
+        }
+    }
+
+    /// @brief Subscribes every referenced topic the broker does not hold yet in a single subscribe request and stops deferring topics subscribed afterwards
+    /// @return Whether subscribing the topics was successful or not, topics that could not be subscribed are subscribed once the next connection is established instead
+    bool Resubscribe() {
+        m_resubscribing = false;
+        char const * topics[THINGSBOARD_SESSION_MAX_TOPICS] = {};
+        size_t count = 0U;
+        for (size_t index = 0U; index < m_entries_size; index++) {
+            Subscription_Entry const & entry = m_entries[index];
+            if (entry.references != 0U && !entry.held) {
+                topics[count++] = entry.topic;
+            }
+        }
+
+        if (count == 0U) {
+            return true;
+        }
+        else if (!m_client.subscribe_multiple(topics, count)) {
+            return false;
+        }
+        for (size_t index = 0U; index < m_entries_size; index++) {
+            m_entries[index].held = m_entries[index].held || m_entries[index].references != 0U;
+        }
+        return true;
+    }
+
+    /// @brief Unsubscribes every topic that has not been referenced anymore for the linger time
+    /// @param now Current time in microseconds of a monotonic clock
+    void loop(uint64_t const & now) {
+        if (!m_client.connected()) {
+            return;
+        }
+        for (size_t index = m_entries_size; index > 0U; index--) {
+            Subscription_Entry const & entry = m_entries[index - 1U];
+            if (entry.references != 0U || !entry.held || entry.topic == nullptr || now < entry.linger_deadline) {
+                continue;
+            }
+            (void)Unsubscribe_Entry(index - 1U);
+        }
+    }
+
+    /// @brief Copies the hashes of the topics the broker currently holds a subscription for into the given session state, the request id is not changed
+    /// @param state State the topics should be copied into
+    void Get_State(MQTT_Session_State & state) const {
+        state.topics_size = 0U;
+        for (size_t index = 0U; index < m_entries_size; index++) {
+            if (m_entries[index].held) {
+                state.topics[state.topics_size++] = m_entries[index].hash;
+            }
+        }
+    }
+
+    /// @brief Replaces every topic with the topics contained in the given session state, as held by the broker but not referenced,
+    /// they are only unsubscribed if they are referenced and released again afterwards, because only the hash of the topics has been persisted
+    /// @param state Previously persisted session state
+    void Restore_State(MQTT_Session_State const & state) {
+        m_entries_size = 0U;
+        size_t const size = state.topics_size < THINGSBOARD_SESSION_MAX_TOPICS ? state.topics_size : THINGSBOARD_SESSION_MAX_TOPICS;
+        for (size_t index = 0U; index < size; index++) {
+            Subscription_Entry & entry = m_entries[m_entries_size++];
+            entry = Subscription_Entry();
+            entry.hash = state.topics[index];
+            entry.held = true;
+        }
+    }
+
+  private:
+    /// @brief Searches the entries for the topic with the given hash
+    /// @param hash Hash of the topic that should be found
+    /// @return Index of the entry or the amount of entries if the topic is not contained
+    size_t Find_Entry(uint32_t const & hash) const {
+        for (size_t index = 0U; index < m_entries_size; index++) {
+            if (m_entries[index].hash == hash) {
+                return index;
+            }
+        }
+        return m_entries_size;
+    }
+
+    /// @brief Unsubscribes the topic of the entry at the given index and removes the entry
+    /// @param index Index of the entry that should be unsubscribed
+    /// @return Whether unsubscribing was successful or not, the entry is kept if it was not to attempt unsubscribing again in the next loop
+    bool Unsubscribe_Entry(size_t const & index) {
+        if (!m_client.unsubscribe(m_entries[index].topic)) {
+            return false;
+        }
+        Remove_Entry(index);
+        return true;
+    }
+
+    /// @brief Removes the entry at the given index by replacing it with the last entry, because the order of the entries is irrelevant
+    /// @param index Index of the entry that should be removed
+    void Remove_Entry(size_t const & index) {
+        m_entries[index] = m_entries[--m_entries_size];
+    }
+
+    IMQTT_Client       &m_client;                                         // MQTT Client implementation the topics are subscribed and unsubscribed with
+    Subscription_Entry m_entries[THINGSBOARD_SESSION_MAX_TOPICS] = {};    // Topics that are referenced or held by the broker
+    size_t             m_entries_size = {};                               // Amount of used entries
+    uint64_t           m_linger_time = {};                                // Amount of time in microseconds topics are kept subscribed after their last reference has been released
+    bool               m_resubscribing = {};                              // Whether the connection is currently being established, which defers subscribing topics until Resubscribe() is called
+};
+
+#endif // Subscription_Manager_h
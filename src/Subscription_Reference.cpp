@@ -0,0 +1,35 @@
+// Header include.
+#include "Subscription_Reference.h"
+
+Subscription_Reference::Subscription_Reference(char const * topic)
+  : m_topic(topic)
+  , m_acquired(false)
+{
+    // Nothing to do
+}
+
+bool Subscription_Reference::Acquire(IThingsBoard_Client * client) {
+    if (m_acquired) {
+        return true;
+    }
+    else if (client == nullptr || !client->clientSubscribe(m_topic)) {
+        return false;
+    }
+    m_acquired = true;
+    return true;
+}
+
+bool Subscription_Reference::Release(IThingsBoard_Client * client) {
+    if (client == nullptr) {
+        return false;
+    }
+    else if (!m_acquired) {
+        return true;
+    }
+    m_acquired = false;
+    return client->clientUnsubscribe(m_topic);
+}
+
+bool Subscription_Reference::Is_Acquired() const {
+    return m_acquired;
+}
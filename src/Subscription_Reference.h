@@ -0,0 +1,36 @@
+#ifndef Subscription_Reference_h
+#define Subscription_Reference_h
+
+// Local include.
+#include "IThingsBoard_Client.h"
+
+
+/// @brief Single reference of an api implementation to a topic it requires to be subscribed, which ensures the api implementation never takes more than one reference to the same topic.
+/// Required because the client counts the references of every topic, to only unsubscribe it once no api implementation requires it anymore,
+/// whereas api implementations subscribe their topic with every request or callback they register and unsubscribe it only once, after all of them have been handled or removed
+class Subscription_Reference {
+  public:
+    /// @brief Constructor
+    /// @param topic Topic that is subscribed while the reference is acquired, has to be kept alive for as long as the instance of this class
+    explicit Subscription_Reference(char const * topic);
+
+    /// @brief Subscribes the topic with the given client, if the reference has not been acquired yet
+    /// @param client Client the topic should be subscribed with
+    /// @return Whether the reference is acquired or not
+    bool Acquire(IThingsBoard_Client * client);
+
+    /// @brief Unsubscribes the topic with the given client, if the reference has been acquired
+    /// @param client Client the topic should be unsubscribed with
+    /// @return Whether releasing the reference was successful or not, false if the client is nullptr
+    bool Release(IThingsBoard_Client * client);
+
+    /// @brief Gets whether the reference is currently acquired, meaning the topic has been subscribed and not been unsubscribed since
+    /// @return Whether the reference is acquired or not
+    bool Is_Acquired() const;
+
+  private:
+    char const *m_topic = {};    // Topic that is subscribed while the reference is acquired
+    bool       m_acquired = {};  // Whether the topic has been subscribed and not been unsubscribed since
+};
+
+#endif // Subscription_Reference_h
@@ -1,8 +1,233 @@
 // Header include.
 #include "Telemetry.h"
 
+// Library includes.
+#include <math.h>
+#include <string.h>
+
+// Every two digit number from 00 to 99 after each other, allows to format integers two digits at a time with a single division
+constexpr char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+// Binary powers of ten (10^1, 10^2, 10^4, ..., 10^256), used to normalize floating point values into the range [1, 10) with at most 9 multiplications
+constexpr double POSITIVE_BINARY_POWERS_OF_TEN[] = { 1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256 };
+// Inverse of the binary powers of ten (10^-1, 10^-2, 10^-4, ..., 10^-256), large values are multiplied with those instead of being divided by the positive powers,
+// because ArduinoJson does the same and dividing rounds differently, which would change the last written decimal place
+constexpr double NEGATIVE_BINARY_POWERS_OF_TEN[] = { 1e-1, 1e-2, 1e-4, 1e-8, 1e-16, 1e-32, 1e-64, 1e-128, 1e-256 };
+// Thresholds below which the value is multiplied with the binary power of ten at the same index (10^0, 10^-1, 10^-3, ..., 10^-255), to end up in the range [1, 10)
+constexpr double NEGATIVE_BINARY_POWER_THRESHOLDS[] = { 1e0, 1e-1, 1e-3, 1e-7, 1e-15, 1e-31, 1e-63, 1e-127, 1e-255 };
+// Same thresholds ArduinoJson uses to decide whether a floating point value is written with an exponent
+constexpr double POSITIVE_EXPONENTIATION_THRESHOLD = 1e7;
+constexpr double NEGATIVE_EXPONENTIATION_THRESHOLD = 1e-5;
+// Amount of decimal places and the corresponding factor, that are written for double values by ArduinoJson
+constexpr uint8_t MAX_DECIMAL_PLACES = 9U;
+constexpr uint32_t MAX_DECIMAL_FACTOR = 1000000000U;
+// Longest possible formatted integer, which is the sign and the 20 digits of the smallest int64_t
+constexpr size_t MAX_INTEGER_LENGTH = 20U;
+
+/// @brief Formats the given unsigned integer into the given buffer, two digits at a time
+/// @param current Position in the buffer the integer should be written at
+/// @param end End of the space in the buffer the integer can be written into
+/// @param value Integer that should be written
+/// @param min_digits Amount of digits that are atleast written, missing digits are padded with leading zeros
+/// @return Position directly after the written integer, or nullptr if it did not fit
+char * Write_Unsigned(char * current, char const * end, uint64_t value, uint8_t const & min_digits = 1U) {
+    // Digits are written from back to front into a temporary buffer first, because the amount of digits is not known beforehand
+    char digits[MAX_INTEGER_LENGTH] = {};
+    char * const digits_end = digits + sizeof(digits);
+    char * digit = digits_end;
+    while (value >= 100U) {
+        uint64_t const quotient = value / 100U;
+        size_t const pair_index = static_cast<size_t>(value - (quotient * 100U)) * 2U;
+        *--digit = DIGIT_PAIRS[pair_index + 1U];
+        *--digit = DIGIT_PAIRS[pair_index];
+        value = quotient;
+    }
+    if (value >= 10U) {
+        *--digit = DIGIT_PAIRS[value * 2U + 1U];
+        *--digit = DIGIT_PAIRS[value * 2U];
+    }
+    else {
+        *--digit = static_cast<char>('0' + value);
+    }
+    while (digits_end - digit < min_digits) {
+        *--digit = '0';
+    }
+
+    size_t const length = digits_end - digit;
+    if (static_cast<size_t>(end - current) < length) {
+        return nullptr;
+    }
+    memcpy(current, digit, length);
+    return current + length;
+}
+
+/// @brief Formats the given signed integer into the given buffer
+/// @param current Position in the buffer the integer should be written at
+/// @param end End of the space in the buffer the integer can be written into
+/// @param value Integer that should be written
+/// @return Position directly after the written integer, or nullptr if it did not fit
+char * Write_Signed(char * current, char const * end, int64_t const & value) {
+    if (value >= 0) {
+        return Write_Unsigned(current, end, static_cast<uint64_t>(value));
+    }
+    else if (current >= end) {
+        return nullptr;
+    }
+    *current++ = '-';
+    // Negated as an unsigned value, because the smallest int64_t can not be represented as a positive int64_t
+    return Write_Unsigned(current, end, ~static_cast<uint64_t>(value) + 1U);
+}
+
+/// @brief Formats the given floating point value into the given buffer, with the same algorithm ArduinoJson uses, meaning atmost 9 decimal places without trailing zeros
+/// and an exponent if the value is outside of the range [1e-5, 1e7). Not a number or infinite values are written as null instead, because they are not valid json
+/// @param current Position in the buffer the value should be written at
+/// @param end End of the space in the buffer the value can be written into
+/// @param value Value that should be written
+/// @return Position directly after the written value, or nullptr if it did not fit
+char * Write_Real(char * current, char const * end, double value) {
+    if (isnan(value) || isinf(value)) {
+        if (end - current < 4) {
+            return nullptr;
+        }
+        memcpy(current, "null", 4U);
+        return current + 4U;
+    }
+    else if (value < 0.0) {
+        if (current >= end) {
+            return nullptr;
+        }
+        *current++ = '-';
+        value = -value;
+    }
+
+    // Normalizes the value into the range [1, 10) and remembers the exponent, if it is to big or small to be written without an exponent
+    int16_t exponent = 0;
+    if (value >= POSITIVE_EXPONENTIATION_THRESHOLD) {
+        for (int8_t index = 8; index >= 0; index--) {
+            if (value >= POSITIVE_BINARY_POWERS_OF_TEN[index]) {
+                value *= NEGATIVE_BINARY_POWERS_OF_TEN[index];
+                exponent += static_cast<int16_t>(1U << index);
+            }
+        }
+    }
+    else if (value > 0.0 && value <= NEGATIVE_EXPONENTIATION_THRESHOLD) {
+        for (int8_t index = 8; index >= 0; index--) {
+            if (value < NEGATIVE_BINARY_POWER_THRESHOLDS[index]) {
+                value *= POSITIVE_BINARY_POWERS_OF_TEN[index];
+                exponent -= static_cast<int16_t>(1U << index);
+            }
+        }
+    }
+
+    // Every digit of the integral part reduces the amount of written decimal places by one, to keep the amount of significant digits the same
+    uint32_t integral = static_cast<uint32_t>(value);
+    uint32_t max_decimal = MAX_DECIMAL_FACTOR;
+    uint8_t decimal_places = MAX_DECIMAL_PLACES;
+    for (uint32_t remaining = integral; remaining >= 10U; remaining /= 10U) {
+        max_decimal /= 10U;
+        decimal_places--;
+    }
+    double remainder = (value - static_cast<double>(integral)) * static_cast<double>(max_decimal);
+    uint32_t decimal = static_cast<uint32_t>(remainder);
+    remainder -= static_cast<double>(decimal);
+    // Rounds up if the remainder is atleast 0.5, which can overflow into the integral part
+    decimal += static_cast<uint32_t>(remainder * 2.0);
+    if (decimal >= max_decimal) {
+        decimal = 0U;
+        integral++;
+        if (exponent != 0 && integral >= 10U) {
+            exponent++;
+            integral = 1U;
+        }
+    }
+    while (decimal_places > 0U && decimal % 10U == 0U) {
+        decimal /= 10U;
+        decimal_places--;
+    }
+
+    current = Write_Unsigned(current, end, integral);
+    if (current != nullptr && decimal_places > 0U) {
+        if (current >= end) {
+            return nullptr;
+        }
+        *current++ = '.';
+        current = Write_Unsigned(current, end, decimal, decimal_places);
+    }
+    if (current != nullptr && exponent != 0) {
+        if (current >= end) {
+            return nullptr;
+        }
+        *current++ = 'e';
+        current = Write_Signed(current, end, exponent);
+    }
+    return current;
+}
+
+/// @brief Writes the given string surrounded by quotes into the given buffer, escaping quotes, backslashes and the control characters with a short escape sequence the same way ArduinoJson does.
+/// Other control characters are written as is, because ArduinoJson does not escape them either
+/// @param current Position in the buffer the string should be written at
+/// @param end End of the space in the buffer the string can be written into
+/// @param string Null terminated string that should be written
+/// @return Position directly after the closing quote of the written string, or nullptr if it did not fit
+char * Write_Escaped_String(char * current, char const * end, char const * string) {
+    if (current >= end) {
+        return nullptr;
+    }
+    *current++ = '"';
+    for (char const * symbol = string; *symbol != '\0'; symbol++) {
+        char escaped = '\0';
+        switch (*symbol) {
+            case '"':
+                escaped = '"';
+                break;
+            case '\\':
+                escaped = '\\';
+                break;
+            case '\b':
+                escaped = 'b';
+                break;
+            case '\f':
+                escaped = 'f';
+                break;
+            case '\n':
+                escaped = 'n';
+                break;
+            case '\r':
+                escaped = 'r';
+                break;
+            case '\t':
+                escaped = 't';
+                break;
+            default:
+                break;
+        }
+
+        if (escaped != '\0') {
+            if (end - current < 2) {
+                return nullptr;
+            }
+            *current++ = '\\';
+            *current++ = escaped;
+        }
+        else {
+            if (current >= end) {
+                return nullptr;
+            }
+            *current++ = *symbol;
+        }
+    }
+    if (current >= end) {
+        return nullptr;
+    }
+    *current++ = '"';
+    return current;
+}
+
 Telemetry::Telemetry()
   : m_type(DataType::TYPE_NONE)
+  , m_key_length(0U)
   , m_key(nullptr)
   , m_value()
 {
@@ -11,6 +236,7 @@ Telemetry::Telemetry()
 
 Telemetry::Telemetry(char const * key, bool value)
   : m_type(DataType::TYPE_BOOL)
+  , m_key_length(Measure_Key(key))
   , m_key(key)
   , m_value()
 {
@@ -19,6 +245,7 @@ Telemetry::Telemetry(char const * key, bool value)
 
 Telemetry::Telemetry(char const * key, char const * value)
   : m_type(DataType::TYPE_STR)
+  , m_key_length(Measure_Key(key))
   , m_key(key)
   , m_value()
 {
@@ -28,3 +255,68 @@ Telemetry::Telemetry(char const * key, char const * value)
 bool Telemetry::IsEmpty() const {
     return (m_key == nullptr) && m_type == DataType::TYPE_NONE;
 }
+
+char * Telemetry::Write_Json_String(char * current, char const * end, char const * string) {
+    if (string == nullptr) {
+        return nullptr;
+    }
+    return Write_Escaped_String(current, end, string);
+}
+
+char * Telemetry::Write_Json_Pair(char * current, char const * end) const {
+    if (m_key == nullptr || m_type == DataType::TYPE_NONE) {
+        return nullptr;
+    }
+
+    // Quotes and colon are reserved together with the key, if it can be copied as is
+    if (m_key_length != KEY_REQUIRES_ESCAPING) {
+        if (static_cast<size_t>(end - current) < m_key_length + 3U) {
+            return nullptr;
+        }
+        *current++ = '"';
+        memcpy(current, m_key, m_key_length);
+        current += m_key_length;
+        *current++ = '"';
+    }
+    else if ((current = Write_Escaped_String(current, end, m_key)) == nullptr || current >= end) {
+        return nullptr;
+    }
+    *current++ = ':';
+
+    switch (m_type) {
+        case DataType::TYPE_BOOL:
+            if (end - current < (m_value.boolean ? 4 : 5)) {
+                return nullptr;
+            }
+            memcpy(current, m_value.boolean ? "true" : "false", m_value.boolean ? 4U : 5U);
+            return current + (m_value.boolean ? 4U : 5U);
+        case DataType::TYPE_INT:
+            return Write_Signed(current, end, m_value.integer);
+        case DataType::TYPE_REAL:
+            return Write_Real(current, end, m_value.real);
+        case DataType::TYPE_STR:
+            if (m_value.str == nullptr) {
+                if (end - current < 4) {
+                    return nullptr;
+                }
+                memcpy(current, "null", 4U);
+                return current + 4U;
+            }
+            return Write_Escaped_String(current, end, m_value.str);
+        default:
+            return nullptr;
+    }
+}
+
+uint16_t Telemetry::Measure_Key(char const * key) {
+    if (key == nullptr) {
+        return 0U;
+    }
+    size_t length = 0U;
+    for (; key[length] != '\0'; length++) {
+        if (length >= KEY_REQUIRES_ESCAPING || key[length] == '"' || key[length] == '\\' || key[length] == '\b' || key[length] == '\f' || key[length] == '\n' || key[length] == '\r' || key[length] == '\t') {
+            return KEY_REQUIRES_ESCAPING;
+        }
+    }
+    return static_cast<uint16_t>(length);
+}
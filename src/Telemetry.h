@@ -6,6 +6,7 @@
 
 // Library includes.
 #include <ArduinoJson.h>
+#include <stdint.h>
 #if THINGSBOARD_ENABLE_STL
 #include <type_traits>
 #endif // THINGSBOARD_ENABLE_STL
@@ -33,6 +34,7 @@ class Telemetry {
 #endif // THINGSBOARD_ENABLE_STL
     Telemetry(char const * key, T const & value)
       : m_type(DataType::TYPE_INT)
+      , m_key_length(Measure_Key(key))
       , m_key(key)
       , m_value()
     {
@@ -54,6 +56,7 @@ class Telemetry {
 #endif // THINGSBOARD_ENABLE_STL
     Telemetry(char const * key, T const & value)
       : m_type(DataType::TYPE_REAL)
+      , m_key_length(Measure_Key(key))
       , m_key(key)
       , m_value()
     {
@@ -74,6 +77,71 @@ class Telemetry {
     /// @return Whether there is any data in this record or not
     bool IsEmpty() const;
 
+    /// @brief Writes the given records as a single json object directly into the given buffer, in one pass and without requiring a JsonDocument.
+    /// Keys that do not have to be escaped are copied with their length calculated once when the record was constructed, and numbers are formatted without snprintf,
+    /// floating point values are formatted with the same amount of significant digits ArduinoJson uses, so the payload is the same as when it is serialized from a JsonDocument.
+    /// Only supports records that contain a key-value pair, because a value without a key can not be part of an object
+    /// @tparam InputIterator Class that points to the begin and end iterator
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @param buffer Buffer the json object should be written into, is null terminated if writing was successful
+    /// @param buffer_size Size of the given buffer, including the space for the null terminator
+    /// @return Length of the written json object without the null terminator, or 0 if the object did not fit into the buffer or any of the records did not contain a key-value pair
+    template <typename InputIterator>
+    static size_t Write_Json_Object(InputIterator const & first, InputIterator const & last, char * buffer, size_t const & buffer_size) {
+        return Write_Json_Object(first, last, buffer, buffer_size, [](Telemetry const &) { return true; });
+    }
+
+    /// @brief Writes the records the given predicate includes as a single json object directly into the given buffer, see the overload without a predicate for more information
+    /// @tparam InputIterator Class that points to the begin and end iterator
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @tparam Predicate Callable that receives a record and returns whether it should be written, allows to skip records without having to copy the remaining ones into a separate container
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @param buffer Buffer the json object should be written into, is null terminated if writing was successful
+    /// @param buffer_size Size of the given buffer, including the space for the null terminator
+    /// @param include Predicate that decides for every record whether it is written into the object or skipped
+    /// @return Length of the written json object without the null terminator, or 0 if the object did not fit into the buffer or any of the included records did not contain a key-value pair
+    template <typename InputIterator, typename Predicate>
+    static size_t Write_Json_Object(InputIterator const & first, InputIterator const & last, char * buffer, size_t const & buffer_size, Predicate const & include) {
+        if (buffer == nullptr || buffer_size < 3U) {
+            return 0U;
+        }
+        char * current = buffer;
+        // Space for the closing bracket and the null terminator is always kept free
+        char const * const end = buffer + buffer_size - 2U;
+        *current++ = '{';
+        for (auto it = first; it != last; ++it) {
+            if (!include(*it)) {
+                continue;
+            }
+            else if (current != buffer + 1U) {
+                if (current >= end) {
+                    return 0U;
+                }
+                *current++ = ',';
+            }
+            current = (*it).Write_Json_Pair(current, end);
+            if (current == nullptr) {
+                return 0U;
+            }
+        }
+        *current++ = '}';
+        *current = '\0';
+        return current - buffer;
+    }
+
+    /// @brief Writes the given string surrounded by quotes directly into the given buffer, escaping it the same way the keys and values written by Write_Json_Object() are escaped.
+    /// Allows to write keys that are not part of a record, like the name of a device the records belong to, without having to copy them into a JsonDocument first
+    /// @param current Position in the buffer the string should be written at
+    /// @param end End of the space in the buffer the string can be written into
+    /// @param string Null terminated string that should be written
+    /// @return Position directly after the closing quote of the written string, or nullptr if it did not fit
+    static char * Write_Json_String(char * current, char const * end, char const * string);
+
     /// @brief Serializes a key-value pair or a value, depending on the constructor used
     /// @tparam TSource Source class that the given key value pair or a value, should be copied into
     /// @param source Data source that should contain the key value pair or a value
@@ -113,6 +181,22 @@ class Telemetry {
     }
 
   private:
+    // Allows the filter to compare the value with the last reported value of the same key, without having to serialize it first
+    friend class Deadband_Filter;
+
+    /// @brief Writes the key-value pair as "key":value directly into the given buffer
+    /// @param current Position in the buffer the key-value pair should be written at
+    /// @param end End of the space in the buffer the key-value pair can be written into
+    /// @return Position directly after the written key-value pair, or nullptr if it did not fit or the record does not contain a key-value pair
+    char * Write_Json_Pair(char * current, char const * end) const;
+
+    /// @brief Calculates the length of the given key, if it can be written as is without escaping any of its characters
+    /// @param key Key of the key value pair
+    /// @return Length of the key or KEY_REQUIRES_ESCAPING if it contains a character that has to be escaped or is too long
+    static uint16_t Measure_Key(char const * key);
+
+    static constexpr uint16_t KEY_REQUIRES_ESCAPING = UINT16_MAX;
+
     /// @brief Data container, which contains one of the possibly passed values
     union Data {
         const char  *str;
@@ -130,9 +214,10 @@ class Telemetry {
         TYPE_STR ///< Telemetry isntance is a key value-pair with a string value
     };
 
-    DataType     m_type = {};  // Data type flag, showing which value is saved in the class instance
-    const char   *m_key = {};  // Data key of the key-value pair
-    Data         m_value = {}; // Data value of the key-value pair
+    DataType     m_type = {};       // Data type flag, showing which value is saved in the class instance
+    uint16_t     m_key_length = {}; // Length of the key calculated once when constructed, allows to copy the key as is when writing json, KEY_REQUIRES_ESCAPING if it has to be escaped instead
+    const char   *m_key = {};       // Data key of the key-value pair
+    Data         m_value = {};      // Data value of the key-value pair
 };
 
 /// @brief Telemetry and attributes are only different on the database side (one has a history the other one does not), but both are simply key-value pairs
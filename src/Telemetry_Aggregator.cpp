@@ -0,0 +1,190 @@
+// Header include.
+#include "Telemetry_Aggregator.h"
+
+// Library includes.
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+Aggregator_Channel::Aggregator_Channel(char const * key, float * samples, size_t const & samples_size, uint8_t const & statistics)
+  : key(key)
+  , samples(samples)
+  , samples_size(samples != nullptr ? samples_size : 0U)
+  , statistics(statistics)
+  , length(0U)
+  , min(0.0f)
+  , max(0.0f)
+  , sum(0.0)
+  , count(0U)
+  , keys()
+{
+    // Nothing to do
+}
+
+Telemetry_Aggregator::Iterator::Iterator(Telemetry_Aggregator const * aggregator, size_t const & channel, size_t const & statistic)
+  : m_aggregator(aggregator)
+  , m_channel(channel)
+  , m_statistic(statistic)
+{
+    Skip_Unused();
+}
+
+Telemetry Telemetry_Aggregator::Iterator::operator*() const {
+    Aggregator_Channel const & channel = m_aggregator->m_channels[m_channel];
+    char const * const key = channel.keys[m_statistic];
+    switch (1U << m_statistic) {
+        case AGGREGATE_MIN:
+            return Telemetry(key, channel.min);
+        case AGGREGATE_MAX:
+            return Telemetry(key, channel.max);
+        case AGGREGATE_MEAN:
+            return Telemetry(key, channel.sum / channel.count);
+        default:
+            return Telemetry(key, channel.count);
+    }
+}
+
+Telemetry_Aggregator::Iterator & Telemetry_Aggregator::Iterator::operator++() {
+    m_statistic++;
+    Skip_Unused();
+    return *this;
+}
+
+bool Telemetry_Aggregator::Iterator::operator==(Iterator const & other) const {
+    return m_aggregator == other.m_aggregator && m_channel == other.m_channel && m_statistic == other.m_statistic;
+}
+
+bool Telemetry_Aggregator::Iterator::operator!=(Iterator const & other) const {
+    return !(*this == other);
+}
+
+void Telemetry_Aggregator::Iterator::Skip_Unused() {
+    for (; m_channel < m_aggregator->m_channels_size; m_channel++, m_statistic = 0U) {
+        Aggregator_Channel const & channel = m_aggregator->m_channels[m_channel];
+        // Channels without any sample in the current window have no statistics, not even a count, because the mean would be undefined
+        if (channel.count == 0U) {
+            continue;
+        }
+        for (; m_statistic < AGGREGATE_STATISTICS; m_statistic++) {
+            if ((channel.statistics & (1U << m_statistic)) != 0U) {
+                return;
+            }
+        }
+    }
+    // Every iterator past the last statistic is the same as end()
+    m_channel = m_aggregator->m_channels_size;
+    m_statistic = 0U;
+}
+
+Telemetry_Aggregator::Telemetry_Aggregator(Aggregator_Channel * channels, size_t const & channels_size, uint64_t const & window_microseconds, char const * min_suffix,
+  char const * max_suffix, char const * mean_suffix, char const * count_suffix)
+  : m_channels(channels)
+  , m_channels_size(channels != nullptr ? channels_size : 0U)
+  , m_window(window_microseconds)
+  , m_window_start(0U)
+  , m_window_samples(0U)
+  , m_window_started(false)
+{
+    char const * const suffixes[AGGREGATE_STATISTICS] = { min_suffix, max_suffix, mean_suffix, count_suffix };
+    for (size_t index = 0U; index < m_channels_size; index++) {
+        Aggregator_Channel & channel = m_channels[index];
+        for (size_t statistic = 0U; statistic < AGGREGATE_STATISTICS; statistic++) {
+            int const length = snprintf(channel.keys[statistic], THINGSBOARD_AGGREGATOR_MAX_KEY_SIZE, "%s%s", channel.key != nullptr ? channel.key : "", suffixes[statistic] != nullptr ? suffixes[statistic] : "");
+            // Statistics whose key would be truncated are never sent, because they would otherwise overwrite the value of a different key on the server
+            if (channel.key == nullptr || length < 0 || static_cast<size_t>(length) >= THINGSBOARD_AGGREGATOR_MAX_KEY_SIZE) {
+                channel.statistics &= ~static_cast<uint8_t>(1U << statistic);
+            }
+        }
+    }
+}
+
+bool Telemetry_Aggregator::Add_Sample(size_t const & channel, float const & value) {
+    if (channel >= m_channels_size || isnan(value)) {
+        return false;
+    }
+    Aggregator_Channel & current = m_channels[channel];
+    if (current.samples_size == 0U) {
+        return false;
+    }
+    else if (current.length == current.samples_size) {
+        Reduce(current);
+    }
+    current.samples[current.length++] = value;
+    m_window_samples++;
+    return true;
+}
+
+bool Telemetry_Aggregator::Add_Sample(char const * key, float const & value) {
+    if (key == nullptr) {
+        return false;
+    }
+    for (size_t index = 0U; index < m_channels_size; index++) {
+        char const * const channel_key = m_channels[index].key;
+        if (channel_key != nullptr && strcmp(channel_key, key) == 0) {
+            return Add_Sample(index, value);
+        }
+    }
+    return false;
+}
+
+bool Telemetry_Aggregator::Should_Emit(uint64_t const & now) {
+    if (m_window_samples == 0U) {
+        return false;
+    }
+    else if (!m_window_started) {
+        m_window_start = now;
+        m_window_started = true;
+    }
+    return now - m_window_start >= m_window;
+}
+
+bool Telemetry_Aggregator::Is_Empty() const {
+    return m_window_samples == 0U;
+}
+
+void Telemetry_Aggregator::Close_Window() {
+    for (size_t index = 0U; index < m_channels_size; index++) {
+        Reduce(m_channels[index]);
+    }
+}
+
+Telemetry_Aggregator::Iterator Telemetry_Aggregator::begin() const {
+    return Iterator(this, 0U, 0U);
+}
+
+Telemetry_Aggregator::Iterator Telemetry_Aggregator::end() const {
+    return Iterator(this, m_channels_size, 0U);
+}
+
+void Telemetry_Aggregator::clear() {
+    for (size_t index = 0U; index < m_channels_size; index++) {
+        Aggregator_Channel & channel = m_channels[index];
+        channel.length = 0U;
+        channel.sum = 0.0;
+        channel.count = 0U;
+    }
+    m_window_samples = 0U;
+    m_window_started = false;
+}
+
+void Telemetry_Aggregator::Reduce(Aggregator_Channel & channel) {
+    if (channel.length == 0U) {
+        return;
+    }
+    float const * const samples = channel.samples;
+    float minimum = channel.count == 0U ? samples[0] : channel.min;
+    float maximum = channel.count == 0U ? samples[0] : channel.max;
+    double sum = 0.0;
+    // Branchless loop over contiguous memory, which the compiler can unroll or vectorize on targets that support it
+    for (size_t index = 0U; index < channel.length; index++) {
+        float const sample = samples[index];
+        minimum = sample < minimum ? sample : minimum;
+        maximum = sample > maximum ? sample : maximum;
+        sum += sample;
+    }
+    channel.min = minimum;
+    channel.max = maximum;
+    channel.sum += sum;
+    channel.count += channel.length;
+    channel.length = 0U;
+}
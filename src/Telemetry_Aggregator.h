@@ -0,0 +1,159 @@
+#ifndef Telemetry_Aggregator_h
+#define Telemetry_Aggregator_h
+
+// Local include.
+#include "Telemetry.h"
+
+// Library includes.
+#if THINGSBOARD_ENABLE_STL
+#include <iterator>
+#endif // THINGSBOARD_ENABLE_STL
+
+
+// Statistics a channel of the Telemetry_Aggregator can send at the end of every window, can be combined with a bitwise or
+uint8_t constexpr AGGREGATE_MIN = 1U << 0U;
+uint8_t constexpr AGGREGATE_MAX = 1U << 1U;
+uint8_t constexpr AGGREGATE_MEAN = 1U << 2U;
+uint8_t constexpr AGGREGATE_COUNT = 1U << 3U;
+uint8_t constexpr AGGREGATE_ALL = AGGREGATE_MIN | AGGREGATE_MAX | AGGREGATE_MEAN | AGGREGATE_COUNT;
+// Amount of different statistics, the index of every statistic is the position of its bit
+size_t constexpr AGGREGATE_STATISTICS = 4U;
+// Default suffixes that are appended to the key of the channel, to create the key every statistic is sent with
+char constexpr AGGREGATE_MIN_SUFFIX[] = "_min";
+char constexpr AGGREGATE_MAX_SUFFIX[] = "_max";
+char constexpr AGGREGATE_MEAN_SUFFIX[] = "_mean";
+char constexpr AGGREGATE_COUNT_SUFFIX[] = "_count";
+
+
+/// @brief Single key that raw samples are aggregated for by the Telemetry_Aggregator, an array of these channels has to be passed to the aggregator.
+/// Samples are appended into the passed buffer and only reduced into the statistics of the current window once the buffer is full or the window ends,
+/// which keeps adding a sample down to a single store and reduces the samples in one tight loop over contiguous memory, instead of updating every statistic on every sample
+struct Aggregator_Channel {
+    char const *key = {};                                                     // Key of the channel, the key of every statistic is this key followed by the suffix of the statistic
+    float      *samples = {};                                                 // Buffer the raw samples are appended into, before they are reduced
+    size_t     samples_size = {};                                             // Amount of samples the buffer can hold
+    uint8_t    statistics = {};                                               // Statistics that are sent at the end of every window
+    size_t     length = {};                                                   // Amount of samples currently contained in the buffer
+    float      min = {};                                                      // Smallest sample of the current window, that has already been reduced
+    float      max = {};                                                      // Biggest sample of the current window, that has already been reduced
+    double     sum = {};                                                      // Sum of the samples of the current window, that have already been reduced
+    uint32_t   count = {};                                                    // Amount of samples of the current window, that have already been reduced
+    char       keys[AGGREGATE_STATISTICS][THINGSBOARD_AGGREGATOR_MAX_KEY_SIZE]; // Key of every statistic, created once by the aggregator so it does not have to be formatted every window
+
+    /// @brief Constructor
+    /// @param key Key of the channel, has to be kept alive for as long as the instance of this class
+    /// @param samples Buffer the raw samples are appended into, has to be kept alive for as long as the instance of this class.
+    /// Bigger buffers are reduced less often, but the size does not affect the result, because a full buffer is reduced into the statistics of the window and then reused
+    /// @param samples_size Amount of samples the buffer can hold
+    /// @param statistics Statistics that are sent at the end of every window, default = AGGREGATE_ALL
+    Aggregator_Channel(char const * key, float * samples, size_t const & samples_size, uint8_t const & statistics = AGGREGATE_ALL);
+};
+
+
+/// @brief Aggregator that accepts raw samples of telemetry sampled at a high rate and reduces them into the min, max, mean and count of every key over a fixed window,
+/// so that only the statistics have to be sent to the server, instead of every single sample or one sample out of many. All memory is passed to the constructor, meaning no memory is ever allocated.
+/// The statistics are sent with the key of the channel followed by the suffix of the statistic, for example temp_min, temp_max, temp_mean and temp_count, channels that did not receive any sample during a window are omitted.
+/// The aggregator can be iterated over like a container of Telemetry records, which allows to send the statistics through the same path as sendTelemetry(),
+/// which is done automatically from loop() at the end of every window, when the aggregator is passed to ThingsBoardSized::Set_Telemetry_Aggregator()
+class Telemetry_Aggregator {
+  public:
+    /// @brief Input iterator over the statistics of the current window, returns a Telemetry record for every statistic of every channel that received samples
+    class Iterator {
+      public:
+#if THINGSBOARD_ENABLE_STL
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Telemetry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Telemetry const *;
+        using reference = Telemetry;
+#endif // THINGSBOARD_ENABLE_STL
+
+        /// @brief Constructor
+        /// @param aggregator Aggregator the statistics are read from
+        /// @param channel Index of the channel the iterator points to, the iterator is moved to the next sent statistic if the given one is not sent
+        /// @param statistic Index of the statistic the iterator points to
+        Iterator(Telemetry_Aggregator const * aggregator, size_t const & channel, size_t const & statistic);
+
+        /// @brief Creates the record of the statistic the iterator points to
+        /// @return Record containing the suffixed key and the value of the statistic
+        Telemetry operator*() const;
+
+        /// @brief Moves the iterator to the next statistic that is sent
+        /// @return Reference to the moved iterator
+        Iterator & operator++();
+
+        bool operator==(Iterator const & other) const;
+
+        bool operator!=(Iterator const & other) const;
+
+      private:
+        /// @brief Moves the iterator forward until it points to a statistic that is sent or the end
+        void Skip_Unused();
+
+        Telemetry_Aggregator const *m_aggregator = {}; // Aggregator the statistics are read from
+        size_t                     m_channel = {};    // Index of the channel the iterator points to
+        size_t                     m_statistic = {};  // Index of the statistic the iterator points to
+    };
+
+    /// @brief Constructor, creates the suffixed key of every statistic of every channel
+    /// @param channels Array of channels the samples are aggregated for, has to be kept alive for as long as the instance of this class
+    /// @param channels_size Amount of channels in the given array
+    /// @param window_microseconds Length of a window in microseconds, starting with the first call to Should_Emit() after the first sample of the window was added, which ThingsBoardSized does on every call to loop()
+    /// @param min_suffix Suffix appended to the key of the channel for the smallest sample, default = AGGREGATE_MIN_SUFFIX
+    /// @param max_suffix Suffix appended to the key of the channel for the biggest sample, default = AGGREGATE_MAX_SUFFIX
+    /// @param mean_suffix Suffix appended to the key of the channel for the mean of the samples, default = AGGREGATE_MEAN_SUFFIX
+    /// @param count_suffix Suffix appended to the key of the channel for the amount of samples, default = AGGREGATE_COUNT_SUFFIX
+    Telemetry_Aggregator(Aggregator_Channel * channels, size_t const & channels_size, uint64_t const & window_microseconds, char const * min_suffix = AGGREGATE_MIN_SUFFIX,
+      char const * max_suffix = AGGREGATE_MAX_SUFFIX, char const * mean_suffix = AGGREGATE_MEAN_SUFFIX, char const * count_suffix = AGGREGATE_COUNT_SUFFIX);
+
+    /// @brief Appends a raw sample to the channel at the given index, reduces the samples of the channel first if its buffer is full.
+    /// Is the fastest way to add a sample and should therefore be preferred for keys sampled at a high rate
+    /// @param channel Index of the channel in the array passed to the constructor
+    /// @param value Raw sample that should be aggregated
+    /// @return Whether the sample was added, false if the index is out of range, the channel has no buffer or the value is not a number
+    bool Add_Sample(size_t const & channel, float const & value);
+
+    /// @brief Appends a raw sample to the channel with the given key, see the overload with the index for more information
+    /// @param key Key of the channel, the channels are compared in order
+    /// @param value Raw sample that should be aggregated
+    /// @return Whether the sample was added, false if no channel has the given key, the channel has no buffer or the value is not a number
+    bool Add_Sample(char const * key, float const & value);
+
+    /// @brief Whether the current window has ended, meaning its statistics should be sent.
+    /// Samples are added without the current time, so that adding them stays as cheap as possible, therefore the first call after the first sample of a window was added starts the window instead
+    /// @param now Current time in microseconds, has to be of the same clock for every call
+    /// @return Whether the window contains samples and the window length has passed since it was started
+    bool Should_Emit(uint64_t const & now);
+
+    /// @brief Whether the current window contains any samples
+    /// @return Whether the window is empty or not
+    bool Is_Empty() const;
+
+    /// @brief Reduces the samples still contained in the buffer of every channel into the statistics of the current window, has to be called before the statistics are iterated
+    void Close_Window();
+
+    /// @brief Gets an iterator to the first statistic of the current window
+    /// @return Iterator pointing to the first statistic
+    Iterator begin() const;
+
+    /// @brief Gets an iterator to the end of the statistics of the current window
+    /// @return Iterator pointing to the end of the statistics (last statistic + 1)
+    Iterator end() const;
+
+    /// @brief Removes all samples and starts a new window with the next sample, has to be called once the statistics have been sent
+    void clear();
+
+  private:
+    /// @brief Reduces the samples in the buffer of the given channel into the statistics of the current window and empties the buffer
+    /// @param channel Channel whose samples should be reduced
+    static void Reduce(Aggregator_Channel & channel);
+
+    Aggregator_Channel *m_channels = {};      // Array of channels the samples are aggregated for
+    size_t             m_channels_size = {};  // Amount of channels in the array
+    uint64_t           m_window = {};         // Length of a window in microseconds
+    uint64_t           m_window_start = {};   // Time in microseconds the current window was started at
+    size_t             m_window_samples = {}; // Amount of samples added to the current window
+    bool               m_window_started = {}; // Whether the current window has been started by a call to Should_Emit()
+};
+
+#endif // Telemetry_Aggregator_h
@@ -0,0 +1,83 @@
+// Header include.
+#include "Telemetry_Batch.h"
+
+constexpr char TIMESTAMPED_ROW_PREFIX[] = "%c{\"ts\":%llu,\"values\":";
+
+Telemetry_Batch::Telemetry_Batch(char * buffer, size_t const & buffer_size, size_t const & max_rows, uint64_t const & max_age_microseconds)
+  : m_buffer(buffer)
+  , m_buffer_size(buffer_size)
+  , m_max_rows(max_rows)
+  , m_max_age(max_age_microseconds)
+  , m_length(0U)
+  , m_rows(0U)
+  , m_first_row_time(0U)
+{
+    // Nothing to do
+}
+
+bool Telemetry_Batch::Append(uint64_t const & timestamp, JsonDocument const & values, uint64_t const & now) {
+    // Space for the closing bracket of the array and the null terminator is always kept free
+    if (m_buffer == nullptr || m_length + 2U >= m_buffer_size) {
+        return false;
+    }
+    size_t const remaining = m_buffer_size - m_length - 2U;
+    // The first row opens the array, every following row is separated from the previous one with a comma
+    int const prefix_size = snprintf(m_buffer + m_length, remaining, TIMESTAMPED_ROW_PREFIX, m_rows == 0U ? '[' : ',', static_cast<unsigned long long>(timestamp));
+    if (prefix_size < 0 || static_cast<size_t>(prefix_size) >= remaining) {
+        return false;
+    }
+    size_t const values_size = Helper::Measure_Json(values);
+    // Space for the serialized values and the closing bracket of the row, the null terminator written by serializeJson overlaps with that bracket
+    if (prefix_size + values_size > remaining) {
+        return false;
+    }
+    size_t const written = serializeJson(values, m_buffer + m_length + prefix_size, values_size);
+    if (written != values_size - 1U) {
+        return false;
+    }
+
+    if (m_rows == 0U) {
+        m_first_row_time = now;
+    }
+    m_length += prefix_size + written;
+    m_buffer[m_length++] = '}';
+    m_rows++;
+    return true;
+}
+
+bool Telemetry_Batch::Should_Flush(uint64_t const & now) const {
+    if (m_rows == 0U) {
+        return false;
+    }
+    if (m_max_rows != 0U && m_rows >= m_max_rows) {
+        return true;
+    }
+    return m_max_age != 0U && now - m_first_row_time >= m_max_age;
+}
+
+bool Telemetry_Batch::Is_Empty() const {
+    return m_rows == 0U;
+}
+
+size_t const & Telemetry_Batch::Get_Rows() const {
+    return m_rows;
+}
+
+char const * Telemetry_Batch::Get_Payload() {
+    if (m_rows == 0U) {
+        return nullptr;
+    }
+    m_buffer[m_length] = ']';
+    m_buffer[m_length + 1U] = '\0';
+    return m_buffer;
+}
+
+size_t Telemetry_Batch::Get_Payload_Size() const {
+    return m_rows == 0U ? 0U : m_length + 1U;
+}
+
+void Telemetry_Batch::clear() {
+    m_length = 0U;
+    m_rows = 0U;
+    m_first_row_time = 0U;
+}
@@ -0,0 +1,67 @@
+#ifndef Telemetry_Batch_h
+#define Telemetry_Batch_h
+
+// Local include.
+#include "Helper.h"
+
+
+/// @brief Builder that accumulates multiple rows of telemetry with their own timestamp in a preallocated buffer,
+/// which are then sent as a single payload in the timestamped telemetry array format [{"ts":1451649600512,"values":{"key":"value"}},...].
+/// Allows to send telemetry that is sampled at a high rate, with a single publish for hundreds of samples instead of a publish per sample,
+/// while still keeping the time every single sample was taken at, instead of the time it was received by the server.
+/// The rows are serialized directly into the passed buffer, which has to be kept alive for as long as the instance of this class.
+/// The batch should be flushed once the buffer is full, the configured amount of rows is reached or the oldest row exceeds the configured max age,
+/// which is done automatically when the batch is passed to ThingsBoardSized::Set_Telemetry_Batch() and rows are appended with sendTelemetryBatched()
+class Telemetry_Batch {
+  public:
+    /// @brief Constructor
+    /// @param buffer Buffer the rows are serialized into, should not be bigger than the send buffer size of the client, because the complete batch has to be sent at once
+    /// @param buffer_size Size of the given buffer, the last two bytes are reserved for the closing bracket and the null terminator
+    /// @param max_rows Maximum amount of rows before the batch should be flushed, 0 means the batch is only flushed once the buffer is full or the max age is exceeded, default = 0
+    /// @param max_age_microseconds Maximum amount of microseconds since the first row was appended before the batch should be flushed,
+    /// 0 means the batch is only flushed once the buffer is full or the max rows are reached, default = 0
+    Telemetry_Batch(char * buffer, size_t const & buffer_size, size_t const & max_rows = 0U, uint64_t const & max_age_microseconds = 0U);
+
+    /// @brief Serializes the given values as a new row with the given timestamp into the buffer
+    /// @param timestamp Unix timestamp in milliseconds the values were sampled at
+    /// @param values JsonDocument containing the key value pairs of the row
+    /// @param now Current time in microseconds, remembered if the row is the first row of the batch, to compare the max age against
+    /// @return Whether the row fit into the remaining buffer and was appended successfully or not.
+    /// If it did not, the batch has to be flushed before the row is appended again
+    bool Append(uint64_t const & timestamp, JsonDocument const & values, uint64_t const & now);
+
+    /// @brief Whether the batch should be flushed, because the max rows are reached or the first row exceeds the max age
+    /// @param now Current time in microseconds of the same clock that was passed to Append()
+    /// @return Whether the batch should be flushed
+    bool Should_Flush(uint64_t const & now) const;
+
+    /// @brief Whether the batch contains any rows
+    /// @return Whether the batch is empty or not
+    bool Is_Empty() const;
+
+    /// @brief Gets the amount of rows currently contained in the batch
+    /// @return Amount of rows in the batch
+    size_t const & Get_Rows() const;
+
+    /// @brief Closes the array of rows and returns the complete payload, more rows can still be appended afterwards
+    /// @return Null terminated timestamped telemetry array containing all rows
+    char const * Get_Payload();
+
+    /// @brief Gets the length of the payload returned by Get_Payload()
+    /// @return Length of the payload without the null terminator
+    size_t Get_Payload_Size() const;
+
+    /// @brief Removes all rows, has to be called once the payload has been sent successfully
+    void clear();
+
+  private:
+    char     *m_buffer = {};           // Buffer the rows are serialized into
+    size_t   m_buffer_size = {};       // Size of the buffer
+    size_t   m_max_rows = {};          // Maximum amount of rows before the batch should be flushed
+    uint64_t m_max_age = {};           // Maximum amount of microseconds since the first row was appended before the batch should be flushed
+    size_t   m_length = {};            // Amount of bytes written into the buffer without the closing bracket
+    size_t   m_rows = {};              // Amount of rows currently contained in the batch
+    uint64_t m_first_row_time = {};    // Time in microseconds the first row of the current batch was appended
+};
+
+#endif // Telemetry_Batch_h
@@ -3,10 +3,21 @@
 
 // Local includes.
 #include "Constants.h"
+#include "Callback_Watchdog.h"
 #include "IAPI_Implementation.h"
+#include "IThingsBoard_Client.h"
+#include "Topic_Router.h"
+#include "Outbox.h"
+#include "Outbound_Queue.h"
+#include "Rate_Limiter.h"
+#include "Subscription_Manager.h"
 #include "IMQTT_Client.h"
+#include "IPayload_Codec.h"
 #include "DefaultLogger.h"
 #include "Telemetry.h"
+#include "Telemetry_Batch.h"
+#include "Deadband_Filter.h"
+#include "Telemetry_Aggregator.h"
 
 // Library includes.
 #if THINGSBOARD_ENABLE_STREAM_UTILS
@@ -21,6 +32,12 @@ char constexpr UNABLE_TO_DE_SERIALIZE_JSON[] = "Unable to de-serialize received
 char constexpr INVALID_BUFFER_SIZE[] = "Send buffer size (%u) to small for the given payloads size (%u), increase with setBufferSize accordingly or install the StreamUtils library";
 char constexpr UNABLE_TO_ALLOCATE_BUFFER[] = "Allocating memory for the internal MQTT buffer failed";
 char constexpr MAX_ENDPOINTS_AMOUNT_TEMPLATE_NAME[] = "MaxEndpointsAmount";
+char constexpr TELEMETRY_BATCH_NOT_SET[] = "Telemetry batch has not been set, call Set_Telemetry_Batch before appending rows";
+char constexpr TELEMETRY_BATCH_TOO_SMALL[] = "Telemetry row does not fit into an empty batch, increase the size of the buffer passed to the Telemetry_Batch";
+char constexpr UNABLE_TO_ENCODE_PAYLOAD[] = "Unable to encode data for topic (%s) with the payload codec, because it does not match the schema or does not fit into the send buffer size (%u)";
+char constexpr UNABLE_TO_DECODE_PAYLOAD[] = "Unable to decode received data from topic (%s) with the payload codec, because it is invalid or does not match the schema";
+char constexpr PAYLOAD_CODEC_REQUIRES_JSON_DOCUMENT[] = "Unable to send json string over topic (%s), because the payload codec encodes it from a JsonDocument, use the methods accepting a JsonDocument instead";
+char constexpr RATE_LIMITER_REQUIRES_OUTBOUND_QUEUE[] = "Rate limiter requires an outbound queue to defer messages exceeding the limits into, set the queue before the rate limiter and keep it set for as long as the rate limiter is";
 #if THINGSBOARD_ENABLE_DYNAMIC
 char constexpr MAXIMUM_RESPONSE_EXCEEDED[] = "Prevented allocation on the heap (%u) for JsonDocument. Discarding message that is bigger than maximum response size (%u)";
 char constexpr HEAP_ALLOCATION_FAILED[] = "Failed allocating required size (%u) for JsonDocument. Ensure there is enough heap memory left";
@@ -38,6 +55,47 @@ char constexpr SECRET_KEY[] = "secretKey";
 char constexpr DURATION_KEY[] = "durationMs";
 
 
+/// @brief Additional routes passed to ThingsBoardSized::Route_Message, when a received message should only be handled by the subscribed api implementations
+struct Empty_Routes {
+    bool Match(char const * topic) const {
+        return false;
+    }
+
+    size_t Count_Process_Type(API_Process_Type const & type) const {
+        return 0U;
+    }
+
+    void Process_Response(API_Process_Type const & type, char const * topic, uint8_t * payload, unsigned int length) const {
+        // Nothing to do
+    }
+
+    void Process_Json_Response(char const * topic, JsonDocument const & data) const {
+        // Nothing to do
+    }
+};
+
+
+/// @brief Predicate passed to Telemetry::Write_Json_Object() by ThingsBoardSized::sendTelemetry(), that only includes the records the optional Deadband_Filter decides should be reported
+struct Report_Filter {
+    Deadband_Filter const *filter = {}; // Filter the records are checked with, nullptr to include every record
+    uint64_t              now = {};     // Time in microseconds every record is checked against
+
+    /// @brief Constructor
+    /// @param filter Filter the records are checked with, nullptr to include every record
+    /// @param now Time in microseconds every record is checked against
+    Report_Filter(Deadband_Filter const * filter, uint64_t const & now)
+      : filter(filter)
+      , now(now)
+    {
+        // Nothing to do
+    }
+
+    bool operator()(Telemetry const & data) const {
+        return filter == nullptr || filter->Should_Report(data, now);
+    }
+};
+
+
 #if THINGSBOARD_ENABLE_DYNAMIC
 /// @brief Wrapper around any arbitrary MQTT Client implementing the IMQTT_Client interface, to allow connecting and sending / retrieving data from ThingsBoard over the MQTT or MQTT with TLS/SSL protocol.
 /// BufferSize of the underlying data buffer can be changed during the runtime and the maximum amount of data points that can ever be sent or received are automatically deduced at runtime.
@@ -61,7 +119,7 @@ template <typename Logger = DefaultLogger>
 /// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
 template<size_t MaxResponse = Default_Response_Amount, size_t MaxEndpointsAmount = Default_Endpoints_Amount, typename Logger = DefaultLogger>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
-class ThingsBoardSized {
+class ThingsBoardSized : public IThingsBoard_Client {
   public:
     /// @brief Constructs a ThingsBoardSized instance with the given network client that should be used to establish the connection to ThingsBoard.
     /// Directly forwards the last given arguments to the overloaded Array or Vector (THINGSBOARD_ENABLE_DYNAMIC) constructor,
@@ -111,6 +169,8 @@ class ThingsBoardSized {
 #endif // THINGSBOARD_ENABLE_DYNAMIC
       : m_client(client)
       , m_max_stack(max_stack_size)
+      , m_subscriptions(client)
+      , m_timer_queue(&Callback_Watchdog::now)
 #if THINGSBOARD_ENABLE_STREAM_UTILS
       , m_buffering_size(buffering_size)
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
@@ -123,12 +183,9 @@ class ThingsBoardSized {
             if (api == nullptr) {
                 continue;
             }
-#if THINGSBOARD_ENABLE_STL
-            api->Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoardSized::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::clientSubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::clientUnsubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::getClientReceiveBufferSize, this), std::bind(&ThingsBoardSized::getClientSendBufferSize, this), std::bind(&ThingsBoardSized::setBufferSize, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::getRequestID, this));
-#else
-            api->Set_Client_Callbacks(ThingsBoardSized::staticSubscribeImplementation, ThingsBoardSized::staticSendJson, ThingsBoardSized::staticSendJsonString, ThingsBoardSized::staticClientSubscribe, ThingsBoardSized::staticClientUnsubscribe, ThingsBoardSized::staticGetClientReceiveBufferSize, ThingsBoardSized::staticGetClientSendBufferSize, ThingsBoardSized::staticSetBufferSize, ThingsBoardSized::staticGetRequestID);
-#endif // THINGSBOARD_ENABLE_STL
+            api->Set_Client(*this);
             api->Initialize();
+            m_topic_router.Add_Route(*api);
         }
         (void)setBufferSize(receive_buffer_size, send_buffer_size);
         // Initialize callback.
@@ -151,6 +208,104 @@ class ThingsBoardSized {
         return m_client;
     }
 
+    /// @brief Gets the queue that handles the timeouts of every request sent by the api implementations, instead of each request starting its own timer.
+    /// The expired requests are handled in loop(), allows to replace the clock the queue uses with Timer_Queue::Set_Time_Callback(),
+    /// to expire requests without actually having to wait when the library is run natively on a host
+    /// @return Reference to the internal timer queue
+    Timer_Queue & getTimerQueue() override {
+        return m_timer_queue;
+    }
+
+    /// @brief Sets the outbox that telemetry and attributes are persisted into, if publishing them fails because the connection has been lost or the client buffer is full.
+    /// The stored messages are published again in batches from loop() once the connection has been reestablished.
+    /// The outbox is initialized directly, which restores any messages that were still pending before the device was restarted.
+    /// Ensure the actual variable is kept alive for as long as the instance of this class
+    /// @param outbox Outbox the messages should be persisted into
+    /// @return Whether the outbox could be initialized successfully or not
+    bool Set_Outbox(Outbox<Logger> & outbox) {
+        m_outbox = &outbox;
+        return m_outbox->Initialize();
+    }
+
+    /// @brief Sets the queue that every sent message is copied into instead of being published directly, the queued messages are then published from loop(),
+    /// highest priority class first and limited by the budget of the queue, so that a burst of telemetry does not delay RPC responses or OTA chunk requests sent afterwards.
+    /// Messages sent while THINGSBOARD_ENABLE_STREAM_UTILS serializes them directly into the client, because they are bigger than its buffer, are still published directly.
+    /// Ensure the actual variable is kept alive for as long as the instance of this class
+    /// @param queue Queue the messages should be copied into, nullptr to publish every message directly again, which is only possible if no rate limiter is set
+    /// @return Whether the queue was set successfully or not, false if the queue should be removed while a rate limiter still requires it
+    bool Set_Outbound_Queue(Outbound_Queue<Logger> * queue) {
+        if (queue == nullptr && m_rate_limiter != nullptr) {
+            Logger::printfln(RATE_LIMITER_REQUIRES_OUTBOUND_QUEUE);
+            return false;
+        }
+        m_outbound_queue = queue;
+        return true;
+    }
+
+    /// @brief Sets the rate limiter every published message and its telemetry or attribute data points are taken from, to ensure the device never exceeds the rate limits configured for it on the server,
+    /// which would otherwise disconnect it. Requires an outbound queue to be set with Set_Outbound_Queue() beforehand, because messages exceeding the limits are deferred into that queue,
+    /// which then only publishes them from loop() once the limits allow it. Without a queue every message that is not telemetry or attributes, that could be stored into the outbox instead, would be dropped,
+    /// therefore setting a rate limiter is rejected in that case. The outbox is drained within the same limits, because its messages are replayed through the queue as well.
+    /// The limits are refilled with the clock of the timer queue, which can be replaced to run the library natively on a host with getTimerQueue().Set_Time_Callback().
+    /// Ensure the actual variable is kept alive for as long as the instance of this class
+    /// @param limiter Rate limiter the messages should be taken from, nullptr to not limit the rate anymore
+    /// @return Whether the rate limiter was set successfully or not, false if no outbound queue has been set
+    bool Set_Rate_Limiter(Rate_Limiter * limiter) {
+        if (limiter != nullptr && m_outbound_queue == nullptr) {
+            Logger::printfln(RATE_LIMITER_REQUIRES_OUTBOUND_QUEUE);
+            return false;
+        }
+        m_rate_limiter = limiter;
+        return true;
+    }
+
+    /// @brief Configures whether the following connections are established as a persistent session, meaning with the cleanSession flag set to false, which requires connecting with the same client id every time.
+    /// If the broker reports that it still held the session once the connection is established again, the topics are not subscribed again and requests that were still waiting for their response are kept,
+    /// instead of every api implementation resubscribing its topics and discarding its pending requests. Has to be called before connect() to apply to the next connection
+    /// @param persistent Whether the broker should keep the session of the client id after the connection has been lost
+    /// @return Whether the given session mode is supported by the underlying MQTT client or not, if it is not the previous session mode is kept
+    bool Set_Persistent_Session(bool persistent) {
+        if (!m_client.set_clean_session(!persistent)) {
+            return false;
+        }
+        m_persistent_session = persistent;
+        return true;
+    }
+
+    /// @brief Gets the state of the current session, that has to be persisted before the device is restarted and restored with Restore_Session_State() afterwards,
+    /// to continue a persistent session without subscribing the topics the broker still holds again and without reusing the id of a request whose response might still be delivered
+    /// @param state State the topics held by the broker and the shared request id, which the firmware requests and the generation of attribute and client-side RPC requests are taken from, are copied into
+    void Get_Session_State(MQTT_Session_State & state) const {
+        m_subscriptions.Get_State(state);
+        state.request_id = m_request_id;
+    }
+
+    /// @brief Restores the state of a session previously read with Get_Session_State(), has to be called before connect(), because the remembered topics are discarded,
+    /// if the broker does not report that it still held the session once the connection is established
+    /// @param state Previously persisted state of the session
+    void Restore_Session_State(MQTT_Session_State const & state) {
+        m_subscriptions.Restore_State(state);
+        m_request_id = state.request_id;
+    }
+
+    /// @brief Sets the amount of time a topic is kept subscribed, after the last api implementation requiring it unsubscribed it.
+    /// Avoids sending a subscribe and unsubscribe request with every request of api implementations that only subscribe their response topic while they wait for a response,
+    /// like client-side or shared attribute requests and client-side RPC, as long as the next request is sent before the time has passed. Topics are unsubscribed from loop() once the time has passed
+    /// @param linger_time Amount of time in microseconds, 0 to unsubscribe topics immediately, default = Default_Subscription_Linger_Time (30 seconds)
+    void Set_Subscription_Linger_Time(uint64_t const & linger_time) {
+        m_subscriptions.Set_Linger_Time(linger_time);
+    }
+
+    /// @brief Sets the codec that messages are encoded with before they are published and decoded with after they are received, instead of using json.
+    /// Only applies to the topics the codec encodes or decodes, every other topic keeps using json. The public send methods and the callbacks of the api implementations work unchanged,
+    /// because the codec converts from and into the same JsonDocument that would otherwise be serialized or deserialized.
+    /// Should be set before connecting, because the payload type is configured per device profile on the server and therefore has to be the same for the whole connection.
+    /// Ensure the actual variable is kept alive for as long as the instance of this class
+    /// @param codec Codec the messages should be converted with, nullptr to use json for every topic again
+    void Set_Payload_Codec(IPayload_Codec * codec) {
+        m_payload_codec = codec;
+    }
+
     /// @brief Sets the maximum amount of bytes that we want to allocate on the stack, before the memory is allocated on the heap instead
     /// @param max_stack_size Maximum amount of bytes we want to allocate on the stack
     void setMaximumStackSize(size_t const & max_stack_size) {
@@ -192,7 +347,7 @@ class ThingsBoardSized {
     /// So if the available heap memory is a problem on the board it might be useful to enable the THINGSBOARD_ENABLE_STREAM_UTILS option.
     /// This can be done by simply using Arduino as the framework and installing the StreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) library
     /// @return Whether allocating the needed memory for the given buffer sizes was successful or not
-    bool setBufferSize(uint16_t receive_buffer_size, uint16_t send_buffer_size) {
+    bool setBufferSize(uint16_t receive_buffer_size, uint16_t send_buffer_size) override {
         bool const result = m_client.set_buffer_size(receive_buffer_size, send_buffer_size);
         if (!result) {
             Logger::printfln(UNABLE_TO_ALLOCATE_BUFFER);
@@ -248,9 +403,10 @@ class ThingsBoardSized {
     }
 
     /// @brief Receives / sends any outstanding messages from and to the MQTT broker.
-    /// Additionally when not being able to use the ESP Timer, it updates the internal timeout timers
+    /// Additionally calls the timeout callback of every request that did not receive a response in time and when not being able to use the ESP Timer, it updates the internal timers of the api implementations
     /// @return Whether sending or receiving the oustanding the messages was successful or not
     bool loop() {
+        m_timer_queue.update();
 #if !THINGSBOARD_USE_ESP_TIMER
         for (auto & api : m_api_implementations) {
             if (api == nullptr) {
@@ -259,7 +415,28 @@ class ThingsBoardSized {
             api->loop();
         }
 #endif // !THINGSBOARD_USE_ESP_TIMER
-        return m_client.loop();
+        uint64_t const now = m_timer_queue.now();
+        if (m_telemetry_batch != nullptr && m_telemetry_batch->Should_Flush(now)) {
+            (void)flushTelemetryBatch();
+        }
+        if (m_telemetry_aggregator != nullptr && m_telemetry_aggregator->Should_Emit(now)) {
+            (void)flushTelemetryAggregator();
+        }
+        m_subscriptions.loop(now);
+        if (m_outbox != nullptr && m_client.connected()) {
+            // Replayed over the same path as newly sent messages, meaning they are copied into the outbound queue if one is set and therefore published in the order of their priority and within the limits of the rate limiter
+            (void)m_outbox->Drain(m_client.get_send_buffer_size(), [this](char const * topic, uint8_t const * payload, size_t const & length, size_t const & data_points) {
+                return Publish(topic, payload, length, data_points);
+            });
+        }
+        bool const result = m_client.loop();
+        // Drained after the client received its messages, so that responses sent by the callbacks of the received requests are published in the same call
+        if (m_outbound_queue != nullptr && m_client.connected()) {
+            (void)m_outbound_queue->Drain(m_client, m_timer_queue, m_rate_limiter, [this](char const * topic, uint8_t const * payload, size_t const & length) {
+                return Store_In_Outbox(topic, payload, length);
+            });
+        }
+        return result;
     }
 
     /// @brief Attempts to send key value pairs from custom source over the given topic to the server
@@ -267,8 +444,8 @@ class ThingsBoardSized {
     /// @param source JsonDocument containing our json key value pairs we want to send,
     /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
     /// @param json_size Size of the data inside the source
-    /// @return Whether sending the data was successful or not
-    bool Send_Json(char const * topic, JsonDocument const & source, size_t const & json_size) {
+    /// @return Whether sending the data was successful or not, also true if publishing failed but the data was stored in the outbox to be sent later
+    bool Send_Json(char const * topic, JsonDocument const & source, size_t const & json_size) override {
         // Check if allocating needed memory failed when trying to create the JsonDocument,
         // if it did the isNull() method will return true. See https://arduinojson.org/v6/api/jsonvariant/isnull/ for more information
         if (source.isNull()) {
@@ -281,6 +458,11 @@ class ThingsBoardSized {
             Logger::printfln(JSON_SIZE_TO_SMALL);
             return false;
         }
+        // Check if the topic is encoded in a different format than json,
+        // if it is the json is only ever used as the source to encode from and the serialization below has to be skipped
+        if (m_payload_codec != nullptr && m_payload_codec->Is_Encoded_Topic(topic)) {
+            return Send_Encoded(topic, source);
+        }
         bool result = false;
 
 #if THINGSBOARD_ENABLE_STREAM_UTILS
@@ -324,11 +506,15 @@ class ThingsBoardSized {
     /// @brief Attempts to send custom json string over the given topic to the server
     /// @param topic Topic we want to send the data over
     /// @param json String containing our json key value pairs we want to attempt to send
-    /// @return Whether sending the data was successful or not
-    bool Send_Json_String(char const * topic, char const * json) {
+    /// @return Whether sending the data was successful or not, also true if publishing failed but the data was stored in the outbox to be sent later
+    bool Send_Json_String(char const * topic, char const * json) override {
         if (json == nullptr) {
             return false;
         }
+        else if (m_payload_codec != nullptr && m_payload_codec->Is_Encoded_Topic(topic)) {
+            Logger::printfln(PAYLOAD_CODEC_REQUIRES_JSON_DOCUMENT, topic);
+            return false;
+        }
 
         uint16_t current_send_buffer_size = m_client.get_send_buffer_size();
         size_t const json_size = strlen(json);
@@ -341,26 +527,126 @@ class ThingsBoardSized {
 #if THINGSBOARD_ENABLE_DEBUG
         Logger::printfln(SEND_MESSAGE, topic, json);
 #endif // THINGSBOARD_ENABLE_DEBUG
-        return m_client.publish(topic, reinterpret_cast<uint8_t const *>(json), json_size);
+        if (Publish(topic, reinterpret_cast<uint8_t const *>(json), json_size, Count_Data_Points(topic, reinterpret_cast<uint8_t const *>(json), json_size))) {
+            return true;
+        }
+        return Store_In_Outbox(topic, reinterpret_cast<uint8_t const *>(json), json_size);
+    }
+
+    /// @brief Attempts to encode the given json with the payload codec and send the encoded payload over the given topic to the server.
+    /// The payload is encoded into a temporary buffer the size of the send buffer, that is placed onto the stack or the heap depending on the remaining stack size of the current task
+    /// @param topic Topic we want to send the data over, has to be encoded by the payload codec
+    /// @param source JsonDocument containing our json key value pairs we want to encode and send
+    /// @return Whether sending the data was successful or not, also true if publishing failed but the data was stored in the outbox to be sent later
+    bool Send_Encoded(char const * topic, JsonDocument const & source) {
+        uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+        // Encoded payloads can not be counted, the data points are therefore taken from the json they are encoded from instead
+        size_t const data_points = Count_Data_Points(topic, source);
+        bool result = false;
+        // Check if the remaining stack size of the current task would overflow the stack,
+        // if it would allocate the memory on the heap instead to ensure no stack overflow occurs
+        if (current_send_buffer_size > getMaximumStackSize()) {
+            uint8_t* payload = new uint8_t[current_send_buffer_size]();
+            size_t const length = m_payload_codec->Encode(topic, source, payload, current_send_buffer_size);
+            if (length == 0U) {
+                Logger::printfln(UNABLE_TO_ENCODE_PAYLOAD, topic, current_send_buffer_size);
+            }
+            else {
+                result = Publish(topic, payload, length, data_points) || Store_In_Outbox(topic, payload, length);
+            }
+            // Ensure to actually delete the memory placed onto the heap, to make sure we do not create a memory leak
+            // and set the pointer to null so we do not have a dangling reference.
+            delete[] payload;
+            payload = nullptr;
+        }
+        else {
+            uint8_t payload[current_send_buffer_size] = {};
+            size_t const length = m_payload_codec->Encode(topic, source, payload, current_send_buffer_size);
+            if (length == 0U) {
+                Logger::printfln(UNABLE_TO_ENCODE_PAYLOAD, topic, current_send_buffer_size);
+                return result;
+            }
+            result = Publish(topic, payload, length, data_points) || Store_In_Outbox(topic, payload, length);
+        }
+        return result;
+    }
+
+    /// @brief Publishes the given message directly or copies it into the outbound queue, if one has been set, to be published from loop() instead
+    /// @param topic Topic the message should be published on
+    /// @param payload Payload of the message
+    /// @param length Length of the payload in bytes
+    /// @param data_points Amount of telemetry or attribute data points contained in the payload, taken from the rate limiter once the queued message is published
+    /// @return Whether the message was published or queued successfully or not
+    bool Publish(char const * topic, uint8_t const * payload, size_t const & length, size_t const & data_points) {
+        if (m_outbound_queue != nullptr) {
+            return m_outbound_queue->Push(topic, payload, length, data_points);
+        }
+        return m_client.publish(topic, payload, length);
+    }
+
+    /// @brief Counts the telemetry or attribute data points contained in the given json payload, only if a rate limiter has been set, because it is the only one requiring the amount.
+    /// Counts every node of the json, which is exact for a single object of key-value pairs and an upper bound for timestamped or nested values
+    /// @param topic Topic the message should be published on, messages over topics other than telemetry and attributes never contain any data points
+    /// @param payload Json payload of the message
+    /// @param length Length of the payload in bytes
+    /// @return Amount of data points contained in the payload
+    size_t Count_Data_Points(char const * topic, uint8_t const * payload, size_t const & length) const {
+        if (m_rate_limiter == nullptr || !Contains_Data_Points(topic)) {
+            return 0U;
+        }
+        return Helper::getJsonNodeCount(payload, length);
+    }
+
+    /// @brief Counts the telemetry or attribute data points contained in the given json, only if a rate limiter has been set, because it is the only one requiring the amount.
+    /// Counts the members of the root object or array, which is exact for a single object of key-value pairs
+    /// @param topic Topic the message should be published on, messages over topics other than telemetry and attributes never contain any data points
+    /// @param source JsonDocument containing the data points
+    /// @return Amount of data points contained in the json
+    size_t Count_Data_Points(char const * topic, JsonDocument const & source) const {
+        if (m_rate_limiter == nullptr || !Contains_Data_Points(topic)) {
+            return 0U;
+        }
+        return source.size();
+    }
+
+    /// @brief Whether messages over the given topic contain data points, that are counted towards the data point rate limit of the server
+    /// @param topic Topic the message should be published on
+    /// @return Whether the topic is a telemetry or attribute topic
+    static bool Contains_Data_Points(char const * topic) {
+        Outbound_Priority const priority = Outbound_Queue<Logger>::Get_Priority(topic);
+        return priority == Outbound_Priority::TELEMETRY || priority == Outbound_Priority::ATTRIBUTES;
+    }
+
+    /// @brief Persists the given message that could not be published into the outbox, if one has been set.
+    /// Only telemetry and attributes are stored, because every other message is a request or response that is no longer relevant once the connection has been reestablished
+    /// @param topic Topic the message should have been published on
+    /// @param payload Payload of the message
+    /// @param length Length of the payload in bytes
+    /// @return Whether the message was stored successfully and will be published later or not
+    bool Store_In_Outbox(char const * topic, uint8_t const * payload, size_t const & length) {
+        if (m_outbox == nullptr) {
+            return false;
+        }
+        if (strncmp(topic, TELEMETRY_TOPIC, sizeof(TELEMETRY_TOPIC)) != 0 && strncmp(topic, ATTRIBUTE_TOPIC, sizeof(ATTRIBUTE_TOPIC)) != 0) {
+            return false;
+        }
+        return m_outbox->Store(topic, payload, length);
     }
 
     /// @brief Copies a non-owning pointer to the given API implementation, into the local data container.
     /// Ensure the actual variable is kept alive for as long as the instance of this class
     /// @param api Additional API that we want to be handled
-    void Subscribe_API_Implementation(IAPI_Implementation & api) {
+    void Subscribe_API_Implementation(IAPI_Implementation & api) override {
 #if !THINGSBOARD_ENABLE_DYNAMIC
         if (m_api_implementations.size() + 1 > m_api_implementations.capacity()) {
             Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, MAX_ENDPOINTS_AMOUNT_TEMPLATE_NAME, MaxEndpointsAmount);
             return;
         }
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
-#if THINGSBOARD_ENABLE_STL
-        api.Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoardSized::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::clientSubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::clientUnsubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::getClientReceiveBufferSize, this), std::bind(&ThingsBoardSized::getClientSendBufferSize, this), std::bind(&ThingsBoardSized::setBufferSize, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::getRequestID, this));
-#else
-        api.Set_Client_Callbacks(ThingsBoardSized::staticSubscribeImplementation, ThingsBoardSized::staticSendJson, ThingsBoardSized::staticSendJsonString, ThingsBoardSized::staticClientSubscribe, ThingsBoardSized::staticClientUnsubscribe, ThingsBoardSized::staticGetClientReceiveBufferSize, ThingsBoardSized::staticGetClientSendBufferSize, ThingsBoardSized::staticSetBufferSize, ThingsBoardSized::staticGetRequestID);
-#endif // THINGSBOARD_ENABLE_STL
+        api.Set_Client(*this);
         api.Initialize();
         m_api_implementations.push_back(&api);
+        m_topic_router.Add_Route(api);
     }
 
     /// @brief Copies the non-owning pointers to the given API implementations, into the local data container.
@@ -385,12 +671,9 @@ class ThingsBoardSized {
             if (api == nullptr) {
                 continue;
             }
-#if THINGSBOARD_ENABLE_STL
-            api->Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoardSized::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::clientSubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::clientUnsubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::getClientReceiveBufferSize, this), std::bind(&ThingsBoardSized::getClientSendBufferSize, this), std::bind(&ThingsBoardSized::setBufferSize, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::getRequestID, this));
-#else
-            api->Set_Client_Callbacks(ThingsBoardSized::staticSubscribeImplementation, ThingsBoardSized::staticSendJson, ThingsBoardSized::staticSendJsonString, ThingsBoardSized::staticClientSubscribe, ThingsBoardSized::staticClientUnsubscribe, ThingsBoardSized::staticGetClientReceiveBufferSize, ThingsBoardSized::staticGetClientSendBufferSize, ThingsBoardSized::staticSetBufferSize, ThingsBoardSized::staticGetRequestID);
-#endif // THINGSBOARD_ENABLE_STL
+            api->Set_Client(*this);
             api->Initialize();
+            m_topic_router.Add_Route(*api);
         }
         m_api_implementations.insert(m_api_implementations.end(), first, last);
     }
@@ -453,6 +736,119 @@ class ThingsBoardSized {
 #endif // THINGSBOARD_ENABLE_DYNAMIC
     }
 
+    /// @brief Sets the batch that timestamped telemetry rows appended with sendTelemetryBatched() are accumulated in.
+    /// The batch is flushed automatically once it is full, once the max rows are reached, or from loop() once the first row exceeds the max age.
+    /// Ensure the actual variable is kept alive for as long as the instance of this class
+    /// @param batch Batch the rows should be accumulated in
+    void Set_Telemetry_Batch(Telemetry_Batch & batch) {
+        m_telemetry_batch = &batch;
+    }
+
+    /// @brief Sets the filter that decides whether a telemetry key changed enough since it was last reported, to be sent again with sendTelemetryData() or sendTelemetry().
+    /// Keys that did not change enough are dropped before any json is built, if no key is left, nothing is published at all and the call still counts as successful.
+    /// The last reported value of every key is only updated once the message was published or stored in the outbox, so values that failed to send are reported again on the next call.
+    /// Attributes and telemetry appended with sendTelemetryBatched() are never filtered, because attributes only change rarely anyway and the batch keeps the timestamp of every row.
+    /// The max silence of the filter is measured with the clock of the timer queue, which can be replaced to run the library natively on a host with getTimerQueue().Set_Time_Callback().
+    /// Ensure the actual variable is kept alive for as long as the instance of this class
+    /// @param filter Filter the telemetry keys should be checked with
+    void Set_Telemetry_Filter(Deadband_Filter & filter) {
+        m_telemetry_filter = &filter;
+    }
+
+    /// @brief Appends batched telemetry data with the given timestamp as a new row to the previously set batch, expects iterators to a container containing Telemetry class instances.
+    /// Instead of sending every row on its own, the batch is sent as a single payload in the timestamped telemetry array format once one of its thresholds is reached,
+    /// which allows to send telemetry sampled at a high rate with a fraction of the publishes, without losing the time every single sample was taken at.
+    /// See https://thingsboard.io/docs/reference/mqtt-api/#telemetry-upload-api for more information
+    /// @tparam InputIterator Class that points to the begin and end iterator
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param timestamp Unix timestamp in milliseconds the values were sampled at
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether appending the row and sending the batch if a threshold was reached was successful or not
+#if THINGSBOARD_ENABLE_DYNAMIC
+    template<typename InputIterator>
+#else
+    /// @tparam MaxKeyValuePairAmount Maximum amount of json key value pairs, which will ever be sent with this method to the cloud.
+    /// Should simply be the biggest distance between first and last iterator this method is ever called with
+    template<size_t MaxKeyValuePairAmount, typename InputIterator>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    bool sendTelemetryBatched(uint64_t const & timestamp, InputIterator const & first, InputIterator const & last) {
+        if (m_telemetry_batch == nullptr) {
+            Logger::printfln(TELEMETRY_BATCH_NOT_SET);
+            return false;
+        }
+        size_t const size = Helper::distance(first, last);
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        if (size > MaxKeyValuePairAmount) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, size, "MaxKeyValuePairAmount", MaxKeyValuePairAmount);
+            return false;
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+#if THINGSBOARD_ENABLE_DYNAMIC
+        TBJsonDocument json_buffer(JSON_OBJECT_SIZE(size));
+#else
+        StaticJsonDocument<JSON_OBJECT_SIZE(MaxKeyValuePairAmount)> json_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        for (auto it = first; it != last; ++it) {
+            auto const & data = *it;
+            if (!data.SerializeKeyValue(json_buffer)) {
+                Logger::printfln(UNABLE_TO_SERIALIZE);
+                return false;
+            }
+        }
+
+        // Row does not fit into the remaining buffer, therefore we send the current batch first and append the row to the then empty batch
+        uint64_t const now = m_timer_queue.now();
+        if (!m_telemetry_batch->Append(timestamp, json_buffer, now)) {
+            if (!flushTelemetryBatch() || !m_telemetry_batch->Append(timestamp, json_buffer, now)) {
+                Logger::printfln(TELEMETRY_BATCH_TOO_SMALL);
+                return false;
+            }
+        }
+        return !m_telemetry_batch->Should_Flush(now) || flushTelemetryBatch();
+    }
+
+    /// @brief Sends all rows accumulated in the previously set batch as a single timestamped telemetry array, independent of whether any threshold has been reached.
+    /// The rows are only removed from the batch if sending them was successful
+    /// @return Whether sending the batch was successful or not, true if the batch was empty
+    bool flushTelemetryBatch() {
+        if (m_telemetry_batch == nullptr || m_telemetry_batch->Is_Empty()) {
+            return true;
+        }
+        if (!Send_Json_String(TELEMETRY_TOPIC, m_telemetry_batch->Get_Payload())) {
+            return false;
+        }
+        m_telemetry_batch->clear();
+        return true;
+    }
+
+    /// @brief Sets the aggregator that raw samples are reduced in, before their statistics are sent as telemetry at the end of every window.
+    /// Samples are added directly to the aggregator with Telemetry_Aggregator::Add_Sample(), the statistics are then sent automatically from loop() once the window has ended.
+    /// Ensure the actual variable is kept alive for as long as the instance of this class
+    /// @param aggregator Aggregator the samples are reduced in
+    void Set_Telemetry_Aggregator(Telemetry_Aggregator & aggregator) {
+        m_telemetry_aggregator = &aggregator;
+    }
+
+    /// @brief Sends the statistics of the current window of the previously set aggregator as telemetry, independent of whether the window has ended, and starts a new window.
+    /// The statistics are sent the same way as sendTelemetry() would, meaning they are written directly into the send buffer if possible and checked with the telemetry filter if one was set.
+    /// The window is cleared even if sending failed, because merging it into the next window would report statistics over a longer time than configured, set an outbox to keep failed messages instead
+    /// @return Whether sending the statistics was successful or not, true if the window was empty
+    bool flushTelemetryAggregator() {
+        if (m_telemetry_aggregator == nullptr || m_telemetry_aggregator->Is_Empty()) {
+            return true;
+        }
+        m_telemetry_aggregator->Close_Window();
+#if THINGSBOARD_ENABLE_DYNAMIC
+        bool const result = sendDataArray(m_telemetry_aggregator->begin(), m_telemetry_aggregator->end(), true);
+#else
+        bool const result = sendDataArray<THINGSBOARD_AGGREGATOR_MAX_VALUES>(m_telemetry_aggregator->begin(), m_telemetry_aggregator->end(), true);
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        m_telemetry_aggregator->clear();
+        return result;
+    }
+
     /// @brief Attempts to send custom json telemetry string.
     /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
     /// @param json String containing our json key value pairs we want to attempt to send
@@ -526,7 +922,7 @@ class ThingsBoardSized {
         return Send_Json(ATTRIBUTE_TOPIC, source, json_size);
     }
 
-  private:
+  protected:
 #if THINGSBOARD_ENABLE_STREAM_UTILS
     /// @brief Serialize the custom attribute source into the underlying client.
     /// Sends the given bytes to the client without requiring any temporary buffer at the cost of hugely increased send times
@@ -559,35 +955,36 @@ class ThingsBoardSized {
 
     /// @brief Returns the current receive buffer size of the underlying client interface
     /// @return Current internal send buffer size
-    uint16_t getClientReceiveBufferSize() {
+    uint16_t getClientReceiveBufferSize() override {
         return m_client.get_receive_buffer_size();
     }
 
     /// @brief Returns the current send buffer size of the underlying client interface
     /// @return Current internal receive buffer size
-    uint16_t getClientSendBufferSize() {
+    uint16_t getClientSendBufferSize() override {
         return m_client.get_send_buffer_size();
     }
 
-    /// @brief Subscribes the given topic with the underlying client interface
+    /// @brief Subscribes the given topic with the underlying client interface, if no other api implementation requires it to be subscribed already.
+    /// If we are not connected, the topic is subscribed together with every other topic once the connection has been established instead
     /// @param topic Topic that should be subscribed
     /// @return Whether subscribing was successfull or not
-    bool clientSubscribe(char const * topic) {
-        return m_client.subscribe(topic);
+    bool clientSubscribe(char const * topic) override {
+        return m_subscriptions.Subscribe(topic);
     }
 
-    /// @brief Unsubscribes the given topic with the underlying client interface
+    /// @brief Unsubscribes the given topic with the underlying client interface, once no api implementation requires it to be subscribed anymore and the linger time set with Set_Subscription_Linger_Time() has passed
     /// @param topic Topic that should be unsubscribed
     /// @return Whether unsubscribing was successfull or not
-    bool clientUnsubscribe(char const * topic) {
-        return m_client.unsubscribe(topic);
+    bool clientUnsubscribe(char const * topic) override {
+        return m_subscriptions.Unsubscribe(topic, m_timer_queue.now());
     }
 
     /// @brief Gets a mutable pointer to the request id, the current value is the id of the last sent request.
     /// Is used because each request to the cloud of the same type (attribute request, rpc request, over the air firmware update), has to use a different id to differentiate request and response.
-    /// To ensure that we therefore simply provide a global request id that can be used and incremented by all request types
+    /// To ensure that we therefore simply provide a global request id that can be used and incremented by all request types, attribute and client-side RPC requests use it as the generation of their request table
     /// @return Mutable reference to the request id
-    size_t * getRequestID() {
+    size_t * getRequestID() override {
         return &m_request_id;
     }
 
@@ -619,141 +1016,99 @@ class ThingsBoardSized {
     /// Only the topics that establish a permanent connection are resubscribed, because all not yet received data is discard on the MQTT broker,
     // once we establish a connection again. This is the case because we connect with the cleanSession attribute set to true.
     // Therefore we can also clear the buffer of all non-permanent topics.
+    // If a persistent session has been resumed instead, the broker still holds every topic and the pending requests can still receive their response, therefore nothing is resubscribed or cleared.
     void Resubscribe_Topics() {
+        Resume_Session(Begin_Session());
+    }
+
+    /// @brief Checks whether the broker still held the session, once a connection has been established, if it did not every remembered topic is forgotten, because the broker does not hold them anymore
+    /// @return Whether a persistent session has been resumed or not
+    bool Begin_Session() {
+        bool const session_present = m_persistent_session && m_client.get_session_present();
+        m_subscriptions.Begin_Connection(session_present);
+        return session_present;
+    }
+
+    /// @brief Resubscribes the topics of the api implementations, unless a persistent session has been resumed, and starts draining the outbox.
+    /// Every topic is subscribed in a single request once all api implementations have been resubscribed
+    /// @param session_present Whether a persistent session has been resumed, as returned by Begin_Session()
+    void Resume_Session(bool const & session_present) {
         // Results are ignored, because the important part of clearing internal data structures always succeeds
         for (auto & api : m_api_implementations) {
-            if (api == nullptr) {
+            if (api == nullptr || session_present) {
                 continue;
             }
             (void)api->Resubscribe_Topic();
         }
-    }
-
-    /// @brief Attempts to send a single key-value pair with the given key and value of the given type
-    /// @tparam T Type of the passed value
-    /// @param key Key of the key value pair we want to send
-    /// @param value Value of the key value pair we want to send
-    /// @param telemetry Whether the data we want to send should be sent as an attribute or telemetry data value
-    /// @return Whether sending the data was successful or not
-    template<typename T>
-    bool sendKeyValue(char const * key, T const & value, bool telemetry = true) {
-        const Telemetry t(key, value);
-        if (t.IsEmpty()) {
-            return false;
-        }
-
-        StaticJsonDocument<JSON_OBJECT_SIZE(1)> json_buffer;
-        if (!t.SerializeKeyValue(json_buffer)) {
-            Logger::printfln(UNABLE_TO_SERIALIZE);
-            return false;
-        }
-        return telemetry ? sendTelemetryJson(json_buffer, Helper::Measure_Json(json_buffer)) : sendAttributeJson(json_buffer, Helper::Measure_Json(json_buffer));
-    }
-
-    /// @brief Attempts to send aggregated attribute or telemetry data
-    /// @tparam InputIterator Class that points to the begin and end iterator
-    /// of the given data container, allows for using / passing either std::vector or std::array.
-    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
-    /// @param first Iterator pointing to the first element in the data container
-    /// @param last Iterator pointing to the end of the data container (last element + 1)
-    /// @param telemetry Whether the data we want to send should be sent over the attribute or telemtry topic
-    /// @return Whether sending the aggregated data was successful or not
-#if THINGSBOARD_ENABLE_DYNAMIC
-    template<typename InputIterator>
-#else
-    /// @tparam MaxKeyValuePairAmount Maximum amount of json key value pairs, which will ever be sent with this method to the cloud.
-    /// Should simply be the biggest distance between first and last iterator this method is ever called with
-    template<size_t MaxKeyValuePairAmount, typename InputIterator>
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-    bool sendDataArray(InputIterator const & first, InputIterator const & last, bool telemetry) {
-        size_t const size = Helper::distance(first, last);
-#if THINGSBOARD_ENABLE_DYNAMIC
-        // char const * are stored as only a pointer inside the JsonDocument --> zero copy, meaning the size for the strings is 0 bytes.
-        // Data structure size, therefore only depends on the amount of key value pairs passed.
-        // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
-        TBJsonDocument json_buffer(JSON_OBJECT_SIZE(size));
-#else
-        if (size > MaxKeyValuePairAmount) {
-            Logger::printfln(TOO_MANY_JSON_FIELDS, size, "MaxKeyValuePairAmount", MaxKeyValuePairAmount);
-            return false;
-        }
-        StaticJsonDocument<JSON_OBJECT_SIZE(MaxKeyValuePairAmount)> json_buffer;
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-
-#if THINGSBOARD_ENABLE_STL
-        if (std::any_of(first, last, [&json_buffer](Telemetry const & data) { return !data.SerializeKeyValue(json_buffer); })) {
-            Logger::printfln(UNABLE_TO_SERIALIZE);
-            return false;
-        }
-#else
-        for (auto it = first; it != last; ++it) {
-            auto const & data = *it;
-            if (!data.SerializeKeyValue(json_buffer)) {
-                Logger::printfln(UNABLE_TO_SERIALIZE);
-                return false;
-            }
+        (void)m_subscriptions.Resubscribe();
+        if (m_outbox != nullptr) {
+            m_outbox->Start_Draining();
         }
-#endif // THINGSBOARD_ENABLE_STL
-        return telemetry ? sendTelemetryJson(json_buffer, Helper::Measure_Json(json_buffer)) : sendAttributeJson(json_buffer, Helper::Measure_Json(json_buffer));
     }
 
-    /// @brief MQTT callback that will be called if a publish message is received from the server
-    /// Payload contains data from the internal buffer of the MQTT client,
-    /// therefore the buffer and the specific memory region the payload points too and the following length bytes need to live on for as long as this method has not finished.
-    /// This could be a problem if the system uses FreeRTOS or another tasking system and the processing of the data is interrupted.
-    /// Because if this happens and we then send data it is possible for the system to overwrite the memory region that contained the previous response.
-    /// Therefore we simply assume that either the used MQTT client, has seperate input and output buffers
-    /// or that the receiving of data is not executed on a seperate FreeRTOS tasks to other sends
+    /// @brief Passes the received message to all subscribed api implementations as well as the given additional routes, that handle responses on the received topic.
+    /// Deserializes the payload only once and only if atleast one of them processes it as json, to allow front-ends that know their api implementations at compile time (ThingsBoardStatic),
+    /// to dispatch to them directly instead of over the subscribed pointers, while still sharing the same deserialization and still handling api implementations that were subscribed at runtime.
+    /// If the only api implementation handling the topic streams its responses (API_Process_Type::STREAM), the payload is instead passed to it directly and never deserialized into a JsonDocument
+    /// @tparam Routes Class that has to implement Match(topic), which returns whether any of its routes handles the topic, Count_Process_Type(type), which returns the amount of matched routes with the given process type,
+    /// Process_Response(type, topic, payload, length), which passes the raw payload to its matched routes with the given process type,
+    /// and Process_Json_Response(topic, data), which passes the deserialized payload to its matched routes that do not process the response as raw bytes
     /// @param topic Previously subscribed topic, we got the response over
     /// @param payload Payload that was sent over the cloud and received over the given topic
     /// @param length Total length of the received payload
-    void onMQTTMessage(char * topic, uint8_t * payload, unsigned int length) {
+    /// @param additional_routes Routes that should be processed additionally to the subscribed api implementations
+    template <typename Routes>
+    void Route_Message(char * topic, uint8_t * payload, unsigned int length, Routes & additional_routes) {
 #if THINGSBOARD_ENABLE_DEBUG
         Logger::printfln(RECEIVE_MESSAGE, length, topic);
 #endif // THINGSBOARD_ENABLE_DEBUG
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_CXX20
-        auto filtered_raw_api_implementations = m_api_implementations | std::views::filter([&topic](IAPI_Implementation const * api) {
-#else
+        // Topic router returns all api implementations that handle responses on the received topic in a single pass over the topic,
+        // instead of having to compare the received topic against the response topic of every single subscribed api implementation
 #if THINGSBOARD_ENABLE_DYNAMIC
-        Vector<IAPI_Implementation *> filtered_raw_api_implementations = {};
+        Vector<IAPI_Implementation *> matched_api_implementations = {};
 #else
-        Array<IAPI_Implementation *, MaxEndpointsAmount> filtered_raw_api_implementations = {};
+        Array<IAPI_Implementation *, MaxEndpointsAmount> matched_api_implementations = {};
 #endif // THINGSBOARD_ENABLE_DYNAMIC
-        std::copy_if(m_api_implementations.begin(), m_api_implementations.end(), std::back_inserter(filtered_raw_api_implementations), [&topic](IAPI_Implementation const * api) {
-#endif // THINGSBOARD_ENABLE_CXX20
-            return (api != nullptr && api->Get_Process_Type() == API_Process_Type::RAW && api->Compare_Response_Topic(topic));
-        });
-
-        for (auto & api : filtered_raw_api_implementations) {
-            api->Process_Response(topic, payload, length);
-        }
-
-        // If the filtered api implementations was not emtpy it means the response was processed as its raw bytes representation atleast once,
-        // and because we interpreted it as raw bytes instead of json, we skip the further processing of those raw bytes as json.
-        // We do that because the received response is in that case not even valid json in the first place and would therefore simply fail deserialization
-        if (!filtered_raw_api_implementations.empty()) {
+        m_topic_router.Match(topic, matched_api_implementations);
+        bool const matched_additional_routes = additional_routes.Match(topic);
+        if (matched_api_implementations.empty() && !matched_additional_routes) {
             return;
         }
-#else
-        bool processed_response_as_raw = false;
-        for (auto & api : m_api_implementations) {
-            if (api == nullptr || api->Get_Process_Type() != API_Process_Type::RAW || !api->Compare_Response_Topic(topic)) {
-                continue;
-            }
-            api->Process_Response(topic, payload, length);
-            processed_response_as_raw = true;
+
+        size_t raw_processors = matched_additional_routes ? additional_routes.Count_Process_Type(API_Process_Type::RAW) : 0U;
+        size_t stream_processors = matched_additional_routes ? additional_routes.Count_Process_Type(API_Process_Type::STREAM) : 0U;
+        size_t json_processors = matched_additional_routes ? additional_routes.Count_Process_Type(API_Process_Type::JSON) : 0U;
+        for (auto const & api : matched_api_implementations) {
+            API_Process_Type const type = api->Get_Process_Type();
+            raw_processors += type == API_Process_Type::RAW ? 1U : 0U;
+            stream_processors += type == API_Process_Type::STREAM ? 1U : 0U;
+            json_processors += type == API_Process_Type::JSON ? 1U : 0U;
         }
 
-        if (processed_response_as_raw) {
+        // If any api implementation processed the response as its raw bytes representation,
+        // we skip the further processing of those raw bytes as json.
+        // We do that because the received response is in that case not even valid json in the first place and would therefore simply fail deserialization.
+        // A single streaming api implementation is passed the raw bytes as well, because it parses them in place, which is only possible if no one else reads the payload afterwards.
+        // Payloads that are decoded with the payload codec are never streamed, because they are not json and can therefore not be parsed by the streaming api implementations
+        bool const decode_payload = m_payload_codec != nullptr && m_payload_codec->Is_Decoded_Topic(topic);
+        API_Process_Type const raw_process_type = raw_processors != 0U ? API_Process_Type::RAW : API_Process_Type::STREAM;
+        if (raw_processors != 0U || (!decode_payload && stream_processors == 1U && json_processors == 0U)) {
+            if (matched_additional_routes) {
+                additional_routes.Process_Response(raw_process_type, topic, payload, length);
+            }
+            for (auto & api : matched_api_implementations) {
+                if (api->Get_Process_Type() != raw_process_type) {
+                    continue;
+                }
+                api->Process_Response(topic, payload, length);
+            }
             return;
         }
-#endif // THINGSBOARD_ENABLE_STL
 
-        // Calculate size with the total amount of commas, always denotes the end of a key-value pair besides for the last element in an array or in an object where the comma is not permitted,
-        // therfore we have to add the space for another key-value pair for all the occurences of thoose symbols as well
-        size_t const size = Helper::getOccurences(payload, ',', length) + Helper::getOccurences(payload, '{', length) + Helper::getOccurences(payload, '[', length);
+        // Calculate size with the total amount of nodes in a single pass, commas always denote the end of a key-value pair besides for the last element in an array or in an object where the comma is not permitted,
+        // therfore every non empty object or array requires space for another key-value pair as well. Commas or brackets inside of strings are ignored, because they do not require any additional space
+        size_t const size = decode_payload ? m_payload_codec->Get_Decoded_Node_Count(topic, payload, length) : Helper::getJsonNodeCount(payload, length);
 #if THINGSBOARD_ENABLE_DYNAMIC
         // Buffer that we deserialize is writeable and not read only and therefore stored as a pointer inside the JsonDocument --> zero copy, meaning the size for the received payload is 0 bytes.
         // Data structure size, therefore only depends on the amount of key value pairs received.
@@ -782,118 +1137,212 @@ class ThingsBoardSized {
         Logger::printfln(ALLOCATING_JSON, document_size);
 #endif // THINGSBOARD_ENABLE_DEBUG
 
-        // The deserializeJson method we use, can use the zero copy mode because a writeable input was passed,
-        // if that were not the case the needed allocated memory would drastically increase, because the keys would need to be copied as well.
-        // See https://arduinojson.org/v6/doc/deserialization/ for more info on ArduinoJson deserialization
-        DeserializationError const error = deserializeJson(json_buffer, payload, length);
-        if (error) {
-            Logger::printfln(UNABLE_TO_DE_SERIALIZE_JSON, error.c_str());
-            return;
+        if (decode_payload) {
+            if (!m_payload_codec->Decode(topic, payload, length, json_buffer)) {
+                Logger::printfln(UNABLE_TO_DECODE_PAYLOAD, topic);
+                return;
+            }
+        }
+        else {
+            // The deserializeJson method we use, can use the zero copy mode because a writeable input was passed,
+            // if that were not the case the needed allocated memory would drastically increase, because the keys would need to be copied as well.
+            // See https://arduinojson.org/v6/doc/deserialization/ for more info on ArduinoJson deserialization
+            DeserializationError const error = deserializeJson(json_buffer, payload, length);
+            if (error) {
+                Logger::printfln(UNABLE_TO_DE_SERIALIZE_JSON, error.c_str());
+                return;
+            }
         }
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_CXX20
-        auto filtered_json_api_implementations = m_api_implementations | std::views::filter([&topic](IAPI_Implementation const * api) {
-#else
-#if THINGSBOARD_ENABLE_DYNAMIC
-        Vector<IAPI_Implementation *> filtered_json_api_implementations = {};
-#else
-        Array<IAPI_Implementation *, MaxEndpointsAmount> filtered_json_api_implementations = {};
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-        std::copy_if(m_api_implementations.begin(), m_api_implementations.end(), std::back_inserter(filtered_json_api_implementations), [&topic](IAPI_Implementation const * api) {
-#endif // THINGSBOARD_ENABLE_CXX20
-            return (api != nullptr && api->Get_Process_Type() == API_Process_Type::JSON && api->Compare_Response_Topic(topic));
-        });
-
-        for (auto & api : filtered_json_api_implementations) {
-            api->Process_Json_Response(topic, json_buffer);
+        if (matched_additional_routes) {
+            additional_routes.Process_Json_Response(topic, json_buffer);
         }
-#else
-        for (auto & api : m_api_implementations) {
-            if (api == nullptr || api->Get_Process_Type() != API_Process_Type::JSON || !api->Compare_Response_Topic(topic)) {
+        for (auto & api : matched_api_implementations) {
+            if (api->Get_Process_Type() == API_Process_Type::RAW) {
                 continue;
             }
             api->Process_Json_Response(topic, json_buffer);
         }
-#endif // THINGSBOARD_ENABLE_STL
     }
 
-#if !THINGSBOARD_ENABLE_STL
-    static void onStaticMQTTMessage(char * topic, uint8_t * payload, unsigned int length) {
-        if (m_subscribedInstance == nullptr) {
-            return;
+  private:
+    /// @brief Attempts to send a single key-value pair with the given key and value of the given type
+    /// @tparam T Type of the passed value
+    /// @param key Key of the key value pair we want to send
+    /// @param value Value of the key value pair we want to send
+    /// @param telemetry Whether the data we want to send should be sent as an attribute or telemetry data value
+    /// @return Whether sending the data was successful or not
+    template<typename T>
+    bool sendKeyValue(char const * key, T const & value, bool telemetry = true) {
+        const Telemetry t(key, value);
+        if (t.IsEmpty()) {
+            return false;
         }
-        m_subscribedInstance->onMQTTMessage(topic, payload, length);
-    }
-
-    static void staticMQTTConnect() {
-        if (m_subscribedInstance == nullptr) {
-            return;
+        Deadband_Filter * const filter = telemetry ? m_telemetry_filter : nullptr;
+        uint64_t const now = filter != nullptr ? m_timer_queue.now() : 0U;
+        if (filter != nullptr && !filter->Should_Report(t, now)) {
+            return true;
         }
-        m_subscribedInstance->Resubscribe_Topics();
-    }
 
-    static void staticSubscribeImplementation(IAPI_Implementation & api) {
-        if (m_subscribedInstance == nullptr) {
-            return;
+        bool result = false;
+        if (!Send_Data_Direct(telemetry ? TELEMETRY_TOPIC : ATTRIBUTE_TOPIC, &t, &t + 1, Report_Filter(filter, now), result)) {
+            StaticJsonDocument<JSON_OBJECT_SIZE(1)> json_buffer;
+            if (!t.SerializeKeyValue(json_buffer)) {
+                Logger::printfln(UNABLE_TO_SERIALIZE);
+                return false;
+            }
+            result = telemetry ? sendTelemetryJson(json_buffer, Helper::Measure_Json(json_buffer)) : sendAttributeJson(json_buffer, Helper::Measure_Json(json_buffer));
         }
-        m_subscribedInstance->Subscribe_API_Implementation(api);
-    }
-
-    static bool staticSendJson(char const * topic, JsonDocument const & source, size_t const & json_size) {
-        if (m_subscribedInstance == nullptr) {
-            return false;
+        if (result && filter != nullptr) {
+            filter->Reported(t, now);
         }
-        return m_subscribedInstance->Send_Json(topic, source, json_size);
+        return result;
     }
 
-    static bool staticSendJsonString(char const * topic, char const * json) {
-        if (m_subscribedInstance == nullptr) {
+    /// @brief Attempts to send aggregated attribute or telemetry data
+    /// @tparam InputIterator Class that points to the begin and end iterator
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @param telemetry Whether the data we want to send should be sent over the attribute or telemtry topic
+    /// @return Whether sending the aggregated data was successful or not
+#if THINGSBOARD_ENABLE_DYNAMIC
+    template<typename InputIterator>
+#else
+    /// @tparam MaxKeyValuePairAmount Maximum amount of json key value pairs, which will ever be sent with this method to the cloud.
+    /// Should simply be the biggest distance between first and last iterator this method is ever called with
+    template<size_t MaxKeyValuePairAmount, typename InputIterator>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    bool sendDataArray(InputIterator const & first, InputIterator const & last, bool telemetry) {
+        size_t const size = Helper::distance(first, last);
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        if (size > MaxKeyValuePairAmount) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, size, "MaxKeyValuePairAmount", MaxKeyValuePairAmount);
             return false;
         }
-        return m_subscribedInstance->Send_Json_String(topic, json);
-    }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        Deadband_Filter * const filter = telemetry ? m_telemetry_filter : nullptr;
+        // Every record is checked against the same time, so that the records written into the message are the same ones that are marked as reported afterwards
+        Report_Filter const include(filter, filter != nullptr ? m_timer_queue.now() : 0U);
+        if (filter != nullptr) {
+            auto it = first;
+            for (; it != last && !include(*it); ++it) {}
+            // Every key is unchanged, therefore there is nothing left to send
+            if (it == last) {
+                return true;
+            }
+        }
 
-    static bool staticClientSubscribe(char const * topic) {
-        if (m_subscribedInstance == nullptr) {
-            return false;
+        bool result = false;
+        if (!Send_Data_Direct(telemetry ? TELEMETRY_TOPIC : ATTRIBUTE_TOPIC, first, last, include, result)) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+            // char const * are stored as only a pointer inside the JsonDocument --> zero copy, meaning the size for the strings is 0 bytes.
+            // Data structure size, therefore only depends on the amount of key value pairs passed.
+            // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
+            TBJsonDocument json_buffer(JSON_OBJECT_SIZE(size));
+#else
+            StaticJsonDocument<JSON_OBJECT_SIZE(MaxKeyValuePairAmount)> json_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+#if THINGSBOARD_ENABLE_STL
+            if (std::any_of(first, last, [&json_buffer, &include](Telemetry const & data) { return include(data) && !data.SerializeKeyValue(json_buffer); })) {
+                Logger::printfln(UNABLE_TO_SERIALIZE);
+                return false;
+            }
+#else
+            for (auto it = first; it != last; ++it) {
+                auto const & data = *it;
+                if (include(data) && !data.SerializeKeyValue(json_buffer)) {
+                    Logger::printfln(UNABLE_TO_SERIALIZE);
+                    return false;
+                }
+            }
+#endif // THINGSBOARD_ENABLE_STL
+            result = telemetry ? sendTelemetryJson(json_buffer, Helper::Measure_Json(json_buffer)) : sendAttributeJson(json_buffer, Helper::Measure_Json(json_buffer));
+        }
+        if (result && filter != nullptr) {
+            for (auto it = first; it != last; ++it) {
+                auto const & data = *it;
+                if (include(data)) {
+                    filter->Reported(data, include.now);
+                }
+            }
         }
-        return m_subscribedInstance->clientSubscribe(topic);
+        return result;
     }
 
-    static bool staticClientUnsubscribe(char const * topic) {
-        if (m_subscribedInstance == nullptr) {
+    /// @brief Attempts to write the given key-value pairs directly as a json object with Telemetry::Write_Json_Object() and send them over the given topic to the server,
+    /// without copying them into a JsonDocument and serializing that document afterwards. The object is written into a temporary buffer the size of the send buffer,
+    /// that is placed onto the stack or the heap depending on the remaining stack size of the current task
+    /// @tparam InputIterator Class that points to the begin and end iterator
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param topic Topic we want to send the data over
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @param include Predicate that decides for every record whether it is sent or skipped
+    /// @param result Whether sending the data was successful or not, only valid if the data could be written directly
+    /// @return Whether the data could be written directly, if not because it did not fit into the send buffer or a record did not contain a key-value pair,
+    /// the data has to be sent with the JsonDocument instead, which also logs the reason why it could not be sent
+    template<typename InputIterator, typename Predicate>
+    bool Send_Data_Direct(char const * topic, InputIterator const & first, InputIterator const & last, Predicate const & include, bool & result) {
+        // Data that is encoded with the payload codec has to be copied into the JsonDocument the codec encodes from instead
+        if (m_payload_codec != nullptr && m_payload_codec->Is_Encoded_Topic(topic)) {
             return false;
         }
-        return m_subscribedInstance->clientUnsubscribe(topic);
-    }
+        size_t const buffer_size = m_client.get_send_buffer_size() + 1U;
 
-    static size_t * staticGetRequestID() {
-        if (m_subscribedInstance == nullptr) {
-            return nullptr;
+        // Check if the remaining stack size of the current task would overflow the stack,
+        // if it would allocate the memory on the heap instead to ensure no stack overflow occurs
+        if (buffer_size > getMaximumStackSize()) {
+            char* json = new char[buffer_size]();
+            bool const written = Telemetry::Write_Json_Object(first, last, json, buffer_size, include) != 0U;
+            if (written) {
+                result = Send_Json_String(topic, json);
+            }
+            // Ensure to actually delete the memory placed onto the heap, to make sure we do not create a memory leak
+            // and set the pointer to null so we do not have a dangling reference.
+            delete[] json;
+            json = nullptr;
+            return written;
+        }
+        char json[buffer_size] = {};
+        if (Telemetry::Write_Json_Object(first, last, json, buffer_size, include) == 0U) {
+            return false;
         }
-        return m_subscribedInstance->getRequestID();
+        result = Send_Json_String(topic, json);
+        return true;
     }
 
-    static uint16_t staticGetClientReceiveBufferSize() {
-        if (m_subscribedInstance == nullptr) {
-            return 0U;
-        }
-        return m_subscribedInstance->getClientReceiveBufferSize();
+    /// @brief MQTT callback that will be called if a publish message is received from the server
+    /// Payload contains data from the internal buffer of the MQTT client,
+    /// therefore the buffer and the specific memory region the payload points too and the following length bytes need to live on for as long as this method has not finished.
+    /// This could be a problem if the system uses FreeRTOS or another tasking system and the processing of the data is interrupted.
+    /// Because if this happens and we then send data it is possible for the system to overwrite the memory region that contained the previous response.
+    /// Therefore we simply assume that either the used MQTT client, has seperate input and output buffers
+    /// or that the receiving of data is not executed on a seperate FreeRTOS tasks to other sends
+    /// @param topic Previously subscribed topic, we got the response over
+    /// @param payload Payload that was sent over the cloud and received over the given topic
+    /// @param length Total length of the received payload
+    void onMQTTMessage(char * topic, uint8_t * payload, unsigned int length) {
+        Empty_Routes additional_routes;
+        Route_Message(topic, payload, length, additional_routes);
     }
 
-    static uint16_t staticGetClientSendBufferSize() {
+#if !THINGSBOARD_ENABLE_STL
+    static void onStaticMQTTMessage(char * topic, uint8_t * payload, unsigned int length) {
         if (m_subscribedInstance == nullptr) {
-            return 0U;
+            return;
         }
-        return m_subscribedInstance->getClientSendBufferSize();
+        m_subscribedInstance->onMQTTMessage(topic, payload, length);
     }
 
-    static bool staticSetBufferSize(uint16_t receive_buffer_size, uint16_t send_buffer_size) {
+    static void staticMQTTConnect() {
         if (m_subscribedInstance == nullptr) {
-            return false;
+            return;
         }
-        return m_subscribedInstance->setBufferSize(receive_buffer_size, send_buffer_size);
+        m_subscribedInstance->Resubscribe_Topics();
     }
 
     // PubSub client cannot call a instanced method when message arrives on subscribed topic.
@@ -904,15 +1353,27 @@ class ThingsBoardSized {
 
     IMQTT_Client&                                   m_client = {};              // MQTT client instance.
     size_t                                          m_max_stack = {};           // Maximum stack size we allocate at once.
-    size_t                                          m_request_id = {};          // Internal id used to differentiate which request should receive which response for certain API calls. Can send 4'294'967'296 requests before wrapping back to 0
+    size_t                                          m_request_id = {};          // Internal id used to differentiate which request should receive which response, used directly by firmware requests and as the generation of attribute and client-side RPC requests. Can send 4'294'967'296 requests before wrapping back to 0
+    Outbox<Logger>                                  *m_outbox = {};             // Optional outbox that telemetry and attributes that could not be published are persisted into
+    Outbound_Queue<Logger>                          *m_outbound_queue = {};     // Optional queue that sent messages are copied into and published from loop() in the order of their priority
+    Rate_Limiter                                    *m_rate_limiter = {};       // Optional rate limiter that ensures published messages do not exceed the rate limits of the server
+    Subscription_Manager<Logger>                    m_subscriptions;            // Counts the references of the topics subscribed by the api implementations
+    bool                                            m_persistent_session = {};  // Whether connections are established as a persistent session, that might still be held by the broker once connected again
+    Telemetry_Batch                                 *m_telemetry_batch = {};    // Optional batch that timestamped telemetry rows are accumulated in before they are sent together
+    IPayload_Codec                                  *m_payload_codec = {};      // Optional codec that the payload of certain topics is encoded and decoded with instead of json
+    Deadband_Filter                                 *m_telemetry_filter = {};   // Optional filter that drops telemetry keys, which did not change enough since they were last reported
+    Telemetry_Aggregator                            *m_telemetry_aggregator = {}; // Optional aggregator that raw samples are reduced in before their statistics are sent at the end of every window
+    Timer_Queue                                     m_timer_queue;              // Queue that handles the timeouts of every request sent by the api implementations
 #if THINGSBOARD_ENABLE_STREAM_UTILS
     size_t                                          m_buffering_size = {};      // Buffering size used to serialize directly into client.
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
 #if !THINGSBOARD_ENABLE_DYNAMIC
     Array<IAPI_Implementation*, MaxEndpointsAmount> m_api_implementations = {}; // Can hold a pointer to all possible API implementations (Server side RPC, Client side RPC, Shared attribute update, Client-side or shared attribute request, Provision)   
+    Topic_Router<MaxEndpointsAmount>                m_topic_router = {};        // Maps received topics to the api implementations that handle responses on them
 #else
     size_t                                          m_max_response_size = {};   // Maximum size allocated on the heap to hold the Json data structure for received cloud response payload, prevents possible malicious payload allocaitng a lot of memory
     Vector<IAPI_Implementation*>                    m_api_implementations = {}; // Can hold a pointer to all  possible API implementations (Server side RPC, Client side RPC, Shared attribute update, Client-side or shared attribute request, Provision)   
+    Topic_Router                                    m_topic_router = {};        // Maps received topics to the api implementations that handle responses on them
 #endif // !THINGSBOARD_ENABLE_DYNAMIC                
 };
 
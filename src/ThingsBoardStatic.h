@@ -0,0 +1,234 @@
+#ifndef ThingsBoard_Static_h
+#define ThingsBoard_Static_h
+
+// Local includes.
+#include "ThingsBoard.h"
+
+#if THINGSBOARD_ENABLE_STL
+
+// Library includes.
+#include <tuple>
+
+
+/// @brief Sequence of compile time indices, used to expand the api implementations contained in a tuple into a single expression that handles every one of them.
+/// Implemented manually instead of using std::index_sequence, because that only exists since C++14
+/// @tparam ...Indices Indices of the elements in the tuple
+template <size_t... Indices>
+struct Index_Sequence {};
+
+/// @brief Creates an Index_Sequence containing every index from 0 to N - 1
+/// @tparam N Amount of indices in the created sequence
+/// @tparam ...Indices Indices that have already been created by the previous recursion steps
+template <size_t N, size_t... Indices>
+struct Make_Index_Sequence : Make_Index_Sequence<N - 1U, N - 1U, Indices...> {};
+
+template <size_t... Indices>
+struct Make_Index_Sequence<0U, Indices...> {
+    using type = Index_Sequence<Indices...>;
+};
+
+
+/// @brief Front-end around ThingsBoardSized, that contains all api implementations known at compile time directly as members of a tuple instead of as pointers in an Array or Vector (THINGSBOARD_ENABLE_DYNAMIC).
+/// Routing received messages, updating the internal timers in loop() and resubscribing topics once the connection has been reestablished, is unrolled at compile time for every api implementation in the tuple,
+/// and each of them is called with its complete type, meaning the calls are bound statically and can be inlined, instead of being dispatched over the virtual methods of the IAPI_Implementation interface.
+/// Additionally api implementations that are not part of the template arguments are never instantiated, meaning they do not require any flash or ram.
+/// API implementations that are subscribed at runtime, like the internal Shared_Attribute_Update and Attribute_Request of the OTA_Firmware_Update, are still handled by the underlying ThingsBoardSized instance.
+/// Therefore its MaxEndpointsAmount only has to be big enough to hold those instead of every api implementation. Requires THINGSBOARD_ENABLE_STL, because the api implementations are contained in a std::tuple
+/// @tparam Client ThingsBoardSized instantiation that is used to send data and handles the api implementations subscribed at runtime, for example ThingsBoard or ThingsBoardSized<8, 2>
+/// @tparam ...Apis API implementations that should be contained, for example Server_Side_RPC<> and Shared_Attribute_Update<>, each of them has to be default constructible
+template <typename Client, typename... Apis>
+class ThingsBoardStatic : public Client {
+  public:
+    static_assert(sizeof...(Apis) <= 32U, "ThingsBoardStatic can contain at most 32 api implementations, because the matched api implementations are kept in a uint32_t bitmask");
+
+    /// @brief Constructs a ThingsBoardStatic instance with the given network client that should be used to establish the connection to ThingsBoard.
+    /// All contained api implementations are default constructed and can be accessed with Get_API() afterwards
+    /// @tparam ...Args Holds the multiple arguments that will simply be forwarded to the ThingsBoardSized constructor
+    /// @param client MQTT Client implementation that should be used to establish the connection to ThingsBoard
+    /// @param ...args Arguments that will be forwarded into the ThingsBoardSized constructor, for example the receive and send buffer size
+    template <typename... Args>
+    ThingsBoardStatic(IMQTT_Client & client, Args const &... args)
+      : Client(client, args...)
+      , m_api_implementations()
+    {
+        Initialize_APIs(Indices());
+        // Replaces the callbacks set by the ThingsBoardSized constructor, because this instance has to handle the contained api implementations as well
+        client.set_data_callback(std::bind(&ThingsBoardStatic::onMQTTMessage, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+        client.set_connect_callback(std::bind(&ThingsBoardStatic::Resubscribe_Topics, this));
+    }
+
+    /// @brief Gets the contained api implementation at the given index of the template arguments
+    /// @tparam Index Index of the api implementation in the template arguments
+    /// @return Reference to the contained api implementation
+    template <size_t Index>
+    typename std::tuple_element<Index, std::tuple<Apis...>>::type & Get_API() {
+        return std::get<Index>(m_api_implementations);
+    }
+
+    /// @brief Clears all currently subscribed callbacks of the contained as well as the api implementations subscribed at runtime,
+    /// see ThingsBoardSized::Cleanup_Subscriptions() for more information
+    void Cleanup_Subscriptions() {
+        Unsubscribe_APIs(Indices());
+        Client::Cleanup_Subscriptions();
+    }
+
+    /// @brief Receives / sends any outstanding messages from and to the MQTT broker.
+    /// Additionally when not being able to use the ESP Timer, it updates the internal timeout timers of the contained as well as the api implementations subscribed at runtime
+    /// @return Whether sending or receiving the oustanding the messages was successful or not
+    bool loop() {
+#if !THINGSBOARD_USE_ESP_TIMER
+        Loop_APIs(Indices());
+#endif // !THINGSBOARD_USE_ESP_TIMER
+        return Client::loop();
+    }
+
+  private:
+    using Indices = typename Make_Index_Sequence<sizeof...(Apis)>::type;
+
+    /// @brief Complete type of the api implementation at the given index, used to call the methods of the api implementation statically bound instead of over the virtual table
+    /// @tparam Index Index of the api implementation in the template arguments
+    template <size_t Index>
+    using API = typename std::tuple_element<Index, std::tuple<Apis...>>::type;
+
+    /// @brief Additional routes passed to ThingsBoardSized::Route_Message, that match the received topic against every contained api implementation
+    /// and remember which of them matched, so that only those are passed the response afterwards
+    class Static_Routes {
+      public:
+        /// @brief Constructor
+        /// @param instance Instance containing the api implementations that should be matched
+        Static_Routes(ThingsBoardStatic & instance)
+          : m_instance(instance)
+          , m_matched(0U)
+        {
+            // Nothing to do
+        }
+
+        bool Match(char const * topic) {
+            m_matched = m_instance.Match_APIs(topic, Indices());
+            return m_matched != 0U;
+        }
+
+        size_t Count_Process_Type(API_Process_Type const & type) {
+            return m_instance.Count_APIs_Process_Type(m_matched, type, Indices());
+        }
+
+        void Process_Response(API_Process_Type const & type, char const * topic, uint8_t * payload, unsigned int length) {
+            m_instance.Process_APIs_Response(m_matched, type, topic, payload, length, Indices());
+        }
+
+        void Process_Json_Response(char const * topic, JsonDocument const & data) {
+            m_instance.Process_APIs_Json_Response(m_matched, topic, data, Indices());
+        }
+
+      private:
+        ThingsBoardStatic &m_instance; // Instance containing the api implementations that are matched
+        uint32_t          m_matched;   // Bitmask of the contained api implementations that handle responses on the received topic
+    };
+
+    /// @brief MQTT callback that will be called if a publish message is received from the server, see ThingsBoardSized::Route_Message() for more information
+    /// @param topic Previously subscribed topic, we got the response over
+    /// @param payload Payload that was sent over the cloud and received over the given topic
+    /// @param length Total length of the received payload
+    void onMQTTMessage(char * topic, uint8_t * payload, unsigned int length) {
+        Static_Routes additional_routes(*this);
+        this->Route_Message(topic, payload, length, additional_routes);
+    }
+
+    /// @brief Resubscribes to the topics of the contained as well as the api implementations subscribed at runtime, see ThingsBoardSized::Resubscribe_Topics() for more information
+    void Resubscribe_Topics() {
+        bool const session_present = this->Begin_Session();
+        if (!session_present) {
+            Resubscribe_APIs(Indices());
+        }
+        this->Resume_Session(session_present);
+    }
+
+    template <size_t... Index>
+    void Initialize_APIs(Index_Sequence<Index...>) {
+        // Expands into one statement per api implementation, evaluated in order, because the elements of a braced initializer list are always evaluated from left to right.
+        // The leading 0 ensures the array is not empty if there are no api implementations
+        int const expansion[] = { 0, (Initialize_API<Index>(), 0)... };
+        (void)expansion;
+    }
+
+    template <size_t Index>
+    void Initialize_API() {
+        API<Index> & api = std::get<Index>(m_api_implementations);
+        api.API<Index>::Set_Client(*this);
+        api.API<Index>::Initialize();
+    }
+
+    template <size_t... Index>
+    uint32_t Match_APIs(char const * topic, Index_Sequence<Index...>) {
+        uint32_t matched = 0U;
+        int const expansion[] = { 0, (matched |= (std::get<Index>(m_api_implementations).API<Index>::Compare_Response_Topic(topic) ? (1U << Index) : 0U), 0)... };
+        (void)expansion;
+        return matched;
+    }
+
+    template <size_t... Index>
+    size_t Count_APIs_Process_Type(uint32_t const & matched, API_Process_Type const & type, Index_Sequence<Index...>) {
+        size_t count = 0U;
+        int const expansion[] = { 0, (count += ((matched & (1U << Index)) != 0U && std::get<Index>(m_api_implementations).API<Index>::Get_Process_Type() == type) ? 1U : 0U, 0)... };
+        (void)expansion;
+        return count;
+    }
+
+    template <size_t... Index>
+    void Process_APIs_Response(uint32_t const & matched, API_Process_Type const & type, char const * topic, uint8_t * payload, unsigned int length, Index_Sequence<Index...>) {
+        int const expansion[] = { 0, (Process_API_Response<Index>(matched, type, topic, payload, length), 0)... };
+        (void)expansion;
+    }
+
+    template <size_t Index>
+    void Process_API_Response(uint32_t const & matched, API_Process_Type const & type, char const * topic, uint8_t * payload, unsigned int length) {
+        API<Index> & api = std::get<Index>(m_api_implementations);
+        if ((matched & (1U << Index)) == 0U || api.API<Index>::Get_Process_Type() != type) {
+            return;
+        }
+        api.API<Index>::Process_Response(topic, payload, length);
+    }
+
+    template <size_t... Index>
+    void Process_APIs_Json_Response(uint32_t const & matched, char const * topic, JsonDocument const & data, Index_Sequence<Index...>) {
+        int const expansion[] = { 0, (Process_API_Json_Response<Index>(matched, topic, data), 0)... };
+        (void)expansion;
+    }
+
+    template <size_t Index>
+    void Process_API_Json_Response(uint32_t const & matched, char const * topic, JsonDocument const & data) {
+        API<Index> & api = std::get<Index>(m_api_implementations);
+        if ((matched & (1U << Index)) == 0U || api.API<Index>::Get_Process_Type() == API_Process_Type::RAW) {
+            return;
+        }
+        api.API<Index>::Process_Json_Response(topic, data);
+    }
+
+    template <size_t... Index>
+    void Resubscribe_APIs(Index_Sequence<Index...>) {
+        // Results are ignored, because the important part of clearing internal data structures always succeeds
+        int const expansion[] = { 0, ((void)std::get<Index>(m_api_implementations).API<Index>::Resubscribe_Topic(), 0)... };
+        (void)expansion;
+    }
+
+    template <size_t... Index>
+    void Unsubscribe_APIs(Index_Sequence<Index...>) {
+        // Results are ignored, because the important part of clearing internal data structures always succeeds
+        int const expansion[] = { 0, ((void)std::get<Index>(m_api_implementations).API<Index>::Unsubscribe(), 0)... };
+        (void)expansion;
+    }
+
+#if !THINGSBOARD_USE_ESP_TIMER
+    template <size_t... Index>
+    void Loop_APIs(Index_Sequence<Index...>) {
+        int const expansion[] = { 0, (std::get<Index>(m_api_implementations).API<Index>::loop(), 0)... };
+        (void)expansion;
+    }
+#endif // !THINGSBOARD_USE_ESP_TIMER
+
+    std::tuple<Apis...> m_api_implementations = {}; // Contains every api implementation known at compile time, which are called directly with their complete type
+};
+
+#endif // THINGSBOARD_ENABLE_STL
+
+#endif // ThingsBoard_Static_h
@@ -0,0 +1,254 @@
+#ifndef Timer_Queue_h
+#define Timer_Queue_h
+
+// Local includes.
+#include "Callback.h"
+
+
+// Forward declaration, because the entries have to be able to remove themselves from the queue they are scheduled in
+class Timer_Queue;
+
+
+/// @brief Interface of the owner of scheduled entries, that has to be informed once one of them expired, after the callback of the entry has been called.
+/// Allows the owner to clean up the state associated with the entry, for example to remove the request that timed out, even if the callback of the entry is a plain function pointer that can not capture the owner
+class ITimeout_Listener {
+  public:
+    /// @brief Called once the entry the listener has been set on expired, after its callback has been called
+    /// @param id Id the listener has been set with, allows to differentiate which of the entries of the owner expired
+    virtual void Timeout_Expired(size_t const & id) = 0;
+};
+
+
+/// @brief Entry that can be scheduled in a Timer_Queue, the callback is called once the scheduled deadline has passed and the entry has not been cancelled until then.
+/// The entry is intrusive, meaning the links to the previous and next entry in the queue are stored directly inside of the entry itself,
+/// which allows to schedule and cancel any amount of entries without the queue having to allocate any memory or being limited to a fixed capacity.
+/// Copying a scheduled entry schedules the copy with the same deadline directly after the original, which ensures the deadline is kept when requests are copied into or relocated inside of an Array or Vector.
+/// Destroying a scheduled entry automatically removes it from the queue
+class Timer_Queue_Entry : public Callback<void> {
+    friend class Timer_Queue;
+
+  public:
+    /// @brief Constructs empty entry, will result in never being called. Internals are simply default constructed as nullptr
+    Timer_Queue_Entry() = default;
+
+    /// @brief Constructor
+    /// @param callback Callback method that will be called as soon as the deadline the entry has been scheduled with has passed
+    explicit Timer_Queue_Entry(function callback)
+      : Callback(callback)
+      , m_listener(nullptr)
+      , m_listener_id(0U)
+      , m_queue(nullptr)
+      , m_previous(nullptr)
+      , m_next(nullptr)
+      , m_deadline(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Copy constructor, if the given entry is scheduled the copy is scheduled directly after it with the same deadline
+    /// @param other Entry that should be copied
+    Timer_Queue_Entry(Timer_Queue_Entry const & other);
+
+    /// @brief Copy assignment operator, removes this entry from the queue it is currently scheduled in
+    /// and if the given entry is scheduled, schedules this entry directly after it with the same deadline
+    /// @param other Entry that should be copied
+    /// @return Reference to this instance
+    Timer_Queue_Entry & operator=(Timer_Queue_Entry const & other);
+
+    /// @brief Destructor, removes this entry from the queue it is currently scheduled in
+    ~Timer_Queue_Entry();
+
+    /// @brief Whether the entry is currently scheduled in a queue, meaning it has neither expired nor been cancelled yet
+    /// @return Whether the entry is scheduled
+    bool Is_Scheduled() const {
+        return m_queue != nullptr;
+    }
+
+    /// @brief Removes the entry from the queue it is currently scheduled in, meaning the callback is not called anymore. Does nothing if the entry is not scheduled
+    void Cancel();
+
+    /// @brief Sets the listener that is informed once the entry expired, after the callback has been called. Is copied together with the entry
+    /// @param listener Listener that should be informed, nullptr to not inform any listener, has to be kept alive for as long as the entry is scheduled
+    /// @param id Id the listener is informed with
+    void Set_Listener(ITimeout_Listener * listener, size_t const & id) {
+        m_listener = listener;
+        m_listener_id = id;
+    }
+
+  private:
+    ITimeout_Listener *m_listener = {};    // Listener that is informed once the entry expired, nullptr if no listener is set
+    size_t            m_listener_id = {}; // Id the listener is informed with
+    Timer_Queue       *m_queue = {};       // Queue the entry is currently scheduled in, nullptr if the entry is not scheduled
+    Timer_Queue_Entry *m_previous = {};    // Scheduled entry with the next earlier or the same deadline, nullptr if this is the first entry in the queue
+    Timer_Queue_Entry *m_next = {};        // Scheduled entry with the next later or the same deadline, nullptr if this is the last entry in the queue
+    uint64_t          m_deadline = {};     // Time in microseconds of the clock of the queue, the callback should be called at
+};
+
+
+/// @brief Single queue that handles the timeouts of all requests at once, instead of every request requiring its own timer.
+/// The scheduled entries are kept in a doubly linked list that is sorted by their deadline, inserting starts at the last entry, because requests are mostly sent with the same timeout,
+/// which results in the new entry simply being appended. Cancelling an entry only has to unlink it and calling update() only has to look at the expired entries at the front of the queue,
+/// meaning the work done in the loop does not depend on the amount of pending requests anymore.
+/// The time is read from the given clock callback, which allows to replace the clock when the library is run natively on a host, to expire requests without actually having to wait
+class Timer_Queue {
+  public:
+    /// @brief Constructor
+    /// @param get_time_callback Callback that returns the current time of a monotonic clock in microseconds, for example Callback_Watchdog::now()
+    explicit Timer_Queue(Callback<uint64_t>::function get_time_callback)
+      : m_get_time_callback(get_time_callback)
+      , m_first(nullptr)
+      , m_last(nullptr)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Destructor, removes all entries that are still scheduled, so they do not point to the destroyed queue
+    ~Timer_Queue() {
+        while (m_first != nullptr) {
+            Unlink(*m_first);
+        }
+    }
+
+    /// @brief Sets the callback that returns the current time in microseconds, only has to be changed to replace the clock when the library is run natively on a host.
+    /// Should only be called while no entries are scheduled, because their deadlines have been calculated with the previous clock
+    /// @param get_time_callback Callback that returns the current time of a monotonic clock in microseconds
+    void Set_Time_Callback(Callback<uint64_t>::function get_time_callback) {
+        m_get_time_callback.Set_Callback(get_time_callback);
+    }
+
+    /// @brief Gets the current time of the clock the deadlines of the entries are compared against
+    /// @return Current time in microseconds
+    uint64_t now() const {
+        return m_get_time_callback.Call_Callback();
+    }
+
+    /// @brief Schedules the given entry to be called once the given timeout has passed, if the entry is already scheduled it is rescheduled with the new timeout instead
+    /// @param entry Entry that should be scheduled, has to be kept alive until it expired or it is cancelled, which is done automatically once it is destroyed
+    /// @param timeout_microseconds Amount of microseconds until the callback of the entry is called, at least one microsecond is used,
+    /// to ensure an entry that is rescheduled from its own callback is not called again in the same update()
+    void Schedule(Timer_Queue_Entry & entry, uint64_t const & timeout_microseconds) {
+        Insert(entry, now() + (timeout_microseconds > 0U ? timeout_microseconds : 1U));
+    }
+
+    /// @brief Cancels the given entry, meaning the callback is not called anymore. Does nothing if the entry is not scheduled in this queue
+    /// @param entry Entry that should be cancelled
+    void Cancel(Timer_Queue_Entry & entry) {
+        if (entry.m_queue != this) {
+            return;
+        }
+        Unlink(entry);
+    }
+
+    /// @brief Whether there are currently no entries scheduled
+    /// @return Whether the queue is empty
+    bool Is_Empty() const {
+        return m_first == nullptr;
+    }
+
+    /// @brief Calls the callback of every entry whose deadline has passed and removes those entries from the queue, has to be called regularly from the loop.
+    /// Only the expired entries are looked at, because they are sorted at the front of the queue
+    void update() {
+        uint64_t const current_time = now();
+        while (m_first != nullptr && m_first->m_deadline <= current_time) {
+            Timer_Queue_Entry & expired = *m_first;
+            Unlink(expired);
+            // The entry is not accessed after the callback anymore, because the callback might destroy or reschedule it
+            ITimeout_Listener * listener = expired.m_listener;
+            size_t const listener_id = expired.m_listener_id;
+            expired.Call_Callback();
+            if (listener != nullptr) {
+                listener->Timeout_Expired(listener_id);
+            }
+        }
+    }
+
+  private:
+    friend class Timer_Queue_Entry;
+
+    /// @brief Inserts the given entry sorted by the given deadline, entries with the same deadline keep the order they were inserted in
+    /// @param entry Entry that should be inserted, is removed from the queue it is currently scheduled in beforehand
+    /// @param deadline Time in microseconds the callback of the entry should be called at
+    void Insert(Timer_Queue_Entry & entry, uint64_t const & deadline) {
+        // Removed before searching for the insert position, because the entry itself might be the last entry if it is rescheduled
+        entry.Cancel();
+        Timer_Queue_Entry * previous = m_last;
+        while (previous != nullptr && previous->m_deadline > deadline) {
+            previous = previous->m_previous;
+        }
+        Insert_After(entry, previous, deadline);
+    }
+
+    /// @brief Inserts the given entry directly after the given entry, without checking the order of the deadlines
+    /// @param entry Entry that should be inserted, is removed from the queue it is currently scheduled in beforehand
+    /// @param previous Entry the given entry should be inserted after, nullptr to insert the entry as the first entry in the queue
+    /// @param deadline Time in microseconds the callback of the entry should be called at
+    void Insert_After(Timer_Queue_Entry & entry, Timer_Queue_Entry * previous, uint64_t const & deadline) {
+        if (entry.m_queue != nullptr) {
+            entry.m_queue->Unlink(entry);
+        }
+        Timer_Queue_Entry * next = previous != nullptr ? previous->m_next : m_first;
+        entry.m_queue = this;
+        entry.m_previous = previous;
+        entry.m_next = next;
+        entry.m_deadline = deadline;
+        (previous != nullptr ? previous->m_next : m_first) = &entry;
+        (next != nullptr ? next->m_previous : m_last) = &entry;
+    }
+
+    /// @brief Removes the given entry from the queue, expects the entry to be scheduled in this queue
+    /// @param entry Entry that should be removed
+    void Unlink(Timer_Queue_Entry & entry) {
+        (entry.m_previous != nullptr ? entry.m_previous->m_next : m_first) = entry.m_next;
+        (entry.m_next != nullptr ? entry.m_next->m_previous : m_last) = entry.m_previous;
+        entry.m_queue = nullptr;
+        entry.m_previous = nullptr;
+        entry.m_next = nullptr;
+    }
+
+    Callback<uint64_t> m_get_time_callback = {}; // Callback that returns the current time in microseconds
+    Timer_Queue_Entry  *m_first = {};            // Scheduled entry with the earliest deadline, nullptr if the queue is empty
+    Timer_Queue_Entry  *m_last = {};             // Scheduled entry with the latest deadline, nullptr if the queue is empty
+};
+
+
+inline Timer_Queue_Entry::Timer_Queue_Entry(Timer_Queue_Entry const & other)
+  : Callback(other)
+  , m_listener(other.m_listener)
+  , m_listener_id(other.m_listener_id)
+  , m_queue(nullptr)
+  , m_previous(nullptr)
+  , m_next(nullptr)
+  , m_deadline(0U)
+{
+    if (other.m_queue != nullptr) {
+        other.m_queue->Insert_After(*this, const_cast<Timer_Queue_Entry *>(&other), other.m_deadline);
+    }
+}
+
+inline Timer_Queue_Entry & Timer_Queue_Entry::operator=(Timer_Queue_Entry const & other) {
+    if (this == &other) {
+        return *this;
+    }
+    Callback::operator=(other);
+    m_listener = other.m_listener;
+    m_listener_id = other.m_listener_id;
+    if (m_queue != nullptr) {
+        m_queue->Unlink(*this);
+    }
+    if (other.m_queue != nullptr) {
+        other.m_queue->Insert_After(*this, const_cast<Timer_Queue_Entry *>(&other), other.m_deadline);
+    }
+    return *this;
+}
+
+inline Timer_Queue_Entry::~Timer_Queue_Entry() {
+    Cancel();
+}
+
+inline void Timer_Queue_Entry::Cancel() {
+    if (m_queue != nullptr) {
+        m_queue->Unlink(*this);
+    }
+}
+
+#endif // Timer_Queue_h
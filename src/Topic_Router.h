@@ -0,0 +1,116 @@
+#ifndef Topic_Router_h
+#define Topic_Router_h
+
+// Local includes.
+#include "Configuration.h"
+#include "IAPI_Implementation.h"
+
+// Library includes.
+#include <string.h>
+
+
+/// @brief Single entry of the topic router, connects the response topic of an API implementation to the implementation itself
+struct Topic_Route {
+    char const          *topic = {};     // Constant response topic of the API implementation, nullptr if the topic can only be compared with Compare_Response_Topic
+    size_t              length = {};     // Length of the response topic without the null terminator
+    bool                is_prefix = {};  // Whether the received topic only has to start with the response topic or has to match it exactly
+    IAPI_Implementation *api = {};       // API implementation that handles responses received on the topic
+};
+
+
+/// @brief Maps received topics to the API implementations that handle responses on them, in a single pass over the received topic.
+/// Routes are kept sorted by their topic, which makes the route array behave like a trie, because all routes that share the same first characters are stored next to each other.
+/// Walking the received topic character by character then only has to narrow down the range of routes that still match, instead of comparing the complete topic against every single API implementation.
+/// API implementations that do not have a constant response topic are still supported, but have to be compared with Compare_Response_Topic for every received message
+#if THINGSBOARD_ENABLE_DYNAMIC
+class Topic_Router {
+#else
+/// @tparam MaxRoutes Maximum amount of API implementations that can be routed to
+template <size_t MaxRoutes>
+class Topic_Router {
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+  public:
+    /// @brief Constructor
+    Topic_Router() = default;
+
+    /// @brief Adds the route for the given API implementation, has to be called once when the API implementation is subscribed.
+    /// Inserts the route at its sorted position, which is more expensive than simply appending it, but only happens once instead of for every received message
+    /// @param api API implementation that should be routed to
+    void Add_Route(IAPI_Implementation & api) {
+        Topic_Route route = {};
+        route.topic = api.Get_Response_Topic(route.is_prefix);
+        route.length = route.topic != nullptr ? strlen(route.topic) : 0U;
+        route.api = &api;
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        if (m_routes.size() + 1 > m_routes.capacity()) {
+            return;
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        m_routes.push_back(route);
+        for (size_t i = m_routes.size() - 1U; i > 0U && Is_Sorted_Before(m_routes[i], m_routes[i - 1U]); i--) {
+            Topic_Route const previous = m_routes[i - 1U];
+            m_routes[i - 1U] = m_routes[i];
+            m_routes[i] = previous;
+        }
+    }
+
+    /// @brief Copies all API implementations that handle responses on the given topic into the given container
+    /// @tparam Container Container that the matching API implementations will be pushed back into, allows for using / passing either Array or Vector
+    /// @param topic Received topic that should be routed
+    /// @param matches Container the matching API implementations will be copied into
+    template <typename Container>
+    void Match(char const * topic, Container & matches) const {
+        size_t lower = 0U;
+        size_t upper = m_routes.size();
+
+        // Routes without a constant topic are always sorted to the front
+        for (; lower < upper && m_routes[lower].topic == nullptr; lower++) {
+            if (m_routes[lower].api->Compare_Response_Topic(topic)) {
+                matches.push_back(m_routes[lower].api);
+            }
+        }
+
+        for (size_t i = 0U; lower < upper; i++) {
+            unsigned char const symbol = static_cast<unsigned char>(topic[i]);
+            // Routes that end at the current character are always sorted in front of the longer routes in the remaining range,
+            // prefix routes match as soon as we reached their end, exact routes only if the received topic ends at the same character
+            for (; lower < upper && m_routes[lower].length == i; lower++) {
+                if (m_routes[lower].is_prefix || symbol == '\0') {
+                    matches.push_back(m_routes[lower].api);
+                }
+            }
+            if (symbol == '\0') {
+                break;
+            }
+            for (; lower < upper && static_cast<unsigned char>(m_routes[lower].topic[i]) < symbol; lower++) {}
+            for (; lower < upper && static_cast<unsigned char>(m_routes[upper - 1U].topic[i]) > symbol; upper--) {}
+        }
+    }
+
+    /// @brief Removes all routes
+    void clear() {
+        m_routes.clear();
+    }
+
+  private:
+    /// @brief Whether the given route has to be sorted in front of the other route.
+    /// Routes without a constant topic are sorted in front of all others, the remaining routes are sorted lexicographically by their topic,
+    /// which guarantees that routes that are a prefix of another route are sorted in front of it
+    /// @param route Route that should be checked
+    /// @param other Route that should be compared against
+    /// @return Whether route has to be sorted in front of other
+    static bool Is_Sorted_Before(Topic_Route const & route, Topic_Route const & other) {
+        if (route.topic == nullptr || other.topic == nullptr) {
+            return route.topic == nullptr && other.topic != nullptr;
+        }
+        return strcmp(route.topic, other.topic) < 0;
+    }
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Vector<Topic_Route>           m_routes = {}; // Routes sorted by their topic
+#else
+    Array<Topic_Route, MaxRoutes> m_routes = {}; // Routes sorted by their topic
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+};
+
+#endif // Topic_Router_h
@@ -147,7 +147,11 @@ class Vector {
             m_capacity = (m_capacity == 0) ? 1 : 2 * m_capacity;
             T* new_elements = new T[m_capacity]();
             if (m_elements != nullptr) {
-                memcpy(new_elements, m_elements, m_size * sizeof(T));
+                // Copied with the assignment operator instead of memcpy, because elements like a scheduled Timer_Queue_Entry are referenced by other objects,
+                // which have to be updated to point to the new element before the old one is destroyed
+                for (size_t i = 0U; i < m_size; i++) {
+                    new_elements[i] = m_elements[i];
+                }
                 delete[] m_elements;
             }
             m_elements = new_elements;
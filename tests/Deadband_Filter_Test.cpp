@@ -0,0 +1,108 @@
+// Local includes.
+#include "Test_Fixture.h"
+
+// Library includes.
+#include <math.h>
+
+
+namespace {
+
+class Deadband_Filter_Test : public Test_Fixture<> {
+  protected:
+    void SetUp() override {
+        Test_Fixture<>::SetUp();
+        m_tb.Set_Telemetry_Filter(m_filter);
+    }
+
+    Deadband_Entry  m_entries[8U] = {};
+    Deadband_Filter m_filter{m_entries, 8U, 1.0, 0.0, 1000U};
+};
+
+} // namespace
+
+TEST(Deadband_Filter, AbsoluteDeadbandAndHeartbeat) {
+    Deadband_Entry entries[8U];
+    Deadband_Filter filter(entries, 8U, 0.5, 0.0, 1000U);
+    // Keys are compared by content, not by their address
+    char first_key[] = "temp";
+    char second_key[] = "temp";
+    EXPECT_TRUE(filter.Should_Report(Telemetry(first_key, 20.0), 0U));
+    filter.Reported(Telemetry(first_key, 20.0), 0U);
+    EXPECT_FALSE(filter.Should_Report(Telemetry(second_key, 20.4), 10U));
+    EXPECT_TRUE(filter.Should_Report(Telemetry(second_key, 20.6), 10U));
+    EXPECT_TRUE(filter.Should_Report(Telemetry(second_key, 20.0), 1000U));
+    EXPECT_TRUE(filter.Should_Report(Telemetry(second_key, "x"), 10U));
+}
+
+TEST(Deadband_Filter, RelativeDeadband) {
+    Deadband_Entry entries[8U];
+    Deadband_Filter filter(entries, 8U);
+    ASSERT_TRUE(filter.Set_Deadband("hum", 0.0, 0.1));
+    filter.Reported(Telemetry("hum", 50), 0U);
+    EXPECT_FALSE(filter.Should_Report(Telemetry("hum", 54), 1U));
+    EXPECT_TRUE(filter.Should_Report(Telemetry("hum", 56), 1U));
+}
+
+TEST(Deadband_Filter, NonNumericValuesAreReportedOnChange) {
+    Deadband_Entry entries[8U];
+    Deadband_Filter filter(entries, 8U, 0.5);
+    filter.Reported(Telemetry("s", "on"), 0U);
+    EXPECT_FALSE(filter.Should_Report(Telemetry("s", "on"), 1U));
+    EXPECT_TRUE(filter.Should_Report(Telemetry("s", "off"), 1U));
+    filter.Reported(Telemetry("b", true), 0U);
+    EXPECT_FALSE(filter.Should_Report(Telemetry("b", true), 1U));
+    EXPECT_TRUE(filter.Should_Report(Telemetry("b", false), 1U));
+    filter.Reported(Telemetry("n", NAN), 0U);
+    EXPECT_FALSE(filter.Should_Report(Telemetry("n", NAN), 1U));
+    EXPECT_TRUE(filter.Should_Report(Telemetry("n", 1.0), 1U));
+    filter.clear();
+    EXPECT_TRUE(filter.Should_Report(Telemetry("s", "on"), 1U));
+}
+
+TEST(Deadband_Filter, UntrackedKeysAreAlwaysReported) {
+    Deadband_Entry entries[1U];
+    Deadband_Filter filter(entries, 1U);
+    filter.Reported(Telemetry("a", 1), 0U);
+    filter.Reported(Telemetry("z", 1), 0U);
+    EXPECT_FALSE(filter.Should_Report(Telemetry("a", 1), 1U));
+    EXPECT_TRUE(filter.Should_Report(Telemetry("z", 1), 1U));
+}
+
+TEST_F(Deadband_Filter_Test, FiltersTelemetryButNotAttributes) {
+    EXPECT_TRUE(m_tb.sendTelemetryData("t", 20.0));
+    EXPECT_EQ(1U, payloads.size());
+    EXPECT_TRUE(m_tb.sendTelemetryData("t", 20.5));
+    EXPECT_EQ(1U, payloads.size());
+    EXPECT_TRUE(m_tb.sendTelemetryData("t", 22));
+    EXPECT_EQ(2U, payloads.size());
+    EXPECT_TRUE(m_tb.sendAttributeData("t", 22));
+    EXPECT_EQ(3U, payloads.size());
+
+    Telemetry const telemetry[] = { Telemetry("t", 22.1), Telemetry("u", "x"), Telemetry("v", 3) };
+#if THINGSBOARD_ENABLE_DYNAMIC
+    EXPECT_TRUE(m_tb.sendTelemetry(&telemetry[0], &telemetry[0] + 3U));
+#else
+    EXPECT_TRUE(m_tb.sendTelemetry<3U>(&telemetry[0], &telemetry[0] + 3U));
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    ASSERT_EQ(4U, payloads.size());
+    EXPECT_EQ("{\"u\":\"x\",\"v\":3}", payloads.back());
+    // Nothing changed, therefore the complete message is skipped
+#if THINGSBOARD_ENABLE_DYNAMIC
+    EXPECT_TRUE(m_tb.sendTelemetry(&telemetry[0], &telemetry[0] + 3U));
+#else
+    EXPECT_TRUE(m_tb.sendTelemetry<3U>(&telemetry[0], &telemetry[0] + 3U));
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    EXPECT_EQ(4U, payloads.size());
+}
+
+TEST_F(Deadband_Filter_Test, HeartbeatUsesTimerQueueClock) {
+    current_time = 5000000U;
+    EXPECT_TRUE(m_tb.sendTelemetryData("h", 1));
+    EXPECT_EQ(1U, payloads.size());
+    current_time += 999U;
+    EXPECT_TRUE(m_tb.sendTelemetryData("h", 1));
+    EXPECT_EQ(1U, payloads.size());
+    current_time += 1U;
+    EXPECT_TRUE(m_tb.sendTelemetryData("h", 1));
+    EXPECT_EQ(2U, payloads.size());
+}
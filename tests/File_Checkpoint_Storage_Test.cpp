@@ -0,0 +1,97 @@
+// Local includes.
+#include "File_Checkpoint_Storage.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+class File_Checkpoint_Storage_Test : public testing::Test {
+  protected:
+    void SetUp() override {
+        m_storage.erase();
+        (void)strncpy(m_checkpoint.fw_title, "title", sizeof(m_checkpoint.fw_title) - 1U);
+        (void)strncpy(m_checkpoint.fw_version, "2.0", sizeof(m_checkpoint.fw_version) - 1U);
+        (void)strncpy(m_checkpoint.fw_checksum, "abcdef", sizeof(m_checkpoint.fw_checksum) - 1U);
+        m_checkpoint.fw_checksum_algorithm = MBEDTLS_MD_SHA256;
+        m_checkpoint.fw_size = 0x01020304U;
+        m_checkpoint.chunk_size = 4096U;
+        m_checkpoint.written_chunks = 258U;
+    }
+
+    void TearDown() override {
+        m_storage.erase();
+    }
+
+    std::vector<uint8_t> Read_File() const {
+        std::vector<uint8_t> content = {};
+        FILE* file = fopen(m_path.c_str(), "rb");
+        if (file == nullptr) {
+            return content;
+        }
+        int byte = 0;
+        while ((byte = fgetc(file)) != EOF) {
+            content.push_back(static_cast<uint8_t>(byte));
+        }
+        fclose(file);
+        return content;
+    }
+
+    void Write_File(std::vector<uint8_t> const & content) const {
+        FILE* file = fopen(m_path.c_str(), "wb");
+        ASSERT_NE(nullptr, file);
+        (void)fwrite(content.data(), 1, content.size(), file);
+        fclose(file);
+    }
+
+    std::string               m_path = testing::TempDir() + "ota_checkpoint.bin";
+    File_Checkpoint_Storage<> m_storage{m_path.c_str()};
+    OTA_Checkpoint            m_checkpoint = {};
+};
+
+} // namespace
+
+TEST_F(File_Checkpoint_Storage_Test, LoadsStoredCheckpoint) {
+    OTA_Checkpoint loaded = {};
+    EXPECT_FALSE(m_storage.load(loaded));
+    ASSERT_TRUE(m_storage.store(m_checkpoint));
+    ASSERT_TRUE(m_storage.load(loaded));
+    EXPECT_STREQ("title", loaded.fw_title);
+    EXPECT_STREQ("2.0", loaded.fw_version);
+    EXPECT_STREQ("abcdef", loaded.fw_checksum);
+    EXPECT_EQ(MBEDTLS_MD_SHA256, loaded.fw_checksum_algorithm);
+    EXPECT_EQ(0x01020304U, loaded.fw_size);
+    EXPECT_EQ(4096U, loaded.chunk_size);
+    EXPECT_EQ(258U, loaded.written_chunks);
+}
+
+TEST_F(File_Checkpoint_Storage_Test, WritesVersionedLittleEndianHeader) {
+    ASSERT_TRUE(m_storage.store(m_checkpoint));
+    std::vector<uint8_t> const content = Read_File();
+    ASSERT_EQ(CHECKPOINT_FILE_HEADER_SIZE + CHECKPOINT_FILE_BODY_SIZE, content.size());
+    std::vector<uint8_t> const header(content.begin(), content.begin() + CHECKPOINT_FILE_HEADER_SIZE);
+    std::vector<uint8_t> const expected_header = { 'T', 'B', 'C', 'P', CHECKPOINT_FILE_VERSION, static_cast<uint8_t>(CHECKPOINT_FILE_BODY_SIZE), static_cast<uint8_t>(CHECKPOINT_FILE_BODY_SIZE >> 8U) };
+    EXPECT_EQ(expected_header, header);
+    // Amount of written chunks is the last field of the checkpoint
+    std::vector<uint8_t> const written_chunks(content.end() - 4U, content.end());
+    std::vector<uint8_t> const expected_written_chunks = { 0x02U, 0x01U, 0x00U, 0x00U };
+    EXPECT_EQ(expected_written_chunks, written_chunks);
+}
+
+TEST_F(File_Checkpoint_Storage_Test, IgnoresOtherVersionAndTruncatedFile) {
+    ASSERT_TRUE(m_storage.store(m_checkpoint));
+    std::vector<uint8_t> content = Read_File();
+    content[4U] = CHECKPOINT_FILE_VERSION + 1U;
+    Write_File(content);
+    OTA_Checkpoint loaded = {};
+    EXPECT_FALSE(m_storage.load(loaded));
+
+    content[4U] = CHECKPOINT_FILE_VERSION;
+    content.pop_back();
+    Write_File(content);
+    EXPECT_FALSE(m_storage.load(loaded));
+}
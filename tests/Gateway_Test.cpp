@@ -0,0 +1,105 @@
+// Local includes.
+#include "Test_Fixture.h"
+#include "Gateway.h"
+
+
+namespace {
+
+size_t attribute_updates = 0U;
+std::string rpc_method = {};
+
+void On_Attributes(JsonObjectConst const & data) {
+    EXPECT_EQ(7, data["x"].as<int>());
+    attribute_updates++;
+}
+
+void On_Rpc(char const * method, JsonVariantConst const & data, JsonDocument & response) {
+    rpc_method = method != nullptr ? method : "";
+    response["ok"] = true;
+}
+
+class Gateway_Test : public Test_Fixture<> {
+  protected:
+    void SetUp() override {
+        Test_Fixture<>::SetUp();
+        attribute_updates = 0U;
+        rpc_method.clear();
+        m_tb.Subscribe_API_Implementation(m_gateway);
+        ASSERT_TRUE(m_gateway.Connect_Device(Gateway_Device("A")));
+#if THINGSBOARD_ENABLE_DYNAMIC
+        ASSERT_TRUE(m_gateway.Connect_Device(Gateway_Device("B", "sensor", &On_Rpc, &On_Attributes, JSON_OBJECT_SIZE(1U))));
+#else
+        ASSERT_TRUE(m_gateway.Connect_Device(Gateway_Device("B", "sensor", &On_Rpc, &On_Attributes)));
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Gateway<>          m_gateway = {};
+#else
+    Gateway<3U, 2U>    m_gateway = {};
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+};
+
+} // namespace
+
+TEST_F(Gateway_Test, ConnectsDevices) {
+    ASSERT_EQ(2U, payloads.size());
+    EXPECT_EQ("v1/gateway/connect", topics[1U]);
+    EXPECT_EQ("{\"device\":\"A\"}", payloads[0U]);
+    EXPECT_EQ("{\"device\":\"B\",\"type\":\"sensor\"}", payloads[1U]);
+}
+
+TEST_F(Gateway_Test, BatchesTelemetryOfMultipleDevices) {
+    Telemetry const first("t", 1), second("t", 2), third("t", 3);
+    EXPECT_FALSE(m_gateway.Append_Telemetry("A", 0U, &first, &first + 1U));
+    char buffer[64U] = {};
+    m_gateway.Set_Telemetry_Buffer(buffer, sizeof(buffer));
+    ASSERT_TRUE(m_gateway.Append_Telemetry("A", 0U, &first, &first + 1U));
+    ASSERT_TRUE(m_gateway.Append_Telemetry("A", 0U, &second, &second + 1U));
+    ASSERT_TRUE(m_gateway.Append_Telemetry("B", 5U, &third, &third + 1U));
+    EXPECT_FALSE(m_gateway.Append_Telemetry("X", 0U, &first, &first + 1U));
+    ASSERT_TRUE(m_gateway.Flush_Telemetry());
+    EXPECT_EQ("v1/gateway/telemetry", topics.back());
+    EXPECT_EQ("{\"A\":[{\"t\":1},{\"t\":2}],\"B\":[{\"ts\":5,\"values\":{\"t\":3}}]}", payloads.back());
+}
+
+TEST_F(Gateway_Test, SendsDataOfSingleDevice) {
+    Telemetry const telemetry[] = { Telemetry("t", 1), Telemetry("u", 2) };
+#if THINGSBOARD_ENABLE_DYNAMIC
+    ASSERT_TRUE(m_gateway.Send_Telemetry("B", &telemetry[0], &telemetry[0] + 2U));
+    ASSERT_TRUE(m_gateway.Send_Attributes("B", &telemetry[0], &telemetry[0] + 1U));
+#else
+    ASSERT_TRUE(m_gateway.Send_Telemetry<2U>("B", &telemetry[0], &telemetry[0] + 2U));
+    ASSERT_TRUE(m_gateway.Send_Attributes<2U>("B", &telemetry[0], &telemetry[0] + 1U));
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    EXPECT_EQ("{\"B\":[{\"t\":1,\"u\":2}]}", payloads[payloads.size() - 2U]);
+    EXPECT_EQ("v1/gateway/attributes", topics.back());
+    EXPECT_EQ("{\"B\":{\"t\":1}}", payloads.back());
+}
+
+TEST_F(Gateway_Test, DispatchesAttributesAndRpcToDevice) {
+    ASSERT_TRUE(Receive("v1/gateway/attributes", "{\"device\":\"B\",\"data\":{\"x\":7}}"));
+    EXPECT_EQ(1U, attribute_updates);
+    ASSERT_TRUE(Receive("v1/gateway/rpc", "{\"device\":\"B\",\"data\":{\"id\":4,\"method\":\"set\",\"params\":1}}"));
+    EXPECT_EQ("set", rpc_method);
+    EXPECT_EQ("v1/gateway/rpc", topics.back());
+    EXPECT_EQ("{\"device\":\"B\",\"id\":4,\"data\":{\"ok\":true}}", payloads.back());
+
+    rpc_method.clear();
+    ASSERT_TRUE(Receive("v1/gateway/rpc", "{\"device\":\"Z\",\"data\":{\"id\":4,\"method\":\"set\"}}"));
+    EXPECT_TRUE(rpc_method.empty());
+}
+
+TEST_F(Gateway_Test, DisconnectFlushesPendingTelemetry) {
+    char buffer[64U] = {};
+    m_gateway.Set_Telemetry_Buffer(buffer, sizeof(buffer));
+    Telemetry const telemetry("t", 1);
+    ASSERT_TRUE(m_gateway.Append_Telemetry("B", 0U, &telemetry, &telemetry + 1U));
+    size_t const published = payloads.size();
+    ASSERT_TRUE(m_gateway.Disconnect_Device("B"));
+    ASSERT_EQ(published + 2U, payloads.size());
+    EXPECT_EQ("{\"B\":[{\"t\":1}]}", payloads[published]);
+    EXPECT_EQ("{\"device\":\"B\"}", payloads[published + 1U]);
+    ASSERT_TRUE(Receive("v1/gateway/attributes", "{\"device\":\"B\",\"data\":{\"x\":7}}"));
+    EXPECT_EQ(0U, attribute_updates);
+}
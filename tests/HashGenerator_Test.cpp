@@ -0,0 +1,27 @@
+// Local includes.
+#include "HashGenerator.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+
+
+TEST(HashGenerator, Sha256) {
+    char constexpr data[] = "abc";
+    HashGenerator hash;
+    ASSERT_TRUE(hash.start(MBEDTLS_MD_SHA256));
+    ASSERT_TRUE(hash.update(reinterpret_cast<uint8_t const *>(data), 3U));
+    char result[FIRMWARE_HASH_SIZE] = {};
+    ASSERT_TRUE(hash.finish(result));
+    EXPECT_STREQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", result);
+}
+
+TEST(HashGenerator, Sha256InMultipleUpdates) {
+    char constexpr data[] = "abc";
+    HashGenerator hash;
+    ASSERT_TRUE(hash.start(MBEDTLS_MD_SHA256));
+    ASSERT_TRUE(hash.update(reinterpret_cast<uint8_t const *>(data), 1U));
+    ASSERT_TRUE(hash.update(reinterpret_cast<uint8_t const *>(data) + 1U, 2U));
+    char result[FIRMWARE_HASH_SIZE] = {};
+    ASSERT_TRUE(hash.finish(result));
+    EXPECT_STREQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", result);
+}
@@ -0,0 +1,55 @@
+// Local includes.
+#include "Helper.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+#include <string.h>
+
+
+namespace {
+
+size_t Count_Nodes(char const * json) {
+    return Helper::getJsonNodeCount(reinterpret_cast<uint8_t const *>(json), strlen(json));
+}
+
+} // namespace
+
+TEST(Helper, Crc32MatchesCheckValue) {
+    char constexpr data[] = "123456789";
+    EXPECT_EQ(0xCBF43926U, Helper::calculateCrc32(reinterpret_cast<uint8_t const *>(data), 9U));
+}
+
+TEST(Helper, Crc32CanBeCalculatedIncrementally) {
+    char constexpr data[] = "123456789";
+    uint32_t const crc = Helper::calculateCrc32(reinterpret_cast<uint8_t const *>(data), 4U);
+    EXPECT_EQ(0xCBF43926U, Helper::calculateCrc32(reinterpret_cast<uint8_t const *>(data) + 4U, 5U, crc));
+}
+
+TEST(Helper, ParseRequestId) {
+    EXPECT_EQ(4294967040U, Helper::parseRequestId("v1/x/", "v1/x/4294967040"));
+    EXPECT_EQ(12U, Helper::parseRequestId("v1/devices/me/rpc/request/", "v1/devices/me/rpc/request/12"));
+}
+
+TEST(Helper, JsonNodeCountSkipsStrings) {
+    EXPECT_EQ(0U, Count_Nodes("{}"));
+    EXPECT_EQ(1U, Count_Nodes("{\"a\":1}"));
+    EXPECT_EQ(6U, Count_Nodes("{\"a\":1,\"b\":[1,2,{}],\"c\":\"x,{[\\\"]\"}"));
+    EXPECT_EQ(0U, Count_Nodes("[ ]"));
+    EXPECT_EQ(2U, Count_Nodes("{\"shared\":{\"k\":\"v\"}}"));
+    EXPECT_EQ(0U, Count_Nodes("\"a\\\\\""));
+    EXPECT_EQ(2U, Count_Nodes("{ \"a\" : [ ] , \"b\" : { } }"));
+}
+
+TEST(Helper, HashStringDistinguishesTopics) {
+    char const * topics[] = { "v1/devices/me/attributes/response/+", "v1/devices/me/rpc/response/+", "v1/gateway/attributes", "v1/gateway/rpc", "v1/devices/me/attributes", "v2/fw/response/+", "/provision/response", "v1/devices/me/rpc/request/+" };
+    for (char const * first : topics) {
+        for (char const * second : topics) {
+            if (first == second) {
+                continue;
+            }
+            EXPECT_NE(Helper::hashString(first), Helper::hashString(second)) << first << " " << second;
+            EXPECT_NE(Helper::hashString64(first), Helper::hashString64(second)) << first << " " << second;
+        }
+    }
+    EXPECT_EQ(Helper::hashString64("temperature"), Helper::hashString64("temperature"));
+}
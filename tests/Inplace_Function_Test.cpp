@@ -0,0 +1,57 @@
+// Local includes.
+#include "Callback.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+
+namespace {
+
+int Increment(int value) {
+    return value + 1;
+}
+
+} // namespace
+
+TEST(Inplace_Function, CallsFunctionPointer) {
+    Callback<int, int> callback(&Increment);
+    EXPECT_EQ(2, callback.Call_Callback(1));
+}
+
+TEST(Inplace_Function, EmptyCallbackReturnsDefaultValue) {
+    int (*function)(int) = nullptr;
+    Callback<int, int> callback(function);
+    EXPECT_EQ(0, callback.Call_Callback(1));
+    Callback<int, int> default_callback;
+    EXPECT_EQ(0, default_callback.Call_Callback(5));
+}
+
+TEST(Inplace_Function, CopiesAndMovesCapturedState) {
+    auto const captured = std::make_shared<std::string>("captured string that is longer than the small string optimization");
+    Callback<size_t>::function function = [captured]() {
+        return captured->size();
+    };
+    Callback<size_t>::function copy = function;
+    EXPECT_EQ(3, captured.use_count());
+    Callback<size_t>::function moved = std::move(copy);
+    EXPECT_FALSE(static_cast<bool>(copy));
+    EXPECT_EQ(captured->size(), moved());
+    EXPECT_EQ(3, captured.use_count());
+
+    // Destroys the captured state when the function is reassigned
+    function = nullptr;
+    moved = function;
+    EXPECT_EQ(1, captured.use_count());
+}
+
+TEST(Inplace_Function, IgnoresReturnValueOfVoidCallback) {
+    size_t calls = 0U;
+    Callback<void> callback([&calls]() {
+        calls++;
+        return 5;
+    });
+    callback.Call_Callback();
+    EXPECT_EQ(1U, calls);
+}
@@ -0,0 +1,112 @@
+// Local includes.
+#include "Json_Stream_Parser.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+#include <string>
+
+
+namespace {
+
+/// @brief Handler that records every reported container and value into a string
+class Recording_Handler {
+  public:
+    explicit Recording_Handler(bool descend_nested)
+      : m_descend_nested(descend_nested)
+    {
+        // Nothing to do
+    }
+
+    bool On_Container(size_t const & depth, char const * key, Json_Stream_Type const & type) {
+        m_events += "C" + std::to_string(depth) + (key != nullptr ? key : "-") + (type == Json_Stream_Type::OBJECT ? "{ " : "[ ");
+        return depth == 0U || m_descend_nested;
+    }
+
+    bool On_Value(size_t const & depth, char const * key, Json_Stream_Value const & value) {
+        m_events += "V" + std::to_string(depth) + (key != nullptr ? key : "-") + "=";
+        switch (value.type) {
+            case Json_Stream_Type::STRING:
+                m_events += "s:" + std::string(value.begin, value.length);
+                break;
+            case Json_Stream_Type::INTEGER:
+                m_events += "i:" + std::to_string(value.integer);
+                break;
+            case Json_Stream_Type::DECIMAL:
+                m_events += "d:" + std::to_string(value.decimal);
+                break;
+            case Json_Stream_Type::BOOLEAN:
+                m_events += value.boolean ? "true" : "false";
+                break;
+            case Json_Stream_Type::NULL_VALUE:
+                m_events += "null";
+                break;
+            default:
+                m_events += "raw:" + std::string(value.begin, value.length) + "#" + std::to_string(value.Get_Node_Count());
+                break;
+        }
+        m_events += " ";
+        return true;
+    }
+
+    std::string const & Get_Events() const {
+        return m_events;
+    }
+
+  private:
+    bool        m_descend_nested = {};
+    std::string m_events = {};
+};
+
+/// @brief Parses a copy of the given json, because the parser modifies the payload in place
+bool Parse(std::string json, std::string & events, bool descend_nested = true) {
+    Recording_Handler handler(descend_nested);
+    Json_Stream_Parser parser(&json[0], json.size());
+    bool const result = parser.Parse(handler);
+    events = handler.Get_Events();
+    return result;
+}
+
+} // namespace
+
+TEST(Json_Stream_Parser, StreamsNestedValues) {
+    std::string events;
+    ASSERT_TRUE(Parse("{\"a\":1,\"b\":\"x\\\"y\\u00e9\\ud83d\\ude00\",\"c\":[1,2.5,true,null],\"d\":{\"e\":-3e2}}", events));
+    EXPECT_EQ("C0-{ V1a=i:1 V1b=s:x\"y\xC3\xA9\xF0\x9F\x98\x80 C1c[ V2-=i:1 V2-=d:2.500000 V2-=true V2-=null C1d{ V2e=d:-300.000000 ", events);
+}
+
+TEST(Json_Stream_Parser, SkipsContainersAsRawJson) {
+    std::string events;
+    ASSERT_TRUE(Parse("{\"a\":1,\"c\":[1,2.5,{\"q\":\"}\"}],\"d\":{\"e\":-3e2}} ", events, false));
+    EXPECT_EQ("C0-{ V1a=i:1 C1c[ V1c=raw:[1,2.5,{\"q\":\"}\"}]#4 C1d{ V1d=raw:{\"e\":-3e2}#1 ", events);
+}
+
+TEST(Json_Stream_Parser, AcceptsEmptyContainersAndWhitespace) {
+    std::string events;
+    EXPECT_TRUE(Parse("{}", events));
+    EXPECT_TRUE(Parse("[]", events));
+    ASSERT_TRUE(Parse(" { \"a\" : [ ] } ", events));
+    EXPECT_EQ("C0-{ C1a[ ", events);
+}
+
+TEST(Json_Stream_Parser, IntegerOverflowIsReportedAsDecimal) {
+    std::string events;
+    ASSERT_TRUE(Parse("{\"a\":99999999999999999999}", events));
+    EXPECT_EQ("C0-{ V1a=d:100000000000000000000.000000 ", events);
+}
+
+TEST(Json_Stream_Parser, RejectsInvalidJson) {
+    std::string events;
+    EXPECT_FALSE(Parse("{\"a\":1,}", events));
+    EXPECT_FALSE(Parse("{\"a\" 1}", events));
+    EXPECT_FALSE(Parse("{\"a\":1", events));
+    EXPECT_FALSE(Parse("{\"a\":tru}", events));
+    EXPECT_FALSE(Parse("{\"a\":\"unterminated}", events));
+    EXPECT_FALSE(Parse("[1 2]", events));
+    EXPECT_FALSE(Parse("{\"method\":\"set\",\"params\":{\"x\":[1,2]}}x", events));
+}
+
+TEST(Json_Stream_Parser, RejectsTooDeeplyNestedJson) {
+    std::string events;
+    std::string const nested = std::string(JSON_STREAM_MAX_DEPTH + 8U, '[') + std::string(JSON_STREAM_MAX_DEPTH + 8U, ']');
+    EXPECT_FALSE(Parse(nested, events));
+}
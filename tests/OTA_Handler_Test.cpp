@@ -0,0 +1,251 @@
+// Local includes.
+#include "Test_Fixture.h"
+#include "OTA_Handler.h"
+#include "Memory_Updater.h"
+#include "DefaultLogger.h"
+
+// Library includes.
+#include <string>
+#include <vector>
+
+
+namespace {
+
+size_t constexpr FIRMWARE_SIZE = 10U;
+uint16_t constexpr OTA_CHUNK_SIZE = 4U;
+uint64_t constexpr OTA_TIMEOUT = 1000U;
+
+std::vector<size_t> requested_chunks = {};
+std::vector<std::string> states = {};
+std::vector<bool> results = {};
+
+bool On_Request_Chunk(size_t const & request_id, size_t const & chunk) {
+    requested_chunks.push_back(chunk);
+    return true;
+}
+
+bool On_State(char const * state, char const * error) {
+    states.push_back(state);
+    return true;
+}
+
+bool On_Finish() {
+    return true;
+}
+
+void On_Updated(bool const & success) {
+    results.push_back(success);
+}
+
+/// @brief Checkpoint storage that keeps the checkpoint in memory, simulates a restart by creating a new handler with the same storage
+class Memory_Checkpoint_Storage : public IOTA_Checkpoint_Storage {
+  public:
+    bool load(OTA_Checkpoint & checkpoint) override {
+        if (!m_stored) {
+            return false;
+        }
+        checkpoint = m_checkpoint;
+        return true;
+    }
+
+    bool store(OTA_Checkpoint const & checkpoint) override {
+        m_checkpoint = checkpoint;
+        m_stored = true;
+        return true;
+    }
+
+    void erase() override {
+        m_stored = false;
+    }
+
+    bool Is_Stored() const {
+        return m_stored;
+    }
+
+  private:
+    OTA_Checkpoint m_checkpoint = {};
+    bool           m_stored = {};
+};
+
+/// @brief Updater that is able to resume an update, but not to read back the already written data, meaning the hash calculation can not be restored
+class Write_Only_Updater : public Memory_Updater {
+  public:
+    using Memory_Updater::Memory_Updater;
+
+    size_t read(size_t const & offset, uint8_t * buffer, size_t const & length) override {
+        return 0U;
+    }
+};
+
+class OTA_Handler_Test : public Test_Fixture<> {
+  protected:
+    void SetUp() override {
+        Test_Fixture<>::SetUp();
+        current_time = 1000U;
+        requested_chunks.clear();
+        states.clear();
+        results.clear();
+        for (size_t i = 0U; i < FIRMWARE_SIZE; i++) {
+            m_firmware[i] = static_cast<uint8_t>('a' + i);
+        }
+        HashGenerator hash;
+        ASSERT_TRUE(hash.start(MBEDTLS_MD_SHA256));
+        ASSERT_TRUE(hash.update(m_firmware, FIRMWARE_SIZE));
+        ASSERT_TRUE(hash.finish(m_checksum));
+    }
+
+    OTA_Update_Callback Create_Callback(uint8_t const & retries, uint8_t const & chunk_window) {
+        return OTA_Update_Callback("title", "1.0", &m_updater, &On_Updated, nullptr, nullptr, retries, OTA_CHUNK_SIZE, OTA_TIMEOUT, chunk_window);
+    }
+
+    void Start(OTA_Handler<DefaultLogger> & handler, OTA_Update_Callback const & callback, char const * checksum) {
+        handler.Set_Timer_Queue(&m_tb.getTimerQueue());
+        handler.Start_Firmware_Update(callback, "title", "2.0", FIRMWARE_SIZE, checksum, MBEDTLS_MD_SHA256);
+    }
+
+    void Process(OTA_Handler<DefaultLogger> & handler, size_t const & chunk) {
+        size_t const offset = chunk * OTA_CHUNK_SIZE;
+        size_t const size = FIRMWARE_SIZE - offset < OTA_CHUNK_SIZE ? FIRMWARE_SIZE - offset : OTA_CHUNK_SIZE;
+        uint8_t payload[OTA_CHUNK_SIZE] = {};
+        (void)memcpy(payload, m_firmware + offset, size);
+        handler.Process_Firmware_Packet(chunk, payload, size);
+    }
+
+    uint8_t        m_firmware[FIRMWARE_SIZE] = {};
+    char           m_checksum[FIRMWARE_HASH_SIZE] = {};
+    uint8_t        m_flash[FIRMWARE_SIZE] = {};
+    Memory_Updater m_updater{m_flash, sizeof(m_flash)};
+};
+
+} // namespace
+
+TEST_F(OTA_Handler_Test, WritesChunksReceivedInOrder) {
+    OTA_Handler<DefaultLogger> handler(&On_Request_Chunk, &On_State, &On_Finish);
+    OTA_Update_Callback const callback = Create_Callback(1U, 1U);
+    Start(handler, callback, m_checksum);
+    for (size_t chunk = 0U; chunk < 3U; chunk++) {
+        Process(handler, chunk);
+    }
+    std::vector<size_t> const expected_requests = { 0U, 1U, 2U };
+    EXPECT_EQ(expected_requests, requested_chunks);
+    std::vector<bool> const expected_results = { true };
+    EXPECT_EQ(expected_results, results);
+    EXPECT_EQ(FIRMWARE_SIZE, m_updater.get_offset());
+    EXPECT_EQ(0, memcmp(m_firmware, m_flash, FIRMWARE_SIZE));
+    std::vector<std::string> const expected_states = { FW_STATE_DOWNLOADING, FW_STATE_DOWNLOADED, FW_STATE_UPDATING };
+    EXPECT_EQ(expected_states, states);
+}
+
+TEST_F(OTA_Handler_Test, BuffersChunksReceivedOutOfOrder) {
+    OTA_Handler<DefaultLogger> handler(&On_Request_Chunk, &On_State, &On_Finish);
+    OTA_Update_Callback const callback = Create_Callback(1U, 2U);
+    Start(handler, callback, m_checksum);
+    std::vector<size_t> expected_requests = { 0U, 1U };
+    EXPECT_EQ(expected_requests, requested_chunks);
+
+    Process(handler, 1U);
+    EXPECT_EQ(0U, m_updater.get_offset());
+    Process(handler, 0U);
+    EXPECT_EQ(2U * OTA_CHUNK_SIZE, m_updater.get_offset());
+    expected_requests.push_back(2U);
+    EXPECT_EQ(expected_requests, requested_chunks);
+
+    Process(handler, 2U);
+    std::vector<bool> const expected_results = { true };
+    EXPECT_EQ(expected_results, results);
+    EXPECT_EQ(0, memcmp(m_firmware, m_flash, FIRMWARE_SIZE));
+}
+
+TEST_F(OTA_Handler_Test, IgnoresChunksOutsideOfWindowAndWithWrongSize) {
+    OTA_Handler<DefaultLogger> handler(&On_Request_Chunk, &On_State, &On_Finish);
+    OTA_Update_Callback const callback = Create_Callback(1U, 1U);
+    Start(handler, callback, m_checksum);
+    Process(handler, 1U);
+    uint8_t payload[OTA_CHUNK_SIZE] = {};
+    handler.Process_Firmware_Packet(0U, payload, 2U);
+    EXPECT_EQ(0U, m_updater.get_offset());
+    EXPECT_TRUE(results.empty());
+}
+
+TEST_F(OTA_Handler_Test, RequestsChunkAgainAfterTimeout) {
+    OTA_Handler<DefaultLogger> handler(&On_Request_Chunk, &On_State, &On_Finish);
+    OTA_Update_Callback const callback = Create_Callback(1U, 1U);
+    Start(handler, callback, m_checksum);
+    current_time += OTA_TIMEOUT - 1U;
+    m_tb.getTimerQueue().update();
+    EXPECT_EQ(1U, requested_chunks.size());
+    current_time += 1U;
+    m_tb.getTimerQueue().update();
+    std::vector<size_t> const expected_requests = { 0U, 0U };
+    EXPECT_EQ(expected_requests, requested_chunks);
+
+    // No retries are left, therefore the next timeout aborts the update
+    current_time += OTA_TIMEOUT;
+    m_tb.getTimerQueue().update();
+    std::vector<bool> const expected_results = { false };
+    EXPECT_EQ(expected_results, results);
+    EXPECT_EQ(FW_STATE_FAILED, states.back());
+}
+
+TEST_F(OTA_Handler_Test, FailsOnChecksumMismatch) {
+    OTA_Handler<DefaultLogger> handler(&On_Request_Chunk, &On_State, &On_Finish);
+    OTA_Update_Callback const callback = Create_Callback(0U, 1U);
+    Start(handler, callback, "0000000000000000000000000000000000000000000000000000000000000000");
+    for (size_t chunk = 0U; chunk < 3U; chunk++) {
+        Process(handler, chunk);
+    }
+    std::vector<bool> const expected_results = { false };
+    EXPECT_EQ(expected_results, results);
+    EXPECT_EQ(FW_STATE_FAILED, states.back());
+}
+
+TEST_F(OTA_Handler_Test, ResumesFromCheckpoint) {
+    Memory_Checkpoint_Storage storage;
+    OTA_Update_Callback callback = Create_Callback(1U, 1U);
+    callback.Set_Checkpoint_Storage(&storage);
+    callback.Set_Checkpoint_Interval(1U);
+    {
+        OTA_Handler<DefaultLogger> interrupted(&On_Request_Chunk, &On_State, &On_Finish);
+        Start(interrupted, callback, m_checksum);
+        Process(interrupted, 0U);
+        EXPECT_TRUE(storage.Is_Stored());
+    }
+
+    requested_chunks.clear();
+    OTA_Handler<DefaultLogger> resumed(&On_Request_Chunk, &On_State, &On_Finish);
+    Start(resumed, callback, m_checksum);
+    std::vector<size_t> const expected_requests = { 1U };
+    EXPECT_EQ(expected_requests, requested_chunks);
+    EXPECT_EQ(OTA_CHUNK_SIZE, m_updater.get_offset());
+    Process(resumed, 1U);
+    Process(resumed, 2U);
+    std::vector<bool> const expected_results = { true };
+    EXPECT_EQ(expected_results, results);
+    EXPECT_EQ(0, memcmp(m_firmware, m_flash, FIRMWARE_SIZE));
+    EXPECT_FALSE(storage.Is_Stored());
+}
+
+TEST_F(OTA_Handler_Test, RestartsIfWrittenDataCanNotBeReadBack) {
+    Memory_Checkpoint_Storage storage;
+    Write_Only_Updater updater(m_flash, sizeof(m_flash));
+    OTA_Update_Callback callback("title", "1.0", &updater, &On_Updated, nullptr, nullptr, 1U, OTA_CHUNK_SIZE, OTA_TIMEOUT, 1U);
+    callback.Set_Checkpoint_Storage(&storage);
+    callback.Set_Checkpoint_Interval(1U);
+    {
+        OTA_Handler<DefaultLogger> interrupted(&On_Request_Chunk, &On_State, &On_Finish);
+        Start(interrupted, callback, m_checksum);
+        Process(interrupted, 0U);
+        EXPECT_TRUE(storage.Is_Stored());
+    }
+
+    requested_chunks.clear();
+    OTA_Handler<DefaultLogger> restarted(&On_Request_Chunk, &On_State, &On_Finish);
+    Start(restarted, callback, m_checksum);
+    std::vector<size_t> const expected_requests = { 0U };
+    EXPECT_EQ(expected_requests, requested_chunks);
+    for (size_t chunk = 0U; chunk < 3U; chunk++) {
+        Process(restarted, chunk);
+    }
+    std::vector<bool> const expected_results = { true };
+    EXPECT_EQ(expected_results, results);
+}
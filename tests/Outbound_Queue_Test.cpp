@@ -0,0 +1,125 @@
+// Local includes.
+#include "Test_Fixture.h"
+#include "RAM_Outbox_Storage.h"
+
+// Library includes.
+#include <algorithm>
+
+
+namespace {
+
+class Outbound_Queue_Test : public Test_Fixture<> {
+  protected:
+    void SetUp() override {
+        Test_Fixture<>::SetUp();
+        ASSERT_TRUE(m_tb.setBufferSize(128U, 128U));
+        m_tb.Set_Outbound_Queue(&m_queue);
+        std::fill(m_outbox_buffer, m_outbox_buffer + sizeof(m_outbox_buffer), 0xFF);
+    }
+
+    uint8_t            m_buffer[400U] = {};
+    Outbound_Queue<>   m_queue{m_buffer, sizeof(m_buffer)};
+    uint8_t            m_outbox_buffer[2U * 128U] = {};
+    RAM_Outbox_Storage m_storage{m_outbox_buffer, sizeof(m_outbox_buffer), 128U};
+    Outbox<>           m_outbox{m_storage};
+};
+
+} // namespace
+
+TEST_F(Outbound_Queue_Test, MessagesAreOnlyPublishedFromLoop) {
+    ASSERT_TRUE(m_tb.sendTelemetryData("t", 1));
+    EXPECT_TRUE(payloads.empty());
+    EXPECT_EQ(1U, m_queue.Get_Count(Outbound_Priority::TELEMETRY));
+    m_tb.loop();
+    ASSERT_EQ(1U, payloads.size());
+    EXPECT_EQ("{\"t\":1}", payloads[0U]);
+    EXPECT_TRUE(m_queue.Is_Empty());
+}
+
+TEST_F(Outbound_Queue_Test, DrainsByPriorityWithinBudget) {
+    m_queue.Set_Drain_Budget(16U, 0U);
+    for (size_t i = 0U; i < 5U; i++) {
+        ASSERT_TRUE(m_tb.sendTelemetryData("t", i));
+    }
+    ASSERT_TRUE(m_tb.sendAttributeData("a", 1));
+    ASSERT_TRUE(m_tb.Send_Json_String("v2/fw/request/1/chunk/0", "4096"));
+    ASSERT_TRUE(m_tb.Send_Json_String("v1/devices/me/rpc/response/3", "{\"ok\":true}"));
+    EXPECT_EQ(5U, m_queue.Get_Count(Outbound_Priority::TELEMETRY));
+    EXPECT_EQ(1U, m_queue.Get_Count(Outbound_Priority::CONTROL));
+    EXPECT_EQ(1U, m_queue.Get_Count(Outbound_Priority::OTA));
+    EXPECT_EQ(1U, m_queue.Get_Count(Outbound_Priority::ATTRIBUTES));
+
+    // Budget of 16 bytes allows the rpc response (11) and the chunk request (4), but not the attributes (7) anymore
+    m_tb.loop();
+    std::vector<std::string> expected_topics = { "v1/devices/me/rpc/response/3", "v2/fw/request/1/chunk/0" };
+    EXPECT_EQ(expected_topics, topics);
+    m_tb.loop();
+    ASSERT_EQ(4U, payloads.size());
+    EXPECT_EQ("v1/devices/me/attributes", topics[2U]);
+    EXPECT_EQ("{\"t\":0}", payloads[3U]);
+    for (size_t i = 0U; i < 3U; i++) {
+        m_tb.loop();
+    }
+    ASSERT_EQ(8U, payloads.size());
+    EXPECT_EQ("{\"t\":4}", payloads[7U]);
+    EXPECT_TRUE(m_queue.Is_Empty());
+}
+
+TEST_F(Outbound_Queue_Test, ControlMessageEvictsOldestTelemetryOnceFull) {
+    size_t queued = 0U;
+    while (m_tb.sendTelemetryData("t", queued)) {
+        queued++;
+    }
+    ASSERT_GT(queued, 1U);
+    ASSERT_TRUE(m_tb.Send_Json_String("v1/devices/me/rpc/response/4", "{\"ok\":1}"));
+    m_tb.loop();
+    ASSERT_GT(payloads.size(), 1U);
+    EXPECT_EQ("v1/devices/me/rpc/response/4", topics[0U]);
+    EXPECT_NE("{\"t\":0}", payloads[1U]);
+    EXPECT_TRUE(m_queue.Is_Empty());
+}
+
+TEST_F(Outbound_Queue_Test, KeepsMessagesWhileDisconnected) {
+    ASSERT_TRUE(m_tb.sendTelemetryData("x", 1));
+    m_client.disconnect();
+    m_tb.loop();
+    EXPECT_TRUE(payloads.empty());
+    EXPECT_FALSE(m_queue.Is_Empty());
+    Connect();
+    m_tb.loop();
+    EXPECT_EQ(1U, payloads.size());
+}
+
+TEST_F(Outbound_Queue_Test, PublishesDirectlyWithoutQueue) {
+    ASSERT_TRUE(m_tb.Set_Outbound_Queue(nullptr));
+    ASSERT_TRUE(m_tb.sendTelemetryData("y", 2));
+    EXPECT_EQ(1U, payloads.size());
+}
+
+TEST_F(Outbound_Queue_Test, FailedPublishIsStoredInOutbox) {
+    ASSERT_TRUE(m_tb.Set_Outbox(m_outbox));
+    ASSERT_TRUE(m_tb.sendTelemetryData("t", 1));
+    // Send buffer is too small for the queued message, therefore publishing it fails even though the client is still connected
+    ASSERT_TRUE(m_client.set_buffer_size(128U, 4U));
+    m_tb.loop();
+    EXPECT_TRUE(payloads.empty());
+    EXPECT_TRUE(m_queue.Is_Empty());
+    EXPECT_FALSE(m_outbox.Is_Empty());
+
+    ASSERT_TRUE(m_client.set_buffer_size(128U, 128U));
+    m_tb.loop();
+    ASSERT_EQ(1U, payloads.size());
+    EXPECT_EQ("{\"t\":1}", payloads[0U]);
+    EXPECT_TRUE(m_outbox.Is_Empty());
+}
+
+TEST_F(Outbound_Queue_Test, OutboxIsReplayedThroughQueue) {
+    ASSERT_TRUE(m_tb.Set_Outbox(m_outbox));
+    ASSERT_TRUE(m_outbox.Store(TELEMETRY_TOPIC, reinterpret_cast<uint8_t const *>("{\"t\":1}"), 7U));
+    ASSERT_TRUE(m_tb.Send_Json_String("v1/devices/me/rpc/response/3", "{\"ok\":true}"));
+    m_tb.loop();
+    // Stored telemetry is published after the rpc response, because it has a lower priority
+    std::vector<std::string> const expected_topics = { "v1/devices/me/rpc/response/3", TELEMETRY_TOPIC };
+    EXPECT_EQ(expected_topics, topics);
+    EXPECT_TRUE(m_outbox.Is_Empty());
+}
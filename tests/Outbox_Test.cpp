@@ -0,0 +1,166 @@
+// Local includes.
+#include "Test_Fixture.h"
+#include "Outbox.h"
+#include "RAM_Outbox_Storage.h"
+
+// Library includes.
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+class Outbox_Test : public Test_Fixture<> {
+  protected:
+    void SetUp() override {
+        Test_Fixture<>::SetUp();
+        current_time = 1000U;
+        std::fill(m_buffer, m_buffer + sizeof(m_buffer), 0xFF);
+    }
+
+    /// @brief Joins the topic and payload of every published message, separated by a space
+    static std::vector<std::string> Published() {
+        std::vector<std::string> published = {};
+        for (size_t i = 0U; i < payloads.size(); i++) {
+            published.push_back(topics[i] + " " + payloads[i]);
+        }
+        return published;
+    }
+
+    static bool Store(Outbox<> & outbox, char const * topic, char const * payload) {
+        return outbox.Store(topic, reinterpret_cast<uint8_t const *>(payload), strlen(payload));
+    }
+
+    static void Drain_All(Outbox<> & outbox, Memory_MQTT_Client & client) {
+        outbox.Set_Drain_Rate(100U, 0U);
+        while (!outbox.Is_Empty()) {
+            ASSERT_TRUE(outbox.Drain(client));
+        }
+    }
+
+    uint8_t            m_buffer[4U * 128U] = {};
+    RAM_Outbox_Storage m_storage{m_buffer, sizeof(m_buffer), 128U};
+};
+
+} // namespace
+
+TEST_F(Outbox_Test, RejectsStorageWithLessThanTwoSectors) {
+    RAM_Outbox_Storage storage(m_buffer, 128U, 128U);
+    Outbox<> outbox(storage, &Get_Time);
+    EXPECT_FALSE(outbox.Initialize());
+}
+
+TEST_F(Outbox_Test, TelemetryIsPublishedWithTheTimeItWasStored) {
+    Outbox<> outbox(m_storage, &Get_Time);
+    ASSERT_TRUE(outbox.Initialize());
+    EXPECT_TRUE(outbox.Is_Empty());
+    ASSERT_TRUE(Store(outbox, TELEMETRY_TOPIC, "{\"v\":1}"));
+    ASSERT_TRUE(Store(outbox, ATTRIBUTE_TOPIC, "{\"a\":1}"));
+    ASSERT_TRUE(Store(outbox, TELEMETRY_TOPIC, "{\"ts\":5,\"values\":{\"a\":1}}"));
+    ASSERT_TRUE(Store(outbox, TELEMETRY_TOPIC, "{\"tsx\":1}"));
+    Drain_All(outbox, m_client);
+    std::vector<std::string> const expected = {
+        "v1/devices/me/telemetry {\"ts\":1000,\"values\":{\"v\":1}}",
+        "v1/devices/me/attributes {\"a\":1}",
+        "v1/devices/me/telemetry {\"ts\":5,\"values\":{\"a\":1}}",
+        "v1/devices/me/telemetry {\"ts\":1000,\"values\":{\"tsx\":1}}"
+    };
+    EXPECT_EQ(expected, Published());
+}
+
+TEST_F(Outbox_Test, DropsOldestSectorOnceFull) {
+    Outbox<> outbox(m_storage, &Get_Time);
+    ASSERT_TRUE(outbox.Initialize());
+    char payload[32U] = {};
+    for (size_t i = 0U; i < 20U; i++) {
+        (void)snprintf(payload, sizeof(payload), "{\"v\":%zu}", i);
+        current_time += 10U;
+        ASSERT_TRUE(Store(outbox, TELEMETRY_TOPIC, payload));
+    }
+    Drain_All(outbox, m_client);
+    std::vector<std::string> const published = Published();
+    ASSERT_FALSE(published.empty());
+    EXPECT_LT(published.size(), 20U);
+    EXPECT_EQ("v1/devices/me/telemetry {\"ts\":1200,\"values\":{\"v\":19}}", published.back());
+    // Messages of the dropped sectors are lost, but the remaining ones are still published in order
+    size_t const first = 20U - published.size();
+    for (size_t i = 0U; i < published.size(); i++) {
+        EXPECT_NE(std::string::npos, published[i].find("{\"v\":" + std::to_string(first + i) + "}")) << published[i];
+    }
+}
+
+TEST_F(Outbox_Test, RestoresPendingMessagesAfterRestart) {
+    char payload[32U] = {};
+    {
+        Outbox<> outbox(m_storage, &Get_Time);
+        ASSERT_TRUE(outbox.Initialize());
+        for (size_t i = 0U; i < 6U; i++) {
+            (void)snprintf(payload, sizeof(payload), "[{\"x\":%zu}]", i);
+            ASSERT_TRUE(Store(outbox, TELEMETRY_TOPIC, payload));
+        }
+        outbox.Set_Drain_Rate(2U, 0U);
+        ASSERT_TRUE(outbox.Drain(m_client));
+        ASSERT_EQ(2U, payloads.size());
+    }
+    topics.clear();
+    payloads.clear();
+    Outbox<> restarted(m_storage, &Get_Time);
+    ASSERT_TRUE(restarted.Initialize());
+    EXPECT_FALSE(restarted.Is_Empty());
+    Drain_All(restarted, m_client);
+    std::vector<std::string> const expected = {
+        "v1/devices/me/telemetry [{\"x\":2}]",
+        "v1/devices/me/telemetry [{\"x\":3}]",
+        "v1/devices/me/telemetry [{\"x\":4}]",
+        "v1/devices/me/telemetry [{\"x\":5}]"
+    };
+    EXPECT_EQ(expected, Published());
+
+    Outbox<> drained(m_storage, &Get_Time);
+    ASSERT_TRUE(drained.Initialize());
+    EXPECT_TRUE(drained.Is_Empty());
+}
+
+TEST_F(Outbox_Test, DiscardsRecordWithInvalidCrc) {
+    {
+        Outbox<> outbox(m_storage, &Get_Time);
+        ASSERT_TRUE(outbox.Initialize());
+        ASSERT_TRUE(Store(outbox, ATTRIBUTE_TOPIC, "{\"valid\":1}"));
+        ASSERT_TRUE(Store(outbox, ATTRIBUTE_TOPIC, "{\"corrupt\":1}"));
+    }
+    char constexpr corrupt[] = "corrupt";
+    uint8_t * const position = std::search(m_buffer, m_buffer + sizeof(m_buffer), corrupt, corrupt + sizeof(corrupt) - 1U);
+    ASSERT_NE(m_buffer + sizeof(m_buffer), position);
+    *position = 'C';
+
+    Outbox<> restarted(m_storage, &Get_Time);
+    ASSERT_TRUE(restarted.Initialize());
+    Drain_All(restarted, m_client);
+    std::vector<std::string> const expected = { "v1/devices/me/attributes {\"valid\":1}" };
+    EXPECT_EQ(expected, Published());
+}
+
+TEST_F(Outbox_Test, DiscardsExpiredMessages) {
+    Outbox<> outbox(m_storage, &Get_Time);
+    ASSERT_TRUE(outbox.Initialize());
+    ASSERT_TRUE(Store(outbox, ATTRIBUTE_TOPIC, "{\"old\":1}"));
+    current_time += 5000U;
+    ASSERT_TRUE(Store(outbox, ATTRIBUTE_TOPIC, "{\"new\":1}"));
+    outbox.Set_Max_Age(1000U);
+    Drain_All(outbox, m_client);
+    std::vector<std::string> const expected = { "v1/devices/me/attributes {\"new\":1}" };
+    EXPECT_EQ(expected, Published());
+}
+
+TEST_F(Outbox_Test, KeepsMessagesWhileDisconnected) {
+    Outbox<> outbox(m_storage, &Get_Time);
+    ASSERT_TRUE(outbox.Initialize());
+    ASSERT_TRUE(Store(outbox, ATTRIBUTE_TOPIC, "{\"a\":1}"));
+    m_client.disconnect();
+    EXPECT_FALSE(outbox.Drain(m_client));
+    EXPECT_FALSE(outbox.Is_Empty());
+    Connect();
+    Drain_All(outbox, m_client);
+    EXPECT_EQ(1U, payloads.size());
+}
@@ -0,0 +1,198 @@
+// Local includes.
+#include "Protobuf_Codec.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+Protobuf_Field constexpr telemetry_fields[] = {
+    { "temperature", 1U, Protobuf_Field_Type::DOUBLE },
+    { "count", 2U, Protobuf_Field_Type::INT32 },
+    { "on", 3U, Protobuf_Field_Type::BOOL },
+    { "name", 4U, Protobuf_Field_Type::STRING },
+    { "delta", 5U, Protobuf_Field_Type::SINT32 },
+    { "f", 6U, Protobuf_Field_Type::FLOAT },
+    { "big", 300U, Protobuf_Field_Type::UINT64 }
+};
+Protobuf_Field constexpr attribute_fields[] = { { "fw", 1U, Protobuf_Field_Type::STRING } };
+
+void Put_Varint(std::vector<uint8_t> & output, uint64_t value) {
+    do {
+        uint8_t const byte = value & 0x7FU;
+        value >>= 7U;
+        output.push_back(value != 0U ? byte | 0x80U : byte);
+    } while (value != 0U);
+}
+
+template <typename T>
+void Put_Fixed(std::vector<uint8_t> & output, T const & value) {
+    uint8_t bytes[sizeof(T)] = {};
+    (void)memcpy(bytes, &value, sizeof(T));
+    output.insert(output.end(), bytes, bytes + sizeof(T));
+}
+
+void Put_String(std::vector<uint8_t> & output, uint32_t const & number, char const * value) {
+    Put_Varint(output, (number << 3U) | 2U);
+    Put_Varint(output, strlen(value));
+    output.insert(output.end(), value, value + strlen(value));
+}
+
+void Put_Message(std::vector<uint8_t> & output, uint32_t const & number, std::vector<uint8_t> const & message) {
+    Put_Varint(output, (number << 3U) | 2U);
+    Put_Varint(output, message.size());
+    output.insert(output.end(), message.begin(), message.end());
+}
+
+class Protobuf_Codec_Test : public testing::Test {
+  protected:
+    Protobuf_Codec m_codec{telemetry_fields, telemetry_fields + 7U, attribute_fields, attribute_fields + 1U};
+};
+
+} // namespace
+
+TEST_F(Protobuf_Codec_Test, EncodesOnlyTopicsWithSchema) {
+    EXPECT_TRUE(m_codec.Is_Encoded_Topic("v1/devices/me/telemetry"));
+    EXPECT_TRUE(m_codec.Is_Encoded_Topic("v1/devices/me/attributes"));
+    EXPECT_TRUE(m_codec.Is_Encoded_Topic("v1/devices/me/rpc/response/12"));
+    EXPECT_FALSE(m_codec.Is_Encoded_Topic("v1/devices/me/rpc/request/12"));
+    EXPECT_FALSE(m_codec.Is_Encoded_Topic("v1/devices/me/attributes/request/1"));
+    EXPECT_TRUE(m_codec.Is_Decoded_Topic("v1/devices/me/attributes"));
+    EXPECT_TRUE(m_codec.Is_Decoded_Topic("v1/devices/me/rpc/request/7"));
+    EXPECT_FALSE(m_codec.Is_Decoded_Topic("v1/devices/me/attributes/response/1"));
+    EXPECT_FALSE(m_codec.Is_Decoded_Topic("v1/devices/me/rpc/response/7"));
+}
+
+TEST_F(Protobuf_Codec_Test, EncodesTelemetryWithFieldTypes) {
+    StaticJsonDocument<JSON_OBJECT_SIZE(8U)> document;
+    document["temperature"] = 1.5;
+    document["count"] = -1;
+    document["on"] = true;
+    document["name"] = "ab";
+    document["delta"] = -2;
+    document["f"] = 1.0f;
+    document["big"] = 300;
+    document["skip"].set(static_cast<char const *>(nullptr));
+
+    std::vector<uint8_t> expected;
+    Put_Varint(expected, (1U << 3U) | 1U);
+    Put_Fixed(expected, 1.5);
+    Put_Varint(expected, 2U << 3U);
+    Put_Varint(expected, static_cast<uint64_t>(-1));
+    Put_Varint(expected, 3U << 3U);
+    Put_Varint(expected, 1U);
+    Put_String(expected, 4U, "ab");
+    Put_Varint(expected, 5U << 3U);
+    Put_Varint(expected, 3U);
+    Put_Varint(expected, (6U << 3U) | 5U);
+    Put_Fixed(expected, 1.0f);
+    Put_Varint(expected, 300U << 3U);
+    Put_Varint(expected, 300U);
+
+    uint8_t buffer[128U] = {};
+    size_t const length = m_codec.Encode("v1/devices/me/telemetry", document, buffer, sizeof(buffer));
+    ASSERT_EQ(expected.size(), length);
+    EXPECT_EQ(expected, std::vector<uint8_t>(buffer, buffer + length));
+    EXPECT_EQ(0U, m_codec.Encode("v1/devices/me/telemetry", document, buffer, length - 1U));
+    EXPECT_EQ(length, m_codec.Encode("v1/devices/me/telemetry", document, buffer, length));
+    // Attribute schema does not contain any of the keys
+    EXPECT_EQ(0U, m_codec.Encode("v1/devices/me/attributes", document, buffer, sizeof(buffer)));
+}
+
+TEST_F(Protobuf_Codec_Test, RejectsValuesNotMatchingFieldType) {
+    uint8_t buffer[64U] = {};
+    StaticJsonDocument<JSON_OBJECT_SIZE(1U)> string_as_integer;
+    string_as_integer["count"] = "str";
+    EXPECT_EQ(0U, m_codec.Encode("v1/devices/me/telemetry", string_as_integer, buffer, sizeof(buffer)));
+    StaticJsonDocument<JSON_OBJECT_SIZE(1U)> integer_as_bool;
+    integer_as_bool["on"] = 1;
+    EXPECT_EQ(0U, m_codec.Encode("v1/devices/me/telemetry", integer_as_bool, buffer, sizeof(buffer)));
+    // Numbers are converted into their string representation instead
+    StaticJsonDocument<JSON_OBJECT_SIZE(1U)> integer_as_string;
+    integer_as_string["name"] = 12;
+    ASSERT_EQ(4U, m_codec.Encode("v1/devices/me/telemetry", integer_as_string, buffer, sizeof(buffer)));
+    EXPECT_EQ(0x22U, buffer[0U]);
+    EXPECT_EQ(2U, buffer[1U]);
+    EXPECT_EQ(0, memcmp(buffer + 2U, "12", 2U));
+}
+
+TEST_F(Protobuf_Codec_Test, EncodesRpcResponseAsJsonString) {
+    StaticJsonDocument<JSON_OBJECT_SIZE(1U)> document;
+    document["ok"] = true;
+    uint8_t buffer[64U] = {};
+    ASSERT_EQ(13U, m_codec.Encode("v1/devices/me/rpc/response/3", document, buffer, sizeof(buffer)));
+    EXPECT_EQ(0x0AU, buffer[0U]);
+    EXPECT_EQ(11U, buffer[1U]);
+    EXPECT_EQ(0, memcmp(buffer + 2U, "{\"ok\":true}", 11U));
+    EXPECT_EQ(0U, m_codec.Encode("v1/devices/me/rpc/response/3", document, buffer, 13U));
+    EXPECT_EQ(13U, m_codec.Encode("v1/devices/me/rpc/response/3", document, buffer, 14U));
+}
+
+TEST_F(Protobuf_Codec_Test, DecodesAttributeUpdate) {
+    std::vector<uint8_t> message;
+    char const * const keys[] = { "b", "l", "d", "s" };
+    for (size_t i = 0U; i < 4U; i++) {
+        std::vector<uint8_t> key_value, timestamped;
+        Put_String(key_value, 1U, keys[i]);
+        switch (i) {
+            case 0U:
+                Put_Varint(key_value, 3U << 3U);
+                Put_Varint(key_value, 1U);
+                break;
+            case 1U:
+                Put_Varint(key_value, 2U << 3U);
+                Put_Varint(key_value, 1U);
+                Put_Varint(key_value, 4U << 3U);
+                Put_Varint(key_value, static_cast<uint64_t>(static_cast<int64_t>(-5)));
+                break;
+            case 2U:
+                Put_Varint(key_value, 2U << 3U);
+                Put_Varint(key_value, 2U);
+                Put_Varint(key_value, (5U << 3U) | 1U);
+                Put_Fixed(key_value, 2.25);
+                break;
+            default:
+                Put_Varint(key_value, 2U << 3U);
+                Put_Varint(key_value, 3U);
+                Put_String(key_value, 6U, "hello");
+                break;
+        }
+        Put_Varint(timestamped, 1U << 3U);
+        Put_Varint(timestamped, 1700000000000ULL);
+        Put_Message(timestamped, 2U, key_value);
+        Put_Message(message, 1U, timestamped);
+    }
+    Put_String(message, 2U, "gone");
+    Put_String(message, 2U, "");
+    // Unknown fields are skipped
+    Put_Varint(message, 9U << 3U);
+    Put_Varint(message, 77U);
+
+    EXPECT_EQ(7U, m_codec.Get_Decoded_Node_Count("v1/devices/me/attributes", message.data(), message.size()));
+    StaticJsonDocument<256U> document;
+    ASSERT_TRUE(m_codec.Decode("v1/devices/me/attributes", message.data(), message.size(), document));
+    std::string json;
+    (void)serializeJson(document, json);
+    EXPECT_EQ("{\"b\":true,\"l\":-5,\"d\":2.25,\"s\":\"hello\",\"deleted\":[\"gone\",\"\"]}", json);
+
+    std::vector<uint8_t> truncated(message.begin(), message.begin() + 10U);
+    StaticJsonDocument<256U> truncated_document;
+    EXPECT_EQ(0U, m_codec.Get_Decoded_Node_Count("v1/devices/me/attributes", truncated.data(), truncated.size()));
+    EXPECT_FALSE(m_codec.Decode("v1/devices/me/attributes", truncated.data(), truncated.size(), truncated_document));
+}
+
+TEST_F(Protobuf_Codec_Test, DecodesRpcRequest) {
+    std::vector<uint8_t> message;
+    Put_String(message, 1U, "setValue");
+    Put_Varint(message, 2U << 3U);
+    Put_Varint(message, 42U);
+    Put_String(message, 3U, "{\"v\":1}");
+    EXPECT_EQ(2U, m_codec.Get_Decoded_Node_Count("v1/devices/me/rpc/request/42", message.data(), message.size()));
+    StaticJsonDocument<64U> document;
+    ASSERT_TRUE(m_codec.Decode("v1/devices/me/rpc/request/42", message.data(), message.size(), document));
+    EXPECT_STREQ("setValue", document["method"].as<char const *>());
+    EXPECT_STREQ("{\"v\":1}", document["params"].as<char const *>());
+}
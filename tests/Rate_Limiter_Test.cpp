@@ -0,0 +1,106 @@
+// Local includes.
+#include "Test_Fixture.h"
+#include "RAM_Outbox_Storage.h"
+
+// Library includes.
+#include <algorithm>
+
+
+namespace {
+
+class Rate_Limiter_Test : public Test_Fixture<> {
+  protected:
+    void SetUp() override {
+        Test_Fixture<>::SetUp();
+        ASSERT_TRUE(m_tb.setBufferSize(128U, 128U));
+    }
+
+    uint8_t          m_buffer[512U] = {};
+    Outbound_Queue<> m_queue{m_buffer, sizeof(m_buffer)};
+    Rate_Limiter     m_limiter{"2:1", "2:1"};
+};
+
+} // namespace
+
+TEST(Rate_Limiter, LimitsMessagesOverMultipleWindows) {
+    Rate_Limiter limiter("2:1,3:10", "5:1");
+    EXPECT_TRUE(limiter.Try_Consume(1U, 2U, 0U));
+    EXPECT_TRUE(limiter.Try_Consume(1U, 2U, 0U));
+    EXPECT_FALSE(limiter.Try_Consume(1U, 0U, 0U));
+    EXPECT_EQ(500000U, limiter.Get_Wait_Time(1U, 0U, 0U));
+    EXPECT_TRUE(limiter.Try_Consume(1U, 1U, 500000U));
+
+    // The 10 second window refills 3 messages in 10 seconds and already contains 0.15 messages after half a second
+    uint64_t const wait_time = limiter.Get_Wait_Time(1U, 0U, 500000U);
+    EXPECT_GE(wait_time, 2833333U);
+    EXPECT_LE(wait_time, 2833334U);
+    EXPECT_FALSE(limiter.Try_Consume(1U, 0U, 3333333U));
+    EXPECT_TRUE(limiter.Try_Consume(1U, 0U, 3333334U));
+}
+
+TEST(Rate_Limiter, AllowsMessageBiggerThanCapacityIfBucketIsFull) {
+    Rate_Limiter limiter(nullptr, "5:1");
+    EXPECT_TRUE(limiter.Try_Consume(1U, 50U, 0U));
+    EXPECT_FALSE(limiter.Try_Consume(1U, 1U, 0U));
+    EXPECT_TRUE(limiter.Try_Consume(1U, 50U, 1000000U));
+}
+
+TEST(Rate_Limiter, ParsesLimits) {
+    Rate_Limiter limiter;
+    EXPECT_FALSE(limiter.Set_Message_Limits("10:"));
+    EXPECT_FALSE(limiter.Set_Message_Limits("a:1"));
+    EXPECT_FALSE(limiter.Set_Message_Limits("1:1,2:2,3:3,4:4,5:5"));
+    EXPECT_TRUE(limiter.Set_Message_Limits("10:1,300:60"));
+    EXPECT_TRUE(limiter.Set_Message_Limits(""));
+    EXPECT_TRUE(limiter.Try_Consume(1000U, 1000U, 0U));
+}
+
+TEST_F(Rate_Limiter_Test, RequiresOutboundQueue) {
+    EXPECT_FALSE(m_tb.Set_Rate_Limiter(&m_limiter));
+    ASSERT_TRUE(m_tb.Set_Outbound_Queue(&m_queue));
+    EXPECT_TRUE(m_tb.Set_Rate_Limiter(&m_limiter));
+    EXPECT_FALSE(m_tb.Set_Outbound_Queue(nullptr));
+}
+
+TEST_F(Rate_Limiter_Test, DefersQueuedMessagesUntilAllowed) {
+    ASSERT_TRUE(m_tb.Set_Outbound_Queue(&m_queue));
+    ASSERT_TRUE(m_tb.Set_Rate_Limiter(&m_limiter));
+
+    current_time = 2000000U;
+    for (size_t i = 0U; i < 5U; i++) {
+        ASSERT_TRUE(m_tb.sendTelemetryData("a", i));
+    }
+    m_tb.loop();
+    EXPECT_EQ(2U, payloads.size());
+    m_tb.loop();
+    EXPECT_EQ(2U, payloads.size());
+    current_time = 3000000U;
+    m_tb.loop();
+    ASSERT_EQ(4U, payloads.size());
+    EXPECT_EQ("{\"a\":3}", payloads[3U]);
+    current_time = 4000000U;
+    m_tb.loop();
+    EXPECT_EQ(5U, payloads.size());
+    EXPECT_TRUE(m_queue.Is_Empty());
+}
+
+TEST_F(Rate_Limiter_Test, DrainsOutboxWithinLimits) {
+    uint8_t outbox_buffer[2U * 128U] = {};
+    std::fill(outbox_buffer, outbox_buffer + sizeof(outbox_buffer), 0xFF);
+    RAM_Outbox_Storage storage(outbox_buffer, sizeof(outbox_buffer), 128U);
+    Outbox<> outbox(storage);
+    ASSERT_TRUE(m_tb.Set_Outbox(outbox));
+    ASSERT_TRUE(m_tb.Set_Outbound_Queue(&m_queue));
+    ASSERT_TRUE(m_tb.Set_Rate_Limiter(&m_limiter));
+    for (size_t i = 0U; i < 3U; i++) {
+        ASSERT_TRUE(outbox.Store(TELEMETRY_TOPIC, reinterpret_cast<uint8_t const *>("{\"a\":1}"), 7U));
+    }
+
+    current_time = 2000000U;
+    m_tb.loop();
+    EXPECT_EQ(2U, payloads.size());
+    current_time = 3000000U;
+    m_tb.loop();
+    EXPECT_EQ(3U, payloads.size());
+    EXPECT_TRUE(outbox.Is_Empty());
+}
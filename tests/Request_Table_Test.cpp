@@ -0,0 +1,86 @@
+// Local includes.
+#include "Request_Table.h"
+#include "RPC_Request_Callback.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+
+
+namespace {
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+using Table = Request_Table<RPC_Request_Callback>;
+#else
+using Table = Request_Table<RPC_Request_Callback, 2U>;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+RPC_Request_Callback const request("getTime", [](JsonDocument const &) {});
+
+} // namespace
+
+TEST(Request_Table, IdEncodesSlotAndGeneration) {
+    Table table;
+    size_t generation = 0U, first = 0U, second = 0U;
+    ASSERT_NE(nullptr, table.Insert(request, generation, first));
+    ASSERT_NE(nullptr, table.Insert(request, generation, second));
+    EXPECT_EQ((1U << REQUEST_TABLE_INDEX_BITS) | 0U, first);
+    EXPECT_EQ((2U << REQUEST_TABLE_INDEX_BITS) | 1U, second);
+    EXPECT_EQ(2U, generation);
+    EXPECT_EQ(2U, table.size());
+    EXPECT_NE(nullptr, table.Find(first));
+    EXPECT_NE(nullptr, table.Find(second));
+}
+
+TEST(Request_Table, RemovedIdIsStaleAfterSlotIsReused) {
+    Table table;
+    size_t generation = 0U, first = 0U, second = 0U;
+    ASSERT_NE(nullptr, table.Insert(request, generation, first));
+    EXPECT_TRUE(table.Remove(first));
+    EXPECT_EQ(nullptr, table.Find(first));
+    EXPECT_FALSE(table.Remove(first));
+
+    ASSERT_NE(nullptr, table.Insert(request, generation, second));
+    EXPECT_EQ(first & (REQUEST_TABLE_MAX_SLOTS - 1U), second & (REQUEST_TABLE_MAX_SLOTS - 1U));
+    EXPECT_NE(first, second);
+    EXPECT_EQ(nullptr, table.Find(first));
+    EXPECT_NE(nullptr, table.Find(second));
+}
+
+TEST(Request_Table, GenerationSkipsZeroWhenWrapping) {
+    Table table;
+    size_t generation = static_cast<size_t>(UINT32_MAX) >> REQUEST_TABLE_INDEX_BITS;
+    size_t id = 0U;
+    ASSERT_NE(nullptr, table.Insert(request, generation, id));
+    EXPECT_EQ(1U, generation);
+    EXPECT_NE(0U, id);
+}
+
+TEST(Request_Table, IdsFitIntoThirtyTwoBits) {
+    Table table;
+    size_t generation = (static_cast<size_t>(UINT32_MAX) >> REQUEST_TABLE_INDEX_BITS) - 1U;
+    size_t id = 0U;
+    ASSERT_NE(nullptr, table.Insert(request, generation, id));
+    EXPECT_EQ(UINT32_MAX & ~static_cast<size_t>(REQUEST_TABLE_MAX_SLOTS - 1U), id);
+    EXPECT_NE(nullptr, table.Find(id));
+}
+
+TEST(Request_Table, ClearForgetsAllRequests) {
+    Table table;
+    size_t generation = 0U, id = 0U;
+    ASSERT_NE(nullptr, table.Insert(request, generation, id));
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(nullptr, table.Find(id));
+    EXPECT_EQ(nullptr, table.Find(0U));
+}
+
+#if !THINGSBOARD_ENABLE_DYNAMIC
+TEST(Request_Table, InsertFailsOnceFull) {
+    Table table;
+    size_t generation = 0U, id = 0U;
+    ASSERT_NE(nullptr, table.Insert(request, generation, id));
+    ASSERT_NE(nullptr, table.Insert(request, generation, id));
+    EXPECT_TRUE(table.full());
+    EXPECT_EQ(nullptr, table.Insert(request, generation, id));
+}
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
@@ -0,0 +1,179 @@
+// Local includes.
+#include "Test_Fixture.h"
+#include "Server_Side_RPC.h"
+#include "Shared_Attribute_Update.h"
+#include "Attribute_Request.h"
+
+
+namespace {
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+using Test_Server_Side_RPC = Server_Side_RPC<>;
+using Test_Shared_Attribute_Update = Shared_Attribute_Update<>;
+using Test_Shared_Attribute_Callback = Shared_Attribute_Callback;
+using Test_Attribute_Request = Attribute_Request<>;
+using Test_Attribute_Request_Callback = Attribute_Request_Callback;
+#else
+using Test_Server_Side_RPC = Server_Side_RPC<2U, 2U>;
+using Test_Shared_Attribute_Update = Shared_Attribute_Update<2U, 2U>;
+using Test_Shared_Attribute_Callback = Shared_Attribute_Callback<2U>;
+using Test_Attribute_Request = Attribute_Request<2U, 2U>;
+using Test_Attribute_Request_Callback = Attribute_Request_Callback<2U>;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+size_t attribute_responses = 0U;
+
+void On_Rpc(JsonVariantConst const & data, JsonDocument & response) {
+    // Nothing to do
+}
+
+void On_Attribute_Response(JsonObjectConst const & data) {
+    attribute_responses++;
+}
+
+void On_Shared_Attribute_Update(JsonObjectConst const & data) {
+    // Nothing to do
+}
+
+char const * const requested_keys[] = { "k" };
+
+class Subscription_Test : public Test_Fixture<> {
+  protected:
+    void SetUp() override {
+        Test_Fixture<>::SetUp();
+        attribute_responses = 0U;
+        m_tb.Subscribe_API_Implementation(m_rpc);
+        m_tb.Subscribe_API_Implementation(m_attribute_request);
+        // Every test connects itself, because some of them subscribe before the connection is established
+        m_client.disconnect();
+    }
+
+    /// @brief Responds to the last published attribute request on its response topic
+    void Respond_To_Attribute_Request() {
+        ASSERT_FALSE(topics.empty());
+        std::string response_topic = topics.back();
+        response_topic.replace(response_topic.find("request"), 7U, "response");
+        ASSERT_TRUE(Receive(response_topic.c_str(), "{\"shared\":{\"k\":1}}"));
+    }
+
+    Test_Server_Side_RPC                  m_rpc = {};
+    Test_Attribute_Request                m_attribute_request = {};
+    Test_Attribute_Request_Callback       m_attribute_callback{&On_Attribute_Response, 0U, nullptr, requested_keys + 0U, requested_keys + 1U};
+    Test_Shared_Attribute_Callback        m_shared_callback{&On_Shared_Attribute_Update};
+};
+
+} // namespace
+
+TEST_F(Subscription_Test, TopicsAreSubscribedOnlyOnce) {
+    Connect();
+    ASSERT_TRUE(m_rpc.RPC_Subscribe(RPC_Callback("a", &On_Rpc)));
+    ASSERT_TRUE(m_rpc.RPC_Subscribe(RPC_Callback("b", &On_Rpc)));
+    ASSERT_TRUE(m_attribute_request.Shared_Attributes_Request(m_attribute_callback));
+    ASSERT_TRUE(m_attribute_request.Shared_Attributes_Request(m_attribute_callback));
+    EXPECT_EQ(2U, m_client.get_subscribe_requests());
+}
+
+TEST_F(Subscription_Test, SubscriptionsBeforeConnectingAreBatched) {
+    Test_Shared_Attribute_Update first_update, second_update;
+    m_tb.Subscribe_API_Implementation(first_update);
+    m_tb.Subscribe_API_Implementation(second_update);
+    ASSERT_TRUE(m_rpc.RPC_Subscribe(RPC_Callback("a", &On_Rpc)));
+    ASSERT_TRUE(first_update.Shared_Attributes_Subscribe(m_shared_callback));
+    ASSERT_TRUE(second_update.Shared_Attributes_Subscribe(m_shared_callback));
+    Connect();
+    EXPECT_EQ(1U, m_client.get_subscribe_requests());
+
+    // Shared topic stays subscribed until every implementation released it
+    m_tb.Set_Subscription_Linger_Time(0U);
+    ASSERT_TRUE(first_update.Shared_Attributes_Unsubscribe());
+    ASSERT_TRUE(first_update.Shared_Attributes_Unsubscribe());
+    EXPECT_EQ(0U, m_client.get_unsubscribe_requests());
+    ASSERT_TRUE(second_update.Shared_Attributes_Unsubscribe());
+    EXPECT_EQ(1U, m_client.get_unsubscribe_requests());
+
+    // Clean reconnect resubscribes every topic that is still referenced in a single request
+    Reconnect();
+    EXPECT_EQ(2U, m_client.get_subscribe_requests());
+}
+
+TEST_F(Subscription_Test, PollingRequestsKeepResponseTopicSubscribedWhileLingering) {
+    Connect();
+    for (size_t i = 0U; i < 5U; i++) {
+        ASSERT_TRUE(m_attribute_request.Shared_Attributes_Request(m_attribute_callback));
+        Respond_To_Attribute_Request();
+        current_time += 1000000U;
+        m_tb.loop();
+    }
+    EXPECT_EQ(5U, attribute_responses);
+    EXPECT_EQ(1U, m_client.get_subscribe_requests());
+    EXPECT_EQ(0U, m_client.get_unsubscribe_requests());
+    current_time += Default_Subscription_Linger_Time;
+    m_tb.loop();
+    EXPECT_EQ(1U, m_client.get_unsubscribe_requests());
+    m_tb.loop();
+    EXPECT_EQ(1U, m_client.get_unsubscribe_requests());
+}
+
+TEST_F(Subscription_Test, FailedRequestDoesNotLeakSubscription) {
+    ASSERT_FALSE(m_attribute_request.Shared_Attributes_Request(m_attribute_callback));
+    Connect();
+    EXPECT_EQ(0U, m_client.get_subscribe_requests());
+}
+
+TEST_F(Subscription_Test, PersistentSessionSkipsResubscribing) {
+    Connect();
+    ASSERT_TRUE(m_rpc.RPC_Subscribe(RPC_Callback("a", &On_Rpc)));
+    ASSERT_TRUE(m_tb.Set_Persistent_Session(true));
+    // First persistent connection has no stored session yet
+    Reconnect();
+    EXPECT_EQ(2U, m_client.get_subscribe_requests());
+    ASSERT_TRUE(m_attribute_request.Shared_Attributes_Request(m_attribute_callback));
+    size_t const subscribe_requests = m_client.get_subscribe_requests();
+    Reconnect();
+    EXPECT_TRUE(m_client.get_session_present());
+    EXPECT_EQ(subscribe_requests, m_client.get_subscribe_requests());
+    EXPECT_EQ(0U, m_client.get_unsubscribe_requests());
+
+    // Request sent before reconnecting is still pending and receives its response
+    Respond_To_Attribute_Request();
+    EXPECT_EQ(1U, attribute_responses);
+}
+
+TEST_F(Subscription_Test, RestoredSessionStateKeepsSubscriptionsAndRequestIds) {
+    ASSERT_TRUE(m_tb.Set_Persistent_Session(true));
+    Connect();
+    ASSERT_TRUE(m_rpc.RPC_Subscribe(RPC_Callback("a", &On_Rpc)));
+    Reconnect();
+    MQTT_Session_State state;
+    m_tb.Get_Session_State(state);
+    EXPECT_EQ(1U, state.topics_size);
+    state.request_id = 42U;
+    size_t const subscribe_requests = m_client.get_subscribe_requests();
+
+    ThingsBoardSized<> restarted(m_client);
+    Test_Server_Side_RPC restarted_rpc;
+    restarted.Subscribe_API_Implementation(restarted_rpc);
+    ASSERT_TRUE(restarted.Set_Persistent_Session(true));
+    restarted.Restore_Session_State(state);
+    Reconnect();
+    ASSERT_TRUE(restarted_rpc.RPC_Subscribe(RPC_Callback("a", &On_Rpc)));
+    EXPECT_EQ(subscribe_requests, m_client.get_subscribe_requests());
+    MQTT_Session_State restored_state;
+    restarted.Get_Session_State(restored_state);
+    EXPECT_EQ(state.request_id, restored_state.request_id);
+    EXPECT_EQ(1U, restored_state.topics_size);
+
+    // Topic is only unsubscribed once, even if unsubscribing is called multiple times
+    restarted.Set_Subscription_Linger_Time(0U);
+    ASSERT_TRUE(restarted_rpc.RPC_Unsubscribe());
+    EXPECT_EQ(1U, m_client.get_unsubscribe_requests());
+    ASSERT_TRUE(restarted_rpc.RPC_Unsubscribe());
+    EXPECT_EQ(1U, m_client.get_unsubscribe_requests());
+
+    // Going back to a clean session forgets every subscription on the next connect
+    ASSERT_TRUE(restarted.Set_Persistent_Session(false));
+    Reconnect();
+    restarted.Get_Session_State(restored_state);
+    EXPECT_FALSE(m_client.get_session_present());
+    EXPECT_EQ(0U, restored_state.topics_size);
+}
@@ -0,0 +1,75 @@
+// Local includes.
+#include "Test_Fixture.h"
+
+// Library includes.
+#include <math.h>
+
+
+namespace {
+
+class Telemetry_Aggregator_Test : public Test_Fixture<> {
+  protected:
+    float              m_temperature_samples[3U] = {};
+    float              m_humidity_samples[4U] = {};
+    Aggregator_Channel m_channels[3U] = { Aggregator_Channel("temp", m_temperature_samples, 3U), Aggregator_Channel("hum", m_humidity_samples, 4U, AGGREGATE_MAX | AGGREGATE_COUNT), Aggregator_Channel("a_key_that_is_way_too_long_for_it", m_humidity_samples, 4U) };
+};
+
+} // namespace
+
+TEST_F(Telemetry_Aggregator_Test, ReducesSamplesOfWindow) {
+    Telemetry_Aggregator aggregator(m_channels, 3U, 1000000U);
+    EXPECT_TRUE(aggregator.Is_Empty());
+    EXPECT_FALSE(aggregator.Should_Emit(0U));
+    for (size_t i = 1U; i <= 10U; i++) {
+        EXPECT_TRUE(aggregator.Add_Sample(size_t(0U), static_cast<float>(i)));
+    }
+    EXPECT_TRUE(aggregator.Add_Sample("hum", 5.0f));
+    EXPECT_FALSE(aggregator.Add_Sample("nope", 1.0f));
+    EXPECT_FALSE(aggregator.Add_Sample(size_t(0U), NAN));
+    EXPECT_FALSE(aggregator.Add_Sample(size_t(5U), 1.0f));
+    aggregator.Close_Window();
+
+    std::string statistics;
+    for (auto it = aggregator.begin(); it != aggregator.end(); ++it) {
+        Telemetry const telemetry = *it;
+        char buffer[64U] = {};
+        size_t const length = Telemetry::Write_Json_Object(&telemetry, &telemetry + 1U, buffer, sizeof(buffer));
+        statistics.append(buffer, length);
+    }
+    EXPECT_EQ("{\"temp_min\":1}{\"temp_max\":10}{\"temp_mean\":5.5}{\"temp_count\":10}{\"hum_max\":5}{\"hum_count\":1}", statistics);
+    aggregator.clear();
+    EXPECT_TRUE(aggregator.Is_Empty());
+    EXPECT_TRUE(aggregator.begin() == aggregator.end());
+}
+
+TEST_F(Telemetry_Aggregator_Test, LoopSendsStatisticsWithCustomSuffixes) {
+    Telemetry_Aggregator aggregator(m_channels, 2U, 0U, "Min", "Max", "Avg", "N");
+    m_tb.Set_Telemetry_Aggregator(aggregator);
+    m_tb.loop();
+    EXPECT_TRUE(payloads.empty());
+    ASSERT_TRUE(aggregator.Add_Sample(size_t(0U), 2.0f));
+    ASSERT_TRUE(aggregator.Add_Sample(size_t(0U), 4.0f));
+    m_tb.loop();
+    EXPECT_EQ(1U, payloads.size());
+    EXPECT_EQ("{\"tempMin\":2,\"tempMax\":4,\"tempAvg\":3,\"tempN\":2}", payloads.back());
+    EXPECT_TRUE(aggregator.Is_Empty());
+}
+
+TEST_F(Telemetry_Aggregator_Test, WindowUsesTimerQueueClock) {
+    Telemetry_Aggregator aggregator(m_channels, 1U, 1000U);
+    m_tb.Set_Telemetry_Aggregator(aggregator);
+    current_time = 7000000U;
+    ASSERT_TRUE(aggregator.Add_Sample(size_t(0U), 1.0f));
+    m_tb.loop();
+    EXPECT_TRUE(payloads.empty());
+    current_time += 999U;
+    m_tb.loop();
+    EXPECT_TRUE(payloads.empty());
+    current_time += 1U;
+    m_tb.loop();
+    EXPECT_EQ(1U, payloads.size());
+    EXPECT_TRUE(aggregator.Is_Empty());
+    EXPECT_FALSE(aggregator.Should_Emit(current_time + 5000U));
+    m_tb.loop();
+    EXPECT_EQ(1U, payloads.size());
+}
@@ -0,0 +1,101 @@
+// Local includes.
+#include "Test_Fixture.h"
+
+
+namespace {
+
+class Telemetry_Batch_Test : public Test_Fixture<> {
+  protected:
+    bool Send(uint64_t const & timestamp, int value) {
+        Telemetry const telemetry[] = { Telemetry("a", value) };
+#if THINGSBOARD_ENABLE_DYNAMIC
+        return m_tb.sendTelemetryBatched(timestamp, &telemetry[0], &telemetry[0] + 1U);
+#else
+        return m_tb.sendTelemetryBatched<1U>(timestamp, &telemetry[0], &telemetry[0] + 1U);
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+};
+
+} // namespace
+
+TEST(Telemetry_Batch, SerializesRowsAsTimestampedArray) {
+    char buffer[128U] = {};
+    Telemetry_Batch batch(buffer, sizeof(buffer), 3U);
+    EXPECT_TRUE(batch.Is_Empty());
+    StaticJsonDocument<JSON_OBJECT_SIZE(2U)> values;
+    values["a"] = 1;
+    values["b"] = "x";
+    ASSERT_TRUE(batch.Append(1U, values, 0U));
+    values["a"] = 2;
+    ASSERT_TRUE(batch.Append(2U, values, 0U));
+    EXPECT_EQ(2U, batch.Get_Rows());
+    EXPECT_FALSE(batch.Should_Flush(0U));
+    EXPECT_STREQ("[{\"ts\":1,\"values\":{\"a\":1,\"b\":\"x\"}},{\"ts\":2,\"values\":{\"a\":2,\"b\":\"x\"}}]", batch.Get_Payload());
+    EXPECT_EQ(strlen(batch.Get_Payload()), batch.Get_Payload_Size());
+    ASSERT_TRUE(batch.Append(3U, values, 0U));
+    EXPECT_TRUE(batch.Should_Flush(0U));
+    batch.clear();
+    EXPECT_TRUE(batch.Is_Empty());
+}
+
+TEST(Telemetry_Batch, RejectsRowThatDoesNotFit) {
+    char buffer[32U] = {};
+    Telemetry_Batch batch(buffer, sizeof(buffer));
+    StaticJsonDocument<JSON_OBJECT_SIZE(1U)> values;
+    values["a"] = 1;
+    ASSERT_TRUE(batch.Append(1U, values, 0U));
+    EXPECT_FALSE(batch.Append(2U, values, 0U));
+    EXPECT_STREQ("[{\"ts\":1,\"values\":{\"a\":1}}]", batch.Get_Payload());
+}
+
+TEST_F(Telemetry_Batch_Test, SendsBatchOnceMaxRowsAreReached) {
+    char buffer[128U] = {};
+    Telemetry_Batch batch(buffer, sizeof(buffer), 2U);
+    m_tb.Set_Telemetry_Batch(batch);
+    ASSERT_TRUE(Send(5U, 1));
+    EXPECT_TRUE(payloads.empty());
+    ASSERT_TRUE(Send(6U, 2));
+    ASSERT_EQ(1U, payloads.size());
+    EXPECT_EQ("[{\"ts\":5,\"values\":{\"a\":1}},{\"ts\":6,\"values\":{\"a\":2}}]", payloads[0U]);
+    EXPECT_TRUE(batch.Is_Empty());
+}
+
+TEST_F(Telemetry_Batch_Test, LoopSendsBatchOnceMaxAgeIsExceeded) {
+    char buffer[128U] = {};
+    Telemetry_Batch batch(buffer, sizeof(buffer), 0U, 1000U);
+    m_tb.Set_Telemetry_Batch(batch);
+    current_time = 3000000U;
+    ASSERT_TRUE(Send(5U, 1));
+    current_time += 999U;
+    m_tb.loop();
+    EXPECT_TRUE(payloads.empty());
+    current_time += 1U;
+    m_tb.loop();
+    ASSERT_EQ(1U, payloads.size());
+    EXPECT_EQ("[{\"ts\":5,\"values\":{\"a\":1}}]", payloads[0U]);
+}
+
+TEST_F(Telemetry_Batch_Test, SendsFullBatchBeforeAppendingRow) {
+    char buffer[64U] = {};
+    Telemetry_Batch batch(buffer, sizeof(buffer));
+    m_tb.Set_Telemetry_Batch(batch);
+    ASSERT_TRUE(Send(5U, 1));
+    ASSERT_TRUE(Send(6U, 2));
+    ASSERT_TRUE(Send(7U, 3));
+    ASSERT_EQ(1U, payloads.size());
+    EXPECT_EQ("[{\"ts\":5,\"values\":{\"a\":1}},{\"ts\":6,\"values\":{\"a\":2}}]", payloads[0U]);
+    ASSERT_TRUE(m_tb.flushTelemetryBatch());
+    ASSERT_EQ(2U, payloads.size());
+    EXPECT_EQ("[{\"ts\":7,\"values\":{\"a\":3}}]", payloads[1U]);
+}
+
+#if !THINGSBOARD_ENABLE_DYNAMIC
+TEST_F(Telemetry_Batch_Test, RejectsRowWithTooManyKeyValuePairs) {
+    char buffer[128U] = {};
+    Telemetry_Batch batch(buffer, sizeof(buffer));
+    m_tb.Set_Telemetry_Batch(batch);
+    Telemetry const telemetry[] = { Telemetry("a", 1), Telemetry("b", 2) };
+    EXPECT_FALSE(m_tb.sendTelemetryBatched<1U>(5U, &telemetry[0], &telemetry[0] + 2U));
+    EXPECT_TRUE(batch.Is_Empty());
+}
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
@@ -0,0 +1,103 @@
+// Local includes.
+#include "Telemetry.h"
+
+// Library includes.
+#include <ArduinoJson.h>
+#include <gtest/gtest.h>
+#include <math.h>
+#include <stdint.h>
+#include <string>
+
+
+namespace {
+
+/// @brief Writes the given telemetry directly as a json object, returns an empty string if the buffer was too small
+template <size_t N>
+std::string Write(Telemetry const (&telemetry)[N], size_t const & buffer_size = 256U) {
+    char buffer[256U] = {};
+    size_t const length = Telemetry::Write_Json_Object(&telemetry[0], &telemetry[0] + N, buffer, buffer_size);
+    if (length == 0U) {
+        return "";
+    }
+    EXPECT_EQ(strlen(buffer), length);
+    return std::string(buffer, length);
+}
+
+/// @brief Copies the given telemetry into a JsonDocument first and serializes it with ArduinoJson, which is the output the direct writer has to match
+template <size_t N>
+std::string Serialize(Telemetry const (&telemetry)[N]) {
+    StaticJsonDocument<JSON_OBJECT_SIZE(N)> json_buffer;
+    for (Telemetry const & data : telemetry) {
+        EXPECT_TRUE(data.SerializeKeyValue(json_buffer));
+    }
+    char buffer[256U] = {};
+    size_t const length = serializeJson(json_buffer, buffer, sizeof(buffer));
+    return std::string(buffer, length);
+}
+
+} // namespace
+
+TEST(Telemetry, WritesBooleansAndStrings) {
+    Telemetry const telemetry[] = { Telemetry("a", 1), Telemetry("b", true), Telemetry("c", false), Telemetry("d", "x\"y\\\n") };
+    EXPECT_EQ("{\"a\":1,\"b\":true,\"c\":false,\"d\":\"x\\\"y\\\\\\n\"}", Write(telemetry));
+}
+
+TEST(Telemetry, EscapesKeys) {
+    Telemetry const telemetry[] = { Telemetry("k\"q", 1) };
+    EXPECT_EQ("{\"k\\\"q\":1}", Write(telemetry));
+}
+
+TEST(Telemetry, WritesIntegerLimits) {
+    Telemetry const telemetry[] = { Telemetry("i", INT64_MIN), Telemetry("j", INT64_MAX), Telemetry("k", -42), Telemetry("z", 0) };
+    EXPECT_EQ("{\"i\":-9223372036854775808,\"j\":9223372036854775807,\"k\":-42,\"z\":0}", Write(telemetry));
+}
+
+TEST(Telemetry, WritesRealNumbers) {
+    Telemetry const telemetry[] = { Telemetry("a", 3.14), Telemetry("b", 1e10), Telemetry("c", 1.5e-7), Telemetry("d", 0.0), Telemetry("e", -2.5), Telemetry("f", 0.1), Telemetry("g", 123456.789) };
+    EXPECT_EQ("{\"a\":3.14,\"b\":1e10,\"c\":1.5e-7,\"d\":0,\"e\":-2.5,\"f\":0.1,\"g\":123456.789}", Write(telemetry));
+}
+
+TEST(Telemetry, RoundsRealNumbersToNineDecimals) {
+    Telemetry const telemetry[] = { Telemetry("a", 1.0 / 3.0), Telemetry("b", 1234567.0), Telemetry("c", 0.00001), Telemetry("d", 0.000012), Telemetry("e", 9.9999999999e9) };
+    EXPECT_EQ("{\"a\":0.333333333,\"b\":1234567,\"c\":1e-5,\"d\":0.000012,\"e\":1e10}", Write(telemetry));
+}
+
+TEST(Telemetry, WritesNonFiniteNumbersAsNull) {
+    Telemetry const telemetry[] = { Telemetry("n", NAN), Telemetry("i", INFINITY) };
+    EXPECT_EQ("{\"n\":null,\"i\":null}", Write(telemetry));
+}
+
+TEST(Telemetry, FailsIfBufferIsTooSmall) {
+    Telemetry const numbers[] = { Telemetry("abc", 12345) };
+    EXPECT_EQ("{\"abc\":12345}", Write(numbers, 14U));
+    EXPECT_EQ("", Write(numbers, 13U));
+    Telemetry const strings[] = { Telemetry("s", "hello") };
+    EXPECT_EQ("{\"s\":\"hello\"}", Write(strings, 14U));
+    EXPECT_EQ("", Write(strings, 13U));
+}
+
+TEST(Telemetry, FailsForEmptyTelemetry) {
+    Telemetry const telemetry[] = { Telemetry("a", 1), Telemetry() };
+    EXPECT_EQ("", Write(telemetry));
+}
+
+TEST(Telemetry, EqualsArduinoJsonForEdgeValues) {
+    Telemetry const exponent_thresholds[] = { Telemetry("a", 1e7), Telemetry("b", 9999999.5), Telemetry("c", 9999999.999999999), Telemetry("d", 1e-5), Telemetry("e", 1.0000001e-5) };
+    EXPECT_EQ(Serialize(exponent_thresholds), Write(exponent_thresholds));
+    Telemetry const rounding_carry[] = { Telemetry("a", 0.99999999995), Telemetry("b", 9.9999999999e9), Telemetry("c", -9.99999999996), Telemetry("d", 1.9999999999e-7) };
+    EXPECT_EQ(Serialize(rounding_carry), Write(rounding_carry));
+    Telemetry const integers[] = { Telemetry("a", INT64_MIN), Telemetry("b", INT64_MAX) };
+    EXPECT_EQ(Serialize(integers), Write(integers));
+    Telemetry const strings[] = { Telemetry("a", "\x01\x1f\x7f"), Telemetry("b", "\b\f\n\r\t"), Telemetry("c", "\"\\/"), Telemetry("k\x02", "v"), Telemetry("k\n", "v") };
+    EXPECT_EQ(Serialize(strings), Write(strings));
+}
+
+TEST(Telemetry, EqualsArduinoJsonForRealNumbersOfEveryMagnitude) {
+    double const mantissas[] = { 1.0, 1.5, 2.5, 3.14159265358979, 1.23456789012345, 9.87654321, 9.999999999, 9.9999999995 };
+    for (int exponent = -320; exponent <= 308; exponent++) {
+        for (double const & mantissa : mantissas) {
+            Telemetry const telemetry[] = { Telemetry("v", mantissa * pow(10.0, exponent)) };
+            ASSERT_EQ(Serialize(telemetry), Write(telemetry)) << mantissa << "e" << exponent;
+        }
+    }
+}
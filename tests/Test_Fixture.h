@@ -0,0 +1,82 @@
+#ifndef Test_Fixture_h
+#define Test_Fixture_h
+
+// Local includes.
+#include "ThingsBoard.h"
+#include "Memory_MQTT_Client.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+
+/// @brief Shared fixture of the tests, that connects an instance of ThingsBoardSized to an in-memory client,
+/// records every message the client publishes and replaces the clock of the timer queue with a manually advanced time.
+/// The recorded messages and the time are static, because the callbacks of the client and the timer queue are function pointers if THINGSBOARD_ENABLE_STL is disabled.
+/// The fixture is a class template, so that the static members can be defined in this header without requiring inline variables
+/// @tparam ThingsBoard Instance of ThingsBoardSized the tests are run against, defaults to the default sized instance
+template <typename ThingsBoard = ThingsBoardSized<>>
+class Test_Fixture : public testing::Test {
+  protected:
+    void SetUp() override {
+        current_time = 0U;
+        topics.clear();
+        payloads.clear();
+        m_client.set_published_callback(&On_Published);
+        m_tb.getTimerQueue().Set_Time_Callback(&Get_Time);
+        ASSERT_TRUE(m_tb.setBufferSize(256U, 256U));
+        Connect();
+    }
+
+    /// @brief Connects the in-memory client, which has to be done before anything can be published
+    void Connect() {
+        ASSERT_TRUE(m_client.connect("client", "user", "password"));
+    }
+
+    /// @brief Disconnects and connects the in-memory client again, simulating a lost and reestablished connection
+    void Reconnect() {
+        m_client.disconnect();
+        Connect();
+    }
+
+    /// @brief Passes the given message to the client as if it had been received from the server,
+    /// copies both because the client expects to be able to modify them, the same as PubSubClient does with its internal buffer
+    /// @param topic Topic the message was received on
+    /// @param payload Payload of the received message
+    /// @return Whether the message was handled by the client or not
+    bool Receive(char const * topic, char const * payload) {
+        std::string topic_copy = topic;
+        std::string payload_copy = payload;
+        return m_client.receive(&topic_copy[0], reinterpret_cast<uint8_t *>(&payload_copy[0]), payload_copy.size());
+    }
+
+    /// @brief Clock of the timer queue, returns the manually advanced time
+    /// @return Current time in microseconds
+    static uint64_t Get_Time() {
+        return current_time;
+    }
+
+    /// @brief Records the topic and payload of every message published by the client
+    static void On_Published(char const * topic, uint8_t const * payload, size_t const & length) {
+        topics.push_back(topic);
+        payloads.push_back(std::string(reinterpret_cast<char const *>(payload), length));
+    }
+
+    static uint64_t                 current_time; // Time in microseconds returned by Get_Time(), reset to 0 before every test
+    static std::vector<std::string> topics;       // Topics of every published message in the order they were published
+    static std::vector<std::string> payloads;     // Payloads of every published message in the order they were published
+    Memory_MQTT_Client              m_client = {};
+    ThingsBoard                     m_tb{m_client};
+};
+
+template <typename ThingsBoard>
+uint64_t Test_Fixture<ThingsBoard>::current_time = 0U;
+
+template <typename ThingsBoard>
+std::vector<std::string> Test_Fixture<ThingsBoard>::topics = {};
+
+template <typename ThingsBoard>
+std::vector<std::string> Test_Fixture<ThingsBoard>::payloads = {};
+
+#endif // Test_Fixture_h
@@ -0,0 +1,174 @@
+// Local includes.
+#include "Test_Fixture.h"
+#include "Server_Side_RPC.h"
+#include "Shared_Attribute_Update.h"
+#include "Attribute_Request.h"
+
+// Library includes.
+#include <string>
+
+
+namespace {
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+using Test_Server_Side_RPC = Server_Side_RPC<>;
+using Test_Shared_Attribute_Update = Shared_Attribute_Update<>;
+using Test_Shared_Attribute_Callback = Shared_Attribute_Callback;
+using Test_Attribute_Request = Attribute_Request<>;
+using Test_Attribute_Request_Callback = Attribute_Request_Callback;
+#else
+using Test_Server_Side_RPC = Server_Side_RPC<2U, 2U>;
+using Test_Shared_Attribute_Update = Shared_Attribute_Update<2U, 2U>;
+using Test_Shared_Attribute_Callback = Shared_Attribute_Callback<2U>;
+using Test_Attribute_Request = Attribute_Request<2U, 2U>;
+using Test_Attribute_Request_Callback = Attribute_Request_Callback<2U>;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+std::string received = {};
+
+void On_Set_Value(JsonVariantConst const & data, JsonDocument & response) {
+    received = "set:" + std::to_string(data["value"].as<int>());
+    response["ok"] = true;
+}
+
+void On_Get_Value(JsonVariantConst const & data, JsonDocument & response) {
+    received = "get";
+    response["value"] = 42;
+}
+
+void On_Attributes(JsonObjectConst const & data) {
+    received.clear();
+    for (JsonPairConst const pair : data) {
+        received += std::string(pair.key().c_str()) + "=" + std::to_string(pair.value().as<int>()) + " ";
+    }
+}
+
+class ThingsBoard_Test : public Test_Fixture<> {
+  protected:
+    void SetUp() override {
+        received.clear();
+        Test_Fixture<>::SetUp();
+    }
+};
+
+} // namespace
+
+TEST_F(ThingsBoard_Test, SendJsonPublishesSerializedDocument) {
+    StaticJsonDocument<JSON_OBJECT_SIZE(2U)> document;
+    document["temperature"] = 21.5;
+    document["active"] = true;
+    ASSERT_TRUE(m_tb.Send_Json(TELEMETRY_TOPIC, document, Helper::Measure_Json(document)));
+    ASSERT_EQ(1U, payloads.size());
+    EXPECT_EQ(TELEMETRY_TOPIC, topics[0U]);
+    EXPECT_EQ("{\"temperature\":21.5,\"active\":true}", payloads[0U]);
+}
+
+TEST_F(ThingsBoard_Test, SendJsonFailsIfPayloadExceedsBuffer) {
+    ASSERT_TRUE(m_tb.setBufferSize(256U, 16U));
+    StaticJsonDocument<JSON_OBJECT_SIZE(1U)> document;
+    document["temperature"] = 21.5;
+    EXPECT_FALSE(m_tb.Send_Json(TELEMETRY_TOPIC, document, Helper::Measure_Json(document)));
+    EXPECT_TRUE(payloads.empty());
+}
+
+TEST_F(ThingsBoard_Test, SendTelemetryAndAttributes) {
+    ASSERT_TRUE(m_tb.sendTelemetryData("temperature", 21));
+    ASSERT_TRUE(m_tb.sendAttributeData("version", "1.0"));
+    std::vector<std::string> const expected_topics = { TELEMETRY_TOPIC, ATTRIBUTE_TOPIC };
+    std::vector<std::string> const expected_payloads = { "{\"temperature\":21}", "{\"version\":\"1.0\"}" };
+    EXPECT_EQ(expected_topics, topics);
+    EXPECT_EQ(expected_payloads, payloads);
+}
+
+TEST_F(ThingsBoard_Test, DispatchesRpcToMethodAndPublishesResponse) {
+    Test_Server_Side_RPC rpc;
+    m_tb.Subscribe_API_Implementation(rpc);
+#if THINGSBOARD_ENABLE_DYNAMIC
+    ASSERT_TRUE(rpc.RPC_Subscribe(RPC_Callback("setValue", &On_Set_Value, JSON_OBJECT_SIZE(1U))));
+    ASSERT_TRUE(rpc.RPC_Subscribe(RPC_Callback("getValue", &On_Get_Value, JSON_OBJECT_SIZE(1U))));
+#else
+    ASSERT_TRUE(rpc.RPC_Subscribe(RPC_Callback("setValue", &On_Set_Value)));
+    ASSERT_TRUE(rpc.RPC_Subscribe(RPC_Callback("getValue", &On_Get_Value)));
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+    ASSERT_TRUE(Receive("v1/devices/me/rpc/request/7", "{\"method\":\"setValue\",\"params\":{\"value\":3}}"));
+    EXPECT_EQ("set:3", received);
+    ASSERT_EQ(1U, payloads.size());
+    EXPECT_EQ("v1/devices/me/rpc/response/7", topics[0U]);
+    EXPECT_EQ("{\"ok\":true}", payloads[0U]);
+
+    ASSERT_TRUE(Receive("v1/devices/me/rpc/request/8", "{\"method\":\"getValue\"}"));
+    EXPECT_EQ("get", received);
+    ASSERT_EQ(2U, payloads.size());
+    EXPECT_EQ("v1/devices/me/rpc/response/8", topics[1U]);
+    EXPECT_EQ("{\"value\":42}", payloads[1U]);
+}
+
+TEST_F(ThingsBoard_Test, IgnoresRpcWithUnknownMethod) {
+    Test_Server_Side_RPC rpc;
+    m_tb.Subscribe_API_Implementation(rpc);
+    ASSERT_TRUE(rpc.RPC_Subscribe(RPC_Callback("setValue", &On_Set_Value)));
+    ASSERT_TRUE(Receive("v1/devices/me/rpc/request/9", "{\"method\":\"unknown\",\"params\":{}}"));
+    EXPECT_TRUE(received.empty());
+    EXPECT_TRUE(payloads.empty());
+}
+
+TEST_F(ThingsBoard_Test, DispatchesSharedAttributeUpdateToSubscribedKeys) {
+    Test_Shared_Attribute_Update update;
+    m_tb.Subscribe_API_Implementation(update);
+    char const * const keys[] = { "led", "mode" };
+    Test_Shared_Attribute_Callback const callback(&On_Attributes, keys + 0U, keys + 2U);
+    ASSERT_TRUE(update.Shared_Attributes_Subscribe(callback));
+
+    ASSERT_TRUE(Receive(ATTRIBUTE_TOPIC, "{\"led\":1,\"other\":2}"));
+    EXPECT_EQ("led=1 other=2 ", received);
+    received.clear();
+    ASSERT_TRUE(Receive(ATTRIBUTE_TOPIC, "{\"other\":2}"));
+    EXPECT_TRUE(received.empty());
+    // Shared attribute updates sent as a response to a request contain the attributes under the shared key
+    ASSERT_TRUE(Receive(ATTRIBUTE_TOPIC, "{\"shared\":{\"mode\":3}}"));
+    EXPECT_EQ("mode=3 ", received);
+}
+
+TEST_F(ThingsBoard_Test, DispatchesAttributeResponseToRequest) {
+    Test_Attribute_Request request;
+    m_tb.Subscribe_API_Implementation(request);
+    char const * const keys[] = { "k" };
+    Test_Attribute_Request_Callback const callback(&On_Attributes, 0U, nullptr, keys + 0U, keys + 1U);
+    ASSERT_TRUE(request.Shared_Attributes_Request(callback));
+    ASSERT_EQ(1U, payloads.size());
+    // Every requested key is followed by a comma, which the server ignores
+    EXPECT_EQ("{\"sharedKeys\":\"k,\"}", payloads[0U]);
+    std::string response_topic = topics[0U];
+    response_topic.replace(response_topic.find("request"), 7U, "response");
+
+    ASSERT_TRUE(Receive(response_topic.c_str(), "{\"shared\":{\"k\":1}}"));
+    EXPECT_EQ("k=1 ", received);
+    // Response is only handled once, because the request is removed afterwards
+    received.clear();
+    ASSERT_TRUE(Receive(response_topic.c_str(), "{\"shared\":{\"k\":1}}"));
+    EXPECT_TRUE(received.empty());
+}
+
+TEST_F(ThingsBoard_Test, IgnoresInvalidPayload) {
+    Test_Server_Side_RPC rpc;
+    m_tb.Subscribe_API_Implementation(rpc);
+    ASSERT_TRUE(rpc.RPC_Subscribe(RPC_Callback("setValue", &On_Set_Value)));
+    ASSERT_TRUE(Receive("v1/devices/me/rpc/request/1", "{\"method\":"));
+    ASSERT_TRUE(Receive("v1/devices/me/unknown", "{\"method\":\"setValue\"}"));
+    EXPECT_TRUE(received.empty());
+    EXPECT_TRUE(payloads.empty());
+}
+
+TEST_F(ThingsBoard_Test, RespondsToRpcWithLargestRequestId) {
+    Test_Server_Side_RPC rpc;
+    m_tb.Subscribe_API_Implementation(rpc);
+#if THINGSBOARD_ENABLE_DYNAMIC
+    ASSERT_TRUE(rpc.RPC_Subscribe(RPC_Callback("getValue", &On_Get_Value, JSON_OBJECT_SIZE(1U))));
+#else
+    ASSERT_TRUE(rpc.RPC_Subscribe(RPC_Callback("getValue", &On_Get_Value)));
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    ASSERT_TRUE(Receive("v1/devices/me/rpc/request/4294967295", "{\"method\":\"getValue\"}"));
+    ASSERT_EQ(1U, topics.size());
+    EXPECT_EQ("v1/devices/me/rpc/response/4294967295", topics[0U]);
+}
@@ -0,0 +1,112 @@
+// Local includes.
+#include "Test_Fixture.h"
+#include "Client_Side_RPC.h"
+
+// Library includes.
+#include <limits>
+
+
+namespace {
+
+size_t timeouts = 0U;
+uint32_t current_micros = 0U;
+uint32_t last_micros = 0U;
+uint32_t overflows = 0U;
+
+/// @brief Simulates the clock used on Arduino, which extends the 32-bit micros() counter
+uint64_t Get_Extended_Micros() {
+    return Callback_Watchdog::extend_micros(current_micros, last_micros, overflows);
+}
+
+void On_Timeout() {
+    timeouts++;
+}
+
+class Timer_Queue_Test : public Test_Fixture<> {
+  protected:
+    void SetUp() override {
+        Test_Fixture<>::SetUp();
+        timeouts = 0U;
+        current_time = 1000U;
+        m_tb.Subscribe_API_Implementation(m_rpc);
+    }
+
+    Client_Side_RPC<> m_rpc = {};
+};
+
+} // namespace
+
+TEST_F(Timer_Queue_Test, ExpiresTimersInOrderOfTheirDeadline) {
+    Timer_Queue queue(&Get_Time);
+    std::vector<int> order;
+    Callback_Watchdog first([&order]() { order.push_back(1); });
+    Callback_Watchdog second([&order]() { order.push_back(2); });
+    Callback_Watchdog third([&order]() { order.push_back(3); });
+    first.once(queue, 300U);
+    second.once(queue, 100U);
+    third.once(queue, 200U);
+    current_time += 50U;
+    queue.update();
+    EXPECT_TRUE(order.empty());
+    current_time += 1000U;
+    queue.update();
+    std::vector<int> const expected = { 2, 3, 1 };
+    EXPECT_EQ(expected, order);
+    EXPECT_TRUE(queue.Is_Empty());
+}
+
+TEST_F(Timer_Queue_Test, DetachedAndDestroyedTimersAreRemoved) {
+    Timer_Queue queue(&Get_Time);
+    std::vector<int> order;
+    Callback_Watchdog first([&order]() { order.push_back(1); });
+    Callback_Watchdog second([&order]() { order.push_back(2); });
+    first.once(queue, 100U);
+    second.once(queue, 200U);
+    {
+        // Copies are scheduled as well and unlinked again once they are destroyed
+        std::vector<Callback_Watchdog> copies;
+        copies.push_back(first);
+        copies.reserve(50U);
+    }
+    second.detach();
+    first.once(queue, 10U);
+    current_time += 1000U;
+    queue.update();
+    std::vector<int> const expected = { 1 };
+    EXPECT_EQ(expected, order);
+    EXPECT_TRUE(queue.Is_Empty());
+}
+
+TEST(Timer_Queue, ExpiresTimerScheduledAcrossMicrosOverflow) {
+    current_micros = std::numeric_limits<uint32_t>::max() - 100U;
+    last_micros = 0U;
+    overflows = 0U;
+    Timer_Queue queue(&Get_Extended_Micros);
+    std::vector<int> order;
+    Callback_Watchdog watchdog([&order]() { order.push_back(1); });
+    watchdog.once(queue, 300U);
+    // Counter overflowed and only 250 microseconds have passed, therefore the deadline has not been reached yet
+    current_micros += 250U;
+    queue.update();
+    EXPECT_TRUE(order.empty());
+    current_micros += 49U;
+    queue.update();
+    EXPECT_TRUE(order.empty());
+    current_micros += 1U;
+    queue.update();
+    std::vector<int> const expected = { 1 };
+    EXPECT_EQ(expected, order);
+    EXPECT_EQ(1U, overflows);
+}
+
+TEST_F(Timer_Queue_Test, ClientSideRpcTimesOutFromLoop) {
+    RPC_Request_Callback const request("getTime", [](JsonDocument const &) {}, nullptr, 5000U, &On_Timeout);
+    ASSERT_TRUE(m_rpc.RPC_Request(request));
+    m_tb.loop();
+    EXPECT_EQ(0U, timeouts);
+    EXPECT_FALSE(m_tb.getTimerQueue().Is_Empty());
+    current_time += 6000U;
+    m_tb.loop();
+    EXPECT_EQ(1U, timeouts);
+    EXPECT_TRUE(m_tb.getTimerQueue().Is_Empty());
+}
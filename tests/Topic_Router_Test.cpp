@@ -0,0 +1,134 @@
+// Local includes.
+#include "Topic_Router.h"
+#include "Array.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+#include <string>
+
+
+namespace {
+
+/// @brief API implementation that only provides the response topic, used to check which implementations a topic is routed to
+class Route : public IAPI_Implementation {
+  public:
+    Route(char const * topic, bool is_prefix, char const * name)
+      : m_topic(topic)
+      , m_is_prefix(is_prefix)
+      , m_name(name)
+    {
+        // Nothing to do
+    }
+
+    char const * Get_Name() const {
+        return m_name;
+    }
+
+    API_Process_Type Get_Process_Type() const override {
+        return API_Process_Type::JSON;
+    }
+
+    void Process_Response(char const * topic, uint8_t * payload, unsigned int length) override {
+        // Nothing to do
+    }
+
+    void Process_Json_Response(char const * topic, JsonDocument const & data) override {
+        // Nothing to do
+    }
+
+    bool Compare_Response_Topic(char const * topic) const override {
+        // Implementations without a constant topic are compared manually, to check the fallback
+        return m_topic == nullptr && topic[0] == 'x';
+    }
+
+    char const * Get_Response_Topic(bool & is_prefix) const override {
+        is_prefix = m_is_prefix;
+        return m_topic;
+    }
+
+    bool Unsubscribe() override {
+        return true;
+    }
+
+    bool Resubscribe_Topic() override {
+        return true;
+    }
+
+#if !THINGSBOARD_USE_ESP_TIMER
+    void loop() override {
+        // Nothing to do
+    }
+#endif // !THINGSBOARD_USE_ESP_TIMER
+
+    void Initialize() override {
+        // Nothing to do
+    }
+
+    void Set_Client(IThingsBoard_Client & client) override {
+        // Nothing to do
+    }
+
+  private:
+    char const * m_topic = {};
+    bool         m_is_prefix = {};
+    char const * m_name = {};
+};
+
+class Topic_Router_Test : public testing::Test {
+  protected:
+    void SetUp() override {
+        for (Route * route : m_routes) {
+            m_router.Add_Route(*route);
+        }
+    }
+
+    std::string Match(char const * topic) const {
+        Array<IAPI_Implementation *, 8U> matches;
+        m_router.Match(topic, matches);
+        std::string names;
+        for (IAPI_Implementation * match : matches) {
+            names += names.empty() ? "" : " ";
+            names += static_cast<Route *>(match)->Get_Name();
+        }
+        return names;
+    }
+
+    Route m_shared{"v1/devices/me/attributes", false, "shared"};
+    Route m_attribute_request{"v1/devices/me/attributes/response/", true, "attribute_request"};
+    Route m_server_rpc{"v1/devices/me/rpc/request/", true, "server_rpc"};
+    Route m_client_rpc{"v1/devices/me/rpc/response/", true, "client_rpc"};
+    Route m_provision{"/provision/response", false, "provision"};
+    Route m_ota{"v2/fw/response/", true, "ota"};
+    Route m_fallback{nullptr, false, "fallback"};
+    Route m_shared_second{"v1/devices/me/attributes", false, "shared_second"};
+    Route * m_routes[8U] = { &m_shared, &m_attribute_request, &m_server_rpc, &m_client_rpc, &m_provision, &m_ota, &m_fallback, &m_shared_second };
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Topic_Router     m_router;
+#else
+    Topic_Router<8U> m_router;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+};
+
+} // namespace
+
+TEST_F(Topic_Router_Test, ExactTopicMatchesAllImplementations) {
+    EXPECT_EQ("shared shared_second", Match("v1/devices/me/attributes"));
+    EXPECT_EQ("provision", Match("/provision/response"));
+}
+
+TEST_F(Topic_Router_Test, ExactTopicDoesNotMatchLongerTopic) {
+    EXPECT_EQ("", Match("v1/devices/me/attributesX"));
+    EXPECT_EQ("", Match("/provision/responsex"));
+}
+
+TEST_F(Topic_Router_Test, PrefixTopicMatchesTopicWithParameters) {
+    EXPECT_EQ("attribute_request", Match("v1/devices/me/attributes/response/3"));
+    EXPECT_EQ("server_rpc", Match("v1/devices/me/rpc/request/12"));
+    EXPECT_EQ("client_rpc", Match("v1/devices/me/rpc/response/1"));
+    EXPECT_EQ("ota", Match("v2/fw/response/5/chunk/3"));
+    EXPECT_EQ("", Match("v1/devices/me/rpc/"));
+}
+
+TEST_F(Topic_Router_Test, ImplementationWithoutTopicIsComparedManually) {
+    EXPECT_EQ("fallback", Match("xyz"));
+}